@@ -71,7 +71,8 @@ enum class StructType
     D3D12DeviceExtendedDesc,
     D3D12ExperimentalFeaturesDesc,
     SlangSessionExtendedDesc,
-    RayTracingValidationDesc
+    RayTracingValidationDesc,
+    CPUDeviceExtendedDesc,
 };
 
 // TODO: Implementation or backend or something else?
@@ -360,6 +361,7 @@ enum class NativeHandleType
 
     Win32 = 0x00000001,
     FileDescriptor = 0x00000002,
+    HostPointer = 0x00000003,
 
     D3D12Device = 0x00020001,
     D3D12CommandQueue = 0x00020002,
@@ -415,6 +417,9 @@ enum class NativeHandleType
     WGPUCommandEncoder = 0x0007000a,
 };
 
+/// Callback releasing host memory wrapped by `IDevice::createBufferFromHostMemory`.
+typedef void (*HostMemoryReleaseFunc)(void* data, void* userData);
+
 struct NativeHandle
 {
     NativeHandleType type = NativeHandleType::Unknown;
@@ -1043,6 +1048,28 @@ public:
     virtual SLANG_NO_THROW Result SLANG_MCALL getSharedHandle(NativeHandle* outHandle) = 0;
 };
 
+/// Handle to an asynchronous readback started with `IDevice::readBufferAsync` or `IDevice::readTextureAsync`.
+class IReadback : public ISlangUnknown
+{
+    SLANG_COM_INTERFACE(0x0d8031e3, 0xd5de, 0x412f, {0x98, 0x9e, 0x79, 0xe2, 0x2e, 0x94, 0x7b, 0x23});
+
+public:
+    /// Returns true if the readback has completed and the data can be accessed without blocking.
+    virtual SLANG_NO_THROW bool SLANG_MCALL isReady() = 0;
+
+    /// Wait on the host for the readback to complete.
+    /// `timeout` is in nanoseconds, can be set to `kTimeoutInfinite`.
+    /// Returns SLANG_E_TIME_OUT if the readback did not complete in time.
+    virtual SLANG_NO_THROW Result SLANG_MCALL wait(uint64_t timeout = kTimeoutInfinite) = 0;
+
+    /// Returns a pointer to the read back data, which stays valid until the readback is released.
+    /// Returns SLANG_E_PENDING if the readback has not completed yet.
+    virtual SLANG_NO_THROW Result SLANG_MCALL getData(const void** outData, Size* outSize) = 0;
+
+    /// Returns the layout of the read back data for texture readbacks (same layout as `IDevice::readTexture`).
+    virtual SLANG_NO_THROW Result SLANG_MCALL getTextureLayout(Size* outRowPitch, Size* outPixelSize) = 0;
+};
+
 struct ShaderOffset
 {
     SlangInt uniformOffset = 0; // TODO: Change to Offset?
@@ -1701,7 +1728,17 @@ class IComputePassEncoder : public IPassEncoder
 public:
     virtual SLANG_NO_THROW void SLANG_MCALL setComputeState(const ComputeState& state) = 0;
     virtual SLANG_NO_THROW void SLANG_MCALL dispatchCompute(GfxCount x, GfxCount y, GfxCount z) = 0;
-    virtual SLANG_NO_THROW void SLANG_MCALL dispatchComputeIndirect(IBuffer* argBuffer, Offset offset) = 0;
+    /// Dispatch with the group counts read from `argBuffer` at `offset` (3 x uint32_t) when the command executes.
+    /// Runs up to `maxDispatchCount` dispatches with consecutive group counts. If `countBuffer` is set, the number of
+    /// dispatches is read from it (uint32_t at `countOffset`) and clamped to `maxDispatchCount`. Count buffers require
+    /// the "dispatch-indirect-count" feature, otherwise `finish` fails with SLANG_E_NOT_AVAILABLE.
+    virtual SLANG_NO_THROW void SLANG_MCALL dispatchComputeIndirect(
+        IBuffer* argBuffer,
+        Offset offset,
+        GfxCount maxDispatchCount = 1,
+        IBuffer* countBuffer = nullptr,
+        Offset countOffset = 0
+    ) = 0;
 };
 
 class IRayTracingPassEncoder : public IPassEncoder
@@ -1825,6 +1862,32 @@ public:
 
     virtual SLANG_NO_THROW void SLANG_MCALL writeTimestamp(IQueryPool* queryPool, GfxIndex queryIndex) = 0;
 
+    /// Create a buffer that is only used by the commands of this encoder.
+    /// Transient resources are recycled once the command buffer has finished executing and must not be used
+    /// afterwards. Their contents are undefined before they are first written by the command buffer.
+    /// On Vulkan, device local transient resources whose uses within the command buffer do not overlap share
+    /// memory. They are bound to memory when the command buffer is recorded, so native handles and device
+    /// addresses are only valid for the commands of this encoder.
+    virtual SLANG_NO_THROW Result SLANG_MCALL createTransientBuffer(const BufferDesc& desc, IBuffer** outBuffer) = 0;
+
+    inline ComPtr<IBuffer> createTransientBuffer(const BufferDesc& desc)
+    {
+        ComPtr<IBuffer> buffer;
+        SLANG_RETURN_NULL_ON_FAIL(createTransientBuffer(desc, buffer.writeRef()));
+        return buffer;
+    }
+
+    /// Create a texture that is only used by the commands of this encoder (see `createTransientBuffer`).
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    createTransientTexture(const TextureDesc& desc, ITexture** outTexture) = 0;
+
+    inline ComPtr<ITexture> createTransientTexture(const TextureDesc& desc)
+    {
+        ComPtr<ITexture> texture;
+        SLANG_RETURN_NULL_ON_FAIL(createTransientTexture(desc, texture.writeRef()));
+        return texture;
+    }
+
     virtual SLANG_NO_THROW Result SLANG_MCALL finish(ICommandBuffer** outCommandBuffer) = 0;
 
     inline ComPtr<ICommandBuffer> finish()
@@ -1834,6 +1897,19 @@ public:
         return commandBuffer;
     }
 
+    /// Finish encoding without waiting for the native command buffer to be recorded.
+    /// Recording runs on the device worker threads (see DeviceDesc::recordingThreadCount). The returned
+    /// command buffer can be submitted right away, submission waits for the recording to complete.
+    /// Devices without worker threads record on the calling thread, like `finish`.
+    virtual SLANG_NO_THROW Result SLANG_MCALL finishAsync(ICommandBuffer** outCommandBuffer) = 0;
+
+    inline ComPtr<ICommandBuffer> finishAsync()
+    {
+        ComPtr<ICommandBuffer> commandBuffer;
+        SLANG_RETURN_NULL_ON_FAIL(finishAsync(commandBuffer.writeRef()));
+        return commandBuffer;
+    }
+
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(NativeHandle* outHandle) = 0;
 };
 
@@ -1851,6 +1927,10 @@ public:
 enum class QueueType
 {
     Graphics,
+    /// Asynchronous compute queue. Falls back to the graphics queue if the device has no dedicated compute queue.
+    Compute,
+    /// Asynchronous copy queue. Falls back to the compute or graphics queue if the device has no dedicated copy queue.
+    Transfer,
 };
 
 class ICommandQueue : public ISlangUnknown
@@ -2067,6 +2147,78 @@ struct SlangDesc
     SlangLineDirectiveMode lineDirectiveMode = SLANG_LINE_DIRECTIVE_MODE_DEFAULT;
 };
 
+/// A timed pass or debug group of a profiled frame (see `IDevice::getProfilerFrame`).
+struct ProfilerZone
+{
+    /// Name of the debug group, or "RenderPass", "ComputePass" or "RayTracingPass" for passes.
+    const char* name;
+    /// Index of the parent zone, -1 for top level zones.
+    GfxIndex parent;
+    /// Nesting depth, 0 for top level zones.
+    uint32_t depth;
+    /// Start and end time in seconds, relative to the start of the first zone of the frame.
+    double startTime;
+    double endTime;
+    /// False if the zone was not closed before the end of its frame, its end time is its start time then.
+    bool closed;
+};
+
+struct ProfilerFrame
+{
+    /// Index of the frame, counted by `IDevice::endProfilerFrame`.
+    uint64_t frameIndex;
+    /// Zones of the frame in depth first order: parents precede their children, siblings are ordered by start time.
+    const ProfilerZone* zones;
+    GfxCount zoneCount;
+};
+
+/// Usage of a block of device memory that resources are sub-allocated from (see `IDevice::getMemoryStats`).
+struct MemoryBlockStats
+{
+    /// Index of the memory heap the block is allocated from.
+    uint32_t heapIndex;
+    /// Size of the block in bytes.
+    Size size;
+    /// Bytes used by the allocations in the block.
+    Size usedSize;
+    /// Bytes not used by any allocation, including the padding between allocations.
+    Size freeSize;
+    /// Size of the largest contiguous free range in bytes.
+    Size largestFreeRange;
+    uint32_t allocationCount;
+    uint32_t freeRangeCount;
+};
+
+/// Device memory usage of a memory heap (see `IDevice::getMemoryStats`).
+struct MemoryHeapStats
+{
+    /// Number of blocks allocated from the heap.
+    uint32_t blockCount;
+    /// Total size of the blocks in bytes.
+    Size blockSize;
+    /// Bytes used by allocations in the blocks.
+    Size usedSize;
+    /// Bytes in the blocks not used by any allocation.
+    Size freeSize;
+    /// Size of the largest contiguous free range over all blocks of the heap in bytes.
+    Size largestFreeRange;
+    /// Number of allocations in the blocks.
+    uint32_t allocationCount;
+    /// Resources with their own device memory object, and the total size of their memory in bytes.
+    uint32_t dedicatedAllocationCount;
+    Size dedicatedSize;
+};
+
+struct MemoryStats
+{
+    /// Statistics of each memory heap of the device, indexed by heap index.
+    const MemoryHeapStats* heaps;
+    GfxCount heapCount;
+    /// Statistics of each memory block.
+    const MemoryBlockStats* blocks;
+    GfxCount blockCount;
+};
+
 struct DeviceNativeHandles
 {
     NativeHandle handles[3] = {};
@@ -2106,6 +2258,16 @@ struct DeviceDesc
     bool enableBackendValidation = false;
     /// Debug callback. If not null, this will be called for each debug message.
     IDebugCallback* debugCallback = nullptr;
+
+    /// Number of worker threads used to record command buffers (Vulkan only).
+    /// Large command lists are split at pass boundaries and recorded in parallel, and
+    /// `ICommandEncoder::finishAsync` records on the workers. 0 records on the calling thread.
+    uint32_t recordingThreadCount = 0;
+
+    /// Enable the GPU timestamp profiler.
+    /// Passes and debug groups recorded by command encoders are timed automatically,
+    /// see `IDevice::endProfilerFrame` and `IDevice::getProfilerFrame`.
+    bool enableProfiler = false;
 };
 
 class IDevice : public ISlangUnknown
@@ -2188,6 +2350,18 @@ public:
     virtual SLANG_NO_THROW Result SLANG_MCALL
     createBufferFromSharedHandle(NativeHandle handle, const BufferDesc& srcDesc, IBuffer** outBuffer) = 0;
 
+    /// Create a buffer using `desc.size` bytes of existing host memory at `data`, without copying it.
+    /// The memory must stay valid until `releaseFunc(data, userData)` is called, which happens once the buffer is
+    /// destroyed. `releaseFunc` can be null if the memory outlives the buffer.
+    /// Only supported by the CPU device.
+    virtual SLANG_NO_THROW Result SLANG_MCALL createBufferFromHostMemory(
+        void* data,
+        const BufferDesc& desc,
+        HostMemoryReleaseFunc releaseFunc,
+        void* userData,
+        IBuffer** outBuffer
+    ) = 0;
+
     virtual SLANG_NO_THROW Result SLANG_MCALL mapBuffer(IBuffer* buffer, CpuAccessMode mode, void** outData) = 0;
     virtual SLANG_NO_THROW Result SLANG_MCALL unmapBuffer(IBuffer* buffer) = 0;
 
@@ -2368,9 +2542,37 @@ public:
     virtual SLANG_NO_THROW Result SLANG_MCALL
     readBuffer(IBuffer* buffer, Offset offset, Size size, ISlangBlob** outBlob) = 0;
 
+    /// Start reading back a texture resource without blocking.
+    /// The copy is submitted to the graphics queue after all previously submitted work,
+    /// the returned readback can be polled or waited on for the result.
+    /// Only the Vulkan backend reads back asynchronously. The other backends fall back to a blocking `readTexture`
+    /// and return a readback that is already complete.
+    virtual SLANG_NO_THROW Result SLANG_MCALL readTextureAsync(ITexture* texture, IReadback** outReadback) = 0;
+
+    /// Start reading back a buffer range without blocking (see `readTextureAsync`).
+    /// Only the Vulkan backend reads back asynchronously. The other backends fall back to a blocking `readBuffer`
+    /// and return a readback that is already complete.
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    readBufferAsync(IBuffer* buffer, Offset offset, Size size, IReadback** outReadback) = 0;
+
     /// Get information about the device.
     virtual SLANG_NO_THROW const DeviceInfo& SLANG_MCALL getDeviceInfo() const = 0;
 
+    /// End the current profiler frame (requires `DeviceDesc::enableProfiler`).
+    /// All command buffers recorded during the frame must have been submitted to the graphics queue.
+    /// The timestamps of the frame are resolved asynchronously, the frame is available through
+    /// `getProfilerFrame` a few frames later. Debug groups inside render passes are not timed.
+    virtual SLANG_NO_THROW Result SLANG_MCALL endProfilerFrame() = 0;
+
+    /// Get the timing tree of the most recent profiler frame whose results are available, without blocking.
+    /// The returned data stays valid until the next call. Returns SLANG_E_NOT_AVAILABLE if no frame is available.
+    virtual SLANG_NO_THROW Result SLANG_MCALL getProfilerFrame(ProfilerFrame* outFrame) = 0;
+
+    /// Get statistics of the device memory that resources are sub-allocated from, per memory heap and per block.
+    /// The returned data stays valid until the next call. Returns SLANG_E_NOT_AVAILABLE on backends that do not
+    /// sub-allocate device memory (all but Vulkan).
+    virtual SLANG_NO_THROW Result SLANG_MCALL getMemoryStats(MemoryStats* outStats) = 0;
+
     virtual SLANG_NO_THROW Result SLANG_MCALL createQueryPool(const QueryPoolDesc& desc, IQueryPool** outPool) = 0;
 
     virtual SLANG_NO_THROW Result SLANG_MCALL
@@ -2511,4 +2713,34 @@ struct RayTracingValidationDesc
     bool enableRaytracingValidation = false;
 };
 
+enum class CPUTextureLayout
+{
+    /// Texels are stored row by row.
+    Linear,
+    /// 2D and 3D textures are stored in tiles of 16x16 (2D) or 8x8x8 (3D) texels, with the texels of a tile in
+    /// Morton (Z) order. Improves cache locality of neighbourhood accesses, uploads and readbacks convert the data.
+    Tiled,
+};
+
+/// Options of the CPU device.
+struct CPUDeviceExtendedDesc
+{
+    StructType structType = StructType::CPUDeviceExtendedDesc;
+    /// Memory layout of textures.
+    CPUTextureLayout textureLayout = CPUTextureLayout::Linear;
+    /// Alignment of buffer memory in bytes (power of 2).
+    Size bufferAlignment = 64;
+    /// Buffers of at least this size are allocated directly from virtual memory, backed by transparent huge pages
+    /// where available. 0 disables huge page allocations.
+    /// Upload and readback buffers are always allocated from virtual memory, which is committed on first access.
+    Size hugePageBufferThreshold = 2 * 1024 * 1024;
+    /// `IDevice::readBuffer` returns a blob referencing the buffer memory instead of a copy.
+    /// The blob keeps the buffer alive, later writes to the buffer are visible through it.
+    bool readBufferView = false;
+    /// Run the work groups of a dispatch in parallel on worker threads instead of one after another.
+    /// Work groups are not synchronized with each other and atomics are not supported, so kernels communicating
+    /// across work groups race when this is enabled.
+    bool parallelDispatch = false;
+};
+
 } // namespace rhi
@@ -4,6 +4,8 @@
 
 #include "core/common.h"
 
+#include <algorithm>
+#include <map>
 #include <vector>
 
 namespace rhi {
@@ -16,6 +18,13 @@ public:
     {
         RefPtr<TBuffer> resource;
         size_t size;
+        uint32_t idleFrames = 0;
+    };
+
+    struct LargeBuffer
+    {
+        RefPtr<TBuffer> resource;
+        uint32_t idleFrames = 0;
     };
 
     struct Allocation
@@ -31,11 +40,17 @@ public:
 
     std::vector<StagingBufferPage> m_pages;
     std::vector<RefPtr<TBuffer>> m_largeAllocations;
+    // Large buffers released by reset(), keyed by size class.
+    std::map<size_t, std::vector<LargeBuffer>> m_freeLargeBuffers;
 
     Index m_pageAllocCounter = 0;
     size_t m_offsetAllocCounter = 0;
+    // Number of pages used since the last reset().
+    Index m_usedPageCount = 0;
 
     const size_t kStagingBufferDefaultPageSize = 16 * 1024 * 1024;
+    // Pages and free large buffers not used for this many frames are released.
+    const uint32_t kMaxIdleFrames = 8;
 
     void init(TDevice* device, MemoryType memoryType, uint32_t alignment, BufferUsage usage)
     {
@@ -47,11 +62,50 @@ public:
 
     static size_t alignUp(size_t value, uint32_t alignment) { return (value + alignment - 1) / alignment * alignment; }
 
+    /// Round a large allocation size up to its size class.
+    /// There are 4 size classes per power of two, so at most 25% of a large buffer is wasted.
+    static size_t getSizeClass(size_t size)
+    {
+        // Largest power of two that fits into `size` 4 times.
+        size_t step = 1;
+        while ((step << 3) <= size)
+            step <<= 1;
+        return alignUp(size, (uint32_t)step);
+    }
+
     void reset()
     {
+        // Trim pages at the end that have not been used for a while.
+        for (Index i = 0; i < (Index)m_pages.size(); i++)
+            m_pages[i].idleFrames = i < m_usedPageCount ? 0 : m_pages[i].idleFrames + 1;
+        while (!m_pages.empty() && m_pages.back().idleFrames > kMaxIdleFrames)
+            m_pages.pop_back();
+
+        // Age the free large buffers and release the ones that have been idle for too long.
+        for (auto it = m_freeLargeBuffers.begin(); it != m_freeLargeBuffers.end();)
+        {
+            auto& buffers = it->second;
+            for (auto& buffer : buffers)
+                buffer.idleFrames++;
+            buffers.erase(
+                std::remove_if(
+                    buffers.begin(),
+                    buffers.end(),
+                    [this](const LargeBuffer& buffer) { return buffer.idleFrames > kMaxIdleFrames; }
+                ),
+                buffers.end()
+            );
+            it = buffers.empty() ? m_freeLargeBuffers.erase(it) : std::next(it);
+        }
+
+        // Large buffers used in the last frame are recycled instead of being released.
+        for (auto& resource : m_largeAllocations)
+            m_freeLargeBuffers[resource->m_desc.size].push_back(LargeBuffer{resource, 0});
+        m_largeAllocations.clear();
+
         m_pageAllocCounter = 0;
         m_offsetAllocCounter = 0;
-        m_largeAllocations.clear();
+        m_usedPageCount = 0;
     }
 
     Result newStagingBufferPage()
@@ -75,6 +129,17 @@ public:
 
     Result newLargeBuffer(size_t size)
     {
+        size = getSizeClass(size);
+        auto it = m_freeLargeBuffers.find(size);
+        if (it != m_freeLargeBuffers.end())
+        {
+            m_largeAllocations.push_back(it->second.back().resource);
+            it->second.pop_back();
+            if (it->second.empty())
+                m_freeLargeBuffers.erase(it);
+            return SLANG_OK;
+        }
+
         ComPtr<IBuffer> bufferPtr;
         BufferDesc bufferDesc;
         bufferDesc.usage = m_usage;
@@ -123,6 +188,7 @@ public:
         result.offset = bufferAllocOffset;
         m_pageAllocCounter = bufferId;
         m_offsetAllocCounter = bufferAllocOffset + size;
+        m_usedPageCount = bufferId + 1;
         return result;
     }
 };
@@ -170,6 +170,7 @@ void CommandList::write(commands::DispatchCompute&& cmd)
 void CommandList::write(commands::DispatchComputeIndirect&& cmd)
 {
     retainResource(cmd.argBuffer);
+    retainResource(cmd.countBuffer);
     writeCommand(std::move(cmd));
 }
 
@@ -221,6 +222,9 @@ void CommandList::write(commands::BuildAccelerationStructure&& cmd)
             cmd.desc.inputs = inputs;
             for (Index i = 0; i < cmd.desc.inputCount; ++i)
             {
+                // Backends read the buffer lists when the command is executed, after the caller may have freed them.
+                inputs[i].vertexBuffers = (BufferWithOffset*)
+                    writeData(inputs[i].vertexBuffers, inputs[i].vertexBufferCount * sizeof(BufferWithOffset));
                 for (Index j = 0; j < inputs[i].vertexBufferCount; ++j)
                     retainResource(inputs[i].vertexBuffers[j].buffer);
                 retainResource(inputs[i].indexBuffer.buffer);
@@ -238,6 +242,8 @@ void CommandList::write(commands::BuildAccelerationStructure&& cmd)
             cmd.desc.inputs = inputs;
             for (Index i = 0; i < cmd.desc.inputCount; ++i)
             {
+                inputs[i].aabbBuffers = (BufferWithOffset*)
+                    writeData(inputs[i].aabbBuffers, inputs[i].aabbBufferCount * sizeof(BufferWithOffset));
                 for (Index j = 0; j < inputs[i].aabbBufferCount; ++j)
                     retainResource(inputs[i].aabbBuffers[j].buffer);
             }
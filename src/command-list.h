@@ -209,6 +209,9 @@ struct DispatchComputeIndirect
 {
     IBuffer* argBuffer;
     Offset offset;
+    GfxCount maxDispatchCount;
+    IBuffer* countBuffer;
+    Offset countOffset;
 };
 
 struct BeginRayTracingPass
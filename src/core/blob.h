@@ -72,4 +72,29 @@ private:
     size_t m_size;
 };
 
+/// Blob referencing memory of another object, which is kept alive by the blob.
+class BorrowedBlob : public BlobBase
+{
+public:
+    virtual SLANG_NO_THROW void const* SLANG_MCALL getBufferPointer() { return m_data; }
+    virtual SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() { return m_size; }
+
+    static ComPtr<ISlangBlob> create(RefObject* owner, const void* data, size_t size)
+    {
+        return ComPtr<ISlangBlob>(new BorrowedBlob(owner, data, size));
+    }
+
+private:
+    explicit BorrowedBlob(RefObject* owner, const void* data, size_t size)
+        : m_owner(owner)
+        , m_data(data)
+        , m_size(size)
+    {
+    }
+
+    RefPtr<RefObject> m_owner;
+    const void* m_data;
+    size_t m_size;
+};
+
 } // namespace rhi
@@ -169,5 +169,37 @@ inline float halfToFloat(unsigned short input)
     return o.fvalue;
 }
 
+inline unsigned short floatToHalf(float input)
+{
+    // Round to nearest even, overflows to Inf, NaN stays NaN.
+    static const auto f32infty = FloatIntUnion::makeFromInt(255 << 23);
+    static const auto f16max = FloatIntUnion::makeFromInt((127 + 16) << 23);
+    static const auto denormMagic = FloatIntUnion::makeFromInt(((127 - 15) + (23 - 10) + 1) << 23);
+    auto f = FloatIntUnion::makeFromFloat(input);
+    uint32_t bits = uint32_t(f.ivalue);
+    uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+    unsigned short o;
+    if (bits >= uint32_t(f16max.ivalue))
+    {
+        o = bits > uint32_t(f32infty.ivalue) ? 0x7e00 : 0x7c00;
+    }
+    else if (bits < (113u << 23))
+    {
+        // Denormal or zero, let the FPU do the rounding.
+        f.ivalue = int(bits);
+        f.fvalue += denormMagic.fvalue;
+        o = (unsigned short)(uint32_t(f.ivalue) - uint32_t(denormMagic.ivalue));
+    }
+    else
+    {
+        uint32_t mantissaOdd = (bits >> 13) & 1;
+        bits += (uint32_t(15 - 127) << 23) + 0xfff;
+        bits += mantissaOdd;
+        o = (unsigned short)(bits >> 13);
+    }
+    return (unsigned short)(o | (sign >> 16));
+}
+
 } // namespace math
 } // namespace rhi
@@ -2,11 +2,19 @@
 
 #include "assert.h"
 
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
 #if SLANG_WINDOWS_FAMILY
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
 #elif SLANG_LINUX_FAMILY || SLANG_APPLE_FAMILY
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #else
 #error "Unsupported platform"
 #endif
@@ -51,4 +59,183 @@ void* findSymbolAddressByName(SharedLibraryHandle handle, char const* name)
 #endif
 }
 
+Size getPageSize()
+{
+#if SLANG_WINDOWS_FAMILY
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    return Size(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+void* alignedAlloc(Size size, Size alignment)
+{
+#if SLANG_WINDOWS_FAMILY
+    return _aligned_malloc(size, alignment);
+#else
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, alignment < sizeof(void*) ? sizeof(void*) : alignment, size) != 0)
+        return nullptr;
+    return ptr;
+#endif
+}
+
+void alignedFree(void* ptr)
+{
+#if SLANG_WINDOWS_FAMILY
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void* allocateVirtualMemory(Size size, bool hugePages)
+{
+#if SLANG_WINDOWS_FAMILY
+    // Large pages need the SeLockMemoryPrivilege and are never paged out, regular pages are used instead.
+    SLANG_UNUSED(hugePages);
+    return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    static const Size kHugePageSize = 2 * 1024 * 1024;
+    // Over-allocate so the start can be aligned to a huge page, and release the excess.
+    Size pageSize = getPageSize();
+    Size mappedSize = (size + pageSize - 1) & ~(pageSize - 1);
+    Size alignment = hugePages ? kHugePageSize : pageSize;
+    Size reservedSize = mappedSize + alignment - pageSize;
+    void* ptr = mmap(nullptr, reservedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (ptr == MAP_FAILED)
+        return nullptr;
+    uint8_t* begin = (uint8_t*)ptr;
+    uint8_t* aligned = (uint8_t*)((uintptr_t(begin) + alignment - 1) & ~uintptr_t(alignment - 1));
+    uint8_t* end = begin + reservedSize;
+    if (aligned > begin)
+        munmap(begin, aligned - begin);
+    if (end > aligned + mappedSize)
+        munmap(aligned + mappedSize, end - (aligned + mappedSize));
+#if SLANG_LINUX_FAMILY
+    if (hugePages)
+        madvise(aligned, mappedSize, MADV_HUGEPAGE);
+#endif
+    return aligned;
+#endif
+}
+
+void freeVirtualMemory(void* ptr, Size size)
+{
+#if SLANG_WINDOWS_FAMILY
+    SLANG_UNUSED(size);
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    munmap(ptr, size);
+#endif
+}
+
+Result mapFile(NativeHandle file, Size size, void** outPtr)
+{
+#if SLANG_WINDOWS_FAMILY
+    if (file.type != NativeHandleType::Win32)
+        return SLANG_E_INVALID_ARG;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx((HANDLE)file.value, &fileSize) || Size(fileSize.QuadPart) < size)
+        return SLANG_FAIL;
+    HANDLE mapping = CreateFileMappingA((HANDLE)file.value, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+    if (!mapping)
+        return SLANG_FAIL;
+    // The view keeps the mapping object alive.
+    void* ptr = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    CloseHandle(mapping);
+    if (!ptr)
+        return SLANG_FAIL;
+#else
+    if (file.type != NativeHandleType::FileDescriptor)
+        return SLANG_E_INVALID_ARG;
+    struct stat fileStat;
+    if (fstat(int(file.value), &fileStat) != 0 || Size(fileStat.st_size) < size)
+        return SLANG_FAIL;
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, int(file.value), 0);
+    if (ptr == MAP_FAILED)
+        return SLANG_FAIL;
+#endif
+    *outPtr = ptr;
+    return SLANG_OK;
+}
+
+void unmapFile(void* ptr, Size size)
+{
+#if SLANG_WINDOWS_FAMILY
+    SLANG_UNUSED(size);
+    UnmapViewOfFile(ptr);
+#else
+    munmap(ptr, size);
+#endif
+}
+
+Result createSharedMemory(Size size, NativeHandle* outHandle)
+{
+#if SLANG_WINDOWS_FAMILY
+    // Section backed by the paging file.
+    HANDLE mapping = CreateFileMappingA(
+        INVALID_HANDLE_VALUE,
+        nullptr,
+        PAGE_READWRITE,
+        DWORD(uint64_t(size) >> 32),
+        DWORD(uint64_t(size) & 0xffffffff),
+        nullptr
+    );
+    if (!mapping)
+        return SLANG_FAIL;
+    outHandle->type = NativeHandleType::Win32;
+    outHandle->value = (uint64_t)mapping;
+    return SLANG_OK;
+#else
+#if SLANG_LINUX_FAMILY
+    int fd = memfd_create("slang-rhi-shared-memory", MFD_CLOEXEC);
+#else
+    // No memfd, use an unlinked POSIX shared memory object.
+    static std::atomic<uint32_t> counter;
+    char name[64];
+    snprintf(name, sizeof(name), "/slang-rhi-%d-%u", int(getpid()), unsigned(counter++));
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0)
+        shm_unlink(name);
+#endif
+    if (fd < 0)
+        return SLANG_FAIL;
+    if (ftruncate(fd, off_t(size)) != 0)
+    {
+        close(fd);
+        return SLANG_FAIL;
+    }
+    outHandle->type = NativeHandleType::FileDescriptor;
+    outHandle->value = uint64_t(fd);
+    return SLANG_OK;
+#endif
+}
+
+void closeSharedMemory(NativeHandle handle)
+{
+#if SLANG_WINDOWS_FAMILY
+    CloseHandle((HANDLE)handle.value);
+#else
+    close(int(handle.value));
+#endif
+}
+
+Result mapSharedMemory(NativeHandle handle, Size size, void** outPtr)
+{
+#if SLANG_WINDOWS_FAMILY
+    if (handle.type != NativeHandleType::Win32)
+        return SLANG_E_INVALID_ARG;
+    void* ptr = MapViewOfFile((HANDLE)handle.value, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!ptr)
+        return SLANG_FAIL;
+    *outPtr = ptr;
+    return SLANG_OK;
+#else
+    return mapFile(handle, size, outPtr);
+#endif
+}
+
 } // namespace rhi
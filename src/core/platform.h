@@ -13,4 +13,31 @@ void unloadSharedLibrary(SharedLibraryHandle handle);
 /// Return nullptr if object is not found.
 void* findSymbolAddressByName(SharedLibraryHandle handle, char const* name);
 
+/// Size of a virtual memory page.
+Size getPageSize();
+
+/// Allocate memory aligned to `alignment` (a power of 2), released with `alignedFree`.
+void* alignedAlloc(Size size, Size alignment);
+void alignedFree(void* ptr);
+
+/// Reserve `size` bytes of zero initialized, page aligned virtual memory.
+/// Physical pages are only committed when first accessed (where the OS supports it).
+/// If `hugePages` is set, the memory is aligned to 2MB and advised to use transparent huge pages.
+/// Returns nullptr on failure.
+void* allocateVirtualMemory(Size size, bool hugePages);
+void freeVirtualMemory(void* ptr, Size size);
+
+/// Map the first `size` bytes of a file (a file descriptor or a Win32 file handle) for reading and writing.
+/// Writes go to the file. Fails if the file is smaller than `size`.
+Result mapFile(NativeHandle file, Size size, void** outPtr);
+/// Unmap memory mapped with `mapFile` or `mapSharedMemory`.
+void unmapFile(void* ptr, Size size);
+
+/// Create `size` bytes of zero initialized shared memory, which other processes can map with `mapSharedMemory`
+/// (after duplicating the handle into them). Returns a file descriptor (memfd on Linux) or a Win32 file mapping handle.
+Result createSharedMemory(Size size, NativeHandle* outHandle);
+void closeSharedMemory(NativeHandle handle);
+/// Map the first `size` bytes of shared memory for reading and writing.
+Result mapSharedMemory(NativeHandle handle, Size size, void** outPtr);
+
 } // namespace rhi
@@ -0,0 +1,91 @@
+#include "thread-pool.h"
+
+namespace rhi {
+
+bool ThreadPool::Task::isDone()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_done;
+}
+
+bool ThreadPool::Task::claim()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_claimed)
+        return false;
+    m_claimed = true;
+    return true;
+}
+
+void ThreadPool::Task::run()
+{
+    m_func();
+    m_func = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_done = true;
+    }
+    m_cv.notify_all();
+}
+
+ThreadPool::ThreadPool(uint32_t threadCount)
+{
+    m_threads.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; i++)
+        m_threads.emplace_back([this]() { workerMain(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    for (auto& thread : m_threads)
+        thread.join();
+}
+
+std::shared_ptr<ThreadPool::Task> ThreadPool::submit(std::function<void()> func)
+{
+    auto task = std::make_shared<Task>();
+    task->m_func = std::move(func);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(task);
+    }
+    m_cv.notify_one();
+    return task;
+}
+
+void ThreadPool::wait(Task* task)
+{
+    if (task->claim())
+    {
+        task->run();
+        return;
+    }
+    std::unique_lock<std::mutex> lock(task->m_mutex);
+    task->m_cv.wait(lock, [task]() { return task->m_done; });
+}
+
+void ThreadPool::workerMain()
+{
+    while (true)
+    {
+        std::shared_ptr<Task> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+            if (m_queue.empty())
+                return;
+            task = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        // Tasks that were already run by a waiting thread are skipped.
+        if (task->claim())
+            task->run();
+    }
+}
+
+} // namespace rhi
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rhi {
+
+/// Fixed size pool of worker threads executing tasks in submission order.
+/// Waiting on a task that no worker has picked up yet runs it on the waiting thread,
+/// so tasks can wait on other tasks without starving the pool.
+class ThreadPool
+{
+public:
+    class Task
+    {
+    public:
+        /// Returns true once the task has finished executing.
+        bool isDone();
+
+    private:
+        friend class ThreadPool;
+
+        std::function<void()> m_func;
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        bool m_claimed = false;
+        bool m_done = false;
+
+        /// Take ownership of running the task. Returns false if it is already run by another thread.
+        bool claim();
+        void run();
+    };
+
+    explicit ThreadPool(uint32_t threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    uint32_t getThreadCount() const { return (uint32_t)m_threads.size(); }
+
+    /// Schedule a task for execution on the worker threads.
+    std::shared_ptr<Task> submit(std::function<void()> func);
+
+    /// Wait for a task to finish, running it on the calling thread if it has not been started yet.
+    void wait(Task* task);
+
+private:
+    void workerMain();
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::shared_ptr<Task>> m_queue;
+    bool m_stop = false;
+};
+
+} // namespace rhi
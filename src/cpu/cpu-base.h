@@ -15,6 +15,7 @@ namespace rhi::cpu {
 class BufferImpl;
 class TextureImpl;
 class TextureViewImpl;
+class SamplerImpl;
 class ShaderObjectLayoutImpl;
 class EntryPointLayoutImpl;
 class RootShaderObjectLayoutImpl;
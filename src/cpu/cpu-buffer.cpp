@@ -1,13 +1,37 @@
 #include "cpu-buffer.h"
 #include "cpu-device.h"
 
+#include "core/platform.h"
+
 namespace rhi::cpu {
 
 BufferImpl::~BufferImpl()
 {
-    if (m_data)
+    if (!m_data)
+    {
+        return;
+    }
+    switch (m_storage)
     {
-        std::free(m_data);
+    case Storage::Heap:
+        alignedFree(m_data);
+        break;
+    case Storage::VirtualMemory:
+        freeVirtualMemory(m_data, m_desc.size);
+        break;
+    case Storage::MappedFile:
+        unmapFile(m_data, m_desc.size);
+        break;
+    case Storage::SharedMemory:
+        unmapFile(m_data, m_desc.size);
+        closeSharedMemory(m_sharedHandle);
+        break;
+    case Storage::External:
+        if (m_releaseFunc)
+        {
+            m_releaseFunc(m_data, m_releaseUserData);
+        }
+        break;
     }
 }
 
@@ -16,11 +40,56 @@ DeviceAddress BufferImpl::getDeviceAddress()
     return (DeviceAddress)m_data;
 }
 
+Result BufferImpl::getNativeHandle(NativeHandle* outHandle)
+{
+    outHandle->type = NativeHandleType::HostPointer;
+    outHandle->value = (uint64_t)m_data;
+    return SLANG_OK;
+}
+
+Result BufferImpl::getSharedHandle(NativeHandle* outHandle)
+{
+    // Only buffers created with `isShared` live in shared memory.
+    *outHandle = m_sharedHandle;
+    return m_sharedHandle ? SLANG_OK : SLANG_E_NOT_AVAILABLE;
+}
+
 Result DeviceImpl::createBuffer(const BufferDesc& descIn, const void* initData, IBuffer** outBuffer)
 {
     BufferDesc desc = fixupBufferDesc(descIn);
     RefPtr<BufferImpl> buffer = new BufferImpl(desc);
-    buffer->m_data = (uint8_t*)std::malloc(desc.size);
+
+    // Large buffers bypass the heap and get huge pages. Upload and readback buffers are often only partially
+    // written, so they get pages which are only committed when touched.
+    Size hugePageThreshold = m_extendedDesc.hugePageBufferThreshold;
+    bool hugePages =
+        desc.memoryType == MemoryType::DeviceLocal && hugePageThreshold > 0 && desc.size >= hugePageThreshold;
+    bool lazyCommit = desc.memoryType != MemoryType::DeviceLocal && desc.size >= getPageSize();
+    if (desc.isShared)
+    {
+        // Shared memory can be mapped by other devices and processes without copying.
+        NativeHandle sharedHandle;
+        SLANG_RETURN_ON_FAIL(createSharedMemory(desc.size, &sharedHandle));
+        void* data = nullptr;
+        if (SLANG_FAILED(mapSharedMemory(sharedHandle, desc.size, &data)))
+        {
+            closeSharedMemory(sharedHandle);
+            return SLANG_FAIL;
+        }
+        buffer->m_data = (uint8_t*)data;
+        buffer->m_storage = BufferImpl::Storage::SharedMemory;
+        buffer->m_sharedHandle = sharedHandle;
+    }
+    else if ((hugePages || lazyCommit) && m_extendedDesc.bufferAlignment <= getPageSize())
+    {
+        buffer->m_data = (uint8_t*)allocateVirtualMemory(desc.size, hugePages);
+        buffer->m_storage = BufferImpl::Storage::VirtualMemory;
+    }
+    else
+    {
+        buffer->m_data = (uint8_t*)alignedAlloc(desc.size, m_extendedDesc.bufferAlignment);
+        buffer->m_storage = BufferImpl::Storage::Heap;
+    }
     if (!buffer->m_data)
     {
         return SLANG_E_OUT_OF_MEMORY;
@@ -33,6 +102,67 @@ Result DeviceImpl::createBuffer(const BufferDesc& descIn, const void* initData,
     return SLANG_OK;
 }
 
+Result DeviceImpl::createBufferFromNativeHandle(NativeHandle handle, const BufferDesc& srcDesc, IBuffer** outBuffer)
+{
+    BufferDesc desc = fixupBufferDesc(srcDesc);
+    RefPtr<BufferImpl> buffer = new BufferImpl(desc);
+
+    if (handle.type == NativeHandleType::FileDescriptor || handle.type == NativeHandleType::Win32)
+    {
+        // File backed buffer, pages are read from and written back to the file by the OS.
+        void* data = nullptr;
+        SLANG_RETURN_ON_FAIL(mapFile(handle, desc.size, &data));
+        buffer->m_data = (uint8_t*)data;
+        buffer->m_storage = BufferImpl::Storage::MappedFile;
+    }
+    else if (handle.type == NativeHandleType::HostPointer)
+    {
+        // The memory is owned by the application (or another buffer).
+        buffer->m_data = (uint8_t*)handle.value;
+        buffer->m_storage = BufferImpl::Storage::External;
+    }
+    else
+    {
+        return SLANG_FAIL;
+    }
+
+    returnComPtr(outBuffer, buffer);
+    return SLANG_OK;
+}
+
+Result DeviceImpl::createBufferFromSharedHandle(NativeHandle handle, const BufferDesc& srcDesc, IBuffer** outBuffer)
+{
+    BufferDesc desc = fixupBufferDesc(srcDesc);
+    RefPtr<BufferImpl> buffer = new BufferImpl(desc);
+
+    // The handle stays owned by the caller, the mapping remains valid after it is closed.
+    void* data = nullptr;
+    SLANG_RETURN_ON_FAIL(mapSharedMemory(handle, desc.size, &data));
+    buffer->m_data = (uint8_t*)data;
+    buffer->m_storage = BufferImpl::Storage::MappedFile;
+
+    returnComPtr(outBuffer, buffer);
+    return SLANG_OK;
+}
+
+Result DeviceImpl::createBufferFromHostMemory(
+    void* data,
+    const BufferDesc& descIn,
+    HostMemoryReleaseFunc releaseFunc,
+    void* userData,
+    IBuffer** outBuffer
+)
+{
+    BufferDesc desc = fixupBufferDesc(descIn);
+    RefPtr<BufferImpl> buffer = new BufferImpl(desc);
+    buffer->m_data = (uint8_t*)data;
+    buffer->m_storage = BufferImpl::Storage::External;
+    buffer->m_releaseFunc = releaseFunc;
+    buffer->m_releaseUserData = userData;
+    returnComPtr(outBuffer, buffer);
+    return SLANG_OK;
+}
+
 Result DeviceImpl::mapBuffer(IBuffer* buffer, CpuAccessMode mode, void** outData)
 {
     *outData = checked_cast<BufferImpl*>(buffer)->m_data;
@@ -48,11 +178,17 @@ Result DeviceImpl::unmapBuffer(IBuffer* buffer)
 Result DeviceImpl::readBuffer(IBuffer* buffer, Offset offset, Size size, ISlangBlob** outBlob)
 {
     BufferImpl* bufferImpl = checked_cast<BufferImpl*>(buffer);
-    auto blob = OwnedBlob::create(size);
     if (offset + size > bufferImpl->m_desc.size)
     {
         return SLANG_FAIL;
     }
+    if (m_extendedDesc.readBufferView)
+    {
+        auto blob = BorrowedBlob::create(bufferImpl, bufferImpl->m_data + offset, size);
+        returnComPtr(outBlob, blob);
+        return SLANG_OK;
+    }
+    auto blob = OwnedBlob::create(size);
     std::memcpy((void*)blob->getBufferPointer(), bufferImpl->m_data + offset, size);
     returnComPtr(outBlob, blob);
     return SLANG_OK;
@@ -7,7 +7,26 @@ namespace rhi::cpu {
 class BufferImpl : public Buffer
 {
 public:
+    /// How the buffer memory was allocated.
+    enum class Storage
+    {
+        /// Aligned heap allocation.
+        Heap,
+        /// Pages allocated directly from virtual memory.
+        VirtualMemory,
+        /// Memory mapped file, or shared memory of another buffer.
+        MappedFile,
+        /// Shared memory owned by the buffer (`m_sharedHandle`), for buffers created with `isShared`.
+        SharedMemory,
+        /// Host memory owned by the application.
+        External,
+    };
+
     uint8_t* m_data = nullptr;
+    Storage m_storage = Storage::Heap;
+    /// Called to release `External` memory.
+    HostMemoryReleaseFunc m_releaseFunc = nullptr;
+    void* m_releaseUserData = nullptr;
 
     BufferImpl(const BufferDesc& desc)
         : Buffer(desc)
@@ -17,6 +36,9 @@ public:
     ~BufferImpl();
 
     virtual SLANG_NO_THROW DeviceAddress SLANG_MCALL getDeviceAddress() override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(NativeHandle* outHandle) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL getSharedHandle(NativeHandle* outHandle) override;
 };
 
 } // namespace rhi::cpu
@@ -1,6 +1,8 @@
 #include "cpu-command.h"
+#include "cpu-copy.h"
 #include "cpu-query.h"
 #include "cpu-shader-program.h"
+#include "cpu-texture.h"
 #include "../command-list.h"
 #include "../strings.h"
 
@@ -56,6 +58,11 @@ public:
     void cmdPushDebugGroup(const commands::PushDebugGroup& cmd);
     void cmdPopDebugGroup(const commands::PopDebugGroup& cmd);
     void cmdInsertDebugMarker(const commands::InsertDebugMarker& cmd);
+
+    /// Host callable function of the current compute pipeline's entry point (null on failure).
+    slang_prelude::ComputeFunc getComputeFunc();
+    /// Run a grid of work groups, split across the device's worker threads.
+    void dispatchGroups(slang_prelude::ComputeFunc func, const uint32_t groupCount[3]);
     void cmdWriteTimestamp(const commands::WriteTimestamp& cmd);
     void cmdExecuteCallback(const commands::ExecuteCallback& cmd);
 };
@@ -95,16 +102,103 @@ void CommandExecutor::cmdCopyBuffer(const commands::CopyBuffer& cmd)
     std::memcpy(dst->m_data + cmd.dstOffset, src->m_data + cmd.srcOffset, cmd.size);
 }
 
+/// Resolve `kRemainingTextureSize` extents to the remaining size of the mip level past `offset`.
+static Extents resolveExtent(const TextureImpl::MipLevel& level, const Offset3D& offset, Extents extent)
+{
+    if (extent.width == kRemainingTextureSize)
+        extent.width = level.extents[0] - offset.x;
+    if (extent.height == kRemainingTextureSize)
+        extent.height = level.extents[1] - offset.y;
+    if (extent.depth == kRemainingTextureSize)
+        extent.depth = level.extents[2] - offset.z;
+    return extent;
+}
+
 void CommandExecutor::cmdCopyTexture(const commands::CopyTexture& cmd)
 {
-    SLANG_UNUSED(cmd);
-    NOT_SUPPORTED(copyTexture);
+    TextureImpl* dst = checked_cast<TextureImpl*>(cmd.dst);
+    TextureImpl* src = checked_cast<TextureImpl*>(cmd.src);
+    SubresourceRange dstSubresource = cmd.dstSubresource;
+    SubresourceRange srcSubresource = cmd.srcSubresource;
+    Offset3D dstOffset = cmd.dstOffset;
+    Offset3D srcOffset = cmd.srcOffset;
+    Extents extent = cmd.extent;
+
+    // Empty subresource ranges on both sides copy the entire resource.
+    bool entireResource = dstSubresource.layerCount == 0 && dstSubresource.mipLevelCount == 0 &&
+                          srcSubresource.layerCount == 0 && srcSubresource.mipLevelCount == 0;
+    if (entireResource)
+    {
+        dstSubresource = dst->resolveSubresourceRange(kEntireTexture);
+        srcSubresource = src->resolveSubresourceRange(kEntireTexture);
+        dstOffset = Offset3D();
+        srcOffset = Offset3D();
+    }
+
+    GfxCount mipLevelCount = max(min(dstSubresource.mipLevelCount, srcSubresource.mipLevelCount), 1);
+    GfxCount layerCount = max(min(dstSubresource.layerCount, srcSubresource.layerCount), 1);
+    ThreadPool* threadPool = m_device->getThreadPool();
+    for (GfxIndex layer = 0; layer < layerCount; layer++)
+    {
+        for (GfxIndex mip = 0; mip < mipLevelCount; mip++)
+        {
+            GfxIndex dstMipLevel = dstSubresource.mipLevel + mip;
+            GfxIndex srcMipLevel = srcSubresource.mipLevel + mip;
+            const auto& srcLevel = src->m_mipLevels[srcMipLevel];
+            Extents copyExtent = entireResource
+                                     ? Extents{srcLevel.extents[0], srcLevel.extents[1], srcLevel.extents[2]}
+                                     : resolveExtent(srcLevel, srcOffset, extent);
+            GfxIndex dstLayer = dstSubresource.baseArrayLayer + layer;
+            GfxIndex srcLayer = srcSubresource.baseArrayLayer + layer;
+            if (!dst->isTiled())
+            {
+                RowLayout dstLayout = dst->getRowLayout(dstMipLevel, dstLayer, dstOffset);
+                src->readTexels(threadPool, srcMipLevel, srcLayer, srcOffset, copyExtent, dstLayout);
+            }
+            else if (!src->isTiled())
+            {
+                RowLayout srcLayout = src->getRowLayout(srcMipLevel, srcLayer, srcOffset);
+                dst->writeTexels(threadPool, dstMipLevel, dstLayer, dstOffset, copyExtent, srcLayout);
+            }
+            else
+            {
+                // Both textures are tiled, go through linear staging memory.
+                Size rowSize = Size(copyExtent.width) * src->m_texelSize;
+                std::vector<uint8_t> staging(rowSize * copyExtent.height * copyExtent.depth);
+                RowLayout stagingLayout = {staging.data(), int64_t(rowSize), int64_t(rowSize * copyExtent.height)};
+                src->readTexels(threadPool, srcMipLevel, srcLayer, srcOffset, copyExtent, stagingLayout);
+                dst->writeTexels(threadPool, dstMipLevel, dstLayer, dstOffset, copyExtent, stagingLayout);
+            }
+        }
+    }
 }
 
 void CommandExecutor::cmdCopyTextureToBuffer(const commands::CopyTextureToBuffer& cmd)
 {
-    SLANG_UNUSED(cmd);
-    NOT_SUPPORTED(copyTextureToBuffer);
+    BufferImpl* dst = checked_cast<BufferImpl*>(cmd.dst);
+    TextureImpl* src = checked_cast<TextureImpl*>(cmd.src);
+    const auto& level = src->m_mipLevels[cmd.srcSubresource.mipLevel];
+    Extents extent = resolveExtent(level, cmd.srcOffset, cmd.extent);
+
+    // Layers are stored one after another, each as `depth` slices of `height` rows.
+    RowLayout dstLayout;
+    dstLayout.data = dst->m_data + cmd.dstOffset;
+    dstLayout.rowStride = int64_t(cmd.dstRowStride);
+    dstLayout.sliceStride = int64_t(cmd.dstRowStride) * extent.height;
+    GfxCount layerCount = max(cmd.srcSubresource.layerCount, 1);
+    ThreadPool* threadPool = m_device->getThreadPool();
+    for (GfxIndex layer = 0; layer < layerCount; layer++)
+    {
+        src->readTexels(
+            threadPool,
+            cmd.srcSubresource.mipLevel,
+            cmd.srcSubresource.baseArrayLayer + layer,
+            cmd.srcOffset,
+            extent,
+            dstLayout
+        );
+        dstLayout.data += dstLayout.sliceStride * extent.depth;
+    }
 }
 
 void CommandExecutor::cmdClearBuffer(const commands::ClearBuffer& cmd)
@@ -115,14 +209,56 @@ void CommandExecutor::cmdClearBuffer(const commands::ClearBuffer& cmd)
 
 void CommandExecutor::cmdClearTexture(const commands::ClearTexture& cmd)
 {
-    SLANG_UNUSED(cmd);
-    NOT_SUPPORTED(clearTexture);
+    TextureImpl* texture = checked_cast<TextureImpl*>(cmd.texture);
+
+    // Pack the clear value into a single texel. Integer formats read the `uintValues` of the color union.
+    uint8_t texel[16] = {};
+    if (isDepthFormat(texture->getFormat()))
+    {
+        if (!cmd.clearDepth)
+            return;
+        texture->m_formatInfo->packFunc(&cmd.clearValue.depthStencil.depth, texel);
+    }
+    else
+    {
+        texture->m_formatInfo->packFunc(cmd.clearValue.color.floatValues, texel);
+    }
+
+    const SubresourceRange& range = cmd.subresourceRange;
+    for (GfxIndex layer = 0; layer < range.layerCount; layer++)
+    {
+        for (GfxIndex mip = 0; mip < range.mipLevelCount; mip++)
+        {
+            texture->fillTexels(range.mipLevel + mip, range.baseArrayLayer + layer, texel);
+        }
+    }
 }
 
 void CommandExecutor::cmdUploadTextureData(const commands::UploadTextureData& cmd)
 {
-    SLANG_UNUSED(cmd);
-    NOT_SUPPORTED(uploadTextureData);
+    TextureImpl* dst = checked_cast<TextureImpl*>(cmd.dst);
+    const SubresourceRange& range = cmd.subresourceRange;
+    ThreadPool* threadPool = m_device->getThreadPool();
+
+    // Subresource data is ordered by array layer, then by mip level.
+    GfxIndex subresourceIndex = 0;
+    for (GfxIndex layer = 0; layer < range.layerCount; layer++)
+    {
+        for (GfxIndex mip = 0; mip < range.mipLevelCount; mip++)
+        {
+            if (subresourceIndex >= cmd.subresourceDataCount)
+                return;
+            const SubresourceData& data = cmd.subresourceData[subresourceIndex++];
+            GfxIndex mipLevel = range.mipLevel + mip;
+            Extents extent = resolveExtent(dst->m_mipLevels[mipLevel], cmd.offset, cmd.extent);
+
+            RowLayout srcLayout;
+            srcLayout.data = (uint8_t*)data.data;
+            srcLayout.rowStride = int64_t(data.strideY);
+            srcLayout.sliceStride = int64_t(data.strideZ);
+            dst->writeTexels(threadPool, mipLevel, range.baseArrayLayer + layer, cmd.offset, extent, srcLayout);
+        }
+    }
 }
 
 void CommandExecutor::cmdUploadBufferData(const commands::UploadBufferData& cmd)
@@ -208,13 +344,59 @@ void CommandExecutor::cmdDispatchCompute(const commands::DispatchCompute& cmd)
     if (!m_computeStateValid)
         return;
 
+    auto func = getComputeFunc();
+    if (!func)
+        return;
+
+    uint32_t groupCount[3] = {uint32_t(cmd.x), uint32_t(cmd.y), uint32_t(cmd.z)};
+    dispatchGroups(func, groupCount);
+}
+
+void CommandExecutor::cmdDispatchComputeIndirect(const commands::DispatchComputeIndirect& cmd)
+{
+    if (!m_computeStateValid)
+        return;
+
+    // The arguments are read at execution time, so earlier dispatches in the same command buffer can write them.
+    BufferImpl* argBuffer = checked_cast<BufferImpl*>(cmd.argBuffer);
+    uint64_t dispatchCount = cmd.maxDispatchCount;
+    if (cmd.countBuffer)
+    {
+        BufferImpl* countBuffer = checked_cast<BufferImpl*>(cmd.countBuffer);
+        if (cmd.countOffset + sizeof(uint32_t) > countBuffer->m_desc.size)
+            return;
+        uint32_t count;
+        std::memcpy(&count, countBuffer->m_data + cmd.countOffset, sizeof(count));
+        dispatchCount = min(dispatchCount, uint64_t(count));
+    }
+    // Only dispatches with arguments inside the buffer are run.
+    const Size argSize = 3 * sizeof(uint32_t);
+    if (cmd.offset >= argBuffer->m_desc.size)
+        return;
+    dispatchCount = min(dispatchCount, uint64_t((argBuffer->m_desc.size - cmd.offset) / argSize));
+    if (dispatchCount == 0)
+        return;
+
+    auto func = getComputeFunc();
+    if (!func)
+        return;
+
+    for (uint64_t i = 0; i < dispatchCount; i++)
+    {
+        uint32_t groupCount[3];
+        std::memcpy(groupCount, argBuffer->m_data + cmd.offset + i * argSize, argSize);
+        dispatchGroups(func, groupCount);
+    }
+}
+
+slang_prelude::ComputeFunc CommandExecutor::getComputeFunc()
+{
     int entryPointIndex = 0;
     int targetIndex = 0;
 
     auto program = m_currentComputePipeline->m_program.get();
     auto entryPointLayout = m_currentRootObject->getLayout()->getEntryPoint(entryPointIndex);
     auto entryPointName = entryPointLayout->getEntryPointName();
-    auto entryPointObject = m_currentRootObject->getEntryPoint(entryPointIndex);
 
     ComPtr<ISlangSharedLibrary> sharedLibrary;
     ComPtr<ISlangBlob> diagnostics;
@@ -230,27 +412,48 @@ void CommandExecutor::cmdDispatchCompute(const commands::DispatchCompute& cmd)
         );
     }
     if (SLANG_FAILED(compileResult))
-        return;
+        return nullptr;
 
-    auto func = (slang_prelude::ComputeFunc)sharedLibrary->findSymbolAddressByName(entryPointName);
+    return (slang_prelude::ComputeFunc)sharedLibrary->findSymbolAddressByName(entryPointName);
+}
 
-    slang_prelude::ComputeVaryingInput varyingInput;
-    varyingInput.startGroupID.x = 0;
-    varyingInput.startGroupID.y = 0;
-    varyingInput.startGroupID.z = 0;
-    varyingInput.endGroupID.x = cmd.x;
-    varyingInput.endGroupID.y = cmd.y;
-    varyingInput.endGroupID.z = cmd.z;
+void CommandExecutor::dispatchGroups(slang_prelude::ComputeFunc func, const uint32_t groupCount[3])
+{
+    if (groupCount[0] == 0 || groupCount[1] == 0 || groupCount[2] == 0)
+        return;
 
     auto globalParamsData = m_currentRootObject->getDataBuffer();
-    auto entryPointParamsData = entryPointObject->getDataBuffer();
-    func(&varyingInput, entryPointParamsData, globalParamsData);
-}
+    auto entryPointParamsData = m_currentRootObject->getEntryPoint(0)->getDataBuffer();
 
-void CommandExecutor::cmdDispatchComputeIndirect(const commands::DispatchComputeIndirect& cmd)
-{
-    SLANG_UNUSED(cmd);
-    NOT_SUPPORTED(dispatchComputeIndirect);
+    // Work groups are independent, split the longest axis of the grid into ranges run in parallel.
+    int axis = 0;
+    for (int i = 1; i < 3; i++)
+    {
+        if (groupCount[i] > groupCount[axis])
+            axis = i;
+    }
+    // Without a thread pool, the groups run serially on the calling thread.
+    ThreadPool* threadPool = m_device->m_extendedDesc.parallelDispatch ? m_device->getThreadPool() : nullptr;
+    parallelFor(
+        threadPool,
+        groupCount[axis],
+        [&](uint64_t begin, uint64_t end)
+        {
+            uint32_t startGroupID[3] = {0, 0, 0};
+            uint32_t endGroupID[3] = {groupCount[0], groupCount[1], groupCount[2]};
+            startGroupID[axis] = uint32_t(begin);
+            endGroupID[axis] = uint32_t(end);
+
+            slang_prelude::ComputeVaryingInput varyingInput;
+            varyingInput.startGroupID.x = startGroupID[0];
+            varyingInput.startGroupID.y = startGroupID[1];
+            varyingInput.startGroupID.z = startGroupID[2];
+            varyingInput.endGroupID.x = endGroupID[0];
+            varyingInput.endGroupID.y = endGroupID[1];
+            varyingInput.endGroupID.z = endGroupID[2];
+            func(&varyingInput, entryPointParamsData, globalParamsData);
+        }
+    );
 }
 
 void CommandExecutor::cmdBeginRayTracingPass(const commands::BeginRayTracingPass& cmd)
@@ -401,9 +604,21 @@ Result CommandEncoderImpl::init()
     m_commandBuffer = new CommandBufferImpl();
     m_commandBuffer->m_commandList = new CommandList();
     m_commandList = m_commandBuffer->m_commandList;
+    m_profiler = m_device->m_profiler.get();
     return SLANG_OK;
 }
 
+Result CommandEncoderImpl::createTransientBuffer(const BufferDesc& desc, IBuffer** outBuffer)
+{
+    // Transient resources are not pooled on this backend.
+    return m_device->createBuffer(desc, nullptr, outBuffer);
+}
+
+Result CommandEncoderImpl::createTransientTexture(const TextureDesc& desc, ITexture** outTexture)
+{
+    return m_device->createTexture(desc, nullptr, outTexture);
+}
+
 Result CommandEncoderImpl::finish(ICommandBuffer** outCommandBuffer)
 {
     SLANG_RETURN_ON_FAIL(resolvePipelines(m_device));
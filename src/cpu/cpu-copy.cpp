@@ -0,0 +1,166 @@
+#include "cpu-copy.h"
+#include "cpu-simd.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+namespace rhi::cpu {
+
+// Fills larger than this use non-temporal stores.
+static const Size kStreamingFillThreshold = 1024 * 1024;
+
+void parallelFor(ThreadPool* threadPool, uint64_t count, const std::function<void(uint64_t begin, uint64_t end)>& func)
+{
+    uint64_t partCount = threadPool ? std::min(uint64_t(threadPool->getThreadCount()) + 1, count) : 1;
+    if (partCount <= 1)
+    {
+        func(0, count);
+        return;
+    }
+
+    // Part 0 runs on the calling thread.
+    auto runPart = [&](uint64_t part) { func(count * part / partCount, count * (part + 1) / partCount); };
+    std::vector<std::shared_ptr<ThreadPool::Task>> tasks;
+    for (uint64_t part = 1; part < partCount; part++)
+        tasks.push_back(threadPool->submit([&runPart, part]() { runPart(part); }));
+    runPart(0);
+    for (auto& task : tasks)
+        threadPool->wait(task.get());
+}
+
+void copyRows(
+    ThreadPool* threadPool,
+    const RowLayout& dst,
+    const RowLayout& src,
+    Size rowSize,
+    uint32_t rowCount,
+    uint32_t sliceCount
+)
+{
+    if (rowSize == 0 || rowCount == 0 || sliceCount == 0)
+        return;
+
+    // Merge rows that are contiguous in both layouts, so they are copied with a single (vectorized) memcpy.
+    bool contiguousRows = dst.rowStride == int64_t(rowSize) && src.rowStride == int64_t(rowSize);
+    if (contiguousRows)
+    {
+        rowSize *= rowCount;
+        rowCount = 1;
+        if (dst.sliceStride == int64_t(rowSize) && src.sliceStride == int64_t(rowSize))
+        {
+            rowSize *= sliceCount;
+            sliceCount = 1;
+        }
+    }
+
+    Size totalSize = rowSize * rowCount * sliceCount;
+    uint64_t totalRowCount = uint64_t(rowCount) * sliceCount;
+    if (totalSize < kParallelCopyThreshold)
+        threadPool = nullptr;
+    if (totalRowCount == 1)
+    {
+        // A single block, split into cache lines.
+        uint64_t lineCount = (totalSize + 63) / 64;
+        parallelFor(
+            threadPool,
+            lineCount,
+            [&](uint64_t begin, uint64_t end)
+            {
+                Size offset = begin * 64;
+                std::memcpy(dst.data + offset, src.data + offset, std::min(end * 64, uint64_t(totalSize)) - offset);
+            }
+        );
+        return;
+    }
+
+    parallelFor(
+        threadPool,
+        totalRowCount,
+        [&](uint64_t begin, uint64_t end)
+        {
+            for (uint64_t i = begin; i < end; i++)
+            {
+                int64_t slice = int64_t(i / rowCount);
+                int64_t row = int64_t(i % rowCount);
+                std::memcpy(
+                    dst.data + slice * dst.sliceStride + row * dst.rowStride,
+                    src.data + slice * src.sliceStride + row * src.rowStride,
+                    rowSize
+                );
+            }
+        }
+    );
+}
+
+void fillRows(
+    const RowLayout& dst,
+    Size rowSize,
+    uint32_t rowCount,
+    uint32_t sliceCount,
+    const void* texel,
+    Size texelSize
+)
+{
+    if (rowSize == 0 || rowCount == 0 || sliceCount == 0 || texelSize == 0)
+        return;
+
+    // The texel pattern repeats every `patternSize` bytes, which is a multiple of 16 bytes.
+    // The pattern is stored twice, so any 16 byte window starting in the first copy can be loaded.
+    Size patternSize = std::lcm(texelSize, Size(16));
+    std::vector<uint8_t> pattern(patternSize * 2);
+    for (Size offset = 0; offset < pattern.size(); offset += texelSize)
+        std::memcpy(pattern.data() + offset, texel, texelSize);
+
+#if SLANG_RHI_CPU_SSE2
+    uint32_t vectorCount = uint32_t(patternSize / 16);
+    if (rowSize * rowCount * sliceCount >= kStreamingFillThreshold && vectorCount <= 16)
+    {
+        __m128i vectors[16];
+        for (uint32_t slice = 0; slice < sliceCount; slice++)
+        {
+            for (uint32_t row = 0; row < rowCount; row++)
+            {
+                uint8_t* rowData = dst.data + slice * dst.sliceStride + row * dst.rowStride;
+                // Unaligned head, streamed 16 byte aligned body and unaligned tail.
+                Size head = std::min(Size((16 - (uintptr_t(rowData) & 15)) & 15), rowSize);
+                Size bodyCount = (rowSize - head) / 16;
+                Size tail = rowSize - head - bodyCount * 16;
+                std::memcpy(rowData, pattern.data(), head);
+                for (uint32_t i = 0; i < vectorCount; i++)
+                    vectors[i] = _mm_loadu_si128((const __m128i*)(pattern.data() + (head + i * 16) % patternSize));
+                __m128i* body = (__m128i*)(rowData + head);
+                uint32_t vectorIndex = 0;
+                for (Size i = 0; i < bodyCount; i++)
+                {
+                    _mm_stream_si128(body + i, vectors[vectorIndex]);
+                    vectorIndex = vectorIndex + 1 == vectorCount ? 0 : vectorIndex + 1;
+                }
+                std::memcpy(rowData + rowSize - tail, pattern.data() + (rowSize - tail) % patternSize, tail);
+            }
+        }
+        _mm_sfence();
+        return;
+    }
+#endif
+
+    // Fill the first row by doubling the filled part, then copy it to the other rows.
+    uint8_t* firstRow = dst.data;
+    Size filled = std::min(patternSize, rowSize);
+    std::memcpy(firstRow, pattern.data(), filled);
+    while (filled < rowSize)
+    {
+        Size size = std::min(filled, rowSize - filled);
+        std::memcpy(firstRow + filled, firstRow, size);
+        filled += size;
+    }
+    for (uint32_t slice = 0; slice < sliceCount; slice++)
+    {
+        for (uint32_t row = slice == 0 ? 1 : 0; row < rowCount; row++)
+            std::memcpy(dst.data + slice * dst.sliceStride + row * dst.rowStride, firstRow, rowSize);
+    }
+}
+
+} // namespace rhi::cpu
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "cpu-base.h"
+
+#include "core/thread-pool.h"
+
+#include <functional>
+
+namespace rhi::cpu {
+
+/// Layout of a 3D block of rows in memory (a texture subresource region or a buffer range).
+struct RowLayout
+{
+    uint8_t* data;
+    int64_t rowStride;
+    int64_t sliceStride;
+};
+
+/// Copies touching less data than this are not worth distributing across threads.
+static const Size kParallelCopyThreshold = 4 * 1024 * 1024;
+
+/// Run `func(begin, end)` over `count` items, split into ranges across the threads of `threadPool` (if not null).
+/// The calling thread runs the first range.
+void parallelFor(ThreadPool* threadPool, uint64_t count, const std::function<void(uint64_t begin, uint64_t end)>& func);
+
+/// Copy `sliceCount` slices of `rowCount` rows of `rowSize` bytes.
+/// Rows that are contiguous in both layouts are merged into single copies, large copies are split across the
+/// threads of `threadPool` (if not null).
+void copyRows(
+    ThreadPool* threadPool,
+    const RowLayout& dst,
+    const RowLayout& src,
+    Size rowSize,
+    uint32_t rowCount,
+    uint32_t sliceCount
+);
+
+/// Fill `sliceCount` slices of `rowCount` rows of `rowSize` bytes with a repeated texel value.
+/// Large fills use non-temporal stores, so the cleared memory does not evict the caches.
+void fillRows(
+    const RowLayout& dst,
+    Size rowSize,
+    uint32_t rowCount,
+    uint32_t sliceCount,
+    const void* texel,
+    Size texelSize
+);
+
+} // namespace rhi::cpu
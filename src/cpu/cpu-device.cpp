@@ -1,15 +1,32 @@
 #include "cpu-device.h"
 #include "cpu-pipeline.h"
 #include "cpu-query.h"
+#include "cpu-sampler.h"
 #include "cpu-shader-object.h"
 #include "cpu-shader-program.h"
+#include "cpu-texture.h"
 
 #include <chrono>
+#include <thread>
 
 namespace rhi::cpu {
 
 DeviceImpl::~DeviceImpl() {}
 
+ThreadPool* DeviceImpl::getThreadPool()
+{
+    std::lock_guard<std::mutex> lock(m_threadPoolMutex);
+    if (!m_threadPoolCreated)
+    {
+        // The submitting thread takes part in the work as well.
+        uint32_t threadCount = std::thread::hardware_concurrency();
+        if (threadCount > 1)
+            m_threadPool = std::make_unique<ThreadPool>(threadCount - 1);
+        m_threadPoolCreated = true;
+    }
+    return m_threadPool.get();
+}
+
 Result DeviceImpl::initialize(const DeviceDesc& desc)
 {
     SLANG_RETURN_ON_FAIL(slangContext.initialize(
@@ -23,6 +40,26 @@ Result DeviceImpl::initialize(const DeviceDesc& desc)
 
     SLANG_RETURN_ON_FAIL(Device::initialize(desc));
 
+    // Read properties from extended device descriptions
+    for (Index i = 0; i < desc.extendedDescCount; i++)
+    {
+        StructType stype;
+        memcpy(&stype, desc.extendedDescs[i], sizeof(stype));
+        switch (stype)
+        {
+        case StructType::CPUDeviceExtendedDesc:
+            m_extendedDesc = *static_cast<CPUDeviceExtendedDesc*>(desc.extendedDescs[i]);
+            break;
+        default:
+            break;
+        }
+    }
+    Size alignment = m_extendedDesc.bufferAlignment;
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
     // Initialize DeviceInfo
     {
         m_info.deviceType = DeviceType::CPU;
@@ -38,6 +75,11 @@ Result DeviceImpl::initialize(const DeviceDesc& desc)
         m_features.push_back("has-ptr");
     }
 
+    // Indirect dispatches read their count when they execute.
+    {
+        m_features.push_back("dispatch-indirect-count");
+    }
+
     m_queue = new CommandQueueImpl(this, QueueType::Graphics);
 
     return SLANG_OK;
@@ -103,6 +145,30 @@ Result DeviceImpl::createShaderProgram(
     return SLANG_OK;
 }
 
+Result DeviceImpl::getFormatSupport(Format format, FormatSupport* outFormatSupport)
+{
+    FormatSupport support = FormatSupport::Buffer | FormatSupport::IndexBuffer | FormatSupport::VertexBuffer;
+
+    // Textures can only be created with formats that have texel pack and unpack functions.
+    if (_getFormatInfo(format))
+    {
+        support |= FormatSupport::Texture;
+        support |= FormatSupport::ShaderLoad;
+        support |= FormatSupport::ShaderSample;
+        support |= FormatSupport::ShaderUavLoad;
+        support |= FormatSupport::ShaderUavStore;
+    }
+    *outFormatSupport = support;
+    return SLANG_OK;
+}
+
+Result DeviceImpl::getTextureRowAlignment(Size* outAlignment)
+{
+    // Texture copies take any row stride.
+    *outAlignment = 1;
+    return SLANG_OK;
+}
+
 const DeviceInfo& DeviceImpl::getDeviceInfo() const
 {
     return m_info;
@@ -110,17 +176,15 @@ const DeviceInfo& DeviceImpl::getDeviceInfo() const
 
 Result DeviceImpl::createSampler(SamplerDesc const& desc, ISampler** outSampler)
 {
-    SLANG_UNUSED(desc);
-    *outSampler = nullptr;
+    RefPtr<SamplerImpl> sampler = new SamplerImpl(desc);
+    returnComPtr(outSampler, sampler);
     return SLANG_OK;
 }
 
 Result DeviceImpl::getQueue(QueueType type, ICommandQueue** outQueue)
 {
-    if (type != QueueType::Graphics)
-    {
-        return SLANG_FAIL;
-    }
+    // There is only a single queue, compute and transfer work is submitted to it as well.
+    SLANG_UNUSED(type);
     m_queue->establishStrongReferenceToDevice();
     returnComPtr(outQueue, m_queue);
     return SLANG_OK;
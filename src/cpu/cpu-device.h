@@ -5,6 +5,11 @@
 #include "cpu-pipeline.h"
 #include "cpu-shader-object.h"
 
+#include "core/thread-pool.h"
+
+#include <memory>
+#include <mutex>
+
 namespace rhi::cpu {
 
 class DeviceImpl : public Device
@@ -20,6 +25,20 @@ public:
     virtual SLANG_NO_THROW Result SLANG_MCALL
     createBuffer(const BufferDesc& descIn, const void* initData, IBuffer** outBuffer) override;
 
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    createBufferFromNativeHandle(NativeHandle handle, const BufferDesc& srcDesc, IBuffer** outBuffer) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    createBufferFromSharedHandle(NativeHandle handle, const BufferDesc& srcDesc, IBuffer** outBuffer) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL createBufferFromHostMemory(
+        void* data,
+        const BufferDesc& desc,
+        HostMemoryReleaseFunc releaseFunc,
+        void* userData,
+        IBuffer** outBuffer
+    ) override;
+
     virtual SLANG_NO_THROW Result SLANG_MCALL mapBuffer(IBuffer* buffer, CpuAccessMode mode, void** outData) override;
 
     virtual SLANG_NO_THROW Result SLANG_MCALL unmapBuffer(IBuffer* buffer) override;
@@ -48,6 +67,10 @@ public:
 
     virtual SLANG_NO_THROW Result SLANG_MCALL createQueryPool(const QueryPoolDesc& desc, IQueryPool** outPool) override;
 
+    virtual SLANG_NO_THROW Result SLANG_MCALL getFormatSupport(Format format, FormatSupport* outFormatSupport) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL getTextureRowAlignment(Size* outAlignment) override;
+
     virtual SLANG_NO_THROW const DeviceInfo& SLANG_MCALL getDeviceInfo() const override;
 
     virtual SLANG_NO_THROW Result SLANG_MCALL createSampler(SamplerDesc const& desc, ISampler** outSampler) override;
@@ -60,9 +83,20 @@ public:
     virtual SLANG_NO_THROW Result SLANG_MCALL
     readBuffer(IBuffer* buffer, Offset offset, Size size, ISlangBlob** outBlob) override;
 
+    /// Worker threads splitting dispatches and large texture copies (created on first use, null on single core
+    /// machines).
+    ThreadPool* getThreadPool();
+
+    /// Texture layout and buffer allocation options.
+    CPUDeviceExtendedDesc m_extendedDesc;
+
 private:
     DeviceInfo m_info;
 
+    std::mutex m_threadPoolMutex;
+    std::unique_ptr<ThreadPool> m_threadPool;
+    bool m_threadPoolCreated = false;
+
     RefPtr<CommandQueueImpl> m_queue;
 };
 
@@ -0,0 +1,275 @@
+#include "cpu-sampler.h"
+#include "cpu-simd.h"
+#include "cpu-texture.h"
+
+#include <cmath>
+
+namespace rhi::cpu {
+
+SamplerImpl::SamplerImpl(const SamplerDesc& desc)
+    : Sampler(desc)
+{
+}
+
+const SamplerDesc& SamplerImpl::getDesc(slang_prelude::SamplerState samplerState)
+{
+    if (samplerState.state)
+        return reinterpret_cast<SamplerImpl*>(samplerState.state)->m_desc;
+
+    // Nearest neighbor sampling clamped to the edge, like before samplers were supported. Texels are selected like
+    // on GPUs (floor(coord * extent)) rather than with the previous round(coord * (extent - 1)).
+    static const SamplerDesc kDefaultDesc = []()
+    {
+        SamplerDesc desc;
+        desc.minFilter = TextureFilteringMode::Point;
+        desc.magFilter = TextureFilteringMode::Point;
+        desc.mipFilter = TextureFilteringMode::Point;
+        desc.addressU = TextureAddressingMode::ClampToEdge;
+        desc.addressV = TextureAddressingMode::ClampToEdge;
+        desc.addressW = TextureAddressingMode::ClampToEdge;
+        return desc;
+    }();
+    return kDefaultDesc;
+}
+
+// Texel loaders, converting a texel of a given format to 4 floats.
+
+template<int N>
+struct LoadFloatTexel
+{
+    static Vec4 load(const uint8_t* texel, const CPUTextureSampleParams& params)
+    {
+        SLANG_UNUSED(params);
+        const float* input = (const float*)texel;
+        if constexpr (N == 4)
+            return Vec4::load(input);
+        else if constexpr (N == 3)
+            return Vec4::set(input[0], input[1], input[2], 1.0f);
+        else if constexpr (N == 2)
+            return Vec4::set(input[0], input[1], 0.0f, 1.0f);
+        else
+            return Vec4::set(input[0], 0.0f, 0.0f, 1.0f);
+    }
+};
+
+template<int N>
+struct LoadFloat16Texel
+{
+    static Vec4 load(const uint8_t* texel, const CPUTextureSampleParams& params)
+    {
+        SLANG_UNUSED(params);
+        // Missing channels are (0, 0, 0, 1) as half floats.
+        uint16_t input[4] = {0, 0, 0, 0x3c00};
+        std::memcpy(input, texel, N * sizeof(uint16_t));
+#if SLANG_RHI_CPU_F16C
+        return {_mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)input))};
+#else
+        return Vec4::set(
+            math::halfToFloat(input[0]),
+            math::halfToFloat(input[1]),
+            math::halfToFloat(input[2]),
+            math::halfToFloat(input[3])
+        );
+#endif
+    }
+};
+
+template<bool BGRA>
+struct LoadUnorm8x4Texel
+{
+    static Vec4 load(const uint8_t* texel, const CPUTextureSampleParams& params)
+    {
+        SLANG_UNUSED(params);
+#if SLANG_RHI_CPU_SSE2
+        int32_t packed;
+        std::memcpy(&packed, texel, sizeof(packed));
+        __m128i zero = _mm_setzero_si128();
+        __m128i bytes = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+        __m128 value = _mm_mul_ps(_mm_cvtepi32_ps(bytes), _mm_set1_ps(1.0f / 255.0f));
+        if constexpr (BGRA)
+            value = _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 0, 1, 2));
+        return {value};
+#else
+        const float scale = 1.0f / 255.0f;
+        if constexpr (BGRA)
+            return Vec4::set(texel[2] * scale, texel[1] * scale, texel[0] * scale, texel[3] * scale);
+        else
+            return Vec4::set(texel[0] * scale, texel[1] * scale, texel[2] * scale, texel[3] * scale);
+#endif
+    }
+};
+
+/// Returns the wrapped texel index, or -1 if the index addresses the border.
+static inline int32_t applyAddressingMode(int32_t index, int32_t extent, TextureAddressingMode mode)
+{
+    switch (mode)
+    {
+    case TextureAddressingMode::Wrap:
+        index %= extent;
+        return index < 0 ? index + extent : index;
+    case TextureAddressingMode::ClampToEdge:
+        return index < 0 ? 0 : (index >= extent ? extent - 1 : index);
+    case TextureAddressingMode::ClampToBorder:
+        return (index < 0 || index >= extent) ? -1 : index;
+    case TextureAddressingMode::MirrorRepeat:
+    {
+        int32_t period = extent * 2;
+        index %= period;
+        if (index < 0)
+            index += period;
+        return index < extent ? index : period - 1 - index;
+    }
+    case TextureAddressingMode::MirrorOnce:
+        if (index < 0)
+            index = -1 - index;
+        return index >= extent ? extent - 1 : index;
+    }
+    return 0;
+}
+
+static inline TextureAddressingMode getAddressingMode(const SamplerDesc& sampler, int32_t axis)
+{
+    return axis == 0 ? sampler.addressU : (axis == 1 ? sampler.addressV : sampler.addressW);
+}
+
+template<typename Loader>
+static void sampleTexels(const SamplerDesc& sampler, const CPUTextureSampleParams& params, float* outValue)
+{
+    const int32_t rank = params.rank;
+    const Vec4 borderColor = Vec4::load(sampler.borderColor);
+
+    if (params.filter == TextureFilteringMode::Point)
+    {
+        int64_t offset = 0;
+        for (int32_t axis = 0; axis < rank; ++axis)
+        {
+            int32_t extent = params.level->extents[axis];
+            int32_t index = int32_t(std::floor(params.coords[axis] * extent));
+            index = applyAddressingMode(index, extent, getAddressingMode(sampler, axis));
+            if (index < 0)
+            {
+                borderColor.store(outValue);
+                return;
+            }
+            offset += params.level->getAxisOffset(axis, index);
+        }
+        Loader::load(params.data + offset, params).store(outValue);
+        return;
+    }
+
+    // Linear filtering: the two texels surrounding the sample point along each axis, and the weight of the second one.
+    int64_t offsets[3][2] = {};
+    bool border[3][2] = {};
+    float weights[3] = {};
+    for (int32_t axis = 0; axis < rank; ++axis)
+    {
+        int32_t extent = params.level->extents[axis];
+        float coord = params.coords[axis] * extent - 0.5f;
+        float base = std::floor(coord);
+        weights[axis] = coord - base;
+        TextureAddressingMode mode = getAddressingMode(sampler, axis);
+        for (int32_t i = 0; i < 2; ++i)
+        {
+            int32_t index = applyAddressingMode(int32_t(base) + i, extent, mode);
+            border[axis][i] = index < 0;
+            offsets[axis][i] = index < 0 ? 0 : params.level->getAxisOffset(axis, index);
+        }
+    }
+
+    auto fetch = [&](int32_t x, int32_t y, int32_t z) -> Vec4
+    {
+        if (border[0][x] || border[1][y] || border[2][z])
+            return borderColor;
+        return Loader::load(params.data + offsets[0][x] + offsets[1][y] + offsets[2][z], params);
+    };
+
+    Vec4 result;
+    if (sampler.reductionOp == TextureReductionOp::Minimum || sampler.reductionOp == TextureReductionOp::Maximum)
+    {
+        // Min/max over the texels contributing to the sample.
+        bool isMinimum = sampler.reductionOp == TextureReductionOp::Minimum;
+        bool first = true;
+        int32_t tapCount = 1 << rank;
+        for (int32_t tap = 0; tap < tapCount; ++tap)
+        {
+            int32_t x = tap & 1, y = (tap >> 1) & 1, z = (tap >> 2) & 1;
+            float weight = (x ? weights[0] : 1.0f - weights[0]) * (y ? weights[1] : 1.0f - weights[1]) *
+                           (z ? weights[2] : 1.0f - weights[2]);
+            if (weight <= 0.0f)
+                continue;
+            Vec4 value = fetch(x, y, z);
+            result = first ? value : (isMinimum ? min(result, value) : max(result, value));
+            first = false;
+        }
+    }
+    else
+    {
+        result = lerp(fetch(0, 0, 0), fetch(1, 0, 0), weights[0]);
+        if (rank >= 2)
+        {
+            result = lerp(result, lerp(fetch(0, 1, 0), fetch(1, 1, 0), weights[0]), weights[1]);
+            if (rank >= 3)
+            {
+                Vec4 back = lerp(
+                    lerp(fetch(0, 0, 1), fetch(1, 0, 1), weights[0]),
+                    lerp(fetch(0, 1, 1), fetch(1, 1, 1), weights[0]),
+                    weights[1]
+                );
+                result = lerp(result, back, weights[2]);
+            }
+        }
+    }
+    result.store(outValue);
+}
+
+/// Integer formats cannot be filtered, they always return the nearest texel.
+static void sampleIntegerTexels(const SamplerDesc& sampler, const CPUTextureSampleParams& params, float* outValue)
+{
+    int64_t offset = 0;
+    for (int32_t axis = 0; axis < params.rank; ++axis)
+    {
+        int32_t extent = params.level->extents[axis];
+        int32_t index = int32_t(std::floor(params.coords[axis] * extent));
+        index = applyAddressingMode(index, extent, getAddressingMode(sampler, axis));
+        if (index < 0)
+        {
+            std::memset(outValue, 0, 4 * sizeof(float));
+            return;
+        }
+        offset += params.level->getAxisOffset(axis, index);
+    }
+    params.unpackFunc(params.data + offset, outValue, 4 * sizeof(float));
+}
+
+CPUTextureSampleFunc _getSampleFunc(Format format)
+{
+    switch (format)
+    {
+    case Format::R32G32B32A32_FLOAT:
+        return &sampleTexels<LoadFloatTexel<4>>;
+    case Format::R32G32B32_FLOAT:
+        return &sampleTexels<LoadFloatTexel<3>>;
+    case Format::R32G32_FLOAT:
+        return &sampleTexels<LoadFloatTexel<2>>;
+    case Format::R32_FLOAT:
+    case Format::D32_FLOAT:
+        return &sampleTexels<LoadFloatTexel<1>>;
+    case Format::R16G16B16A16_FLOAT:
+        return &sampleTexels<LoadFloat16Texel<4>>;
+    case Format::R16G16_FLOAT:
+        return &sampleTexels<LoadFloat16Texel<2>>;
+    case Format::R16_FLOAT:
+        return &sampleTexels<LoadFloat16Texel<1>>;
+    case Format::R8G8B8A8_UNORM:
+        return &sampleTexels<LoadUnorm8x4Texel<false>>;
+    case Format::B8G8R8A8_UNORM:
+        return &sampleTexels<LoadUnorm8x4Texel<true>>;
+    case Format::R16_UINT:
+    case Format::R32_UINT:
+        return &sampleIntegerTexels;
+    default:
+        return nullptr;
+    }
+}
+
+} // namespace rhi::cpu
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "cpu-base.h"
+
+namespace rhi::cpu {
+
+class SamplerImpl : public Sampler
+{
+public:
+    SamplerImpl(const SamplerDesc& desc);
+
+    /// Handle passed to shaders in `slang_prelude::SamplerState`.
+    slang_prelude::ISampler* getPreludeSampler() { return reinterpret_cast<slang_prelude::ISampler*>(this); }
+
+    /// Sampler state behind a shader sampler handle, or the default (point, clamp) sampler if none is bound.
+    static const SamplerDesc& getDesc(slang_prelude::SamplerState samplerState);
+};
+
+} // namespace rhi::cpu
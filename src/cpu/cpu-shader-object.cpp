@@ -1,6 +1,7 @@
 #include "cpu-shader-object.h"
 #include "cpu-device.h"
 #include "cpu-buffer.h"
+#include "cpu-sampler.h"
 #include "cpu-texture.h"
 #include "cpu-shader-object-layout.h"
 
@@ -195,6 +196,10 @@ Result ShaderObjectImpl::setBinding(ShaderOffset const& offset, Binding binding)
     }
     case BindingType::Sampler:
     {
+        auto sampler = checked_cast<SamplerImpl*>(binding.resource);
+        m_resources[viewIndex] = sampler;
+        slang_prelude::SamplerState samplerState = {sampler->getPreludeSampler()};
+        SLANG_RETURN_ON_FAIL(setData(offset, &samplerState, sizeof(samplerState)));
         break;
     }
     case BindingType::CombinedTextureSampler:
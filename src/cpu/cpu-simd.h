@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define SLANG_RHI_CPU_SSE2 1
+#include <emmintrin.h>
+#else
+#define SLANG_RHI_CPU_SSE2 0
+#endif
+
+#if SLANG_RHI_CPU_SSE2 && (defined(__F16C__) || defined(__AVX2__))
+#define SLANG_RHI_CPU_F16C 1
+#include <immintrin.h>
+#else
+#define SLANG_RHI_CPU_F16C 0
+#endif
+
+namespace rhi::cpu {
+
+/// Vector of 4 floats, mapped to an SSE register where available.
+struct Vec4
+{
+#if SLANG_RHI_CPU_SSE2
+    __m128 v;
+
+    static Vec4 load(const float* p) { return {_mm_loadu_ps(p)}; }
+    static Vec4 set(float x, float y, float z, float w) { return {_mm_setr_ps(x, y, z, w)}; }
+    static Vec4 splat(float x) { return {_mm_set1_ps(x)}; }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+
+    friend Vec4 operator+(Vec4 a, Vec4 b) { return {_mm_add_ps(a.v, b.v)}; }
+    friend Vec4 operator-(Vec4 a, Vec4 b) { return {_mm_sub_ps(a.v, b.v)}; }
+    friend Vec4 operator*(Vec4 a, Vec4 b) { return {_mm_mul_ps(a.v, b.v)}; }
+    friend Vec4 min(Vec4 a, Vec4 b) { return {_mm_min_ps(a.v, b.v)}; }
+    friend Vec4 max(Vec4 a, Vec4 b) { return {_mm_max_ps(a.v, b.v)}; }
+#else
+    float v[4];
+
+    static Vec4 load(const float* p) { return {{p[0], p[1], p[2], p[3]}}; }
+    static Vec4 set(float x, float y, float z, float w) { return {{x, y, z, w}}; }
+    static Vec4 splat(float x) { return {{x, x, x, x}}; }
+    void store(float* p) const { std::memcpy(p, v, sizeof(v)); }
+
+    friend Vec4 operator+(Vec4 a, Vec4 b)
+    {
+        for (int i = 0; i < 4; i++)
+            a.v[i] = a.v[i] + b.v[i];
+        return a;
+    }
+    friend Vec4 operator-(Vec4 a, Vec4 b)
+    {
+        for (int i = 0; i < 4; i++)
+            a.v[i] = a.v[i] - b.v[i];
+        return a;
+    }
+    friend Vec4 operator*(Vec4 a, Vec4 b)
+    {
+        for (int i = 0; i < 4; i++)
+            a.v[i] = a.v[i] * b.v[i];
+        return a;
+    }
+    friend Vec4 min(Vec4 a, Vec4 b)
+    {
+        for (int i = 0; i < 4; i++)
+            a.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i];
+        return a;
+    }
+    friend Vec4 max(Vec4 a, Vec4 b)
+    {
+        for (int i = 0; i < 4; i++)
+            a.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i];
+        return a;
+    }
+#endif
+
+    /// Linear interpolation from `a` (t = 0) to `b` (t = 1).
+    friend Vec4 lerp(Vec4 a, Vec4 b, float t) { return a + (b - a) * splat(t); }
+};
+
+} // namespace rhi::cpu
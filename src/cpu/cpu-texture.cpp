@@ -1,5 +1,8 @@
 #include "cpu-texture.h"
 #include "cpu-device.h"
+#include "cpu-sampler.h"
+
+#include <cmath>
 
 namespace rhi::cpu {
 
@@ -8,6 +11,29 @@ static CPUTextureBaseShapeInfo const* _getBaseShapeInfo(TextureType baseShape)
     return &kCPUTextureBaseShapeInfos[(int)baseShape];
 }
 
+/// Copy an unpacked texel to the output. Fixed sizes compile to plain stores once the unpack function is inlined.
+static SLANG_FORCE_INLINE void _storeUnpackedTexel(const void* temp, void* outData, size_t outSize)
+{
+    switch (outSize)
+    {
+    case 4:
+        memcpy(outData, temp, 4);
+        break;
+    case 8:
+        memcpy(outData, temp, 8);
+        break;
+    case 12:
+        memcpy(outData, temp, 12);
+        break;
+    case 16:
+        memcpy(outData, temp, 16);
+        break;
+    default:
+        memcpy(outData, temp, outSize < 16 ? outSize : 16);
+        break;
+    }
+}
+
 template<int N>
 void _unpackFloatTexel(void const* texelData, void* outData, size_t outSize)
 {
@@ -17,7 +43,7 @@ void _unpackFloatTexel(void const* texelData, void* outData, size_t outSize)
     for (int i = 0; i < N; ++i)
         temp[i] = input[i];
 
-    memcpy(outData, temp, outSize);
+    _storeUnpackedTexel(temp, outData, outSize);
 }
 
 template<int N>
@@ -29,7 +55,7 @@ void _unpackFloat16Texel(void const* texelData, void* outData, size_t outSize)
     for (int i = 0; i < N; ++i)
         temp[i] = math::halfToFloat(input[i]);
 
-    memcpy(outData, temp, outSize);
+    _storeUnpackedTexel(temp, outData, outSize);
 }
 
 static inline float _unpackUnorm8Value(uint8_t value)
@@ -46,7 +72,7 @@ void _unpackUnorm8Texel(void const* texelData, void* outData, size_t outSize)
     for (int i = 0; i < N; ++i)
         temp[i] = _unpackUnorm8Value(input[i]);
 
-    memcpy(outData, temp, outSize);
+    _storeUnpackedTexel(temp, outData, outSize);
 }
 
 void _unpackUnormBGRA8Texel(void const* texelData, void* outData, size_t outSize)
@@ -59,7 +85,7 @@ void _unpackUnormBGRA8Texel(void const* texelData, void* outData, size_t outSize
     temp[2] = _unpackUnorm8Value(input[0]);
     temp[3] = _unpackUnorm8Value(input[3]);
 
-    memcpy(outData, temp, outSize);
+    _storeUnpackedTexel(temp, outData, outSize);
 }
 
 template<int N>
@@ -71,7 +97,7 @@ void _unpackUInt16Texel(void const* texelData, void* outData, size_t outSize)
     for (int i = 0; i < N; ++i)
         temp[i] = input[i];
 
-    memcpy(outData, temp, outSize);
+    _storeUnpackedTexel(temp, outData, outSize);
 }
 
 template<int N>
@@ -83,7 +109,62 @@ void _unpackUInt32Texel(void const* texelData, void* outData, size_t outSize)
     for (int i = 0; i < N; ++i)
         temp[i] = input[i];
 
-    memcpy(outData, temp, outSize);
+    _storeUnpackedTexel(temp, outData, outSize);
+}
+
+template<int N>
+void _packFloatTexel(void const* inData, void* texelData)
+{
+    memcpy(texelData, inData, N * sizeof(float));
+}
+
+template<int N>
+void _packFloat16Texel(void const* inData, void* texelData)
+{
+    auto input = (float const*)inData;
+    auto output = (uint16_t*)texelData;
+    for (int i = 0; i < N; ++i)
+        output[i] = math::floatToHalf(input[i]);
+}
+
+static inline uint8_t _packUnorm8Value(float value)
+{
+    value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+    return uint8_t(value * 255.0f + 0.5f);
+}
+
+template<int N>
+void _packUnorm8Texel(void const* inData, void* texelData)
+{
+    auto input = (float const*)inData;
+    auto output = (uint8_t*)texelData;
+    for (int i = 0; i < N; ++i)
+        output[i] = _packUnorm8Value(input[i]);
+}
+
+void _packUnormBGRA8Texel(void const* inData, void* texelData)
+{
+    auto input = (float const*)inData;
+    auto output = (uint8_t*)texelData;
+    output[0] = _packUnorm8Value(input[2]);
+    output[1] = _packUnorm8Value(input[1]);
+    output[2] = _packUnorm8Value(input[0]);
+    output[3] = _packUnorm8Value(input[3]);
+}
+
+template<int N>
+void _packUInt16Texel(void const* inData, void* texelData)
+{
+    auto input = (uint32_t const*)inData;
+    auto output = (uint16_t*)texelData;
+    for (int i = 0; i < N; ++i)
+        output[i] = uint16_t(input[i]);
+}
+
+template<int N>
+void _packUInt32Texel(void const* inData, void* texelData)
+{
+    memcpy(texelData, inData, N * sizeof(uint32_t));
 }
 
 TextureImpl::~TextureImpl()
@@ -91,7 +172,7 @@ TextureImpl::~TextureImpl()
     free(m_data);
 }
 
-Result TextureImpl::init(SubresourceData const* initData)
+Result TextureImpl::init(SubresourceData const* initData, bool tiled)
 {
     auto desc = m_desc;
 
@@ -139,6 +220,11 @@ Result TextureImpl::init(SubresourceData const* initData)
 
     m_mipLevels.resize(levelCount);
 
+    // 1D textures have no 2D neighbourhood to keep close and stay linear.
+    m_tiled = tiled && rank >= 2;
+    int32_t tileRank = rank;
+    int32_t tileShift = rank == 2 ? 4 : 3;
+
     int64_t totalDataSize = 0;
     for (int32_t levelIndex = 0; levelIndex < levelCount; ++levelIndex)
     {
@@ -157,16 +243,54 @@ Result TextureImpl::init(SubresourceData const* initData)
         {
             level.strides[axis] = level.strides[axis - 1] * level.extents[axis - 1];
         }
+        level.tileShift = 0;
+        level.tileRank = 0;
+        for (int32_t axis = 0; axis < kMaxRank; ++axis)
+            level.tiledAxisOffsets[axis] = nullptr;
 
-        int64_t levelDataSize = texelSize;
-        levelDataSize *= effectiveArrayElementCount;
-        for (int32_t axis = 0; axis < rank; ++axis)
-            levelDataSize *= int64_t(level.extents[axis]);
+        if (m_tiled)
+        {
+            // Levels are padded to whole tiles.
+            level.tileShift = tileShift;
+            level.tileRank = tileRank;
+            int64_t tileStride = int64_t(texelSize) << (tileShift * tileRank);
+            for (int32_t axis = 0; axis < kMaxRank; ++axis)
+            {
+                level.tileStrides[axis] = tileStride;
+                int32_t tileCount = axis < tileRank ? (level.extents[axis] + (1 << tileShift) - 1) >> tileShift : 1;
+                tileStride *= tileCount;
+            }
+            level.strides[1] = 0;
+            level.strides[2] = 0;
+            level.strides[3] = tileStride;
+        }
+
+        int64_t levelDataSize = level.strides[3] * effectiveArrayElementCount;
 
         level.offset = totalDataSize;
         totalDataSize += levelDataSize;
     }
 
+    if (m_tiled)
+    {
+        // Tiled addressing looks up the offset along each axis instead of spreading the coordinate bits per texel.
+        size_t tableSize = 0;
+        for (const auto& level : m_mipLevels)
+            tableSize += level.extents[0] + level.extents[1] + level.extents[2];
+        m_tiledAxisOffsets.resize(tableSize);
+        int64_t* table = m_tiledAxisOffsets.data();
+        for (auto& level : m_mipLevels)
+        {
+            for (int32_t axis = 0; axis < kMaxRank; ++axis)
+            {
+                for (int32_t index = 0; index < level.extents[axis]; ++index)
+                    table[index] = level.computeTiledAxisOffset(axis, index);
+                level.tiledAxisOffsets[axis] = table;
+                table += level.extents[axis];
+            }
+        }
+    }
+
     void* textureData = malloc((size_t)totalDataSize);
     m_data = textureData;
 
@@ -178,47 +302,196 @@ Result TextureImpl::init(SubresourceData const* initData)
             for (int32_t mipLevel = 0; mipLevel < m_desc.mipLevelCount; ++mipLevel)
             {
                 int32_t subresourceIndex = subresourceCounter++;
-
-                auto dstRowStride = m_mipLevels[mipLevel].strides[1];
-                auto dstLayerStride = m_mipLevels[mipLevel].strides[2];
-                auto dstArrayStride = m_mipLevels[mipLevel].strides[3];
-
-                auto textureRowSize = m_mipLevels[mipLevel].extents[0] * texelSize;
-
-                auto rowCount = m_mipLevels[mipLevel].extents[1];
-                auto depthLayerCount = m_mipLevels[mipLevel].extents[2];
-
                 auto& srcImage = initData[subresourceIndex];
-                ptrdiff_t srcRowStride = ptrdiff_t(srcImage.strideY);
-                ptrdiff_t srcLayerStride = ptrdiff_t(srcImage.strideZ);
-
-                char* dstLevel = (char*)textureData + m_mipLevels[mipLevel].offset;
-                char* dstImage = dstLevel + dstArrayStride * arrayElementIndex;
-
-                const char* srcLayer = (const char*)srcImage.data;
-                char* dstLayer = dstImage;
+                const auto& level = m_mipLevels[mipLevel];
+
+                RowLayout srcLayout;
+                srcLayout.data = (uint8_t*)srcImage.data;
+                srcLayout.rowStride = int64_t(srcImage.strideY);
+                srcLayout.sliceStride = int64_t(srcImage.strideZ);
+                writeTexels(
+                    nullptr,
+                    mipLevel,
+                    arrayElementIndex,
+                    Offset3D(),
+                    Extents{level.extents[0], level.extents[1], level.extents[2]},
+                    srcLayout
+                );
+            }
+        }
+    }
 
-                for (int32_t depthLayer = 0; depthLayer < depthLayerCount; ++depthLayer)
-                {
-                    const char* srcRow = srcLayer;
-                    char* dstRow = dstLayer;
+    return SLANG_OK;
+}
 
-                    for (int32_t row = 0; row < rowCount; ++row)
-                    {
-                        memcpy(dstRow, srcRow, textureRowSize);
+RowLayout TextureImpl::getRowLayout(int32_t mipLevel, int32_t arrayLayer, const Offset3D& offset)
+{
+    SLANG_RHI_ASSERT(!m_tiled);
+    const MipLevel& level = m_mipLevels[mipLevel];
+    RowLayout layout;
+    layout.data = (uint8_t*)m_data + level.offset + arrayLayer * level.strides[3] + offset.x * level.strides[0] +
+                  offset.y * level.strides[1] + offset.z * level.strides[2];
+    layout.rowStride = level.strides[1];
+    layout.sliceStride = level.strides[2];
+    return layout;
+}
 
-                        srcRow += srcRowStride;
-                        dstRow += dstRowStride;
-                    }
+static SLANG_FORCE_INLINE void _copyTexel(uint8_t* dst, const uint8_t* src, Size texelSize)
+{
+    // Fixed size copies compile to single loads and stores.
+    switch (texelSize)
+    {
+    case 4:
+        memcpy(dst, src, 4);
+        break;
+    case 8:
+        memcpy(dst, src, 8);
+        break;
+    case 16:
+        memcpy(dst, src, 16);
+        break;
+    default:
+        memcpy(dst, src, texelSize);
+        break;
+    }
+}
 
-                    srcLayer += srcLayerStride;
-                    dstLayer += dstLayerStride;
+/// Copy the texels of a box in a tiled subresource from (`toLinear`) or to linear rows.
+template<bool toLinear>
+static void _copyTiledTexels(
+    ThreadPool* threadPool,
+    const CPUTextureMipLevel& level,
+    uint8_t* layerData,
+    const Offset3D& offset,
+    const Extents& extent,
+    const RowLayout& linear,
+    Size texelSize
+)
+{
+    uint64_t rowCount = uint64_t(extent.height) * extent.depth;
+    if (rowCount * extent.width * texelSize < kParallelCopyThreshold)
+        threadPool = nullptr;
+    parallelFor(
+        threadPool,
+        rowCount,
+        [&](uint64_t begin, uint64_t end)
+        {
+            for (uint64_t i = begin; i < end; ++i)
+            {
+                int32_t y = int32_t(i % extent.height);
+                int32_t z = int32_t(i / extent.height);
+                uint8_t* linearRow = linear.data + z * linear.sliceStride + y * linear.rowStride;
+                uint8_t* tiledRow =
+                    layerData + level.getAxisOffset(1, offset.y + y) + level.getAxisOffset(2, offset.z + z);
+                for (int32_t x = 0; x < extent.width; ++x)
+                {
+                    uint8_t* tiledTexel = tiledRow + level.getAxisOffset(0, offset.x + x);
+                    uint8_t* linearTexel = linearRow + x * texelSize;
+                    if (toLinear)
+                        _copyTexel(linearTexel, tiledTexel, texelSize);
+                    else
+                        _copyTexel(tiledTexel, linearTexel, texelSize);
                 }
             }
         }
+    );
+}
+
+void TextureImpl::readTexels(
+    ThreadPool* threadPool,
+    int32_t mipLevel,
+    int32_t arrayLayer,
+    const Offset3D& offset,
+    const Extents& extent,
+    const RowLayout& dst
+)
+{
+    if (!m_tiled)
+    {
+        RowLayout src = getRowLayout(mipLevel, arrayLayer, offset);
+        copyRows(threadPool, dst, src, Size(extent.width) * m_texelSize, extent.height, extent.depth);
+        return;
     }
+    const MipLevel& level = m_mipLevels[mipLevel];
+    uint8_t* layerData = (uint8_t*)m_data + level.offset + arrayLayer * level.strides[3];
+    _copyTiledTexels<true>(threadPool, level, layerData, offset, extent, dst, m_texelSize);
+}
 
-    return SLANG_OK;
+void TextureImpl::writeTexels(
+    ThreadPool* threadPool,
+    int32_t mipLevel,
+    int32_t arrayLayer,
+    const Offset3D& offset,
+    const Extents& extent,
+    const RowLayout& src
+)
+{
+    if (!m_tiled)
+    {
+        RowLayout dst = getRowLayout(mipLevel, arrayLayer, offset);
+        copyRows(threadPool, dst, src, Size(extent.width) * m_texelSize, extent.height, extent.depth);
+        return;
+    }
+    const MipLevel& level = m_mipLevels[mipLevel];
+    uint8_t* layerData = (uint8_t*)m_data + level.offset + arrayLayer * level.strides[3];
+    _copyTiledTexels<false>(threadPool, level, layerData, offset, extent, src, m_texelSize);
+}
+
+void TextureImpl::fillTexels(int32_t mipLevel, int32_t arrayLayer, const void* texel)
+{
+    const MipLevel& level = m_mipLevels[mipLevel];
+    if (!m_tiled)
+    {
+        fillRows(
+            getRowLayout(mipLevel, arrayLayer),
+            Size(level.extents[0]) * m_texelSize,
+            level.extents[1],
+            level.extents[2],
+            texel,
+            m_texelSize
+        );
+        return;
+    }
+    // The tiles of a layer are contiguous, the padding texels are filled as well.
+    RowLayout layer;
+    layer.data = (uint8_t*)m_data + level.offset + arrayLayer * level.strides[3];
+    layer.rowStride = level.strides[3];
+    layer.sliceStride = level.strides[3];
+    fillRows(layer, Size(level.strides[3]), 1, 1, texel, m_texelSize);
+}
+
+/// Select the cube face hit by `direction` and compute the normalized coordinates on it (D3D face conventions).
+static int32_t _getCubeFaceCoords(const float* direction, float* outCoords)
+{
+    float x = direction[0], y = direction[1], z = direction[2];
+    float ax = fabsf(x), ay = fabsf(y), az = fabsf(z);
+    int32_t face;
+    float major, s, t;
+    if (ax >= ay && ax >= az)
+    {
+        face = x >= 0.0f ? 0 : 1;
+        major = ax;
+        s = x >= 0.0f ? -z : z;
+        t = -y;
+    }
+    else if (ay >= az)
+    {
+        face = y >= 0.0f ? 2 : 3;
+        major = ay;
+        s = x;
+        t = y >= 0.0f ? z : -z;
+    }
+    else
+    {
+        face = z >= 0.0f ? 4 : 5;
+        major = az;
+        s = z >= 0.0f ? x : -x;
+        t = -y;
+    }
+    float scale = major > 0.0f ? 0.5f / major : 0.0f;
+    outCoords[0] = s * scale + 0.5f;
+    outCoords[1] = t * scale + 0.5f;
+    return face;
 }
 
 slang_prelude::TextureDimensions TextureViewImpl::GetDimensions(int mipLevel)
@@ -274,51 +547,69 @@ void TextureViewImpl::SampleLevel(
     auto& desc = texture->_getDesc();
     int32_t rank = baseShape->rank;
     int32_t baseCoordCount = baseShape->baseCoordCount;
+    const SamplerDesc& sampler = SamplerImpl::getDesc(samplerState);
+
+    // Cube maps are sampled with a direction, which selects the face and the coordinates on it.
+    float baseCoords[3] = {};
+    int32_t face = 0;
+    if (desc.type == TextureType::TextureCube)
+        face = _getCubeFaceCoords(coords, baseCoords);
+    else
+    {
+        for (int32_t axis = 0; axis < rank; ++axis)
+            baseCoords[axis] = coords[axis];
+    }
 
-    int32_t integerMipLevel = int32_t(level + 0.5f);
-    if (integerMipLevel >= desc.mipLevelCount)
-        integerMipLevel = desc.mipLevelCount - 1;
-    if (integerMipLevel < 0)
-        integerMipLevel = 0;
-
-    auto& mipLevelInfo = texture->m_mipLevels[integerMipLevel];
-
-    bool isArray = (desc.arrayLength > 1) || (desc.type == rhi::TextureType::TextureCube);
-    int32_t effectiveArrayElementCount = texture->m_effectiveArrayElementCount;
-    int32_t coordIndex = baseCoordCount;
+    int32_t implicitElementCount = baseShape->implicitArrayElementCount;
     int32_t elementIndex = 0;
-    if (isArray)
-        elementIndex = int32_t(coords[coordIndex++] + 0.5f);
-    if (elementIndex >= effectiveArrayElementCount)
-        elementIndex = effectiveArrayElementCount - 1;
+    if (desc.arrayLength > 1)
+        elementIndex = int32_t(coords[baseCoordCount] + 0.5f);
+    if (elementIndex >= desc.arrayLength)
+        elementIndex = desc.arrayLength - 1;
     if (elementIndex < 0)
         elementIndex = 0;
-
-    // Note: for now we are just going to do nearest-neighbor sampling
-    //
-    int64_t texelOffset = mipLevelInfo.offset;
-    texelOffset += elementIndex * mipLevelInfo.strides[3];
-    for (int32_t axis = 0; axis < rank; ++axis)
+    elementIndex = elementIndex * implicitElementCount + face;
+
+    // Select the mip levels, `lod <= 0` means the texture is magnified.
+    float lod = level + sampler.mipLODBias;
+    lod = lod < sampler.minLOD ? sampler.minLOD : (lod > sampler.maxLOD ? sampler.maxLOD : lod);
+    TextureFilteringMode filter = lod > 0.0f ? sampler.minFilter : sampler.magFilter;
+    float maxMipLevel = float(desc.mipLevelCount - 1);
+    lod = lod < 0.0f ? 0.0f : (lod > maxMipLevel ? maxMipLevel : lod);
+    int32_t mipLevel = int32_t(lod);
+    float mipWeight = lod - float(mipLevel);
+    if (sampler.mipFilter == TextureFilteringMode::Point)
     {
-        int32_t extent = mipLevelInfo.extents[axis];
-
-        float coord = coords[axis];
-
-        // TODO: deal with wrap/clamp/repeat if `coord < 0` or `coord > 1`
-
-        int32_t integerCoord = int32_t(coord * (extent - 1) + 0.5f);
-
-        if (integerCoord >= extent)
-            integerCoord = extent - 1;
-        if (integerCoord < 0)
-            integerCoord = 0;
-
-        texelOffset += integerCoord * mipLevelInfo.strides[axis];
+        mipLevel = int32_t(lod + 0.5f);
+        mipWeight = 0.0f;
     }
 
-    auto texelPtr = (char const*)texture->m_data + texelOffset;
+    CPUTextureSampleFunc sampleFunc = texture->m_formatInfo->sampleFunc;
+    auto sampleMipLevel = [&](int32_t mipLevelIndex, float* outValue)
+    {
+        const auto& mipLevelInfo = texture->m_mipLevels[mipLevelIndex];
+        CPUTextureSampleParams params;
+        params.data = (const uint8_t*)texture->m_data + mipLevelInfo.offset + elementIndex * mipLevelInfo.strides[3];
+        params.level = &mipLevelInfo;
+        params.rank = rank;
+        params.filter = filter;
+        for (int32_t axis = 0; axis < 3; ++axis)
+            params.coords[axis] = baseCoords[axis];
+        params.unpackFunc = texture->m_formatInfo->unpackFunc;
+        sampleFunc(sampler, params, outValue);
+    };
+
+    float value[4];
+    sampleMipLevel(mipLevel, value);
+    if (mipWeight > 0.0f && mipLevel + 1 < desc.mipLevelCount)
+    {
+        float nextValue[4];
+        sampleMipLevel(mipLevel + 1, nextValue);
+        for (int i = 0; i < 4; ++i)
+            value[i] += (nextValue[i] - value[i]) * mipWeight;
+    }
 
-    m_texture->m_formatInfo->unpackFunc(texelPtr, outData, dataSize);
+    memcpy(outData, value, dataSize < sizeof(value) ? dataSize : sizeof(value));
 }
 
 void* TextureViewImpl::refAt(const uint32_t* texelCoords)
@@ -370,25 +661,129 @@ void* TextureViewImpl::_getTexelPtr(int32_t const* texelCoords)
         if (coord < 0)
             coord = 0;
 
-        texelOffset += texelCoords[axis] * mipLevelInfo.strides[axis];
+        texelOffset += mipLevelInfo.getAxisOffset(axis, coord);
     }
 
     return (uint8_t*)texture->m_data + texelOffset;
 }
 
+/// Texture view with texel addressing specialized for the rank, the coordinate holding the array layer (-1 for non
+/// array textures) and the layout of the texture. The addressing of mip level 0 is captured when the view is created.
+/// Like `_getTexelPtr`, coordinates are clamped to mip level 0 and to the array layers of the texture.
+template<int32_t Rank, int32_t LayerCoord, bool Tiled>
+class AddressedTextureViewImpl : public TextureViewImpl
+{
+public:
+    AddressedTextureViewImpl(const TextureViewDesc& desc, TextureImpl* texture)
+        : TextureViewImpl(desc)
+    {
+        m_texture = texture;
+        m_level = texture->m_mipLevels[0];
+        m_levelData = (uint8_t*)texture->m_data + m_level.offset;
+        for (int32_t axis = 0; axis < 3; ++axis)
+            m_maxCoords[axis] = m_level.extents[axis] - 1;
+        m_maxLayer = texture->m_effectiveArrayElementCount - 1;
+    }
+
+    SLANG_FORCE_INLINE uint8_t* getTexel(const int32_t* texelCoords) const
+    {
+        int64_t offset = 0;
+        for (int32_t axis = 0; axis < Rank; ++axis)
+        {
+            int32_t coord = clamp(texelCoords[axis], 0, m_maxCoords[axis]);
+            offset += Tiled ? m_level.tiledAxisOffsets[axis][coord] : coord * m_level.strides[axis];
+        }
+        if (LayerCoord >= 0)
+            offset += clamp(texelCoords[LayerCoord], 0, m_maxLayer) * m_level.strides[3];
+        return m_levelData + offset;
+    }
+
+    void* refAt(const uint32_t* texelCoords) override { return getTexel((const int32_t*)texelCoords); }
+
+protected:
+    CPUTextureMipLevel m_level;
+    uint8_t* m_levelData;
+    int32_t m_maxCoords[3];
+    int32_t m_maxLayer;
+};
+
+/// Texture view loading texels with the unpack function of the texture format called directly.
+template<typename Addressing, CPUTextureUnpackFunc unpackFunc>
+class SpecializedTextureViewImpl : public Addressing
+{
+public:
+    using Addressing::Addressing;
+
+    void Load(const int32_t* texelCoords, void* outData, size_t dataSize) override
+    {
+        unpackFunc(this->getTexel(texelCoords), outData, dataSize);
+    }
+};
+
+template<typename Addressing>
+static TextureViewImpl* _createSpecializedTextureView(const TextureViewDesc& desc, TextureImpl* texture)
+{
+    switch (texture->getFormat())
+    {
+#define SLANG_RHI_CPU_TEXTURE_FORMAT_CASE(format, unpackFunc, packFunc)                                                \
+    case Format::format:                                                                                               \
+        return new SpecializedTextureViewImpl<Addressing, &unpackFunc>(desc, texture);
+        SLANG_RHI_CPU_TEXTURE_FORMATS(SLANG_RHI_CPU_TEXTURE_FORMAT_CASE)
+#undef SLANG_RHI_CPU_TEXTURE_FORMAT_CASE
+    default:
+        return new Addressing(desc, texture);
+    }
+}
+
+/// Create a view with texel access specialized for the texture, so `Load` and `refAt` do not branch on the format,
+/// shape or layout of the texture for every texel.
+static TextureViewImpl* _createTextureView(const TextureViewDesc& desc, TextureImpl* texture)
+{
+    const TextureDesc& textureDesc = texture->_getDesc();
+    bool isArray = textureDesc.arrayLength > 1;
+    bool tiled = texture->isTiled();
+    // Multisampled textures read the sample index from the coordinates and use the generic path.
+    if (textureDesc.sampleCount <= 1)
+    {
+        switch (textureDesc.type)
+        {
+        case TextureType::Texture1D:
+            return isArray ? _createSpecializedTextureView<AddressedTextureViewImpl<1, 1, false>>(desc, texture)
+                           : _createSpecializedTextureView<AddressedTextureViewImpl<1, -1, false>>(desc, texture);
+        case TextureType::Texture2D:
+            if (isArray)
+            {
+                return tiled ? _createSpecializedTextureView<AddressedTextureViewImpl<2, 2, true>>(desc, texture)
+                             : _createSpecializedTextureView<AddressedTextureViewImpl<2, 2, false>>(desc, texture);
+            }
+            return tiled ? _createSpecializedTextureView<AddressedTextureViewImpl<2, -1, true>>(desc, texture)
+                         : _createSpecializedTextureView<AddressedTextureViewImpl<2, -1, false>>(desc, texture);
+        case TextureType::Texture3D:
+            return tiled ? _createSpecializedTextureView<AddressedTextureViewImpl<3, -1, true>>(desc, texture)
+                         : _createSpecializedTextureView<AddressedTextureViewImpl<3, -1, false>>(desc, texture);
+        case TextureType::TextureCube:
+            // The face (and cube array element) follows the 3 direction coordinates.
+            return tiled ? _createSpecializedTextureView<AddressedTextureViewImpl<2, 3, true>>(desc, texture)
+                         : _createSpecializedTextureView<AddressedTextureViewImpl<2, 3, false>>(desc, texture);
+        }
+    }
+    TextureViewImpl* view = new TextureViewImpl(desc);
+    view->m_texture = texture;
+    return view;
+}
+
 Result DeviceImpl::createTexture(const TextureDesc& descIn, const SubresourceData* initData, ITexture** outTexture)
 {
     TextureDesc desc = fixupTextureDesc(descIn);
     RefPtr<TextureImpl> texture = new TextureImpl(desc);
-    SLANG_RETURN_ON_FAIL(texture->init(initData));
+    SLANG_RETURN_ON_FAIL(texture->init(initData, m_extendedDesc.textureLayout == CPUTextureLayout::Tiled));
     returnComPtr(outTexture, texture);
     return SLANG_OK;
 }
 
 Result DeviceImpl::createTextureView(ITexture* texture, const TextureViewDesc& desc, ITextureView** outView)
 {
-    RefPtr<TextureViewImpl> view = new TextureViewImpl(desc);
-    view->m_texture = checked_cast<TextureImpl*>(texture);
+    RefPtr<TextureViewImpl> view = _createTextureView(desc, checked_cast<TextureImpl*>(texture));
     if (view->m_desc.format == Format::Unknown)
         view->m_desc.format = view->m_texture->m_desc.format;
     view->m_desc.subresourceRange = view->m_texture->resolveSubresourceRange(desc.subresourceRange);
@@ -398,7 +793,40 @@ Result DeviceImpl::createTextureView(ITexture* texture, const TextureViewDesc& d
 
 Result DeviceImpl::readTexture(ITexture* texture, ISlangBlob** outBlob, Size* outRowPitch, Size* outPixelSize)
 {
-    return SLANG_E_NOT_AVAILABLE;
+    TextureImpl* textureImpl = checked_cast<TextureImpl*>(texture);
+
+    // Same layout as the other backends: all subresources tightly packed, array layer major.
+    Size pixelSize = textureImpl->m_texelSize;
+    Size bufferSize = 0;
+    for (const auto& level : textureImpl->m_mipLevels)
+        bufferSize += pixelSize * level.extents[0] * level.extents[1] * level.extents[2];
+    bufferSize *= textureImpl->m_effectiveArrayElementCount;
+
+    auto blob = OwnedBlob::create(bufferSize);
+    uint8_t* dst = (uint8_t*)blob->getBufferPointer();
+    for (int32_t layer = 0; layer < textureImpl->m_effectiveArrayElementCount; ++layer)
+    {
+        for (int32_t mipLevel = 0; mipLevel < int32_t(textureImpl->m_mipLevels.size()); ++mipLevel)
+        {
+            const auto& level = textureImpl->m_mipLevels[mipLevel];
+            Size rowSize = pixelSize * level.extents[0];
+            RowLayout dstLayout = {dst, int64_t(rowSize), int64_t(rowSize * level.extents[1])};
+            textureImpl->readTexels(
+                getThreadPool(),
+                mipLevel,
+                layer,
+                Offset3D(),
+                Extents{level.extents[0], level.extents[1], level.extents[2]},
+                dstLayout
+            );
+            dst += rowSize * level.extents[1] * level.extents[2];
+        }
+    }
+
+    *outRowPitch = pixelSize * textureImpl->m_desc.size.width;
+    *outPixelSize = pixelSize;
+    returnComPtr(outBlob, blob);
+    return SLANG_OK;
 }
 
 } // namespace rhi::cpu
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "cpu-base.h"
+#include "cpu-copy.h"
 
 namespace rhi::cpu {
 
@@ -21,10 +22,89 @@ static const CPUTextureBaseShapeInfo kCPUTextureBaseShapeInfos[] = {
 static CPUTextureBaseShapeInfo const* _getBaseShapeInfo(TextureType baseShape);
 
 typedef void (*CPUTextureUnpackFunc)(void const* texelData, void* outData, size_t outSize);
+/// Packs 4 floats (or 4 integers for integer formats) into a texel.
+typedef void (*CPUTexturePackFunc)(void const* inData, void* texelData);
+
+/// Spread the 4 low bits of `v` to the even bits (Morton code of a 16x16 tile).
+SLANG_FORCE_INLINE uint32_t _spreadBits2(uint32_t v)
+{
+    v = (v | (v << 2)) & 0x33;
+    v = (v | (v << 1)) & 0x55;
+    return v;
+}
+
+/// Spread the 3 low bits of `v` to every third bit (Morton code of a 8x8x8 tile).
+SLANG_FORCE_INLINE uint32_t _spreadBits3(uint32_t v)
+{
+    return (v & 1) | ((v & 2) << 2) | ((v & 4) << 4);
+}
+
+/// Layout of a mip level of a CPU texture.
+/// Linear levels store the texels row by row. Tiled levels store them in tiles of `1 << tileShift` texels along each
+/// of the `tileRank` tiled axes, with the texels of a tile in Morton order. In both layouts the texel offset is the
+/// sum of independent offsets along each axis (see `getAxisOffset`).
+struct CPUTextureMipLevel
+{
+    int32_t extents[3];
+    /// Byte stride along each axis and between array layers. Only the texel size (axis 0) and the array layer stride
+    /// are used for tiled levels.
+    int64_t strides[4];
+    int64_t offset;
+    /// log2 of the tile size along the tiled axes, 0 for linear levels.
+    int32_t tileShift;
+    int32_t tileRank;
+    /// Byte stride between tiles along each axis.
+    int64_t tileStrides[3];
+    /// Byte offset of every texel index along each axis of tiled levels (owned by the texture).
+    const int64_t* tiledAxisOffsets[3];
+
+    /// Byte offset of texel `index` along `axis`.
+    SLANG_FORCE_INLINE int64_t getAxisOffset(int32_t axis, int32_t index) const
+    {
+        if (tileShift == 0)
+            return index * strides[axis];
+        return tiledAxisOffsets[axis][index];
+    }
+
+    /// Byte offset of texel `index` along `axis` of a tiled level, computed from the tile layout.
+    int64_t computeTiledAxisOffset(int32_t axis, int32_t index) const
+    {
+        uint32_t inner = uint32_t(index) & ((1u << tileShift) - 1);
+        uint32_t morton = (tileRank == 2 ? _spreadBits2(inner) : _spreadBits3(inner)) << axis;
+        return (index >> tileShift) * tileStrides[axis] + int64_t(morton) * strides[0];
+    }
+
+    /// Byte offset of a texel within its array layer.
+    SLANG_FORCE_INLINE int64_t getTexelOffset(int32_t x, int32_t y, int32_t z) const
+    {
+        return getAxisOffset(0, x) + getAxisOffset(1, y) + getAxisOffset(2, z);
+    }
+};
+
+/// A single mip level of an array layer to sample from.
+struct CPUTextureSampleParams
+{
+    /// Texel (0, 0, 0) of the array layer.
+    const uint8_t* data;
+    const CPUTextureMipLevel* level;
+    int32_t rank;
+    TextureFilteringMode filter;
+    /// Normalized texture coordinates.
+    float coords[3];
+    CPUTextureUnpackFunc unpackFunc;
+};
+
+/// Samples a mip level with a sampler, returning 4 floats (or 4 integers for integer formats).
+typedef void (*CPUTextureSampleFunc)(const SamplerDesc& sampler, const CPUTextureSampleParams& params, float* outValue);
+
+/// Returns the sampling kernel specialized for `format` (implemented in cpu-sampler.cpp).
+CPUTextureSampleFunc _getSampleFunc(Format format);
 
 struct CPUTextureFormatInfo
 {
     CPUTextureUnpackFunc unpackFunc;
+    CPUTexturePackFunc packFunc;
+    CPUTextureSampleFunc sampleFunc;
 };
 
 template<int N>
@@ -46,33 +126,55 @@ void _unpackUInt16Texel(void const* texelData, void* outData, size_t outSize);
 template<int N>
 void _unpackUInt32Texel(void const* texelData, void* outData, size_t outSize);
 
+template<int N>
+void _packFloatTexel(void const* inData, void* texelData);
+
+template<int N>
+void _packFloat16Texel(void const* inData, void* texelData);
+
+template<int N>
+void _packUnorm8Texel(void const* inData, void* texelData);
+
+void _packUnormBGRA8Texel(void const* inData, void* texelData);
+
+template<int N>
+void _packUInt16Texel(void const* inData, void* texelData);
+
+template<int N>
+void _packUInt32Texel(void const* inData, void* texelData);
+
+/// Formats supported by CPU textures, with their unpack and pack functions.
+#define SLANG_RHI_CPU_TEXTURE_FORMATS(x)                                                                               \
+    x(R32G32B32A32_FLOAT, _unpackFloatTexel<4>, _packFloatTexel<4>)                                                    \
+    x(R32G32B32_FLOAT, _unpackFloatTexel<3>, _packFloatTexel<3>)                                                       \
+    x(R32G32_FLOAT, _unpackFloatTexel<2>, _packFloatTexel<2>)                                                          \
+    x(R32_FLOAT, _unpackFloatTexel<1>, _packFloatTexel<1>)                                                             \
+    x(R16G16B16A16_FLOAT, _unpackFloat16Texel<4>, _packFloat16Texel<4>)                                                \
+    x(R16G16_FLOAT, _unpackFloat16Texel<2>, _packFloat16Texel<2>)                                                      \
+    x(R16_FLOAT, _unpackFloat16Texel<1>, _packFloat16Texel<1>)                                                         \
+    x(R8G8B8A8_UNORM, _unpackUnorm8Texel<4>, _packUnorm8Texel<4>)                                                      \
+    x(B8G8R8A8_UNORM, _unpackUnormBGRA8Texel, _packUnormBGRA8Texel)                                                    \
+    x(R16_UINT, _unpackUInt16Texel<1>, _packUInt16Texel<1>)                                                            \
+    x(R32_UINT, _unpackUInt32Texel<1>, _packUInt32Texel<1>)                                                            \
+    x(D32_FLOAT, _unpackFloatTexel<1>, _packFloatTexel<1>)
+
 struct CPUFormatInfoMap
 {
     CPUFormatInfoMap()
     {
         memset(m_infos, 0, sizeof(m_infos));
 
-        set(Format::R32G32B32A32_FLOAT, &_unpackFloatTexel<4>);
-        set(Format::R32G32B32_FLOAT, &_unpackFloatTexel<3>);
-
-        set(Format::R32G32_FLOAT, &_unpackFloatTexel<2>);
-        set(Format::R32_FLOAT, &_unpackFloatTexel<1>);
-
-        set(Format::R16G16B16A16_FLOAT, &_unpackFloat16Texel<4>);
-        set(Format::R16G16_FLOAT, &_unpackFloat16Texel<2>);
-        set(Format::R16_FLOAT, &_unpackFloat16Texel<1>);
-
-        set(Format::R8G8B8A8_UNORM, &_unpackUnorm8Texel<4>);
-        set(Format::B8G8R8A8_UNORM, &_unpackUnormBGRA8Texel);
-        set(Format::R16_UINT, &_unpackUInt16Texel<1>);
-        set(Format::R32_UINT, &_unpackUInt32Texel<1>);
-        set(Format::D32_FLOAT, &_unpackFloatTexel<1>);
+#define SLANG_RHI_CPU_TEXTURE_FORMAT_SET(format, unpackFunc, packFunc) set(Format::format, &unpackFunc, &packFunc);
+        SLANG_RHI_CPU_TEXTURE_FORMATS(SLANG_RHI_CPU_TEXTURE_FORMAT_SET)
+#undef SLANG_RHI_CPU_TEXTURE_FORMAT_SET
     }
 
-    void set(Format format, CPUTextureUnpackFunc func)
+    void set(Format format, CPUTextureUnpackFunc unpackFunc, CPUTexturePackFunc packFunc)
     {
         auto& info = m_infos[Index(format)];
-        info.unpackFunc = func;
+        info.unpackFunc = unpackFunc;
+        info.packFunc = packFunc;
+        info.sampleFunc = _getSampleFunc(format);
     }
 
     SLANG_FORCE_INLINE const CPUTextureFormatInfo& get(Format format) const { return m_infos[Index(format)]; }
@@ -103,24 +205,49 @@ public:
 
     ~TextureImpl();
 
-    Result init(SubresourceData const* initData);
+    Result init(SubresourceData const* initData, bool tiled);
 
     TextureDesc const& _getDesc() { return m_desc; }
     Format getFormat() { return m_desc.format; }
     int32_t getRank() { return m_baseShape->rank; }
 
+    bool isTiled() const { return m_tiled; }
+
+    /// Layout of the rows of a subresource, starting at texel `offset` (linear textures only).
+    RowLayout getRowLayout(int32_t mipLevel, int32_t arrayLayer, const Offset3D& offset = Offset3D());
+
+    /// Copy a box of texels of a subresource to linear rows, converting from the tiled layout if needed.
+    void readTexels(
+        ThreadPool* threadPool,
+        int32_t mipLevel,
+        int32_t arrayLayer,
+        const Offset3D& offset,
+        const Extents& extent,
+        const RowLayout& dst
+    );
+    /// Copy linear rows to a box of texels of a subresource, converting to the tiled layout if needed.
+    void writeTexels(
+        ThreadPool* threadPool,
+        int32_t mipLevel,
+        int32_t arrayLayer,
+        const Offset3D& offset,
+        const Extents& extent,
+        const RowLayout& src
+    );
+    /// Fill an entire subresource with a texel value.
+    void fillTexels(int32_t mipLevel, int32_t arrayLayer, const void* texel);
+
     CPUTextureBaseShapeInfo const* m_baseShape;
     CPUTextureFormatInfo const* m_formatInfo;
     int32_t m_effectiveArrayElementCount = 0;
     uint32_t m_texelSize = 0;
 
-    struct MipLevel
-    {
-        int32_t extents[kMaxRank];
-        int64_t strides[kMaxRank + 1];
-        int64_t offset;
-    };
+    bool m_tiled = false;
+
+    typedef CPUTextureMipLevel MipLevel;
     std::vector<MipLevel> m_mipLevels;
+    /// Storage of `CPUTextureMipLevel::tiledAxisOffsets` of all levels.
+    std::vector<int64_t> m_tiledAxisOffsets;
     void* m_data = nullptr;
 };
 
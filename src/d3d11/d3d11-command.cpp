@@ -591,8 +591,12 @@ void CommandExecutor::cmdDispatchCompute(const commands::DispatchCompute& cmd)
 
 void CommandExecutor::cmdDispatchComputeIndirect(const commands::DispatchComputeIndirect& cmd)
 {
+    // D3D11 has no count variant, count buffers are rejected when the command list is finished.
     BufferImpl* argBuffer = checked_cast<BufferImpl*>(cmd.argBuffer);
-    m_immediateContext->DispatchIndirect(argBuffer->m_buffer, cmd.offset);
+    for (GfxIndex i = 0; i < cmd.maxDispatchCount; i++)
+    {
+        m_immediateContext->DispatchIndirect(argBuffer->m_buffer, UINT(cmd.offset + i * 3 * sizeof(uint32_t)));
+    }
 }
 
 void CommandExecutor::cmdBeginRayTracingPass(const commands::BeginRayTracingPass& cmd)
@@ -760,9 +764,21 @@ Result CommandEncoderImpl::init()
     m_commandBuffer = new CommandBufferImpl();
     m_commandBuffer->m_commandList = new CommandList();
     m_commandList = m_commandBuffer->m_commandList;
+    m_profiler = m_device->m_profiler.get();
     return SLANG_OK;
 }
 
+Result CommandEncoderImpl::createTransientBuffer(const BufferDesc& desc, IBuffer** outBuffer)
+{
+    // Transient resources are not pooled on this backend.
+    return m_device->createBuffer(desc, nullptr, outBuffer);
+}
+
+Result CommandEncoderImpl::createTransientTexture(const TextureDesc& desc, ITexture** outTexture)
+{
+    return m_device->createTexture(desc, nullptr, outTexture);
+}
+
 Result CommandEncoderImpl::finish(ICommandBuffer** outCommandBuffer)
 {
     SLANG_RETURN_ON_FAIL(resolvePipelines(m_device));
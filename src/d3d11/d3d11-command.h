@@ -37,6 +37,12 @@ public:
 
     // ICommandEncoder implementation
 
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    createTransientBuffer(const BufferDesc& desc, IBuffer** outBuffer) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    createTransientTexture(const TextureDesc& desc, ITexture** outTexture) override;
+
     virtual SLANG_NO_THROW Result SLANG_MCALL finish(ICommandBuffer** outCommandBuffer) override;
 
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(NativeHandle* outHandle) override;
@@ -437,10 +437,8 @@ Result DeviceImpl::readBuffer(IBuffer* buffer, Offset offset, Size size, ISlangB
 
 Result DeviceImpl::getQueue(QueueType type, ICommandQueue** outQueue)
 {
-    if (type != QueueType::Graphics)
-    {
-        return SLANG_FAIL;
-    }
+    // There is only a single queue, compute and transfer work is submitted to it as well.
+    SLANG_UNUSED(type);
     m_queue->establishStrongReferenceToDevice();
     returnComPtr(outQueue, m_queue);
     return SLANG_OK;
@@ -974,17 +974,22 @@ void CommandRecorder::cmdDispatchComputeIndirect(const commands::DispatchCompute
         return;
 
     BufferImpl* argBuffer = checked_cast<BufferImpl*>(cmd.argBuffer);
+    BufferImpl* countBuffer = checked_cast<BufferImpl*>(cmd.countBuffer);
 
     requireBufferState(argBuffer, ResourceState::IndirectArgument);
+    if (countBuffer)
+    {
+        requireBufferState(countBuffer, ResourceState::IndirectArgument);
+    }
     commitBarriers();
 
     m_cmdList->ExecuteIndirect(
         m_device->dispatchIndirectCmdSignature,
-        (UINT)1,
+        (UINT)cmd.maxDispatchCount,
         argBuffer->m_resource,
         (UINT64)cmd.offset,
-        nullptr,
-        0
+        countBuffer ? countBuffer->m_resource.getResource() : nullptr,
+        (UINT64)cmd.countOffset
     );
 }
 
@@ -1409,16 +1414,26 @@ void CommandRecorder::commitBarriers()
             barrier.Transition.pResource = texture->m_resource;
             barrier.Transition.StateBefore = D3DUtil::getResourceState(textureBarrier.stateBefore);
             barrier.Transition.StateAfter = D3DUtil::getResourceState(textureBarrier.stateAfter);
-            for (uint32_t planeIndex = 0; planeIndex < planeCount; ++planeIndex)
+            for (GfxIndex arrayLayer = textureBarrier.arrayLayer;
+                 arrayLayer < textureBarrier.arrayLayer + textureBarrier.arrayLayerCount;
+                 arrayLayer++)
             {
-                barrier.Transition.Subresource = D3DUtil::getSubresourceIndex(
-                    textureBarrier.mipLevel,
-                    textureBarrier.arrayLayer,
-                    planeIndex,
-                    mipLevelCount,
-                    arrayLayerCount
-                );
-                barriers.push_back(barrier);
+                for (GfxIndex mipLevel = textureBarrier.mipLevel;
+                     mipLevel < textureBarrier.mipLevel + textureBarrier.mipLevelCount;
+                     mipLevel++)
+                {
+                    for (uint32_t planeIndex = 0; planeIndex < planeCount; ++planeIndex)
+                    {
+                        barrier.Transition.Subresource = D3DUtil::getSubresourceIndex(
+                            mipLevel,
+                            arrayLayer,
+                            planeIndex,
+                            mipLevelCount,
+                            arrayLayerCount
+                        );
+                        barriers.push_back(barrier);
+                    }
+                }
             }
         }
     }
@@ -1613,6 +1628,7 @@ Result CommandEncoderImpl::init()
 {
     SLANG_RETURN_ON_FAIL(m_queue->getOrCreateCommandBuffer(m_commandBuffer.writeRef()));
     m_commandList = m_commandBuffer->m_commandList;
+    m_profiler = m_device->m_profiler.get();
     return SLANG_OK;
 }
 
@@ -1635,6 +1651,17 @@ void CommandEncoderImpl::uploadBufferData(IBuffer* dst, Offset offset, Size size
     CommandEncoder::uploadBufferData(dst, offset, size, data);
 }
 
+Result CommandEncoderImpl::createTransientBuffer(const BufferDesc& desc, IBuffer** outBuffer)
+{
+    // Transient resources are not pooled on this backend.
+    return m_device->createBuffer(desc, nullptr, outBuffer);
+}
+
+Result CommandEncoderImpl::createTransientTexture(const TextureDesc& desc, ITexture** outTexture)
+{
+    return m_device->createTexture(desc, nullptr, outTexture);
+}
+
 Result CommandEncoderImpl::finish(ICommandBuffer** outCommandBuffer)
 {
     SLANG_RETURN_ON_FAIL(resolvePipelines(m_device));
@@ -76,6 +76,12 @@ public:
     virtual SLANG_NO_THROW void SLANG_MCALL
     uploadBufferData(IBuffer* dst, Offset offset, Size size, void* data) override;
 
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    createTransientBuffer(const BufferDesc& desc, IBuffer** outBuffer) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    createTransientTexture(const TextureDesc& desc, ITexture** outTexture) override;
+
     virtual SLANG_NO_THROW Result SLANG_MCALL finish(ICommandBuffer** outCommandBuffer) override;
 
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(NativeHandle* outHandle) override;
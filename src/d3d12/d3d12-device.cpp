@@ -486,6 +486,9 @@ Result DeviceImpl::initialize(const DeviceDesc& desc)
         m_features.push_back("hardware-device");
     }
 
+    // Indirect dispatches map onto ExecuteIndirect, which takes a count buffer.
+    m_features.push_back("dispatch-indirect-count");
+
     // NVAPI
     if (desc.nvapiExtnSlot >= 0)
     {
@@ -825,10 +828,8 @@ Result DeviceImpl::initialize(const DeviceDesc& desc)
 
 Result DeviceImpl::getQueue(QueueType type, ICommandQueue** outQueue)
 {
-    if (type != QueueType::Graphics)
-    {
-        return SLANG_FAIL;
-    }
+    // There is only a single queue, compute and transfer work is submitted to it as well.
+    SLANG_UNUSED(type);
     m_queue->establishStrongReferenceToDevice();
     returnComPtr(outQueue, m_queue);
     return SLANG_OK;
@@ -168,12 +168,18 @@ void DebugComputePassEncoder::dispatchCompute(GfxCount x, GfxCount y, GfxCount z
     baseObject->dispatchCompute(x, y, z);
 }
 
-void DebugComputePassEncoder::dispatchComputeIndirect(IBuffer* argBuffer, Offset offset)
+void DebugComputePassEncoder::dispatchComputeIndirect(
+    IBuffer* argBuffer,
+    Offset offset,
+    GfxCount maxDispatchCount,
+    IBuffer* countBuffer,
+    Offset countOffset
+)
 {
     SLANG_RHI_API_FUNC;
     m_commandEncoder->requireOpen();
     m_commandEncoder->requireComputePass();
-    baseObject->dispatchComputeIndirect(argBuffer, offset);
+    baseObject->dispatchComputeIndirect(argBuffer, offset, maxDispatchCount, countBuffer, countOffset);
 }
 
 void DebugComputePassEncoder::pushDebugGroup(const char* name, float rgbColor[3])
@@ -540,6 +546,20 @@ void DebugCommandEncoder::writeTimestamp(IQueryPool* pool, GfxIndex index)
     baseObject->writeTimestamp(getInnerObj(pool), index);
 }
 
+Result DebugCommandEncoder::createTransientBuffer(const BufferDesc& desc, IBuffer** outBuffer)
+{
+    SLANG_RHI_API_FUNC;
+    requireOpen();
+    return baseObject->createTransientBuffer(desc, outBuffer);
+}
+
+Result DebugCommandEncoder::createTransientTexture(const TextureDesc& desc, ITexture** outTexture)
+{
+    SLANG_RHI_API_FUNC;
+    requireOpen();
+    return baseObject->createTransientTexture(desc, outTexture);
+}
+
 Result DebugCommandEncoder::finish(ICommandBuffer** outCommandBuffer)
 {
     SLANG_RHI_API_FUNC;
@@ -553,6 +573,19 @@ Result DebugCommandEncoder::finish(ICommandBuffer** outCommandBuffer)
     return result;
 }
 
+Result DebugCommandEncoder::finishAsync(ICommandBuffer** outCommandBuffer)
+{
+    SLANG_RHI_API_FUNC;
+    requireOpen();
+    requireNoPass();
+    RefPtr<DebugCommandBuffer> outObject = new DebugCommandBuffer(ctx);
+    auto result = baseObject->finishAsync(outObject->baseObject.writeRef());
+    if (SLANG_FAILED(result))
+        return result;
+    returnComPtr(outCommandBuffer, outObject);
+    return result;
+}
+
 Result DebugCommandEncoder::getNativeHandle(NativeHandle* outHandle)
 {
     SLANG_RHI_API_FUNC;
@@ -59,7 +59,13 @@ public:
 
     virtual SLANG_NO_THROW void SLANG_MCALL setComputeState(const ComputeState& state) override;
     virtual SLANG_NO_THROW void SLANG_MCALL dispatchCompute(GfxCount x, GfxCount y, GfxCount z) override;
-    virtual SLANG_NO_THROW void SLANG_MCALL dispatchComputeIndirect(IBuffer* argBuffer, Offset offset) override;
+    virtual SLANG_NO_THROW void SLANG_MCALL dispatchComputeIndirect(
+        IBuffer* argBuffer,
+        Offset offset,
+        GfxCount maxDispatchCount = 1,
+        IBuffer* countBuffer = nullptr,
+        Offset countOffset = 0
+    ) override;
 
     virtual SLANG_NO_THROW void SLANG_MCALL pushDebugGroup(const char* name, float rgbColor[3]) override;
     virtual SLANG_NO_THROW void SLANG_MCALL popDebugGroup() override;
@@ -204,7 +210,12 @@ public:
 
     virtual SLANG_NO_THROW void SLANG_MCALL writeTimestamp(IQueryPool* queryPool, GfxIndex queryIndex) override;
 
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    createTransientBuffer(const BufferDesc& desc, IBuffer** outBuffer) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    createTransientTexture(const TextureDesc& desc, ITexture** outTexture) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL finish(ICommandBuffer** outCommandBuffer) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL finishAsync(ICommandBuffer** outCommandBuffer) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(NativeHandle* outHandle) override;
 
 public:
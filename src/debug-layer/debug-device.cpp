@@ -130,6 +130,24 @@ Result DebugDevice::createBufferFromSharedHandle(NativeHandle handle, const Buff
     return baseObject->createBufferFromSharedHandle(handle, srcDesc, outBuffer);
 }
 
+Result DebugDevice::createBufferFromHostMemory(
+    void* data,
+    const BufferDesc& desc,
+    HostMemoryReleaseFunc releaseFunc,
+    void* userData,
+    IBuffer** outBuffer
+)
+{
+    SLANG_RHI_API_FUNC;
+
+    if (!data)
+    {
+        RHI_VALIDATION_ERROR("Host memory is null.");
+        return SLANG_E_INVALID_ARG;
+    }
+    return baseObject->createBufferFromHostMemory(data, desc, releaseFunc, userData, outBuffer);
+}
+
 Result DebugDevice::mapBuffer(IBuffer* buffer, CpuAccessMode mode, void** outData)
 {
     SLANG_RHI_API_FUNC;
@@ -330,12 +348,47 @@ Result DebugDevice::readBuffer(IBuffer* buffer, size_t offset, size_t size, ISla
     return baseObject->readBuffer(buffer, offset, size, outBlob);
 }
 
+Result DebugDevice::readTextureAsync(ITexture* texture, IReadback** outReadback)
+{
+    SLANG_RHI_API_FUNC;
+    return baseObject->readTextureAsync(texture, outReadback);
+}
+
+Result DebugDevice::readBufferAsync(IBuffer* buffer, Offset offset, Size size, IReadback** outReadback)
+{
+    SLANG_RHI_API_FUNC;
+    if (offset + size > buffer->getDesc().size)
+    {
+        RHI_VALIDATION_ERROR("Readback range is out of bounds.");
+        return SLANG_E_INVALID_ARG;
+    }
+    return baseObject->readBufferAsync(buffer, offset, size, outReadback);
+}
+
 const DeviceInfo& DebugDevice::getDeviceInfo() const
 {
     SLANG_RHI_API_FUNC;
     return baseObject->getDeviceInfo();
 }
 
+Result DebugDevice::endProfilerFrame()
+{
+    SLANG_RHI_API_FUNC;
+    return baseObject->endProfilerFrame();
+}
+
+Result DebugDevice::getProfilerFrame(ProfilerFrame* outFrame)
+{
+    SLANG_RHI_API_FUNC;
+    return baseObject->getProfilerFrame(outFrame);
+}
+
+Result DebugDevice::getMemoryStats(MemoryStats* outStats)
+{
+    SLANG_RHI_API_FUNC;
+    return baseObject->getMemoryStats(outStats);
+}
+
 Result DebugDevice::createQueryPool(const QueryPoolDesc& desc, IQueryPool** outPool)
 {
     SLANG_RHI_API_FUNC;
@@ -37,6 +37,13 @@ public:
     createBufferFromNativeHandle(NativeHandle handle, const BufferDesc& srcDesc, IBuffer** outBuffer) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL
     createBufferFromSharedHandle(NativeHandle handle, const BufferDesc& srcDesc, IBuffer** outBuffer) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL createBufferFromHostMemory(
+        void* data,
+        const BufferDesc& desc,
+        HostMemoryReleaseFunc releaseFunc,
+        void* userData,
+        IBuffer** outBuffer
+    ) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL mapBuffer(IBuffer* buffer, CpuAccessMode mode, void** outData) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL unmapBuffer(IBuffer* buffer) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL createSampler(SamplerDesc const& desc, ISampler** outSampler) override;
@@ -79,7 +86,13 @@ public:
     readTexture(ITexture* texture, ISlangBlob** outBlob, Size* outRowPitch, Size* outPixelSize) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL
     readBuffer(IBuffer* buffer, Offset offset, Size size, ISlangBlob** outBlob) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL readTextureAsync(ITexture* texture, IReadback** outReadback) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    readBufferAsync(IBuffer* buffer, Offset offset, Size size, IReadback** outReadback) override;
     virtual SLANG_NO_THROW const DeviceInfo& SLANG_MCALL getDeviceInfo() const override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL endProfilerFrame() override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL getProfilerFrame(ProfilerFrame* outFrame) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL getMemoryStats(MemoryStats* outStats) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL createQueryPool(const QueryPoolDesc& desc, IQueryPool** outPool) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL createFence(const FenceDesc& desc, IFence** outFence) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL
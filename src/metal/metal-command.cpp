@@ -905,9 +905,21 @@ Result CommandEncoderImpl::init()
     m_commandBuffer = new CommandBufferImpl(m_device, m_queue);
     SLANG_RETURN_ON_FAIL(m_commandBuffer->init());
     m_commandList = m_commandBuffer->m_commandList;
+    m_profiler = m_device->m_profiler.get();
     return SLANG_OK;
 }
 
+Result CommandEncoderImpl::createTransientBuffer(const BufferDesc& desc, IBuffer** outBuffer)
+{
+    // Transient resources are not pooled on this backend.
+    return m_device->createBuffer(desc, nullptr, outBuffer);
+}
+
+Result CommandEncoderImpl::createTransientTexture(const TextureDesc& desc, ITexture** outTexture)
+{
+    return m_device->createTexture(desc, nullptr, outTexture);
+}
+
 Result CommandEncoderImpl::finish(ICommandBuffer** outCommandBuffer)
 {
     SLANG_RETURN_ON_FAIL(resolvePipelines(m_device));
@@ -0,0 +1,235 @@
+#include "profiler.h"
+#include "rhi-shared.h"
+
+#include <algorithm>
+
+namespace rhi {
+
+Profiler::Profiler(Device* device)
+    : m_device(device)
+{
+}
+
+Result Profiler::initFrame(Frame& frame)
+{
+    if (frame.queryPool)
+        return SLANG_OK;
+
+    QueryPoolDesc queryPoolDesc = {};
+    queryPoolDesc.type = QueryType::Timestamp;
+    queryPoolDesc.count = kMaxQueriesPerFrame;
+    queryPoolDesc.label = "Profiler timestamps";
+    SLANG_RETURN_ON_FAIL(m_device->createQueryPool(queryPoolDesc, frame.queryPool.writeRef()));
+
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = kMaxQueriesPerFrame * sizeof(uint64_t);
+    bufferDesc.usage = BufferUsage::CopySource | BufferUsage::CopyDestination;
+    bufferDesc.defaultState = ResourceState::CopySource;
+    bufferDesc.label = "Profiler timestamps";
+    SLANG_RETURN_ON_FAIL(m_device->createBuffer(bufferDesc, nullptr, frame.resolveBuffer.writeRef()));
+    return SLANG_OK;
+}
+
+Profiler::ZoneHandle Profiler::beginZone(CommandList* commandList, const char* name, const ZoneHandle& parent)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Frame& frame = m_frames[m_frameIndex % kFrameCount];
+    // Zones that do not fit are dropped, a zone needs two queries.
+    if (frame.skipped || frame.queryCount + frame.openZoneCount + 2 > kMaxQueriesPerFrame)
+        return {};
+    if (SLANG_FAILED(initFrame(frame)))
+    {
+        frame.skipped = true;
+        return {};
+    }
+
+    Zone zone;
+    zone.name = name ? name : "";
+    zone.parent = parent.frameIndex == m_frameIndex ? parent.zoneIndex : kInvalidZone;
+    zone.beginQuery = frame.queryCount++;
+    // The end query is allocated when the zone is closed, so only written queries are resolved. Room for it is
+    // reserved by counting the zone as open.
+    zone.endQuery = kInvalidZone;
+    frame.openZoneCount++;
+    frame.zones.push_back(std::move(zone));
+
+    commands::WriteTimestamp cmd;
+    cmd.queryPool = checked_cast<QueryPool*>(frame.queryPool.get());
+    cmd.queryIndex = frame.zones.back().beginQuery;
+    commandList->write(std::move(cmd));
+
+    ZoneHandle handle;
+    handle.frameIndex = m_frameIndex;
+    handle.zoneIndex = uint32_t(frame.zones.size() - 1);
+    return handle;
+}
+
+void Profiler::endZone(CommandList* commandList, const ZoneHandle& zone)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Zones spanning the end of a frame stay open, their frame may already be resolving.
+    if (zone.zoneIndex == kInvalidZone || zone.frameIndex != m_frameIndex)
+        return;
+    Frame& frame = m_frames[m_frameIndex % kFrameCount];
+    frame.openZoneCount--;
+    frame.zones[zone.zoneIndex].endQuery = frame.queryCount++;
+
+    commands::WriteTimestamp cmd;
+    cmd.queryPool = checked_cast<QueryPool*>(frame.queryPool.get());
+    cmd.queryIndex = frame.zones[zone.zoneIndex].endQuery;
+    commandList->write(std::move(cmd));
+}
+
+Result Profiler::endFrame()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Frame& frame = m_frames[m_frameIndex % kFrameCount];
+    if (!frame.skipped)
+        frame.frameIndex = m_frameIndex;
+
+    if (!frame.skipped && frame.queryCount > 0)
+    {
+        ComPtr<ICommandQueue> queue;
+        SLANG_RETURN_ON_FAIL(m_device->getQueue(QueueType::Graphics, queue.writeRef()));
+        ComPtr<ICommandEncoder> encoder;
+        SLANG_RETURN_ON_FAIL(queue->createCommandEncoder(encoder.writeRef()));
+        encoder->resolveQuery(frame.queryPool, 0, frame.queryCount, frame.resolveBuffer, 0);
+        ComPtr<ICommandBuffer> commandBuffer;
+        SLANG_RETURN_ON_FAIL(encoder->finish(commandBuffer.writeRef()));
+        SLANG_RETURN_ON_FAIL(queue->submit(commandBuffer));
+        SLANG_RETURN_ON_FAIL(m_device->readBufferAsync(
+            frame.resolveBuffer,
+            0,
+            frame.queryCount * sizeof(uint64_t),
+            frame.readback.writeRef()
+        ));
+        frame.pending = true;
+    }
+    else if (!frame.skipped)
+    {
+        // Nothing was recorded, publish an empty frame right away.
+        buildTree(frame, nullptr);
+    }
+
+    m_frameIndex++;
+    pollFrames();
+
+    Frame& nextFrame = m_frames[m_frameIndex % kFrameCount];
+    nextFrame.skipped = nextFrame.pending;
+    if (!nextFrame.pending)
+    {
+        nextFrame.queryCount = 0;
+        nextFrame.openZoneCount = 0;
+        nextFrame.zones.clear();
+    }
+    return SLANG_OK;
+}
+
+void Profiler::pollFrames()
+{
+    // Frames complete in submission order, resolve the oldest first.
+    for (uint32_t i = 0; i < kFrameCount; i++)
+    {
+        Frame& frame = m_frames[(m_frameIndex + i) % kFrameCount];
+        if (!frame.pending || !frame.readback->isReady())
+            continue;
+        const void* data = nullptr;
+        Size size = 0;
+        if (SLANG_SUCCEEDED(frame.readback->getData(&data, &size)))
+            buildTree(frame, (const uint64_t*)data);
+        frame.readback = nullptr;
+        frame.pending = false;
+    }
+}
+
+void Profiler::buildTree(Frame& frame, const uint64_t* timestamps)
+{
+    // Empty frames are published right away, so they can overtake frames that are still resolving.
+    if (m_hasResolvedFrame && frame.frameIndex < m_resolvedFrameIndex)
+        return;
+
+    const std::vector<Zone>& zones = frame.zones;
+    size_t zoneCount = zones.size();
+
+    uint64_t frameStart = ~0ull;
+    for (const Zone& zone : zones)
+        frameStart = std::min(frameStart, timestamps[zone.beginQuery]);
+    uint64_t frequency = m_device->getDeviceInfo().timestampFrequency;
+    double period = frequency ? 1.0 / double(frequency) : 0.0;
+
+    // Children of each zone (and the top level zones at index `zoneCount`), ordered by start time.
+    std::vector<std::vector<uint32_t>> children(zoneCount + 1);
+    for (uint32_t i = 0; i < zoneCount; i++)
+        children[zones[i].parent == kInvalidZone ? zoneCount : zones[i].parent].push_back(i);
+    for (auto& list : children)
+    {
+        std::stable_sort(
+            list.begin(),
+            list.end(),
+            [&](uint32_t a, uint32_t b) { return timestamps[zones[a].beginQuery] < timestamps[zones[b].beginQuery]; }
+        );
+    }
+
+    m_resolvedNames.clear();
+    m_resolvedZones.clear();
+    m_resolvedNames.reserve(zoneCount);
+    m_resolvedZones.reserve(zoneCount);
+
+    // Depth first traversal, so parents precede their children.
+    struct StackEntry
+    {
+        uint32_t zone;
+        GfxIndex parent;
+        uint32_t depth;
+    };
+    std::vector<StackEntry> stack;
+    for (auto it = children[zoneCount].rbegin(); it != children[zoneCount].rend(); ++it)
+        stack.push_back({*it, -1, 0});
+    while (!stack.empty())
+    {
+        StackEntry entry = stack.back();
+        stack.pop_back();
+        const Zone& zone = zones[entry.zone];
+        uint64_t begin = timestamps[zone.beginQuery];
+        // Zones that were not closed before the end of the frame have no end timestamp, they end where they started.
+        bool closed = zone.endQuery != kInvalidZone;
+        uint64_t end = closed ? std::max(begin, timestamps[zone.endQuery]) : begin;
+
+        ProfilerZone result = {};
+        result.parent = entry.parent;
+        result.depth = entry.depth;
+        result.closed = closed;
+        result.startTime = double(begin - frameStart) * period;
+        result.endTime = double(end - frameStart) * period;
+        GfxIndex index = GfxIndex(m_resolvedZones.size());
+        m_resolvedZones.push_back(result);
+        m_resolvedNames.push_back(zone.name);
+
+        const auto& list = children[entry.zone];
+        for (auto it = list.rbegin(); it != list.rend(); ++it)
+            stack.push_back({*it, index, entry.depth + 1});
+    }
+
+    m_resolvedFrameIndex = frame.frameIndex;
+    m_hasResolvedFrame = true;
+}
+
+Result Profiler::getFrame(ProfilerFrame* outFrame)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    pollFrames();
+    if (!m_hasResolvedFrame)
+        return SLANG_E_NOT_AVAILABLE;
+
+    m_publishedNames = m_resolvedNames;
+    m_publishedZones = m_resolvedZones;
+    for (size_t i = 0; i < m_publishedZones.size(); i++)
+        m_publishedZones[i].name = m_publishedNames[i].c_str();
+
+    outFrame->frameIndex = m_resolvedFrameIndex;
+    outFrame->zones = m_publishedZones.data();
+    outFrame->zoneCount = GfxCount(m_publishedZones.size());
+    return SLANG_OK;
+}
+
+} // namespace rhi
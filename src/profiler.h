@@ -0,0 +1,92 @@
+#pragma once
+
+#include <slang-rhi.h>
+
+#include "core/common.h"
+
+#include <array>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rhi {
+
+class Device;
+class CommandList;
+
+/// GPU timestamp profiler (enabled with `DeviceDesc::enableProfiler`).
+/// Command encoders bracket passes and debug groups with timestamps written into the query pool of the current
+/// frame. Frames are kept in a ring: at the end of a frame its queries are resolved into a buffer and read back
+/// asynchronously, and the timing tree of the frame is built once the readback completed. If the ring slot of a
+/// new frame is still waiting for its results, the new frame is not profiled instead of stalling.
+class Profiler
+{
+public:
+    /// Identifies an open zone (see `beginZone`).
+    struct ZoneHandle
+    {
+        uint64_t frameIndex = 0;
+        uint32_t zoneIndex = kInvalidZone;
+    };
+
+    static constexpr uint32_t kInvalidZone = ~0u;
+    static constexpr uint32_t kFrameCount = 4;
+    static constexpr uint32_t kMaxQueriesPerFrame = 4096;
+
+    Profiler(Device* device);
+
+    /// Open a zone, writing its start timestamp into `commandList`.
+    /// `parent` is the innermost open zone of the encoder (or an invalid handle).
+    ZoneHandle beginZone(CommandList* commandList, const char* name, const ZoneHandle& parent);
+    /// Close a zone, writing its end timestamp into `commandList`.
+    void endZone(CommandList* commandList, const ZoneHandle& zone);
+
+    Result endFrame();
+    Result getFrame(ProfilerFrame* outFrame);
+
+private:
+    struct Zone
+    {
+        std::string name;
+        uint32_t parent;
+        uint32_t beginQuery;
+        /// kInvalidZone until the zone is closed.
+        uint32_t endQuery;
+    };
+
+    struct Frame
+    {
+        uint64_t frameIndex = 0;
+        ComPtr<IQueryPool> queryPool;
+        ComPtr<IBuffer> resolveBuffer;
+        ComPtr<IReadback> readback;
+        uint32_t queryCount = 0;
+        /// Zones without an end query yet, each reserves room for one.
+        uint32_t openZoneCount = 0;
+        std::vector<Zone> zones;
+        /// True while the results of the frame are being read back.
+        bool pending = false;
+        /// True if the frame is not profiled (its ring slot was still pending when it started).
+        bool skipped = false;
+    };
+
+    Result initFrame(Frame& frame);
+    void pollFrames();
+    void buildTree(Frame& frame, const uint64_t* timestamps);
+
+    Device* m_device;
+    std::mutex m_mutex;
+    std::array<Frame, kFrameCount> m_frames;
+    uint64_t m_frameIndex = 0;
+
+    // Most recent resolved frame.
+    uint64_t m_resolvedFrameIndex = 0;
+    bool m_hasResolvedFrame = false;
+    std::vector<std::string> m_resolvedNames;
+    std::vector<ProfilerZone> m_resolvedZones;
+    // Copy handed out by `getFrame`, which stays valid until the next call.
+    std::vector<std::string> m_publishedNames;
+    std::vector<ProfilerZone> m_publishedZones;
+};
+
+} // namespace rhi
@@ -1,5 +1,6 @@
 #include "rhi-shared.h"
 #include "command-list.h"
+#include "strings.h"
 
 #include "core/common.h"
 
@@ -37,6 +38,42 @@ IFence* Fence::getInterface(const Guid& guid)
     return nullptr;
 }
 
+IReadback* Readback::getInterface(const Guid& guid)
+{
+    if (guid == ISlangUnknown::getTypeGuid() || guid == IReadback::getTypeGuid())
+        return static_cast<IReadback*>(this);
+    return nullptr;
+}
+
+Result Readback::getTextureLayout(Size* outRowPitch, Size* outPixelSize)
+{
+    if (outRowPitch)
+        *outRowPitch = m_rowPitch;
+    if (outPixelSize)
+        *outPixelSize = m_pixelSize;
+    return SLANG_OK;
+}
+
+/// Readback that has already completed, used by backends without asynchronous readback support.
+class ImmediateReadback : public Readback
+{
+public:
+    ComPtr<ISlangBlob> m_blob;
+
+    virtual SLANG_NO_THROW bool SLANG_MCALL isReady() override { return true; }
+    virtual SLANG_NO_THROW Result SLANG_MCALL wait(uint64_t timeout) override
+    {
+        SLANG_UNUSED(timeout);
+        return SLANG_OK;
+    }
+    virtual SLANG_NO_THROW Result SLANG_MCALL getData(const void** outData, Size* outSize) override
+    {
+        *outData = m_blob->getBufferPointer();
+        *outSize = m_blob->getBufferSize();
+        return SLANG_OK;
+    }
+};
+
 IResource* Buffer::getInterface(const Guid& guid)
 {
     if (guid == ISlangUnknown::getTypeGuid() || guid == IResource::getTypeGuid() || guid == IBuffer::getTypeGuid())
@@ -373,6 +410,8 @@ void RenderPassEncoder::end()
     {
         commands::EndRenderPass cmd;
         m_commandList->write(std::move(cmd));
+        // Debug groups left open inside the pass are closed with it.
+        m_encoder->endProfilerZones(m_profilerZoneIndex);
         m_commandList = nullptr;
     }
 }
@@ -406,13 +445,22 @@ void ComputePassEncoder::dispatchCompute(GfxCount x, GfxCount y, GfxCount z)
     }
 }
 
-void ComputePassEncoder::dispatchComputeIndirect(IBuffer* argBuffer, Offset offset)
+void ComputePassEncoder::dispatchComputeIndirect(
+    IBuffer* argBuffer,
+    Offset offset,
+    GfxCount maxDispatchCount,
+    IBuffer* countBuffer,
+    Offset countOffset
+)
 {
     if (m_commandList)
     {
         commands::DispatchComputeIndirect cmd;
         cmd.argBuffer = argBuffer;
         cmd.offset = offset;
+        cmd.maxDispatchCount = maxDispatchCount;
+        cmd.countBuffer = countBuffer;
+        cmd.countOffset = countOffset;
         m_commandList->write(std::move(cmd));
     }
 }
@@ -427,6 +475,7 @@ void ComputePassEncoder::pushDebugGroup(const char* name, float rgbColor[3])
         cmd.rgbColor[1] = rgbColor[1];
         cmd.rgbColor[2] = rgbColor[2];
         m_commandList->write(std::move(cmd));
+        m_encoder->beginProfilerZone(name);
     }
 }
 
@@ -434,6 +483,9 @@ void ComputePassEncoder::popDebugGroup()
 {
     if (m_commandList)
     {
+        // Unbalanced pops must not close the pass zone or the zones enclosing the pass.
+        if (m_encoder->m_profilerZones.size() > m_profilerZoneIndex + 1)
+            m_encoder->endProfilerZone();
         commands::PopDebugGroup cmd;
         m_commandList->write(std::move(cmd));
     }
@@ -458,6 +510,8 @@ void ComputePassEncoder::end()
     {
         commands::EndComputePass cmd;
         m_commandList->write(std::move(cmd));
+        // Debug groups left open inside the pass are closed with it.
+        m_encoder->endProfilerZones(m_profilerZoneIndex);
         m_commandList = nullptr;
     }
 }
@@ -502,6 +556,7 @@ void RayTracingPassEncoder::pushDebugGroup(const char* name, float rgbColor[3])
         cmd.rgbColor[1] = rgbColor[1];
         cmd.rgbColor[2] = rgbColor[2];
         m_commandList->write(std::move(cmd));
+        m_encoder->beginProfilerZone(name);
     }
 }
 
@@ -509,6 +564,9 @@ void RayTracingPassEncoder::popDebugGroup()
 {
     if (m_commandList)
     {
+        // Unbalanced pops must not close the pass zone or the zones enclosing the pass.
+        if (m_encoder->m_profilerZones.size() > m_profilerZoneIndex + 1)
+            m_encoder->endProfilerZone();
         commands::PopDebugGroup cmd;
         m_commandList->write(std::move(cmd));
     }
@@ -533,6 +591,8 @@ void RayTracingPassEncoder::end()
     {
         commands::EndRayTracingPass cmd;
         m_commandList->write(std::move(cmd));
+        // Debug groups left open inside the pass are closed with it.
+        m_encoder->endProfilerZones(m_profilerZoneIndex);
         m_commandList = nullptr;
     }
 }
@@ -546,26 +606,35 @@ ICommandEncoder* CommandEncoder::getInterface(const Guid& guid)
 
 IRenderPassEncoder* CommandEncoder::beginRenderPass(const RenderPassDesc& desc)
 {
+    m_renderPassEncoder.m_profilerZoneIndex = m_profilerZones.size();
+    beginProfilerZone("RenderPass");
     commands::BeginRenderPass cmd;
     cmd.desc = desc;
     m_commandList->write(std::move(cmd));
     m_renderPassEncoder.m_commandList = m_commandList;
+    m_renderPassEncoder.m_encoder = this;
     return &m_renderPassEncoder;
 }
 
 IComputePassEncoder* CommandEncoder::beginComputePass()
 {
+    m_computePassEncoder.m_profilerZoneIndex = m_profilerZones.size();
+    beginProfilerZone("ComputePass");
     commands::BeginComputePass cmd;
     m_commandList->write(std::move(cmd));
     m_computePassEncoder.m_commandList = m_commandList;
+    m_computePassEncoder.m_encoder = this;
     return &m_computePassEncoder;
 }
 
 IRayTracingPassEncoder* CommandEncoder::beginRayTracingPass()
 {
+    m_rayTracingPassEncoder.m_profilerZoneIndex = m_profilerZones.size();
+    beginProfilerZone("RayTracingPass");
     commands::BeginRayTracingPass cmd;
     m_commandList->write(std::move(cmd));
     m_rayTracingPassEncoder.m_commandList = m_commandList;
+    m_rayTracingPassEncoder.m_encoder = this;
     return &m_rayTracingPassEncoder;
 }
 
@@ -773,10 +842,12 @@ void CommandEncoder::pushDebugGroup(const char* name, float rgbColor[3])
     cmd.rgbColor[1] = rgbColor[1];
     cmd.rgbColor[2] = rgbColor[2];
     m_commandList->write(std::move(cmd));
+    beginProfilerZone(name);
 }
 
 void CommandEncoder::popDebugGroup()
 {
+    endProfilerZone();
     commands::PopDebugGroup cmd;
     m_commandList->write(std::move(cmd));
 }
@@ -799,12 +870,40 @@ void CommandEncoder::writeTimestamp(IQueryPool* queryPool, GfxIndex queryIndex)
     m_commandList->write(std::move(cmd));
 }
 
+void CommandEncoder::beginProfilerZone(const char* name)
+{
+    if (!m_profiler)
+        return;
+    Profiler::ZoneHandle parent = m_profilerZones.empty() ? Profiler::ZoneHandle() : m_profilerZones.back();
+    m_profilerZones.push_back(m_profiler->beginZone(m_commandList, name, parent));
+}
+
+void CommandEncoder::endProfilerZone()
+{
+    if (!m_profiler || m_profilerZones.empty())
+        return;
+    m_profiler->endZone(m_commandList, m_profilerZones.back());
+    m_profilerZones.pop_back();
+}
+
+void CommandEncoder::endProfilerZones(size_t zoneIndex)
+{
+    while (m_profilerZones.size() > zoneIndex)
+        endProfilerZone();
+}
+
 Result CommandEncoder::finish(ICommandBuffer** outCommandBuffer)
 {
     // iterate over commands and specialize pipelines
     return SLANG_FAIL;
 }
 
+Result CommandEncoder::finishAsync(ICommandBuffer** outCommandBuffer)
+{
+    // Backends without worker threads record synchronously.
+    return finish(outCommandBuffer);
+}
+
 Result CommandEncoder::resolvePipelines(Device* device)
 {
     CommandList* commandList = m_commandList;
@@ -843,6 +942,17 @@ Result CommandEncoder::resolvePipelines(Device* device)
             cmd.state.pipeline = static_cast<RayTracingPipeline*>(concretePipeline);
             break;
         }
+        case CommandID::DispatchComputeIndirect:
+        {
+            // Backends without a count variant would have to drop the dispatches.
+            auto& cmd = commandList->getCommand<commands::DispatchComputeIndirect>(command);
+            if (cmd.countBuffer && !device->hasFeature("dispatch-indirect-count"))
+            {
+                device->warning(S_CommandEncoder_dispatchComputeIndirect " with countBuffer not supported");
+                return SLANG_E_NOT_AVAILABLE;
+            }
+            break;
+        }
         }
         command = command->next;
     }
@@ -992,6 +1102,9 @@ Result Device::initialize(const DeviceDesc& desc)
             (void**)m_pipelineCreationAPIDispatcher.writeRef()
         );
     }
+
+    if (desc.enableProfiler)
+        m_profiler = std::make_unique<Profiler>(this);
     return SLANG_OK;
 }
 
@@ -1088,6 +1201,22 @@ Result Device::createBufferFromSharedHandle(NativeHandle handle, const BufferDes
     return SLANG_E_NOT_AVAILABLE;
 }
 
+Result Device::createBufferFromHostMemory(
+    void* data,
+    const BufferDesc& desc,
+    HostMemoryReleaseFunc releaseFunc,
+    void* userData,
+    IBuffer** outBuffer
+)
+{
+    SLANG_UNUSED(data);
+    SLANG_UNUSED(desc);
+    SLANG_UNUSED(releaseFunc);
+    SLANG_UNUSED(userData);
+    SLANG_UNUSED(outBuffer);
+    return SLANG_E_NOT_AVAILABLE;
+}
+
 Result Device::createInputLayout(InputLayoutDesc const& desc, IInputLayout** outLayout)
 {
     SLANG_UNUSED(desc);
@@ -1238,6 +1367,44 @@ Result Device::createSurface(WindowHandle windowHandle, ISurface** outSurface)
     return SLANG_E_NOT_AVAILABLE;
 }
 
+Result Device::readTextureAsync(ITexture* texture, IReadback** outReadback)
+{
+    RefPtr<ImmediateReadback> readback = new ImmediateReadback();
+    SLANG_RETURN_ON_FAIL(
+        readTexture(texture, readback->m_blob.writeRef(), &readback->m_rowPitch, &readback->m_pixelSize)
+    );
+    returnComPtr(outReadback, readback);
+    return SLANG_OK;
+}
+
+Result Device::readBufferAsync(IBuffer* buffer, Offset offset, Size size, IReadback** outReadback)
+{
+    RefPtr<ImmediateReadback> readback = new ImmediateReadback();
+    SLANG_RETURN_ON_FAIL(readBuffer(buffer, offset, size, readback->m_blob.writeRef()));
+    returnComPtr(outReadback, readback);
+    return SLANG_OK;
+}
+
+Result Device::endProfilerFrame()
+{
+    if (!m_profiler)
+        return SLANG_E_NOT_AVAILABLE;
+    return m_profiler->endFrame();
+}
+
+Result Device::getProfilerFrame(ProfilerFrame* outFrame)
+{
+    if (!m_profiler)
+        return SLANG_E_NOT_AVAILABLE;
+    return m_profiler->getFrame(outFrame);
+}
+
+Result Device::getMemoryStats(MemoryStats* outStats)
+{
+    SLANG_UNUSED(outStats);
+    return SLANG_E_NOT_AVAILABLE;
+}
+
 Result Device::getShaderObjectLayout(
     slang::ISession* session,
     slang::TypeReflection* type,
@@ -5,12 +5,15 @@
 #include "slang-context.h"
 #include "resource-desc-utils.h"
 #include "command-list.h"
+#include "profiler.h"
 
 #include "core/common.h"
 #include "core/short_vector.h"
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -165,6 +168,20 @@ protected:
     NativeHandle sharedHandle = {};
 };
 
+class Readback : public IReadback, public ComObject
+{
+public:
+    SLANG_COM_OBJECT_IUNKNOWN_ALL
+    IReadback* getInterface(const Guid& guid);
+
+    // IReadback implementation
+    virtual SLANG_NO_THROW Result SLANG_MCALL getTextureLayout(Size* outRowPitch, Size* outPixelSize) override;
+
+public:
+    Size m_rowPitch = 0;
+    Size m_pixelSize = 0;
+};
+
 class Resource : public ComObject
 {};
 
@@ -177,6 +194,7 @@ public:
 public:
     Buffer(const BufferDesc& desc)
         : m_desc(desc)
+        , m_keepDefaultState(desc.isShared)
     {
         m_descHolder.holdString(m_desc.label);
     }
@@ -192,6 +210,11 @@ public:
     BufferDesc m_desc;
     StructHolder m_descHolder;
     NativeHandle m_sharedHandle;
+    /// Resources shared outside of the device are returned to their default state at the end of
+    /// every command buffer instead of having their state tracked across command buffers.
+    bool m_keepDefaultState = false;
+    /// Slot in the StateTracking instance that last tracked this resource.
+    std::atomic<uint64_t> m_stateTrackingSlot{0};
 };
 
 class Texture : public ITexture, public Resource
@@ -203,6 +226,7 @@ public:
 public:
     Texture(const TextureDesc& desc)
         : m_desc(desc)
+        , m_keepDefaultState(desc.isShared)
     {
         m_descHolder.holdString(m_desc.label);
     }
@@ -219,6 +243,10 @@ public:
     TextureDesc m_desc;
     StructHolder m_descHolder;
     NativeHandle m_sharedHandle;
+    /// See `Buffer::m_keepDefaultState`.
+    bool m_keepDefaultState = false;
+    /// Slot in the StateTracking instance that last tracked this resource.
+    std::atomic<uint64_t> m_stateTrackingSlot{0};
 };
 
 class TextureView : public ITextureView, public Resource
@@ -899,6 +927,8 @@ public:
     QueueType m_type;
 };
 
+class CommandEncoder;
+
 class RenderPassEncoder : public IRenderPassEncoder
 {
 public:
@@ -909,6 +939,9 @@ public:
 
 public:
     CommandList* m_commandList;
+    CommandEncoder* m_encoder;
+    // Index of the pass zone in the open profiler zones of the encoder.
+    size_t m_profilerZoneIndex = 0;
 
     // IRenderPassEncoder implementation
     virtual SLANG_NO_THROW void SLANG_MCALL setRenderState(const RenderState& state) override;
@@ -948,11 +981,20 @@ public:
 
 public:
     CommandList* m_commandList;
+    CommandEncoder* m_encoder;
+    // Index of the pass zone in the open profiler zones of the encoder.
+    size_t m_profilerZoneIndex = 0;
 
     // IComputePassEncoder implementation
     virtual SLANG_NO_THROW void SLANG_MCALL setComputeState(const ComputeState& state) override;
     virtual SLANG_NO_THROW void SLANG_MCALL dispatchCompute(GfxCount x, GfxCount y, GfxCount z) override;
-    virtual SLANG_NO_THROW void SLANG_MCALL dispatchComputeIndirect(IBuffer* argBuffer, Offset offset) override;
+    virtual SLANG_NO_THROW void SLANG_MCALL dispatchComputeIndirect(
+        IBuffer* argBuffer,
+        Offset offset,
+        GfxCount maxDispatchCount = 1,
+        IBuffer* countBuffer = nullptr,
+        Offset countOffset = 0
+    ) override;
 
     // IPassEncoder implementation
     virtual SLANG_NO_THROW void SLANG_MCALL pushDebugGroup(const char* name, float rgbColor[3]) override;
@@ -972,6 +1014,9 @@ public:
 
 public:
     CommandList* m_commandList;
+    CommandEncoder* m_encoder;
+    // Index of the pass zone in the open profiler zones of the encoder.
+    size_t m_profilerZoneIndex = 0;
 
     // IRayTracingPassEncoder implementation
     virtual SLANG_NO_THROW void SLANG_MCALL setRayTracingState(const RayTracingState& state) override;
@@ -1000,6 +1045,16 @@ public:
     ComputePassEncoder m_computePassEncoder;
     RayTracingPassEncoder m_rayTracingPassEncoder;
 
+    // Profiler of the device, null if profiling is disabled. Must be set by the derived class.
+    Profiler* m_profiler = nullptr;
+    // Zones opened by this encoder and its pass encoders, innermost last.
+    std::vector<Profiler::ZoneHandle> m_profilerZones;
+
+    void beginProfilerZone(const char* name);
+    void endProfilerZone();
+    // Close the zone at `zoneIndex` and all zones opened after it.
+    void endProfilerZones(size_t zoneIndex);
+
     // ICommandEncoder implementation
     virtual SLANG_NO_THROW IRenderPassEncoder* SLANG_MCALL beginRenderPass(const RenderPassDesc& desc) override;
     virtual SLANG_NO_THROW IComputePassEncoder* SLANG_MCALL beginComputePass() override;
@@ -1094,6 +1149,7 @@ public:
     virtual SLANG_NO_THROW void SLANG_MCALL writeTimestamp(IQueryPool* queryPool, GfxIndex queryIndex) override;
 
     virtual SLANG_NO_THROW Result SLANG_MCALL finish(ICommandBuffer** outCommandBuffer) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL finishAsync(ICommandBuffer** outCommandBuffer) override;
 
 protected:
     Result resolvePipelines(Device* device);
@@ -1312,6 +1368,7 @@ public:
     uint32_t m_callableShaderCount;
 
     std::map<RayTracingPipeline*, RefPtr<Buffer>> m_deviceBuffers;
+    std::mutex m_deviceBuffersMutex;
 
     SLANG_COM_OBJECT_IUNKNOWN_ALL
     IShaderTable* getInterface(const Guid& guid)
@@ -1325,7 +1382,8 @@ public:
 
     Buffer* getOrCreateBuffer(RayTracingPipeline* pipeline)
     {
-        // TODO: NOT THREADSAFE
+        // Command buffers may be recorded on multiple threads.
+        std::lock_guard<std::mutex> lock(m_deviceBuffersMutex);
         auto it = m_deviceBuffers.find(pipeline);
         if (it != m_deviceBuffers.end())
             return it->second.Ptr();
@@ -1368,6 +1426,9 @@ public:
     SLANG_COM_OBJECT_IUNKNOWN_ADD_REF
     SLANG_COM_OBJECT_IUNKNOWN_RELEASE
 
+    // The profiler's query pools hold strong references to the device, release them with the last external reference.
+    virtual void comFree() override { m_profiler.reset(); }
+
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeDeviceHandles(DeviceNativeHandles* outHandles) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL
     getFeatures(const char** outFeatures, Size bufferSize, GfxCount* outFeatureCount) override;
@@ -1393,6 +1454,15 @@ public:
     virtual SLANG_NO_THROW Result SLANG_MCALL
     createBufferFromSharedHandle(NativeHandle handle, const BufferDesc& srcDesc, IBuffer** outBuffer) override;
 
+    // Provides a default implementation that returns SLANG_E_NOT_AVAILABLE.
+    virtual SLANG_NO_THROW Result SLANG_MCALL createBufferFromHostMemory(
+        void* data,
+        const BufferDesc& desc,
+        HostMemoryReleaseFunc releaseFunc,
+        void* userData,
+        IBuffer** outBuffer
+    ) override;
+
     virtual SLANG_NO_THROW Result SLANG_MCALL
     createInputLayout(InputLayoutDesc const& desc, IInputLayout** outLayout) override;
 
@@ -1450,6 +1520,19 @@ public:
     // Provides a default implementation that returns SLANG_E_NOT_AVAILABLE.
     virtual SLANG_NO_THROW Result SLANG_MCALL createSurface(WindowHandle windowHandle, ISurface** outSurface) override;
 
+    // Provides a default implementation that performs a blocking readback.
+    virtual SLANG_NO_THROW Result SLANG_MCALL readTextureAsync(ITexture* texture, IReadback** outReadback) override;
+
+    // Provides a default implementation that performs a blocking readback.
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    readBufferAsync(IBuffer* buffer, Offset offset, Size size, IReadback** outReadback) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL endProfilerFrame() override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL getProfilerFrame(ProfilerFrame* outFrame) override;
+
+    // Provides a default implementation that returns SLANG_E_NOT_AVAILABLE.
+    virtual SLANG_NO_THROW Result SLANG_MCALL getMemoryStats(MemoryStats* outStats) override;
+
     Result getEntryPointCodeFromShaderCache(
         slang::IComponentType* program,
         SlangInt entryPointIndex,
@@ -1530,6 +1613,9 @@ public:
     ComPtr<IPipelineCreationAPIDispatcher> m_pipelineCreationAPIDispatcher;
 
     IDebugCallback* m_debugCallback = nullptr;
+
+    // Only created if `DeviceDesc::enableProfiler` is set.
+    std::unique_ptr<Profiler> m_profiler;
 };
 
 bool isDepthFormat(Format format);
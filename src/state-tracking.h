@@ -2,8 +2,10 @@
 
 #include "rhi-shared.h"
 
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
 #include <vector>
-#include <map>
 
 namespace rhi {
 
@@ -12,10 +14,21 @@ struct BufferState
     ResourceState state = ResourceState::Undefined;
 };
 
+/// Run of consecutive subresources in the same state.
+/// Subresources are ordered by `arrayLayer * mipLevelCount + mipLevel`.
+struct SubresourceStateRun
+{
+    uint32_t start;
+    ResourceState state;
+};
+
 struct TextureState
 {
+    /// State of the entire texture (Undefined if the subresources are in different states).
     ResourceState state = ResourceState::Undefined;
-    std::vector<ResourceState> subresourceStates;
+    /// Run-length encoded subresource states, sorted by start. Each run extends to the start of the
+    /// next run or the end of the texture. Empty if all subresources are in `state`.
+    std::vector<SubresourceStateRun> runs;
 };
 
 struct BufferBarrier
@@ -30,7 +43,9 @@ struct TextureBarrier
     Texture* texture;
     bool entireTexture;
     GfxIndex mipLevel;
+    GfxCount mipLevelCount;
     GfxIndex arrayLayer;
+    GfxCount arrayLayerCount;
     ResourceState stateBefore;
     ResourceState stateAfter;
 };
@@ -38,6 +53,31 @@ struct TextureBarrier
 class StateTracking
 {
 public:
+    struct TrackedBuffer
+    {
+        Buffer* buffer;
+        BufferState state;
+    };
+
+    struct TrackedTexture
+    {
+        Texture* texture;
+        TextureState state;
+    };
+
+    StateTracking()
+        : m_id(allocateID())
+    {
+    }
+
+    /// Enable tracking resource states across command buffers.
+    /// Resources are no longer assumed to be in their default state when first used. Instead, the first use
+    /// records a pending barrier, which is resolved against the actual resource state when the command buffer
+    /// is submitted, and the resource is left in its last used state. Resources with `m_keepDefaultState` set
+    /// are still transitioned from and back to their default state.
+    /// In this mode, an `Undefined` state denotes a state that is not yet known.
+    void setTrackAcrossCommandBuffers(bool enable) { m_trackAcrossCommandBuffers = enable; }
+
     void setBufferState(Buffer* buffer, ResourceState state)
     {
         // Cannot change state of upload/readback buffers.
@@ -47,7 +87,12 @@ public:
         }
 
         BufferState* bufferState = getBufferState(buffer);
-        if (state != bufferState->state || state == ResourceState::UnorderedAccess)
+        if (bufferState->state == ResourceState::Undefined && isTrackedAcrossCommandBuffers(buffer))
+        {
+            m_pendingBufferBarriers.push_back({buffer, ResourceState::Undefined, state});
+            bufferState->state = state;
+        }
+        else if (state != bufferState->state || state == ResourceState::UnorderedAccess)
         {
             m_bufferBarriers.push_back({buffer, bufferState->state, state});
             bufferState->state = state;
@@ -66,86 +111,134 @@ public:
         bool isEntireTexture = texture->isEntireTexture(subresourceRange);
         TextureState* textureState = getTextureState(texture);
 
-        if (isEntireTexture && textureState->subresourceStates.empty())
+        if (isEntireTexture && textureState->runs.empty())
         {
             // Transition entire texture.
-            if (state != textureState->state || state == ResourceState::UnorderedAccess)
+            if (textureState->state == ResourceState::Undefined && isTrackedAcrossCommandBuffers(texture))
             {
-                m_textureBarriers.push_back({texture, true, 0, 0, textureState->state, state});
+                m_pendingTextureBarriers.push_back({texture, true, 0, 0, 0, 0, ResourceState::Undefined, state});
+                textureState->state = state;
+            }
+            else if (state != textureState->state || state == ResourceState::UnorderedAccess)
+            {
+                m_textureBarriers.push_back({texture, true, 0, 0, 0, 0, textureState->state, state});
                 textureState->state = state;
             }
         }
         else
         {
             // Transition subresources.
-            GfxCount arrayLayerCount =
-                texture->m_desc.arrayLength * (texture->m_desc.type == TextureType::TextureCube ? 6 : 1);
-
-            if (textureState->subresourceStates.empty())
+            // A range covering all mip levels is a single span of consecutive subresources,
+            // otherwise there is one span per array layer.
+            uint32_t mipLevelCount = texture->m_desc.mipLevelCount;
+            if (subresourceRange.mipLevel == 0 && (uint32_t)subresourceRange.mipLevelCount == mipLevelCount)
             {
-                textureState->subresourceStates.resize(
-                    texture->m_desc.mipLevelCount * arrayLayerCount,
-                    textureState->state
+                transitionSubresources(
+                    texture,
+                    textureState,
+                    subresourceRange.baseArrayLayer * mipLevelCount,
+                    (subresourceRange.baseArrayLayer + subresourceRange.layerCount) * mipLevelCount,
+                    state
                 );
-                textureState->state = ResourceState::Undefined;
             }
-            for (GfxIndex arrayLayer = subresourceRange.baseArrayLayer; arrayLayer < arrayLayerCount; arrayLayer++)
+            else
             {
-                for (GfxIndex mipLevel = subresourceRange.mipLevel;
-                     mipLevel < subresourceRange.mipLevel + subresourceRange.mipLevelCount;
-                     mipLevel++)
+                for (GfxIndex arrayLayer = subresourceRange.baseArrayLayer;
+                     arrayLayer < subresourceRange.baseArrayLayer + subresourceRange.layerCount;
+                     arrayLayer++)
                 {
-                    GfxIndex subresourceIndex = arrayLayer * texture->m_desc.mipLevelCount + mipLevel;
-                    if (state != textureState->subresourceStates[subresourceIndex] ||
-                        state == ResourceState::UnorderedAccess)
-                    {
-                        m_textureBarriers.push_back({
-                            texture,
-                            false,
-                            mipLevel,
-                            arrayLayer,
-                            textureState->subresourceStates[subresourceIndex],
-                            state,
-                        });
-                        textureState->subresourceStates[subresourceIndex] = state;
-                    }
+                    uint32_t start = arrayLayer * mipLevelCount + subresourceRange.mipLevel;
+                    transitionSubresources(
+                        texture,
+                        textureState,
+                        start,
+                        start + subresourceRange.mipLevelCount,
+                        state
+                    );
                 }
             }
+        }
+    }
 
-            // Check if all subresource states are equal and we can represent them as a single texture state.
-            ResourceState commonState = textureState->subresourceStates[0];
-            bool allEqual = true;
-            for (ResourceState subresourceState : textureState->subresourceStates)
+    /// Transition all tracked resources back to their default states.
+    /// When tracking across command buffers, this only affects resources with `m_keepDefaultState` set.
+    void requireDefaultStates()
+    {
+        for (size_t i = 0; i < m_buffers.size(); i++)
+        {
+            Buffer* buffer = m_buffers[i].buffer;
+            if (isTrackedAcrossCommandBuffers(buffer))
+                continue;
+            if (m_buffers[i].state.state != buffer->m_desc.defaultState)
             {
-                if (subresourceState != commonState)
-                {
-                    allEqual = false;
-                    break;
-                }
+                setBufferState(buffer, buffer->m_desc.defaultState);
             }
-            if (allEqual)
+        }
+        for (size_t i = 0; i < m_textures.size(); i++)
+        {
+            Texture* texture = m_textures[i].texture;
+            if (isTrackedAcrossCommandBuffers(texture))
+                continue;
+            if (m_textures[i].state.state != texture->m_desc.defaultState)
             {
-                textureState->state = commonState;
-                textureState->subresourceStates.clear();
+                setTextureState(texture, kEntireTexture, texture->m_desc.defaultState);
             }
         }
     }
 
-    void requireDefaultStates()
+    /// Start tracking a buffer from a known state (no-op if the buffer is already tracked).
+    void initBufferState(Buffer* buffer, const BufferState& state)
     {
-        for (auto& bufferState : m_bufferStates)
+        if (!findBufferState(buffer))
+            addBuffer(buffer, state);
+    }
+
+    /// Start tracking a texture from a known state (no-op if the texture is already tracked).
+    void initTextureState(Texture* texture, const TextureState& state)
+    {
+        if (!findTextureState(texture))
+            addTexture(texture, state);
+    }
+
+    /// Update `dst` with the known states of `src`, subresources in `Undefined` state are left unchanged.
+    static void mergeTextureState(Texture* texture, TextureState& dst, const TextureState& src)
+    {
+        if (src.runs.empty())
         {
-            if (bufferState.second.state != bufferState.first->m_desc.defaultState)
+            if (src.state != ResourceState::Undefined)
             {
-                setBufferState(bufferState.first, bufferState.first->m_desc.defaultState);
+                dst.state = src.state;
+                dst.runs.clear();
             }
+            return;
         }
-        for (auto& textureState : m_textureStates)
+        uint32_t subresourceCount = getSubresourceCount(texture);
+        for (size_t i = 0; i < src.runs.size(); i++)
         {
-            if (textureState.second.state != textureState.first->m_desc.defaultState)
-            {
-                setTextureState(textureState.first, kEntireTexture, textureState.first->m_desc.defaultState);
-            }
+            if (src.runs[i].state == ResourceState::Undefined)
+                continue;
+            uint32_t end = i + 1 < src.runs.size() ? src.runs[i + 1].start : subresourceCount;
+            assignSubresources(dst, subresourceCount, src.runs[i].start, end, src.runs[i].state);
+        }
+    }
+
+    /// Get the subresource ranges of a texture in `state`, as barriers from and to the state of each range.
+    static void getSubresourceRanges(
+        Texture* texture,
+        const TextureState& state,
+        std::vector<TextureBarrier>& outRanges
+    )
+    {
+        uint32_t subresourceCount = getSubresourceCount(texture);
+        if (state.runs.empty())
+        {
+            addTextureBarriers(outRanges, texture, 0, subresourceCount, state.state, state.state);
+            return;
+        }
+        for (size_t i = 0; i < state.runs.size(); i++)
+        {
+            uint32_t end = i + 1 < state.runs.size() ? state.runs[i + 1].start : subresourceCount;
+            addTextureBarriers(outRanges, texture, state.runs[i].start, end, state.runs[i].state, state.runs[i].state);
         }
     }
 
@@ -153,6 +246,18 @@ public:
 
     const std::vector<TextureBarrier>& getTextureBarriers() const { return m_textureBarriers; }
 
+    /// Barriers for the first use of resources whose state before the command buffer is not known.
+    /// `stateBefore` of these barriers is always `Undefined`.
+    const std::vector<BufferBarrier>& getPendingBufferBarriers() const { return m_pendingBufferBarriers; }
+
+    const std::vector<TextureBarrier>& getPendingTextureBarriers() const { return m_pendingTextureBarriers; }
+
+    const std::vector<TrackedBuffer>& getBufferStates() const { return m_buffers; }
+
+    const std::vector<TrackedTexture>& getTextureStates() const { return m_textures; }
+
+    bool hasBarriers() const { return !m_bufferBarriers.empty() || !m_textureBarriers.empty(); }
+
     void clearBarriers()
     {
         m_bufferBarriers.clear();
@@ -161,33 +266,278 @@ public:
 
     void clear()
     {
-        m_bufferStates.clear();
-        m_textureStates.clear();
+        // Invalidate the slots cached on the resources.
+        m_id = allocateID();
+        m_buffers.clear();
+        m_textures.clear();
+        m_bufferSlots.clear();
+        m_textureSlots.clear();
+        m_pendingBufferBarriers.clear();
+        m_pendingTextureBarriers.clear();
         clearBarriers();
     }
 
 private:
-    std::map<Buffer*, BufferState> m_bufferStates;
-    std::map<Texture*, TextureState> m_textureStates;
+    // Resources are stored densely and cache their slot together with the ID of the tracker
+    // (see Buffer/Texture::m_stateTrackingSlot), which avoids a map lookup on every state change.
+    // The maps are only used if the cached slot was overwritten by another tracker.
+    uint32_t m_id;
+    bool m_trackAcrossCommandBuffers = false;
+    std::vector<TrackedBuffer> m_buffers;
+    std::vector<TrackedTexture> m_textures;
+    std::unordered_map<Buffer*, uint32_t> m_bufferSlots;
+    std::unordered_map<Texture*, uint32_t> m_textureSlots;
     std::vector<BufferBarrier> m_bufferBarriers;
     std::vector<TextureBarrier> m_textureBarriers;
+    std::vector<BufferBarrier> m_pendingBufferBarriers;
+    std::vector<TextureBarrier> m_pendingTextureBarriers;
+
+    static uint32_t allocateID()
+    {
+        static std::atomic<uint32_t> nextID{1};
+        uint32_t id = nextID.fetch_add(1);
+        // Zero is reserved for resources that have never been tracked.
+        return id != 0 ? id : nextID.fetch_add(1);
+    }
+
+    static uint64_t packSlot(uint32_t id, uint32_t slot) { return (uint64_t(id) << 32) | slot; }
+
+    bool isTrackedAcrossCommandBuffers(Buffer* buffer) const
+    {
+        return m_trackAcrossCommandBuffers && !buffer->m_keepDefaultState;
+    }
+
+    bool isTrackedAcrossCommandBuffers(Texture* texture) const
+    {
+        return m_trackAcrossCommandBuffers && !texture->m_keepDefaultState;
+    }
+
+    BufferState* findBufferState(Buffer* buffer)
+    {
+        uint64_t cached = buffer->m_stateTrackingSlot.load(std::memory_order_relaxed);
+        uint32_t slot = uint32_t(cached);
+        if ((cached >> 32) == m_id && slot < m_buffers.size() && m_buffers[slot].buffer == buffer)
+            return &m_buffers[slot].state;
+        auto it = m_bufferSlots.find(buffer);
+        if (it == m_bufferSlots.end())
+            return nullptr;
+        buffer->m_stateTrackingSlot.store(packSlot(m_id, it->second), std::memory_order_relaxed);
+        return &m_buffers[it->second].state;
+    }
+
+    TextureState* findTextureState(Texture* texture)
+    {
+        uint64_t cached = texture->m_stateTrackingSlot.load(std::memory_order_relaxed);
+        uint32_t slot = uint32_t(cached);
+        if ((cached >> 32) == m_id && slot < m_textures.size() && m_textures[slot].texture == texture)
+            return &m_textures[slot].state;
+        auto it = m_textureSlots.find(texture);
+        if (it == m_textureSlots.end())
+            return nullptr;
+        texture->m_stateTrackingSlot.store(packSlot(m_id, it->second), std::memory_order_relaxed);
+        return &m_textures[it->second].state;
+    }
+
+    BufferState* addBuffer(Buffer* buffer, const BufferState& state)
+    {
+        uint32_t slot = (uint32_t)m_buffers.size();
+        m_buffers.push_back({buffer, state});
+        m_bufferSlots[buffer] = slot;
+        buffer->m_stateTrackingSlot.store(packSlot(m_id, slot), std::memory_order_relaxed);
+        return &m_buffers[slot].state;
+    }
+
+    TextureState* addTexture(Texture* texture, const TextureState& state)
+    {
+        uint32_t slot = (uint32_t)m_textures.size();
+        m_textures.push_back({texture, state});
+        m_textureSlots[texture] = slot;
+        texture->m_stateTrackingSlot.store(packSlot(m_id, slot), std::memory_order_relaxed);
+        return &m_textures[slot].state;
+    }
 
     BufferState* getBufferState(Buffer* buffer)
     {
-        auto it = m_bufferStates.find(buffer);
-        if (it != m_bufferStates.end())
-            return &it->second;
-        m_bufferStates[buffer] = {buffer->m_desc.defaultState};
-        return &m_bufferStates[buffer];
+        if (BufferState* bufferState = findBufferState(buffer))
+            return bufferState;
+        // The state of resources tracked across command buffers is not known until they are first used.
+        return addBuffer(
+            buffer,
+            {isTrackedAcrossCommandBuffers(buffer) ? ResourceState::Undefined : buffer->m_desc.defaultState}
+        );
     }
 
     TextureState* getTextureState(Texture* texture)
     {
-        auto it = m_textureStates.find(texture);
-        if (it != m_textureStates.end())
-            return &it->second;
-        m_textureStates[texture] = {texture->m_desc.defaultState};
-        return &m_textureStates[texture];
+        if (TextureState* textureState = findTextureState(texture))
+            return textureState;
+        return addTexture(
+            texture,
+            {isTrackedAcrossCommandBuffers(texture) ? ResourceState::Undefined : texture->m_desc.defaultState, {}}
+        );
+    }
+
+    static uint32_t getSubresourceCount(Texture* texture)
+    {
+        uint32_t arrayLayerCount =
+            texture->m_desc.arrayLength * (texture->m_desc.type == TextureType::TextureCube ? 6 : 1);
+        return texture->m_desc.mipLevelCount * arrayLayerCount;
+    }
+
+    /// Split the run containing `pos` so that a run starts at `pos`, returns the index of that run.
+    static size_t splitRun(TextureState& textureState, uint32_t pos)
+    {
+        auto& runs = textureState.runs;
+        auto it = std::upper_bound(
+            runs.begin(),
+            runs.end(),
+            pos,
+            [](uint32_t value, const SubresourceStateRun& run) { return value < run.start; }
+        );
+        size_t index = (it - runs.begin()) - 1;
+        if (runs[index].start == pos)
+            return index;
+        runs.insert(runs.begin() + index + 1, {pos, runs[index].state});
+        return index + 1;
+    }
+
+    /// Set the state of subresources [start, end) without recording barriers.
+    static void assignSubresources(
+        TextureState& textureState,
+        uint32_t subresourceCount,
+        uint32_t start,
+        uint32_t end,
+        ResourceState state
+    )
+    {
+        auto& runs = textureState.runs;
+        if (runs.empty())
+        {
+            if (textureState.state == state)
+                return;
+            runs.push_back({0, textureState.state});
+            textureState.state = ResourceState::Undefined;
+        }
+
+        size_t first = splitRun(textureState, start);
+        size_t last = end < subresourceCount ? splitRun(textureState, end) : runs.size();
+        runs.erase(runs.begin() + first + 1, runs.begin() + last);
+        runs[first].state = state;
+
+        // Merge with neighbouring runs in the same state.
+        if (first + 1 < runs.size() && runs[first + 1].state == state)
+            runs.erase(runs.begin() + first + 1);
+        if (first > 0 && runs[first - 1].state == state)
+            runs.erase(runs.begin() + first);
+
+        if (runs.size() == 1)
+        {
+            textureState.state = runs[0].state;
+            runs.clear();
+        }
+    }
+
+    /// Record barriers for subresources [start, end), split into rectangular mip/layer ranges.
+    static void addTextureBarriers(
+        std::vector<TextureBarrier>& barriers,
+        Texture* texture,
+        uint32_t start,
+        uint32_t end,
+        ResourceState stateBefore,
+        ResourceState stateAfter
+    )
+    {
+        uint32_t mipLevelCount = texture->m_desc.mipLevelCount;
+        if (start == 0 && end == getSubresourceCount(texture))
+        {
+            barriers.push_back({texture, true, 0, 0, 0, 0, stateBefore, stateAfter});
+            return;
+        }
+        while (start < end)
+        {
+            uint32_t arrayLayer = start / mipLevelCount;
+            uint32_t mipLevel = start % mipLevelCount;
+            if (mipLevel == 0 && end - start >= mipLevelCount)
+            {
+                uint32_t layerCount = (end - start) / mipLevelCount;
+                barriers.push_back({
+                    texture,
+                    false,
+                    0,
+                    (GfxCount)mipLevelCount,
+                    (GfxIndex)arrayLayer,
+                    (GfxCount)layerCount,
+                    stateBefore,
+                    stateAfter,
+                });
+                start += layerCount * mipLevelCount;
+            }
+            else
+            {
+                uint32_t count = std::min(mipLevelCount - mipLevel, end - start);
+                barriers.push_back({
+                    texture,
+                    false,
+                    (GfxIndex)mipLevel,
+                    (GfxCount)count,
+                    (GfxIndex)arrayLayer,
+                    1,
+                    stateBefore,
+                    stateAfter,
+                });
+                start += count;
+            }
+        }
+    }
+
+    /// Transition subresources [start, end) to `state`, recording barriers for each run in a different state.
+    void transitionSubresources(
+        Texture* texture,
+        TextureState* textureState,
+        uint32_t start,
+        uint32_t end,
+        ResourceState state
+    )
+    {
+        uint32_t subresourceCount = getSubresourceCount(texture);
+        bool trackedAcrossCommandBuffers = isTrackedAcrossCommandBuffers(texture);
+
+        auto visitRun = [&](uint32_t runStart, uint32_t runEnd, ResourceState runState)
+        {
+            runStart = std::max(runStart, start);
+            runEnd = std::min(runEnd, end);
+            if (runStart >= runEnd)
+                return;
+            if (runState == ResourceState::Undefined && trackedAcrossCommandBuffers)
+                addTextureBarriers(m_pendingTextureBarriers, texture, runStart, runEnd, runState, state);
+            else if (runState != state || state == ResourceState::UnorderedAccess)
+                addTextureBarriers(m_textureBarriers, texture, runStart, runEnd, runState, state);
+        };
+
+        const auto& runs = textureState->runs;
+        if (runs.empty())
+        {
+            visitRun(0, subresourceCount, textureState->state);
+        }
+        else
+        {
+            // Start at the run containing `start`.
+            auto it = std::upper_bound(
+                runs.begin(),
+                runs.end(),
+                start,
+                [](uint32_t value, const SubresourceStateRun& run) { return value < run.start; }
+            );
+            for (size_t i = (it - runs.begin()) - 1; i < runs.size(); i++)
+            {
+                uint32_t runEnd = i + 1 < runs.size() ? runs[i + 1].start : subresourceCount;
+                if (runs[i].start >= end)
+                    break;
+                visitRun(runs[i].start, runEnd, runs[i].state);
+            }
+        }
+
+        assignSubresources(*textureState, subresourceCount, start, end, state);
     }
 };
 
@@ -148,6 +148,7 @@
 #define S_Device_createBuffer "createBuffer"
 #define S_Device_createBufferFromNativeHandle "createBufferFromNativeHandle"
 #define S_Device_createBufferFromSharedHandle "createBufferFromSharedHandle"
+#define S_Device_createBufferFromHostMemory "createBufferFromHostMemory"
 #define S_Device_mapBuffer "mapBuffer"
 #define S_Device_unmapBuffer "unmapBuffer"
 #define S_Device_createSampler "createSampler"
@@ -9,7 +9,9 @@ AccelerationStructureImpl::~AccelerationStructureImpl()
 {
     if (m_device)
     {
-        m_device->m_api.vkDestroyAccelerationStructureKHR(m_device->m_api.m_device, m_vkHandle, nullptr);
+        RetiredObjects retired(m_device);
+        retired.add(VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_KHR, (uint64_t)m_vkHandle);
+        m_device->retireObjects(std::move(retired));
     }
 }
 
@@ -99,6 +99,8 @@ Result VulkanApi::initDeviceProcs(VkDevice device)
         vkGetSemaphoreCounterValue = vkGetSemaphoreCounterValueKHR;
     if (!vkSignalSemaphore && vkSignalSemaphoreKHR)
         vkSignalSemaphore = vkSignalSemaphoreKHR;
+    if (!vkCmdPipelineBarrier2 && vkCmdPipelineBarrier2KHR)
+        vkCmdPipelineBarrier2 = vkCmdPipelineBarrier2KHR;
     m_device = device;
     return SLANG_OK;
 }
@@ -125,7 +127,7 @@ int VulkanApi::findMemoryTypeIndex(uint32_t typeBits, VkMemoryPropertyFlags prop
     return -1;
 }
 
-int VulkanApi::findQueue(VkQueueFlags reqFlags) const
+int VulkanApi::findQueue(VkQueueFlags reqFlags, VkQueueFlags excludedFlags) const
 {
     SLANG_RHI_ASSERT(m_physicalDevice != VK_NULL_HANDLE);
 
@@ -142,7 +144,7 @@ int VulkanApi::findQueue(VkQueueFlags reqFlags) const
     int queueFamilyIndex = -1;
     for (int i = 0; i < int(numQueueFamilies); ++i)
     {
-        if ((queueFamilies[i].queueFlags & reqFlags) == reqFlags)
+        if ((queueFamilies[i].queueFlags & reqFlags) == reqFlags && (queueFamilies[i].queueFlags & excludedFlags) == 0)
         {
             return i;
         }
@@ -57,6 +57,8 @@ namespace rhi::vk {
     x(vkCreateComputePipelines) \
     x(vkCreateGraphicsPipelines) \
     x(vkDestroyPipeline) \
+    x(vkCreatePipelineCache) \
+    x(vkDestroyPipelineCache) \
     x(vkCreateShaderModule) \
     x(vkDestroyShaderModule) \
     x(vkCreateFramebuffer) \
@@ -216,6 +218,10 @@ namespace rhi::vk {
     x(vkCmdInsertDebugUtilsLabelEXT) \
     x(vkSetDebugUtilsObjectNameEXT) \
     x(vkCmdDrawMeshTasksEXT) \
+    x(vkCmdPipelineBarrier2) \
+    x(vkCmdPipelineBarrier2KHR) \
+    x(vkGetShaderModuleIdentifierEXT) \
+    x(vkGetShaderModuleCreateInfoIdentifierEXT) \
     /* */
 
 #define VK_API_ALL_GLOBAL_PROCS(x) \
@@ -317,6 +323,11 @@ struct VulkanExtendedFeatureProperties
     // Vulkan 1.3 features.
     VkPhysicalDeviceVulkan13Features vulkan13Features = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES};
 
+    // Synchronization2 features
+    VkPhysicalDeviceSynchronization2FeaturesKHR synchronization2Features = {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR
+    };
+
     // Dynamic rendering features
     VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures = {
         VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR
@@ -330,6 +341,21 @@ struct VulkanExtendedFeatureProperties
     VkPhysicalDeviceRayTracingValidationFeaturesNV rayTracingValidationFeatures = {
         VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_VALIDATION_FEATURES_NV
     };
+
+    // Pipeline creation cache control features
+    VkPhysicalDevicePipelineCreationCacheControlFeaturesEXT pipelineCreationCacheControlFeatures = {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PIPELINE_CREATION_CACHE_CONTROL_FEATURES_EXT
+    };
+
+    // Shader module identifier features
+    VkPhysicalDeviceShaderModuleIdentifierFeaturesEXT shaderModuleIdentifierFeatures = {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_MODULE_IDENTIFIER_FEATURES_EXT
+    };
+
+    // Graphics pipeline library features
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT graphicsPipelineLibraryFeatures = {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT
+    };
 };
 
 struct VulkanApi
@@ -362,8 +388,8 @@ struct VulkanApi
     /// Returns -1 if couldn't find an appropriate memory type index
     int findMemoryTypeIndex(uint32_t typeBits, VkMemoryPropertyFlags properties) const;
 
-    /// Given queue required flags, finds a queue
-    int findQueue(VkQueueFlags reqFlags) const;
+    /// Given queue required flags, finds a queue family that has none of the excluded flags
+    int findQueue(VkQueueFlags reqFlags, VkQueueFlags excludedFlags = 0) const;
 
     /// Module this was all loaded from.
     const VulkanModule* m_module = nullptr;
@@ -3,6 +3,7 @@
 #include "../rhi-shared.h"
 #include "vk-api.h"
 #include "vk-descriptor-allocator.h"
+#include "vk-memory-allocator.h"
 #include "vk-device-queue.h"
 
 #include "core/common.h"
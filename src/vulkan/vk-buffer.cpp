@@ -8,8 +8,39 @@
 
 namespace rhi::vk {
 
+static Result createVkBuffer(
+    DeviceImpl* device,
+    Size bufferSize,
+    VkBufferUsageFlags usage,
+    const void* next,
+    VkBuffer& outBuffer
+)
+{
+    const VulkanApi& api = device->m_api;
+
+    VkBufferCreateInfo bufferCreateInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+    bufferCreateInfo.pNext = next;
+    bufferCreateInfo.size = bufferSize;
+    bufferCreateInfo.usage = usage;
+    // Buffers have no layout, so they are shared concurrently between all queue families instead of
+    // transferring ownership between queues.
+    if (device->m_queueFamilyIndices.size() > 1)
+    {
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        bufferCreateInfo.queueFamilyIndexCount = (uint32_t)device->m_queueFamilyIndices.size();
+        bufferCreateInfo.pQueueFamilyIndices = device->m_queueFamilyIndices.data();
+    }
+    else
+    {
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    }
+
+    SLANG_VK_RETURN_ON_FAIL(api.vkCreateBuffer(api.m_device, &bufferCreateInfo, nullptr, &outBuffer));
+    return SLANG_OK;
+}
+
 Result VKBufferHandleRAII::init(
-    const VulkanApi& api,
+    DeviceImpl* device,
     Size bufferSize,
     VkBufferUsageFlags usage,
     VkMemoryPropertyFlags reqMemoryProperties,
@@ -19,37 +50,28 @@ Result VKBufferHandleRAII::init(
 {
     SLANG_RHI_ASSERT(!isInitialized());
 
+    const VulkanApi& api = device->m_api;
     m_api = &api;
-    m_memory = VK_NULL_HANDLE;
+    m_allocator = &device->m_memoryAllocator;
     m_buffer = VK_NULL_HANDLE;
 
-    VkBufferCreateInfo bufferCreateInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
-    bufferCreateInfo.size = bufferSize;
-    bufferCreateInfo.usage = usage;
-    bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
     VkExternalMemoryBufferCreateInfo externalMemoryBufferCreateInfo = {
         VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO
     };
     if (isShared)
     {
         externalMemoryBufferCreateInfo.handleTypes = extMemHandleType;
-        bufferCreateInfo.pNext = &externalMemoryBufferCreateInfo;
     }
 
-    SLANG_VK_RETURN_ON_FAIL(api.vkCreateBuffer(api.m_device, &bufferCreateInfo, nullptr, &m_buffer));
-
-    VkMemoryRequirements memoryReqs = {};
-    api.vkGetBufferMemoryRequirements(api.m_device, m_buffer, &memoryReqs);
+    SLANG_RETURN_ON_FAIL(
+        createVkBuffer(device, bufferSize, usage, isShared ? &externalMemoryBufferCreateInfo : nullptr, m_buffer)
+    );
 
-    int memoryTypeIndex = api.findMemoryTypeIndex(memoryReqs.memoryTypeBits, reqMemoryProperties);
-    SLANG_RHI_ASSERT(memoryTypeIndex >= 0);
+    MemoryAllocationDesc allocationDesc;
+    api.vkGetBufferMemoryRequirements(api.m_device, m_buffer, &allocationDesc.requirements);
+    allocationDesc.properties = reqMemoryProperties;
+    allocationDesc.linear = true;
 
-    VkMemoryPropertyFlags actualMemoryProperites =
-        api.m_deviceMemoryProperties.memoryTypes[memoryTypeIndex].propertyFlags;
-    VkMemoryAllocateInfo allocateInfo = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
-    allocateInfo.allocationSize = memoryReqs.size;
-    allocateInfo.memoryTypeIndex = memoryTypeIndex;
 #if SLANG_WINDOWS_FAMILY
     VkExportMemoryWin32HandleInfoKHR exportMemoryWin32HandleInfo = {
         VK_STRUCTURE_TYPE_EXPORT_MEMORY_WIN32_HANDLE_INFO_KHR
@@ -69,36 +91,80 @@ Result VKBufferHandleRAII::init(
                                              : nullptr;
 #endif
         exportMemoryAllocateInfo.handleTypes = extMemHandleType;
-        allocateInfo.pNext = &exportMemoryAllocateInfo;
+        // Exported memory must not be shared with other resources.
+        allocationDesc.dedicated = true;
+        allocationDesc.next = &exportMemoryAllocateInfo;
     }
-    VkMemoryAllocateFlagsInfo flagInfo = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO};
-    if (usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
-    {
-        flagInfo.deviceMask = 1;
-        flagInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
 
-        flagInfo.pNext = allocateInfo.pNext;
-        allocateInfo.pNext = &flagInfo;
+    SLANG_RETURN_ON_FAIL(m_allocator->allocate(allocationDesc, m_allocation));
+    SLANG_VK_RETURN_ON_FAIL(
+        api.vkBindBufferMemory(api.m_device, m_buffer, m_allocation.memory, m_allocation.offset)
+    );
+
+    return SLANG_OK;
+}
+
+Result VKBufferHandleRAII::initWithoutMemory(DeviceImpl* device, Size bufferSize, VkBufferUsageFlags usage)
+{
+    SLANG_RHI_ASSERT(!isInitialized());
+
+    m_api = &device->m_api;
+    m_allocator = nullptr;
+    m_buffer = VK_NULL_HANDLE;
+    return createVkBuffer(device, bufferSize, usage, nullptr, m_buffer);
+}
+
+void VKBufferHandleRAII::reset()
+{
+    if (m_api)
+    {
+        m_api->vkDestroyBuffer(m_api->m_device, m_buffer, nullptr);
+        if (m_allocator)
+            m_allocator->free(m_allocation);
     }
+    m_api = nullptr;
+    m_allocator = nullptr;
+    m_buffer = VK_NULL_HANDLE;
+    m_allocation = {};
+}
 
-    SLANG_VK_RETURN_ON_FAIL(api.vkAllocateMemory(api.m_device, &allocateInfo, nullptr, &m_memory));
-    SLANG_VK_RETURN_ON_FAIL(api.vkBindBufferMemory(api.m_device, m_buffer, m_memory, 0));
+void VKBufferHandleRAII::retire(RetiredObjects& objects)
+{
+    if (m_api)
+    {
+        objects.add(VK_OBJECT_TYPE_BUFFER, (uint64_t)m_buffer);
+        if (m_allocator)
+            objects.add(m_allocation);
+    }
+    m_api = nullptr;
+    m_allocator = nullptr;
+    m_buffer = VK_NULL_HANDLE;
+    m_allocation = {};
+}
 
-    return SLANG_OK;
+VKBufferHandleRAII::~VKBufferHandleRAII()
+{
+    reset();
 }
 
 BufferImpl::BufferImpl(DeviceImpl* device, const BufferDesc& desc)
     : Buffer(desc)
     , m_device(device)
 {
+    m_queueState.state = desc.defaultState;
 }
 
 BufferImpl::~BufferImpl()
 {
+    // The buffer may still be used by submitted command buffers.
+    RetiredObjects retired(m_device);
     for (auto& view : m_views)
     {
-        m_buffer.m_api->vkDestroyBufferView(m_buffer.m_api->m_device, view.second, nullptr);
+        retired.add(VK_OBJECT_TYPE_BUFFER_VIEW, (uint64_t)view.second);
     }
+    m_buffer.retire(retired);
+    m_uploadBuffer.retire(retired);
+    m_device->retireObjects(std::move(retired));
 
     if (m_sharedHandle)
     {
@@ -139,7 +205,7 @@ Result BufferImpl::getSharedHandle(NativeHandle* outHandle)
     VkMemoryGetWin32HandleInfoKHR info = {};
     info.sType = VK_STRUCTURE_TYPE_MEMORY_GET_WIN32_HANDLE_INFO_KHR;
     info.pNext = nullptr;
-    info.memory = m_buffer.m_memory;
+    info.memory = m_buffer.m_allocation.memory;
     info.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_WIN32_BIT;
 
     auto api = m_buffer.m_api;
@@ -155,7 +221,7 @@ Result BufferImpl::getSharedHandle(NativeHandle* outHandle)
     VkMemoryGetFdInfoKHR info = {};
     info.sType = VK_STRUCTURE_TYPE_MEMORY_GET_FD_INFO_KHR;
     info.pNext = nullptr;
-    info.memory = m_buffer.m_memory;
+    info.memory = m_buffer.m_allocation.memory;
     info.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
 
     auto api = m_buffer.m_api;
@@ -208,21 +274,15 @@ VkBufferView BufferImpl::getView(Format format, const BufferRange& range)
     return view;
 }
 
-Result DeviceImpl::createBuffer(const BufferDesc& descIn, const void* initData, IBuffer** outBuffer)
+static VkBufferUsageFlags getBufferUsageFlags(DeviceImpl* device, const BufferDesc& desc, const void* initData)
 {
-    BufferDesc desc = fixupBufferDesc(descIn);
-
-    const Size bufferSize = desc.size;
-
-    VkMemoryPropertyFlags reqMemoryProperties = 0;
-
     VkBufferUsageFlags usage = _calcBufferUsageFlags(desc.usage);
-    if (m_api.m_extendedFeatures.vulkan12Features.bufferDeviceAddress)
+    if (device->m_api.m_extendedFeatures.vulkan12Features.bufferDeviceAddress)
     {
         usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
     }
     if (is_set(desc.usage, BufferUsage::ShaderResource) &&
-        m_api.m_extendedFeatures.accelerationStructureFeatures.accelerationStructure)
+        device->m_api.m_extendedFeatures.accelerationStructureFeatures.accelerationStructure)
     {
         usage |= VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR;
     }
@@ -230,6 +290,34 @@ Result DeviceImpl::createBuffer(const BufferDesc& descIn, const void* initData,
     {
         usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
     }
+    return usage;
+}
+
+Result BufferImpl::createUnboundBuffer()
+{
+    for (auto& view : m_views)
+    {
+        m_device->m_api.vkDestroyBufferView(m_device->m_api.m_device, view.second, nullptr);
+    }
+    m_views.clear();
+    m_buffer.reset();
+
+    SLANG_RETURN_ON_FAIL(
+        m_buffer.initWithoutMemory(m_device, m_desc.size, getBufferUsageFlags(m_device, m_desc, nullptr))
+    );
+    m_device->_labelObject((uint64_t)m_buffer.m_buffer, VK_OBJECT_TYPE_BUFFER, m_desc.label);
+    return SLANG_OK;
+}
+
+Result DeviceImpl::createBuffer(const BufferDesc& descIn, const void* initData, IBuffer** outBuffer)
+{
+    BufferDesc desc = fixupBufferDesc(descIn);
+
+    const Size bufferSize = desc.size;
+
+    VkMemoryPropertyFlags reqMemoryProperties = 0;
+
+    VkBufferUsageFlags usage = getBufferUsageFlags(this, desc, initData);
 
     if (is_set(desc.usage, BufferUsage::ConstantBuffer) || desc.memoryType == MemoryType::Upload ||
         desc.memoryType == MemoryType::ReadBack)
@@ -251,12 +339,12 @@ Result DeviceImpl::createBuffer(const BufferDesc& descIn, const void* initData,
             = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
 #endif
         SLANG_RETURN_ON_FAIL(
-            buffer->m_buffer.init(m_api, desc.size, usage, reqMemoryProperties, desc.isShared, extMemHandleType)
+            buffer->m_buffer.init(this, desc.size, usage, reqMemoryProperties, desc.isShared, extMemHandleType)
         );
     }
     else
     {
-        SLANG_RETURN_ON_FAIL(buffer->m_buffer.init(m_api, desc.size, usage, reqMemoryProperties));
+        SLANG_RETURN_ON_FAIL(buffer->m_buffer.init(this, desc.size, usage, reqMemoryProperties));
     }
 
     _labelObject((uint64_t)buffer->m_buffer.m_buffer, VK_OBJECT_TYPE_BUFFER, desc.label);
@@ -266,16 +354,13 @@ Result DeviceImpl::createBuffer(const BufferDesc& descIn, const void* initData,
         if (desc.memoryType == MemoryType::DeviceLocal)
         {
             SLANG_RETURN_ON_FAIL(buffer->m_uploadBuffer.init(
-                m_api,
+                this,
                 bufferSize,
                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
             ));
             // Copy into staging buffer
-            void* mappedData = nullptr;
-            SLANG_VK_CHECK(m_api.vkMapMemory(m_device, buffer->m_uploadBuffer.m_memory, 0, bufferSize, 0, &mappedData));
-            ::memcpy(mappedData, initData, bufferSize);
-            m_api.vkUnmapMemory(m_device, buffer->m_uploadBuffer.m_memory);
+            ::memcpy(buffer->m_uploadBuffer.getMappedData(), initData, bufferSize);
 
             // Copy from staging buffer to real buffer
             VkCommandBuffer commandBuffer = m_deviceQueue.getCommandBuffer();
@@ -294,10 +379,7 @@ Result DeviceImpl::createBuffer(const BufferDesc& descIn, const void* initData,
         else
         {
             // Copy into mapped buffer directly
-            void* mappedData = nullptr;
-            SLANG_VK_CHECK(m_api.vkMapMemory(m_device, buffer->m_buffer.m_memory, 0, bufferSize, 0, &mappedData));
-            ::memcpy(mappedData, initData, bufferSize);
-            m_api.vkUnmapMemory(m_device, buffer->m_buffer.m_memory);
+            ::memcpy(buffer->m_buffer.getMappedData(), initData, bufferSize);
         }
     }
 
@@ -308,6 +390,8 @@ Result DeviceImpl::createBuffer(const BufferDesc& descIn, const void* initData,
 Result DeviceImpl::createBufferFromNativeHandle(NativeHandle handle, const BufferDesc& srcDesc, IBuffer** outBuffer)
 {
     RefPtr<BufferImpl> buffer(new BufferImpl(this, srcDesc));
+    // Buffers owned by another API cannot have their state tracked across command buffers.
+    buffer->m_keepDefaultState = true;
 
     if (handle.type == NativeHandleType::VkBuffer)
     {
@@ -325,16 +409,17 @@ Result DeviceImpl::createBufferFromNativeHandle(NativeHandle handle, const Buffe
 Result DeviceImpl::mapBuffer(IBuffer* buffer, CpuAccessMode mode, void** outData)
 {
     BufferImpl* bufferImpl = checked_cast<BufferImpl*>(buffer);
-    SLANG_VK_RETURN_ON_FAIL(
-        m_api.vkMapMemory(m_api.m_device, bufferImpl->m_buffer.m_memory, 0, VK_WHOLE_SIZE, 0, outData)
-    );
+    // Host visible memory is persistently mapped by the memory allocator.
+    void* mappedData = bufferImpl->m_buffer.getMappedData();
+    if (!mappedData)
+        return SLANG_FAIL;
+    *outData = mappedData;
     return SLANG_OK;
 }
 
 Result DeviceImpl::unmapBuffer(IBuffer* buffer)
 {
-    BufferImpl* bufferImpl = checked_cast<BufferImpl*>(buffer);
-    m_api.vkUnmapMemory(m_api.m_device, bufferImpl->m_buffer.m_memory);
+    SLANG_UNUSED(buffer);
     return SLANG_OK;
 }
 
@@ -2,6 +2,7 @@
 
 #include "vk-base.h"
 #include "vk-device.h"
+#include "../state-tracking.h"
 
 namespace rhi::vk {
 
@@ -10,7 +11,7 @@ class VKBufferHandleRAII
 public:
     /// Initialize a buffer with specified size, and memory props
     Result init(
-        const VulkanApi& api,
+        DeviceImpl* device,
         Size bufferSize,
         VkBufferUsageFlags usage,
         VkMemoryPropertyFlags reqMemoryProperties,
@@ -18,25 +19,31 @@ public:
         VkExternalMemoryHandleTypeFlagsKHR extMemHandleType = 0
     );
 
+    /// Initialize a buffer without memory, memory is bound by the owner.
+    Result initWithoutMemory(DeviceImpl* device, Size bufferSize, VkBufferUsageFlags usage);
+
+    /// Destroy the buffer and free its memory.
+    void reset();
+
+    /// Hand the buffer and its memory over to `objects` for deferred destruction.
+    void retire(RetiredObjects& objects);
+
     /// Returns true if has been initialized
     bool isInitialized() const { return m_api != nullptr; }
 
+    /// Returns a pointer to the buffer memory if it is host visible.
+    void* getMappedData() const { return m_allocation.mappedData; }
+
     VKBufferHandleRAII()
         : m_api(nullptr)
     {
     }
 
-    ~VKBufferHandleRAII()
-    {
-        if (m_api)
-        {
-            m_api->vkDestroyBuffer(m_api->m_device, m_buffer, nullptr);
-            m_api->vkFreeMemory(m_api->m_device, m_memory, nullptr);
-        }
-    }
+    ~VKBufferHandleRAII();
 
     VkBuffer m_buffer;
-    VkDeviceMemory m_memory;
+    MemoryAllocation m_allocation;
+    MemoryAllocator* m_allocator = nullptr;
     const VulkanApi* m_api;
 };
 
@@ -50,6 +57,12 @@ public:
     DeviceImpl* m_device;
     VKBufferHandleRAII m_buffer;
     VKBufferHandleRAII m_uploadBuffer;
+    /// State of the buffer after the last submitted command buffer.
+    BufferState m_queueState;
+
+    /// Recreate the buffer without memory, destroying the previous buffer and its views.
+    /// Used for transient buffers, which are bound to memory when their command buffer is recorded.
+    Result createUnboundBuffer();
 
     virtual SLANG_NO_THROW DeviceAddress SLANG_MCALL getDeviceAddress() override;
 
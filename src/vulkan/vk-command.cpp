@@ -15,6 +15,8 @@
 
 #include "core/static_vector.h"
 
+#include <algorithm>
+
 namespace rhi::vk {
 
 template<typename T>
@@ -29,34 +31,40 @@ public:
     DeviceImpl* m_device;
     VulkanApi& m_api;
 
-    VkCommandBuffer m_cmdBuffer;
-    DescriptorSetAllocator* m_descriptorSetAllocator;
-    BufferPool<DeviceImpl, BufferImpl>* m_constantBufferPool;
-    BufferPool<DeviceImpl, BufferImpl>* m_uploadBufferPool;
+    CommandQueueImpl* m_queue = nullptr;
+    VkCommandBuffer m_cmdBuffer = VK_NULL_HANDLE;
+    DescriptorSetAllocator* m_descriptorSetAllocator = nullptr;
+    BufferPool<DeviceImpl, BufferImpl>* m_constantBufferPool = nullptr;
+    BufferPool<DeviceImpl, BufferImpl>* m_uploadBufferPool = nullptr;
 
     std::unordered_map<IShaderObject*, BindableRootShaderObject> m_bindableRootObjects;
 
     StateTracking m_stateTracking;
 
-    short_vector<RefPtr<TextureViewImpl>> m_renderTargetViews;
-    short_vector<RefPtr<TextureViewImpl>> m_resolveTargetViews;
-    RefPtr<TextureViewImpl> m_depthStencilView;
+    /// Transient resources to initialize before executing a command (see `TransientResourcePool::getFirstUses`).
+    const std::unordered_map<const void*, std::vector<TransientResource*>>* m_transientFirstUses = nullptr;
+
+    // Objects are retained by the command list. Raw pointers avoid touching the (non-atomic)
+    // reference counts, as command lists can be recorded on worker threads.
+    short_vector<TextureViewImpl*> m_renderTargetViews;
+    short_vector<TextureViewImpl*> m_resolveTargetViews;
+    TextureViewImpl* m_depthStencilView = nullptr;
 
     bool m_renderPassActive = false;
     bool m_renderStateValid = false;
     RenderState m_renderState;
-    RefPtr<RenderPipelineImpl> m_renderPipeline;
+    RenderPipelineImpl* m_renderPipeline = nullptr;
 
     bool m_computePassActive = false;
     bool m_computeStateValid = false;
     ComputeState m_computeState;
-    RefPtr<ComputePipelineImpl> m_computePipeline;
+    ComputePipelineImpl* m_computePipeline = nullptr;
 
     bool m_rayTracingPassActive = false;
     bool m_rayTracingStateValid = false;
     RayTracingState m_rayTracingState;
-    RefPtr<RayTracingPipelineImpl> m_rayTracingPipeline;
-    RefPtr<ShaderTableImpl> m_shaderTable;
+    RayTracingPipelineImpl* m_rayTracingPipeline = nullptr;
+    ShaderTableImpl* m_shaderTable = nullptr;
 
     uint64_t m_rayGenTableAddr = 0;
     VkStridedDeviceAddressRegionKHR m_raygenSBT;
@@ -72,6 +80,26 @@ public:
 
     Result record(CommandBufferImpl* commandBuffer);
 
+    /// Compute the lifetimes of the transient resources used by a command list and bind their memory.
+    Result bindTransientResources(CommandList* commandList, TransientResourcePool& pool);
+
+    /// Discard the contents of transient resources before their first use.
+    void initTransientResources(const std::vector<TransientResource*>& resources);
+
+    /// Replay the commands in [begin, end) and transition untracked resources back to their default states.
+    void recordCommands(
+        CommandList* commandList,
+        const CommandList::CommandSlot* begin,
+        const CommandList::CommandSlot* end
+    );
+
+    /// Record a segment of a command list into its own command buffer.
+    Result recordSegment(
+        CommandList* commandList,
+        const CommandList::CommandSlot* begin,
+        const CommandList::CommandSlot* end
+    );
+
     void cmdCopyBuffer(const commands::CopyBuffer& cmd);
     void cmdCopyTexture(const commands::CopyTexture& cmd);
     void cmdCopyTextureToBuffer(const commands::CopyTextureToBuffer& cmd);
@@ -139,12 +167,266 @@ public:
     );
 };
 
+/// Minimum number of commands in a command list segment recorded on a worker thread.
+static const uint32_t kMinSegmentCommandCount = 256;
+
+static SubresourceRange getBarrierRange(const TextureBarrier& barrier)
+{
+    if (barrier.entireTexture)
+        return kEntireTexture;
+    return {barrier.mipLevel, barrier.mipLevelCount, barrier.arrayLayer, barrier.arrayLayerCount};
+}
+
+/// Split a command list into at most `maxSegmentCount` segments of similar command counts.
+/// Segments only start between passes, so no pass state is carried across segments.
+static void splitCommandList(
+    CommandList* commandList,
+    uint32_t maxSegmentCount,
+    short_vector<const CommandList::CommandSlot*>& outSegmentStarts
+)
+{
+    outSegmentStarts.push_back(commandList->getCommands());
+
+    uint32_t commandCount = 0;
+    for (const CommandList::CommandSlot* slot = commandList->getCommands(); slot; slot = slot->next)
+        commandCount++;
+    if (maxSegmentCount < 2 || commandCount < 2 * kMinSegmentCommandCount)
+        return;
+
+    uint32_t segmentCommandCount = std::max(kMinSegmentCommandCount, (commandCount + maxSegmentCount - 1) / maxSegmentCount);
+    uint32_t count = 0;
+    bool insidePass = false;
+    for (const CommandList::CommandSlot* slot = commandList->getCommands(); slot; slot = slot->next)
+    {
+        switch (slot->id)
+        {
+        case CommandID::BeginRenderPass:
+        case CommandID::BeginComputePass:
+        case CommandID::BeginRayTracingPass:
+            insidePass = true;
+            break;
+        case CommandID::EndRenderPass:
+        case CommandID::EndComputePass:
+        case CommandID::EndRayTracingPass:
+            insidePass = false;
+            break;
+        default:
+            break;
+        }
+        count++;
+        if (!insidePass && count >= segmentCommandCount && slot->next && outSegmentStarts.size() < maxSegmentCount)
+        {
+            outSegmentStarts.push_back(slot->next);
+            count = 0;
+        }
+    }
+}
+
+Result CommandRecorder::bindTransientResources(CommandList* commandList, TransientResourcePool& pool)
+{
+    // Lifetimes are tracked in steps: a whole pass or a single command outside of a pass.
+    uint32_t step = 0;
+    const CommandList::CommandSlot* stepBegin = nullptr;
+    bool insidePass = false;
+    auto use = [&](IResource* resource)
+    {
+        if (!resource)
+            return;
+        TransientResource* transient = pool.findResource(resource);
+        if (!transient)
+            return;
+        if (!transient->used)
+        {
+            transient->used = true;
+            transient->firstStep = step;
+            transient->firstCommand = stepBegin;
+        }
+        transient->lastStep = step;
+    };
+    auto useView = [&](ITextureView* view)
+    {
+        if (view)
+            use(checked_cast<TextureViewImpl*>(view)->m_texture.get());
+    };
+    std::vector<IResource*> resources;
+    auto useRootObject = [&](IShaderObject* rootObject)
+    {
+        if (!rootObject)
+            return;
+        resources.clear();
+        checked_cast<RootShaderObjectImpl*>(rootObject)->getResources(resources);
+        for (IResource* resource : resources)
+            use(resource);
+    };
+
+    for (const CommandList::CommandSlot* slot = commandList->getCommands(); slot; slot = slot->next)
+    {
+        if (!insidePass)
+            stepBegin = slot;
+
+        switch (slot->id)
+        {
+        case CommandID::CopyBuffer:
+        {
+            const auto& cmd = commandList->getCommand<commands::CopyBuffer>(slot);
+            use(cmd.dst);
+            use(cmd.src);
+            break;
+        }
+        case CommandID::CopyTexture:
+        {
+            const auto& cmd = commandList->getCommand<commands::CopyTexture>(slot);
+            use(cmd.dst);
+            use(cmd.src);
+            break;
+        }
+        case CommandID::CopyTextureToBuffer:
+        {
+            const auto& cmd = commandList->getCommand<commands::CopyTextureToBuffer>(slot);
+            use(cmd.dst);
+            use(cmd.src);
+            break;
+        }
+        case CommandID::ClearBuffer:
+            use(commandList->getCommand<commands::ClearBuffer>(slot).buffer);
+            break;
+        case CommandID::ClearTexture:
+            use(commandList->getCommand<commands::ClearTexture>(slot).texture);
+            break;
+        case CommandID::UploadTextureData:
+            use(commandList->getCommand<commands::UploadTextureData>(slot).dst);
+            break;
+        case CommandID::UploadBufferData:
+            use(commandList->getCommand<commands::UploadBufferData>(slot).dst);
+            break;
+        case CommandID::ResolveQuery:
+            use(commandList->getCommand<commands::ResolveQuery>(slot).buffer);
+            break;
+        case CommandID::BeginRenderPass:
+        {
+            const auto& cmd = commandList->getCommand<commands::BeginRenderPass>(slot);
+            for (GfxIndex i = 0; i < cmd.desc.colorAttachmentCount; i++)
+            {
+                useView(cmd.desc.colorAttachments[i].view);
+                useView(cmd.desc.colorAttachments[i].resolveTarget);
+            }
+            if (cmd.desc.depthStencilAttachment)
+                useView(cmd.desc.depthStencilAttachment->view);
+            insidePass = true;
+            break;
+        }
+        case CommandID::SetRenderState:
+        {
+            const auto& cmd = commandList->getCommand<commands::SetRenderState>(slot);
+            useRootObject(cmd.state.rootObject);
+            for (GfxIndex i = 0; i < cmd.state.vertexBufferCount; i++)
+                use(cmd.state.vertexBuffers[i].buffer);
+            use(cmd.state.indexBuffer.buffer);
+            break;
+        }
+        case CommandID::DrawIndirect:
+        {
+            const auto& cmd = commandList->getCommand<commands::DrawIndirect>(slot);
+            use(cmd.argBuffer);
+            use(cmd.countBuffer);
+            break;
+        }
+        case CommandID::DrawIndexedIndirect:
+        {
+            const auto& cmd = commandList->getCommand<commands::DrawIndexedIndirect>(slot);
+            use(cmd.argBuffer);
+            use(cmd.countBuffer);
+            break;
+        }
+        case CommandID::BeginComputePass:
+        case CommandID::BeginRayTracingPass:
+            insidePass = true;
+            break;
+        case CommandID::EndRenderPass:
+        case CommandID::EndComputePass:
+        case CommandID::EndRayTracingPass:
+            insidePass = false;
+            break;
+        case CommandID::SetComputeState:
+            useRootObject(commandList->getCommand<commands::SetComputeState>(slot).state.rootObject);
+            break;
+        case CommandID::DispatchComputeIndirect:
+            use(commandList->getCommand<commands::DispatchComputeIndirect>(slot).argBuffer);
+            break;
+        case CommandID::SetRayTracingState:
+            useRootObject(commandList->getCommand<commands::SetRayTracingState>(slot).state.rootObject);
+            break;
+        case CommandID::BuildAccelerationStructure:
+        {
+            const auto& cmd = commandList->getCommand<commands::BuildAccelerationStructure>(slot);
+            use(cmd.scratchBuffer.buffer);
+            if (!cmd.desc.inputs || cmd.desc.inputCount == 0)
+                break;
+            switch (*(AccelerationStructureBuildInputType*)cmd.desc.inputs)
+            {
+            case AccelerationStructureBuildInputType::Instances:
+            {
+                auto inputs = (const AccelerationStructureBuildInputInstances*)cmd.desc.inputs;
+                for (GfxIndex i = 0; i < cmd.desc.inputCount; i++)
+                    use(inputs[i].instanceBuffer.buffer);
+                break;
+            }
+            case AccelerationStructureBuildInputType::Triangles:
+            {
+                auto inputs = (const AccelerationStructureBuildInputTriangles*)cmd.desc.inputs;
+                for (GfxIndex i = 0; i < cmd.desc.inputCount; i++)
+                {
+                    for (GfxIndex j = 0; j < inputs[i].vertexBufferCount; j++)
+                        use(inputs[i].vertexBuffers[j].buffer);
+                    use(inputs[i].indexBuffer.buffer);
+                    use(inputs[i].preTransformBuffer.buffer);
+                }
+                break;
+            }
+            case AccelerationStructureBuildInputType::ProceduralPrimitives:
+            {
+                auto inputs = (const AccelerationStructureBuildInputProceduralPrimitives*)cmd.desc.inputs;
+                for (GfxIndex i = 0; i < cmd.desc.inputCount; i++)
+                {
+                    for (GfxIndex j = 0; j < inputs[i].aabbBufferCount; j++)
+                        use(inputs[i].aabbBuffers[j].buffer);
+                }
+                break;
+            }
+            }
+            break;
+        }
+        case CommandID::SerializeAccelerationStructure:
+            use(commandList->getCommand<commands::SerializeAccelerationStructure>(slot).dst.buffer);
+            break;
+        case CommandID::DeserializeAccelerationStructure:
+            use(commandList->getCommand<commands::DeserializeAccelerationStructure>(slot).src.buffer);
+            break;
+        case CommandID::SetBufferState:
+            use(commandList->getCommand<commands::SetBufferState>(slot).buffer);
+            break;
+        case CommandID::SetTextureState:
+            use(commandList->getCommand<commands::SetTextureState>(slot).texture);
+            break;
+        default:
+            break;
+        }
+
+        if (!insidePass)
+            step++;
+    }
+
+    return pool.bindMemory();
+}
+
 Result CommandRecorder::record(CommandBufferImpl* commandBuffer)
 {
+    m_queue = commandBuffer->m_queue;
     m_cmdBuffer = commandBuffer->m_commandBuffer;
     m_descriptorSetAllocator = &commandBuffer->m_descriptorSetAllocator;
     m_constantBufferPool = &commandBuffer->m_constantBufferPool;
     m_uploadBufferPool = &commandBuffer->m_uploadBufferPool;
+    m_stateTracking.setTrackAcrossCommandBuffers(true);
 
     VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
     beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
@@ -152,6 +434,13 @@ Result CommandRecorder::record(CommandBufferImpl* commandBuffer)
 
     CommandList* commandList = commandBuffer->m_commandList;
 
+    // Transient resources are bound to memory before any descriptors referencing them are written.
+    if (commandBuffer->m_transientResourcePool.hasResourcesInUse())
+    {
+        SLANG_RETURN_ON_FAIL(bindTransientResources(commandList, commandBuffer->m_transientResourcePool));
+        m_transientFirstUses = &commandBuffer->m_transientResourcePool.getFirstUses();
+    }
+
     // First, we setup all the root objects.
     for (const CommandList::CommandSlot* slot = commandList->getCommands(); slot; slot = slot->next)
     {
@@ -188,8 +477,113 @@ Result CommandRecorder::record(CommandBufferImpl* commandBuffer)
         }
     }
 
-    for (const CommandList::CommandSlot* slot = commandList->getCommands(); slot; slot = slot->next)
+    // Large command lists are split into segments, the first segment is recorded on this thread
+    // and the remaining ones on the worker threads.
+    ThreadPool* threadPool = m_device->m_recordingThreadPool.get();
+    short_vector<const CommandList::CommandSlot*> segmentStarts;
+    splitCommandList(commandList, threadPool ? threadPool->getThreadCount() + 1 : 1, segmentStarts);
+    uint32_t segmentCount = (uint32_t)segmentStarts.size();
+
+    if (segmentCount == 1)
+    {
+        recordCommands(commandList, commandList->getCommands(), nullptr);
+        // The queue resolves the pending barriers and tracks the final resource states on submit.
+        commandBuffer->m_stateTracking = std::move(m_stateTracking);
+        SLANG_VK_RETURN_ON_FAIL(m_api.vkEndCommandBuffer(m_cmdBuffer));
+        return SLANG_OK;
+    }
+
+    SLANG_RETURN_ON_FAIL(commandBuffer->allocateSegments(segmentCount - 1));
+    std::vector<std::unique_ptr<CommandRecorder>> recorders(segmentCount - 1);
+    std::vector<Result> results(segmentCount - 1, SLANG_OK);
+    std::vector<std::shared_ptr<ThreadPool::Task>> tasks(segmentCount - 1);
+    for (uint32_t i = 0; i < segmentCount - 1; i++)
+    {
+        auto recorder = std::make_unique<CommandRecorder>(m_device);
+        recorder->m_queue = m_queue;
+        recorder->m_cmdBuffer = commandBuffer->m_segments[i].commandBuffer;
+        recorder->m_bindableRootObjects = m_bindableRootObjects;
+        recorder->m_transientFirstUses = m_transientFirstUses;
+        recorder->m_stateTracking.setTrackAcrossCommandBuffers(true);
+        const CommandList::CommandSlot* begin = segmentStarts[i + 1];
+        const CommandList::CommandSlot* end = i + 2 < segmentCount ? segmentStarts[i + 2] : nullptr;
+        CommandRecorder* recorderPtr = recorder.get();
+        Result* result = &results[i];
+        tasks[i] = threadPool->submit([=]() { *result = recorderPtr->recordSegment(commandList, begin, end); });
+        recorders[i] = std::move(recorder);
+    }
+
+    recordCommands(commandList, segmentStarts[0], segmentStarts[1]);
+
+    for (uint32_t i = 0; i < segmentCount - 1; i++)
+        threadPool->wait(tasks[i].get());
+    for (uint32_t i = 0; i < segmentCount - 1; i++)
+        SLANG_RETURN_ON_FAIL(results[i]);
+
+    // Stitch the segments together. Replaying the first-use transitions of each segment on top of the
+    // final states of the previous segments yields the barriers needed between them. Transitions of
+    // resources not used by any previous segment stay pending and are resolved on submit.
+    StateTracking stateTracking;
+    stateTracking.setTrackAcrossCommandBuffers(true);
+    std::vector<TextureBarrier> ranges;
+    for (uint32_t i = 0; i < segmentCount; i++)
+    {
+        const StateTracking& segmentStates = i == 0 ? m_stateTracking : recorders[i - 1]->m_stateTracking;
+
+        for (const auto& barrier : segmentStates.getPendingBufferBarriers())
+            stateTracking.setBufferState(barrier.buffer, barrier.stateAfter);
+        for (const auto& barrier : segmentStates.getPendingTextureBarriers())
+            stateTracking.setTextureState(barrier.texture, getBarrierRange(barrier), barrier.stateAfter);
+
+        if (i > 0 && stateTracking.hasBarriers())
+        {
+            CommandBufferImpl::Segment& segment = commandBuffer->m_segments[i - 1];
+            SLANG_VK_RETURN_ON_FAIL(m_api.vkBeginCommandBuffer(segment.entryCommandBuffer, &beginInfo));
+            recordBarriers(*m_queue, segment.entryCommandBuffer, stateTracking);
+            SLANG_VK_RETURN_ON_FAIL(m_api.vkEndCommandBuffer(segment.entryCommandBuffer));
+            segment.hasEntryCommands = true;
+        }
+        stateTracking.clearBarriers();
+
+        // Advance to the final states of the segment, the transitions were recorded by the segment itself.
+        for (const auto& tracked : segmentStates.getBufferStates())
+        {
+            if (tracked.state.state != ResourceState::Undefined)
+                stateTracking.setBufferState(tracked.buffer, tracked.state.state);
+        }
+        for (const auto& tracked : segmentStates.getTextureStates())
+        {
+            ranges.clear();
+            StateTracking::getSubresourceRanges(tracked.texture, tracked.state, ranges);
+            for (const auto& range : ranges)
+            {
+                if (range.stateBefore != ResourceState::Undefined)
+                    stateTracking.setTextureState(tracked.texture, getBarrierRange(range), range.stateBefore);
+            }
+        }
+        stateTracking.clearBarriers();
+    }
+
+    commandBuffer->m_stateTracking = std::move(stateTracking);
+    SLANG_VK_RETURN_ON_FAIL(m_api.vkEndCommandBuffer(m_cmdBuffer));
+    return SLANG_OK;
+}
+
+void CommandRecorder::recordCommands(
+    CommandList* commandList,
+    const CommandList::CommandSlot* begin,
+    const CommandList::CommandSlot* end
+)
+{
+    for (const CommandList::CommandSlot* slot = begin; slot != end; slot = slot->next)
     {
+        if (m_transientFirstUses)
+        {
+            auto it = m_transientFirstUses->find(slot);
+            if (it != m_transientFirstUses->end())
+                initTransientResources(it->second);
+        }
+
 #define SLANG_RHI_COMMAND_EXECUTE_X(x)                                                                                 \
     case CommandID::x:                                                                                                 \
         cmd##x(commandList->getCommand<commands::x>(slot));                                                            \
@@ -203,13 +597,22 @@ Result CommandRecorder::record(CommandBufferImpl* commandBuffer)
 #undef SLANG_RHI_COMMAND_EXECUTE_X
     }
 
-    // Transition all resources back to their default states.
+    // Transition resources that are not tracked across command buffers back to their default states.
     m_stateTracking.requireDefaultStates();
     commitBarriers();
-    m_stateTracking.clear();
+}
 
+Result CommandRecorder::recordSegment(
+    CommandList* commandList,
+    const CommandList::CommandSlot* begin,
+    const CommandList::CommandSlot* end
+)
+{
+    VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    SLANG_VK_RETURN_ON_FAIL(m_api.vkBeginCommandBuffer(m_cmdBuffer, &beginInfo));
+    recordCommands(commandList, begin, end);
     SLANG_VK_RETURN_ON_FAIL(m_api.vkEndCommandBuffer(m_cmdBuffer));
-
     return SLANG_OK;
 }
 
@@ -815,6 +1218,8 @@ void CommandRecorder::cmdDispatchCompute(const commands::DispatchCompute& cmd)
     if (!m_computeStateValid)
         return;
 
+    commitBarriers();
+
     m_api.vkCmdDispatch(m_cmdBuffer, cmd.x, cmd.y, cmd.z);
 }
 
@@ -823,11 +1228,19 @@ void CommandRecorder::cmdDispatchComputeIndirect(const commands::DispatchCompute
     if (!m_computeStateValid)
         return;
 
+    // Vulkan has no count variant, count buffers are rejected when the command list is finished.
     auto argBuffer = checked_cast<BufferImpl*>(cmd.argBuffer);
     requireBufferState(argBuffer, ResourceState::IndirectArgument);
     commitBarriers();
 
-    m_api.vkCmdDispatchIndirect(m_cmdBuffer, argBuffer->m_buffer.m_buffer, cmd.offset);
+    for (GfxIndex i = 0; i < cmd.maxDispatchCount; i++)
+    {
+        m_api.vkCmdDispatchIndirect(
+            m_cmdBuffer,
+            argBuffer->m_buffer.m_buffer,
+            cmd.offset + i * sizeof(VkDispatchIndirectCommand)
+        );
+    }
 }
 
 void CommandRecorder::cmdBeginRayTracingPass(const commands::BeginRayTracingPass& cmd)
@@ -903,6 +1316,8 @@ void CommandRecorder::cmdDispatchRays(const commands::DispatchRays& cmd)
     if (!m_rayTracingStateValid)
         return;
 
+    commitBarriers();
+
     m_raygenSBT.deviceAddress = m_rayGenTableAddr + cmd.rayGenShaderIndex * m_raygenSBT.stride;
 
     m_api.vkCmdTraceRaysKHR(
@@ -1080,23 +1495,13 @@ struct BindingContextImpl : public BindingContext
 
         auto allocation = recorder->m_uploadBufferPool->allocate(size);
 
-        auto& api = recorder->m_device->m_api;
-
-        void* mappedData = nullptr;
-        if (api.vkMapMemory(
-                api.m_device,
-                allocation.resource->m_buffer.m_memory,
-                allocation.offset,
-                size,
-                0,
-                &mappedData
-            ) != VK_SUCCESS)
+        uint8_t* mappedData = (uint8_t*)allocation.resource->m_buffer.getMappedData();
+        if (!mappedData)
         {
             // TODO issue error message?
             return;
         }
-        memcpy((char*)mappedData, data, size);
-        api.vkUnmapMemory(api.m_device, allocation.resource->m_buffer.m_memory);
+        memcpy(mappedData + allocation.offset, data, size);
 
         // Copy from staging buffer to real buffer
         VkBufferCopy copyInfo = {};
@@ -1211,8 +1616,8 @@ Result CommandRecorder::prepareRootObject(RootShaderObjectImpl* rootObject, Root
 void CommandRecorder::bindRootObject(BindableRootShaderObject* bindable, VkPipelineBindPoint bindPoint)
 {
     // First, we transition all resources to the required states.
+    // The barriers are committed lazily by the next draw/dispatch command.
     bindable->rootObject->setResourceStates(m_stateTracking);
-    commitBarriers();
 
     // Then we set all push constants.
     for (const auto& pushConstant : bindable->pushConstants)
@@ -1253,118 +1658,501 @@ void CommandRecorder::requireTextureState(TextureImpl* texture, SubresourceRange
     m_stateTracking.setTextureState(texture, subresourceRange, state);
 }
 
-void CommandRecorder::commitBarriers()
+/// Returns true if a barrier from `state` to `state` is required to order accesses.
+static bool needsBarrierToSameState(ResourceState state)
 {
-    short_vector<VkBufferMemoryBarrier, 16> bufferBarriers;
-    short_vector<VkImageMemoryBarrier, 16> imageBarriers;
+    switch (state)
+    {
+    case ResourceState::UnorderedAccess:
+    case ResourceState::RenderTarget:
+    case ResourceState::DepthWrite:
+    case ResourceState::CopyDestination:
+    case ResourceState::ResolveDestination:
+    case ResourceState::AccelerationStructure:
+    case ResourceState::General:
+        return true;
+    default:
+        return false;
+    }
+}
 
-    VkPipelineStageFlags activeBeforeStageFlags = VkPipelineStageFlags(0);
-    VkPipelineStageFlags activeAfterStageFlags = VkPipelineStageFlags(0);
+static bool isSameSubresourceRange(const TextureBarrier& a, const TextureBarrier& b)
+{
+    return a.entireTexture == b.entireTexture &&
+           (a.entireTexture || (a.mipLevel == b.mipLevel && a.mipLevelCount == b.mipLevelCount &&
+                                a.arrayLayer == b.arrayLayer && a.arrayLayerCount == b.arrayLayerCount));
+}
 
-    auto submitBufferBarriers = [&]()
+static bool isOverlappingSubresourceRange(const TextureBarrier& a, const TextureBarrier& b)
+{
+    if (a.texture != b.texture)
+        return false;
+    if (a.entireTexture || b.entireTexture)
+        return true;
+    return a.mipLevel < b.mipLevel + b.mipLevelCount && b.mipLevel < a.mipLevel + a.mipLevelCount &&
+           a.arrayLayer < b.arrayLayer + b.arrayLayerCount && b.arrayLayer < a.arrayLayer + a.arrayLayerCount;
+}
+
+/// Merge the barriers of a batch.
+/// There are no commands between the barriers of a batch.
+/// Consecutive transitions of the same (sub)resource are merged into a single transition, and transitions
+/// of adjacent array layers with the same mip range and states are coalesced.
+static void mergeBarriers(
+    const StateTracking& stateTracking,
+    short_vector<BufferBarrier, 16>& outBufferBarriers,
+    short_vector<TextureBarrier, 16>& outTextureBarriers
+)
+{
+    // Group barriers by resource, keeping the order of barriers on the same resource.
+    short_vector<BufferBarrier, 16> bufferBarriers;
+    for (const auto& barrier : stateTracking.getBufferBarriers())
+        bufferBarriers.push_back(barrier);
+    std::stable_sort(
+        bufferBarriers.begin(),
+        bufferBarriers.end(),
+        [](const BufferBarrier& a, const BufferBarrier& b) { return a.buffer < b.buffer; }
+    );
+    for (const auto& barrier : bufferBarriers)
     {
-        m_api.vkCmdPipelineBarrier(
-            m_cmdBuffer,
-            activeBeforeStageFlags,
-            activeAfterStageFlags,
-            VkDependencyFlags(0),
-            0,
-            nullptr,
-            (uint32_t)bufferBarriers.size(),
-            bufferBarriers.data(),
-            0,
-            nullptr
-        );
-    };
+        if (!outBufferBarriers.empty() && outBufferBarriers.back().buffer == barrier.buffer)
+            outBufferBarriers.back().stateAfter = barrier.stateAfter;
+        else
+            outBufferBarriers.push_back(barrier);
+    }
 
-    auto submitImageBarriers = [&]()
+    short_vector<TextureBarrier, 16> textureBarriers;
+    for (const auto& barrier : stateTracking.getTextureBarriers())
+        textureBarriers.push_back(barrier);
+    std::stable_sort(
+        textureBarriers.begin(),
+        textureBarriers.end(),
+        [](const TextureBarrier& a, const TextureBarrier& b) { return a.texture < b.texture; }
+    );
+    for (const auto& barrier : textureBarriers)
     {
-        m_api.vkCmdPipelineBarrier(
-            m_cmdBuffer,
-            activeBeforeStageFlags,
-            activeAfterStageFlags,
+        if (!outTextureBarriers.empty() && outTextureBarriers.back().texture == barrier.texture)
+        {
+            TextureBarrier& last = outTextureBarriers.back();
+            if (isSameSubresourceRange(last, barrier) && last.stateAfter == barrier.stateBefore)
+            {
+                last.stateAfter = barrier.stateAfter;
+                continue;
+            }
+            if (!last.entireTexture && !barrier.entireTexture && last.stateBefore == barrier.stateBefore &&
+                last.stateAfter == barrier.stateAfter && last.mipLevel == barrier.mipLevel &&
+                last.mipLevelCount == barrier.mipLevelCount &&
+                last.arrayLayer + last.arrayLayerCount == barrier.arrayLayer)
+            {
+                last.arrayLayerCount += barrier.arrayLayerCount;
+                continue;
+            }
+        }
+        outTextureBarriers.push_back(barrier);
+    }
+
+    // Drop merged transitions that end up in the state they started in, unless they order writes.
+    auto isNoop = [](ResourceState before, ResourceState after)
+    { return before == after && !needsBarrierToSameState(after); };
+    size_t count = 0;
+    for (const auto& barrier : outBufferBarriers)
+        if (!isNoop(barrier.stateBefore, barrier.stateAfter))
+            outBufferBarriers[count++] = barrier;
+    outBufferBarriers.resize(count);
+    count = 0;
+    for (const auto& barrier : outTextureBarriers)
+        if (!isNoop(barrier.stateBefore, barrier.stateAfter))
+            outTextureBarriers[count++] = barrier;
+    outTextureBarriers.resize(count);
+}
+
+static VkImageSubresourceRange getBarrierSubresourceRange(const TextureBarrier& textureBarrier)
+{
+    TextureImpl* texture = checked_cast<TextureImpl*>(textureBarrier.texture);
+    VkImageSubresourceRange range = {};
+    range.aspectMask = getAspectMaskFromFormat(VulkanUtil::getVkFormat(texture->m_desc.format));
+    range.baseArrayLayer = textureBarrier.entireTexture ? 0 : textureBarrier.arrayLayer;
+    range.baseMipLevel = textureBarrier.entireTexture ? 0 : textureBarrier.mipLevel;
+    range.layerCount = textureBarrier.entireTexture ? VK_REMAINING_ARRAY_LAYERS : textureBarrier.arrayLayerCount;
+    range.levelCount = textureBarrier.entireTexture ? VK_REMAINING_MIP_LEVELS : textureBarrier.mipLevelCount;
+    return range;
+}
+
+/// Restrict a stage mask to the stages supported by the queue recording the barrier.
+/// Falls back to all commands if none of the stages are supported (e.g. a render target state on a compute queue).
+template<typename T>
+static T filterStages(T stages, T supportedStages, T allCommands)
+{
+    T filtered = stages & supportedStages;
+    return (filtered || !stages) ? filtered : allCommands;
+}
+
+static VkPipelineStageFlags2 getStages2(CommandQueueImpl& queue, ResourceState state, bool src)
+{
+    return filterStages<VkPipelineStageFlags2>(
+        calcPipelineStageFlags2(state, src),
+        queue.m_supportedStages2,
+        VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT
+    );
+}
+
+static VkPipelineStageFlags getStages(CommandQueueImpl& queue, ResourceState state, bool src)
+{
+    return filterStages<VkPipelineStageFlags>(
+        calcPipelineStageFlags(state, src),
+        queue.m_supportedStages,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
+    );
+}
+
+/// Record barriers with a single pipeline barrier command. With synchronization2, each barrier carries its own
+/// stage masks, otherwise the stage masks of all barriers are merged.
+static void recordBarrierBatch(
+    CommandQueueImpl& queue,
+    VkCommandBuffer cmdBuffer,
+    span<const BufferBarrier> bufferBarriers,
+    span<const TextureBarrier> textureBarriers
+)
+{
+    VulkanApi& api = queue.m_api;
+    if (bufferBarriers.empty() && textureBarriers.empty())
+        return;
+
+    if (api.m_extendedFeatures.synchronization2Features.synchronization2)
+    {
+        short_vector<VkBufferMemoryBarrier2, 16> vkBufferBarriers;
+        short_vector<VkImageMemoryBarrier2, 16> vkImageBarriers;
+
+        for (const auto& bufferBarrier : bufferBarriers)
+        {
+            BufferImpl* buffer = checked_cast<BufferImpl*>(bufferBarrier.buffer);
+            VkBufferMemoryBarrier2 barrier = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2};
+            barrier.srcStageMask = getStages2(queue, bufferBarrier.stateBefore, true);
+            barrier.srcAccessMask = calcAccessFlags2(bufferBarrier.stateBefore);
+            barrier.dstStageMask = getStages2(queue, bufferBarrier.stateAfter, false);
+            barrier.dstAccessMask = calcAccessFlags2(bufferBarrier.stateAfter);
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.buffer = buffer->m_buffer.m_buffer;
+            barrier.offset = 0;
+            barrier.size = buffer->m_desc.size;
+            vkBufferBarriers.push_back(barrier);
+        }
+
+        for (const auto& textureBarrier : textureBarriers)
+        {
+            TextureImpl* texture = checked_cast<TextureImpl*>(textureBarrier.texture);
+            VkImageMemoryBarrier2 barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2};
+            barrier.srcStageMask = getStages2(queue, textureBarrier.stateBefore, true);
+            barrier.srcAccessMask = calcAccessFlags2(textureBarrier.stateBefore);
+            barrier.dstStageMask = getStages2(queue, textureBarrier.stateAfter, false);
+            barrier.dstAccessMask = calcAccessFlags2(textureBarrier.stateAfter);
+            barrier.oldLayout = translateImageLayout(textureBarrier.stateBefore);
+            barrier.newLayout = translateImageLayout(textureBarrier.stateAfter);
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = texture->m_image;
+            barrier.subresourceRange = getBarrierSubresourceRange(textureBarrier);
+            vkImageBarriers.push_back(barrier);
+        }
+
+        VkDependencyInfo dependencyInfo = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+        dependencyInfo.bufferMemoryBarrierCount = (uint32_t)vkBufferBarriers.size();
+        dependencyInfo.pBufferMemoryBarriers = vkBufferBarriers.data();
+        dependencyInfo.imageMemoryBarrierCount = (uint32_t)vkImageBarriers.size();
+        dependencyInfo.pImageMemoryBarriers = vkImageBarriers.data();
+        api.vkCmdPipelineBarrier2(cmdBuffer, &dependencyInfo);
+    }
+    else
+    {
+        short_vector<VkBufferMemoryBarrier, 16> vkBufferBarriers;
+        short_vector<VkImageMemoryBarrier, 16> vkImageBarriers;
+        VkPipelineStageFlags srcStageFlags = VkPipelineStageFlags(0);
+        VkPipelineStageFlags dstStageFlags = VkPipelineStageFlags(0);
+
+        for (const auto& bufferBarrier : bufferBarriers)
+        {
+            BufferImpl* buffer = checked_cast<BufferImpl*>(bufferBarrier.buffer);
+            srcStageFlags |= getStages(queue, bufferBarrier.stateBefore, true);
+            dstStageFlags |= getStages(queue, bufferBarrier.stateAfter, false);
+
+            VkBufferMemoryBarrier barrier = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+            barrier.srcAccessMask = calcAccessFlags(bufferBarrier.stateBefore);
+            barrier.dstAccessMask = calcAccessFlags(bufferBarrier.stateAfter);
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.buffer = buffer->m_buffer.m_buffer;
+            barrier.offset = 0;
+            barrier.size = buffer->m_desc.size;
+            vkBufferBarriers.push_back(barrier);
+        }
+
+        for (const auto& textureBarrier : textureBarriers)
+        {
+            TextureImpl* texture = checked_cast<TextureImpl*>(textureBarrier.texture);
+            srcStageFlags |= getStages(queue, textureBarrier.stateBefore, true);
+            dstStageFlags |= getStages(queue, textureBarrier.stateAfter, false);
+
+            VkImageMemoryBarrier barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+            barrier.srcAccessMask = calcAccessFlags(textureBarrier.stateBefore);
+            barrier.dstAccessMask = calcAccessFlags(textureBarrier.stateAfter);
+            barrier.oldLayout = translateImageLayout(textureBarrier.stateBefore);
+            barrier.newLayout = translateImageLayout(textureBarrier.stateAfter);
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = texture->m_image;
+            barrier.subresourceRange = getBarrierSubresourceRange(textureBarrier);
+            vkImageBarriers.push_back(barrier);
+        }
+
+        api.vkCmdPipelineBarrier(
+            cmdBuffer,
+            srcStageFlags,
+            dstStageFlags,
             VkDependencyFlags(0),
             0,
             nullptr,
-            0,
-            nullptr,
-            (uint32_t)imageBarriers.size(),
-            imageBarriers.data()
+            (uint32_t)vkBufferBarriers.size(),
+            vkBufferBarriers.data(),
+            (uint32_t)vkImageBarriers.size(),
+            vkImageBarriers.data()
         );
-    };
+    }
+}
 
-    for (const auto& bufferBarrier : m_stateTracking.getBufferBarriers())
-    {
-        BufferImpl* buffer = checked_cast<BufferImpl*>(bufferBarrier.buffer);
+/// Record the barriers collected in `stateTracking` into `cmdBuffer` and clear them.
+/// The barriers of a pipeline barrier command are not ordered with respect to each other, so the batch is split
+/// into several commands where a texture barrier overlaps an earlier barrier of the same texture.
+static void recordBarriers(CommandQueueImpl& queue, VkCommandBuffer cmdBuffer, StateTracking& stateTracking)
+{
+    if (!stateTracking.hasBarriers())
+        return;
 
-        VkPipelineStageFlags beforeStageFlags = calcPipelineStageFlags(bufferBarrier.stateBefore, true);
-        VkPipelineStageFlags afterStageFlags = calcPipelineStageFlags(bufferBarrier.stateAfter, false);
+    short_vector<BufferBarrier, 16> bufferBarriers;
+    short_vector<TextureBarrier, 16> textureBarriers;
+    mergeBarriers(stateTracking, bufferBarriers, textureBarriers);
+    stateTracking.clearBarriers();
 
-        if ((beforeStageFlags != activeBeforeStageFlags || afterStageFlags != activeAfterStageFlags) &&
-            !bufferBarriers.empty())
+    span<const BufferBarrier> pendingBufferBarriers(bufferBarriers.data(), bufferBarriers.size());
+    size_t batchStart = 0;
+    for (size_t i = 0; i < textureBarriers.size(); i++)
+    {
+        for (size_t j = batchStart; j < i; j++)
         {
-            submitBufferBarriers();
-            bufferBarriers.clear();
+            if (isOverlappingSubresourceRange(textureBarriers[j], textureBarriers[i]))
+            {
+                recordBarrierBatch(
+                    queue,
+                    cmdBuffer,
+                    pendingBufferBarriers,
+                    span<const TextureBarrier>(textureBarriers.data() + batchStart, i - batchStart)
+                );
+                pendingBufferBarriers = {};
+                batchStart = i;
+                break;
+            }
         }
+    }
+    recordBarrierBatch(
+        queue,
+        cmdBuffer,
+        pendingBufferBarriers,
+        span<const TextureBarrier>(textureBarriers.data() + batchStart, textureBarriers.size() - batchStart)
+    );
+}
 
-        activeBeforeStageFlags = beforeStageFlags;
-        activeAfterStageFlags = afterStageFlags;
+/// Record one half of a queue family ownership transfer for texture subresource ranges.
+/// The release half is recorded on the queue currently owning the ranges, the acquire half on the queue
+/// taking ownership. Layouts are kept, the ranges stay in the states given by `stateBefore`.
+static void recordOwnershipBarriers(
+    CommandQueueImpl& queue,
+    VkCommandBuffer cmdBuffer,
+    const std::vector<TextureBarrier>& ranges,
+    uint32_t srcQueueFamilyIndex,
+    uint32_t dstQueueFamilyIndex
+)
+{
+    VulkanApi& api = queue.m_api;
+    bool release = queue.m_queueFamilyIndex == srcQueueFamilyIndex;
 
-        VkBufferMemoryBarrier barrier = {};
-        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-        barrier.srcAccessMask = calcAccessFlags(bufferBarrier.stateBefore);
-        barrier.dstAccessMask = calcAccessFlags(bufferBarrier.stateAfter);
-        barrier.buffer = buffer->m_buffer.m_buffer;
-        barrier.offset = 0;
-        barrier.size = buffer->m_desc.size;
+    if (api.m_extendedFeatures.synchronization2Features.synchronization2)
+    {
+        short_vector<VkImageMemoryBarrier2, 16> vkImageBarriers;
+        for (const auto& range : ranges)
+        {
+            TextureImpl* texture = checked_cast<TextureImpl*>(range.texture);
+            VkImageMemoryBarrier2 barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2};
+            if (release)
+            {
+                barrier.srcStageMask = getStages2(queue, range.stateBefore, true);
+                barrier.srcAccessMask = calcAccessFlags2(range.stateBefore);
+            }
+            else
+            {
+                barrier.dstStageMask = getStages2(queue, range.stateBefore, false);
+                barrier.dstAccessMask = calcAccessFlags2(range.stateBefore);
+            }
+            barrier.oldLayout = translateImageLayout(range.stateBefore);
+            barrier.newLayout = barrier.oldLayout;
+            barrier.srcQueueFamilyIndex = srcQueueFamilyIndex;
+            barrier.dstQueueFamilyIndex = dstQueueFamilyIndex;
+            barrier.image = texture->m_image;
+            barrier.subresourceRange = getBarrierSubresourceRange(range);
+            vkImageBarriers.push_back(barrier);
+        }
 
-        bufferBarriers.push_back(barrier);
+        VkDependencyInfo dependencyInfo = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+        dependencyInfo.imageMemoryBarrierCount = (uint32_t)vkImageBarriers.size();
+        dependencyInfo.pImageMemoryBarriers = vkImageBarriers.data();
+        api.vkCmdPipelineBarrier2(cmdBuffer, &dependencyInfo);
     }
-    if (!bufferBarriers.empty())
+    else
     {
-        submitBufferBarriers();
+        short_vector<VkImageMemoryBarrier, 16> vkImageBarriers;
+        VkPipelineStageFlags stageFlags = VkPipelineStageFlags(0);
+        for (const auto& range : ranges)
+        {
+            TextureImpl* texture = checked_cast<TextureImpl*>(range.texture);
+            stageFlags |= getStages(queue, range.stateBefore, release);
+
+            VkImageMemoryBarrier barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+            if (release)
+                barrier.srcAccessMask = calcAccessFlags(range.stateBefore);
+            else
+                barrier.dstAccessMask = calcAccessFlags(range.stateBefore);
+            barrier.oldLayout = translateImageLayout(range.stateBefore);
+            barrier.newLayout = barrier.oldLayout;
+            barrier.srcQueueFamilyIndex = srcQueueFamilyIndex;
+            barrier.dstQueueFamilyIndex = dstQueueFamilyIndex;
+            barrier.image = texture->m_image;
+            barrier.subresourceRange = getBarrierSubresourceRange(range);
+            vkImageBarriers.push_back(barrier);
+        }
+
+        api.vkCmdPipelineBarrier(
+            cmdBuffer,
+            release ? stageFlags : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            release ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : stageFlags,
+            VkDependencyFlags(0),
+            0,
+            nullptr,
+            0,
+            nullptr,
+            (uint32_t)vkImageBarriers.size(),
+            vkImageBarriers.data()
+        );
     }
+}
+
+void CommandRecorder::commitBarriers()
+{
+    recordBarriers(*m_queue, m_cmdBuffer, m_stateTracking);
+}
 
-    activeBeforeStageFlags = VkPipelineStageFlags(0);
-    activeAfterStageFlags = VkPipelineStageFlags(0);
+void CommandRecorder::initTransientResources(const std::vector<TransientResource*>& resources)
+{
+    commitBarriers();
 
-    for (const auto& textureBarrier : m_stateTracking.getTextureBarriers())
+    // Transient textures start in their default state with undefined contents. Resources placed in memory
+    // used by earlier resources also have to wait for all prior accesses to that memory.
+    bool aliased = false;
+    short_vector<TextureImpl*, 16> textures;
+    short_vector<ResourceState, 16> states;
+    for (TransientResource* resource : resources)
     {
-        TextureImpl* texture = checked_cast<TextureImpl*>(textureBarrier.texture);
+        aliased |= resource->aliased;
+        TextureImpl* texture = resource->texture;
+        if (!texture)
+            continue;
+        ResourceState state = texture->m_desc.defaultState != ResourceState::Undefined ? texture->m_desc.defaultState
+                                                                                        : ResourceState::General;
+        textures.push_back(texture);
+        states.push_back(state);
+        m_stateTracking.initTextureState(texture, {state, {}});
+    }
 
-        VkPipelineStageFlags beforeStageFlags = calcPipelineStageFlags(textureBarrier.stateBefore, true);
-        VkPipelineStageFlags afterStageFlags = calcPipelineStageFlags(textureBarrier.stateAfter, false);
+    if (!aliased && textures.empty())
+        return;
 
-        if ((beforeStageFlags != activeBeforeStageFlags || afterStageFlags != activeAfterStageFlags) &&
-            !imageBarriers.empty())
+    auto getSubresourceRange = [](TextureImpl* texture)
+    {
+        VkImageSubresourceRange range = {};
+        range.aspectMask = getAspectMaskFromFormat(texture->m_vkformat);
+        range.baseMipLevel = 0;
+        range.levelCount = VK_REMAINING_MIP_LEVELS;
+        range.baseArrayLayer = 0;
+        range.layerCount = VK_REMAINING_ARRAY_LAYERS;
+        return range;
+    };
+
+    if (m_api.m_extendedFeatures.synchronization2Features.synchronization2)
+    {
+        short_vector<VkImageMemoryBarrier2, 16> imageBarriers;
+        for (size_t i = 0; i < textures.size(); i++)
         {
-            submitImageBarriers();
-            imageBarriers.clear();
+            VkImageMemoryBarrier2 barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2};
+            // Wait for prior accesses to aliased memory before the layout transition.
+            barrier.srcStageMask = aliased ? VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT : VK_PIPELINE_STAGE_2_NONE;
+            barrier.srcAccessMask = aliased ? VK_ACCESS_2_MEMORY_WRITE_BIT : VK_ACCESS_2_NONE;
+            barrier.dstStageMask = getStages2(*m_queue, states[i], false);
+            barrier.dstAccessMask = calcAccessFlags2(states[i]);
+            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout = translateImageLayout(states[i]);
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = textures[i]->m_image;
+            barrier.subresourceRange = getSubresourceRange(textures[i]);
+            imageBarriers.push_back(barrier);
         }
 
-        activeBeforeStageFlags = beforeStageFlags;
-        activeAfterStageFlags = afterStageFlags;
-
-        VkImageMemoryBarrier barrier = {};
-        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        barrier.image = texture->m_image;
-        barrier.oldLayout = translateImageLayout(textureBarrier.stateBefore);
-        barrier.newLayout = translateImageLayout(textureBarrier.stateAfter);
-        barrier.subresourceRange.aspectMask = getAspectMaskFromFormat(VulkanUtil::getVkFormat(texture->m_desc.format));
-        barrier.subresourceRange.baseArrayLayer = textureBarrier.entireTexture ? 0 : textureBarrier.arrayLayer;
-        barrier.subresourceRange.baseMipLevel = textureBarrier.entireTexture ? 0 : textureBarrier.mipLevel;
-        barrier.subresourceRange.layerCount = textureBarrier.entireTexture ? VK_REMAINING_ARRAY_LAYERS : 1;
-        barrier.subresourceRange.levelCount = textureBarrier.entireTexture ? VK_REMAINING_MIP_LEVELS : 1;
-        barrier.srcAccessMask = calcAccessFlags(textureBarrier.stateBefore);
-        barrier.dstAccessMask = calcAccessFlags(textureBarrier.stateAfter);
-        imageBarriers.push_back(barrier);
+        VkMemoryBarrier2 memoryBarrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+        memoryBarrier.srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        memoryBarrier.srcAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT;
+        memoryBarrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        memoryBarrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+        VkDependencyInfo dependencyInfo = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+        dependencyInfo.memoryBarrierCount = aliased ? 1 : 0;
+        dependencyInfo.pMemoryBarriers = aliased ? &memoryBarrier : nullptr;
+        dependencyInfo.imageMemoryBarrierCount = (uint32_t)imageBarriers.size();
+        dependencyInfo.pImageMemoryBarriers = imageBarriers.data();
+        m_api.vkCmdPipelineBarrier2(m_cmdBuffer, &dependencyInfo);
     }
-    if (!imageBarriers.empty())
+    else
     {
-        submitImageBarriers();
-    }
+        VkPipelineStageFlags dstStageFlags = VkPipelineStageFlags(0);
+        short_vector<VkImageMemoryBarrier, 16> imageBarriers;
+        for (size_t i = 0; i < textures.size(); i++)
+        {
+            dstStageFlags |= getStages(*m_queue, states[i], false);
+
+            VkImageMemoryBarrier barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = calcAccessFlags(states[i]);
+            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout = translateImageLayout(states[i]);
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = textures[i]->m_image;
+            barrier.subresourceRange = getSubresourceRange(textures[i]);
+            imageBarriers.push_back(barrier);
+        }
 
-    m_stateTracking.clearBarriers();
+        VkMemoryBarrier memoryBarrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+        memoryBarrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+        memoryBarrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+        m_api.vkCmdPipelineBarrier(
+            m_cmdBuffer,
+            aliased ? VK_PIPELINE_STAGE_ALL_COMMANDS_BIT : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            (aliased || !dstStageFlags) ? VK_PIPELINE_STAGE_ALL_COMMANDS_BIT : dstStageFlags,
+            VkDependencyFlags(0),
+            aliased ? 1 : 0,
+            aliased ? &memoryBarrier : nullptr,
+            0,
+            nullptr,
+            (uint32_t)imageBarriers.size(),
+            imageBarriers.data()
+        );
+    }
 }
 
 void CommandRecorder::queryAccelerationStructureProperties(
@@ -1429,21 +2217,23 @@ void CommandRecorder::accelerationStructureBarrier(
         memBarriers[i].pNext = nullptr;
         memBarriers[i].dstAccessMask = translateAccelerationStructureAccessFlag(destAccess);
         memBarriers[i].srcAccessMask = translateAccelerationStructureAccessFlag(srcAccess);
-        memBarriers[i].srcQueueFamilyIndex = m_device->m_queueFamilyIndex;
-        memBarriers[i].dstQueueFamilyIndex = m_device->m_queueFamilyIndex;
+        memBarriers[i].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        memBarriers[i].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 
         auto asImpl = checked_cast<AccelerationStructureImpl*>(accelerationStructures[i]);
         memBarriers[i].buffer = asImpl->m_buffer->m_buffer.m_buffer;
         memBarriers[i].offset = 0;
         memBarriers[i].size = asImpl->m_buffer->m_desc.size;
     }
+    // Graphics stages are not supported on compute queues.
+    VkPipelineStageFlags dstStageFlags =
+        VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR | VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT |
+        VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR;
     m_device->m_api.vkCmdPipelineBarrier(
         m_cmdBuffer,
         VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-        VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR | VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT |
-            VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
-            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT |
-            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
+        dstStageFlags & m_queue->m_supportedStages,
         0,
         0,
         nullptr,
@@ -1466,6 +2256,7 @@ CommandQueueImpl::CommandQueueImpl(DeviceImpl* device, QueueType type)
 CommandQueueImpl::~CommandQueueImpl()
 {
     m_api.vkQueueWaitIdle(m_queue);
+    destroyRetiredObjects(UINT64_MAX);
     m_api.vkDestroySemaphore(m_api.m_device, m_semaphore, nullptr);
     m_api.vkDestroySemaphore(m_api.m_device, m_trackingSemaphore, nullptr);
 }
@@ -1475,6 +2266,57 @@ void CommandQueueImpl::init(VkQueue queue, uint32_t queueFamilyIndex)
     m_queue = queue;
     m_queueFamilyIndex = queueFamilyIndex;
 
+    // Dedicated compute and transfer queue families only support a subset of the pipeline stages.
+    switch (m_type)
+    {
+    case QueueType::Compute:
+        m_supportedStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT |
+                            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT |
+                            VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_HOST_BIT |
+                            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT | VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR |
+                            VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR;
+        m_supportedStages2 = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT |
+                             VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COPY_BIT |
+                             VK_PIPELINE_STAGE_2_CLEAR_BIT | VK_PIPELINE_STAGE_2_HOST_BIT |
+                             VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT | VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR |
+                             VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR;
+        break;
+    case QueueType::Transfer:
+        m_supportedStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT |
+                            VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_HOST_BIT |
+                            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        m_supportedStages2 = VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COPY_BIT |
+                             VK_PIPELINE_STAGE_2_CLEAR_BIT | VK_PIPELINE_STAGE_2_HOST_BIT |
+                             VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        break;
+    default:
+        break;
+    }
+
+    // Barriers must not use the stages of features that are not enabled on the device.
+    if (!m_api.m_deviceFeatures.tessellationShader)
+    {
+        m_supportedStages &=
+            ~(VK_PIPELINE_STAGE_TESSELLATION_CONTROL_SHADER_BIT | VK_PIPELINE_STAGE_TESSELLATION_EVALUATION_SHADER_BIT);
+        m_supportedStages2 &= ~(VK_PIPELINE_STAGE_2_TESSELLATION_CONTROL_SHADER_BIT |
+                                VK_PIPELINE_STAGE_2_TESSELLATION_EVALUATION_SHADER_BIT);
+    }
+    if (!m_api.m_deviceFeatures.geometryShader)
+    {
+        m_supportedStages &= ~VK_PIPELINE_STAGE_GEOMETRY_SHADER_BIT;
+        m_supportedStages2 &= ~VK_PIPELINE_STAGE_2_GEOMETRY_SHADER_BIT;
+    }
+    if (!m_device->hasFeature("ray-tracing-pipeline"))
+    {
+        m_supportedStages &= ~VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR;
+        m_supportedStages2 &= ~VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR;
+    }
+    if (!m_device->hasFeature("acceleration-structure"))
+    {
+        m_supportedStages &= ~VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR;
+        m_supportedStages2 &= ~VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR;
+    }
+
     {
         VkSemaphoreCreateInfo semaphoreCreateInfo = {VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
         m_api.vkCreateSemaphore(m_api.m_device, &semaphoreCreateInfo, nullptr, &m_semaphore);
@@ -1542,6 +2384,7 @@ void CommandQueueImpl::retireCommandBuffers()
             m_commandBuffersInFlight.push_back(commandBuffer);
         }
     }
+    destroyRetiredObjects(lastFinishedID);
 }
 
 uint64_t CommandQueueImpl::updateLastFinishedID()
@@ -1550,6 +2393,209 @@ uint64_t CommandQueueImpl::updateLastFinishedID()
     return m_lastFinishedID;
 }
 
+void CommandQueueImpl::retireObjects(const std::shared_ptr<RetiredObjects>& objects)
+{
+    // Objects can be released on any thread, so the cached finished ID is not updated here.
+    uint64_t lastFinishedID = 0;
+    m_api.vkGetSemaphoreCounterValue(m_api.m_device, m_trackingSemaphore, &lastFinishedID);
+    uint64_t lastSubmittedID = m_lastSubmittedID;
+    if (lastSubmittedID <= lastFinishedID)
+        return;
+    std::lock_guard<std::mutex> lock(m_retiredObjectsMutex);
+    m_retiredObjects.push_back({lastSubmittedID, objects});
+}
+
+void CommandQueueImpl::destroyRetiredObjects(uint64_t lastFinishedID)
+{
+    // Objects are destroyed outside of the lock, destroying them may retire further objects.
+    std::vector<std::shared_ptr<RetiredObjects>> finished;
+    {
+        std::lock_guard<std::mutex> lock(m_retiredObjectsMutex);
+        while (!m_retiredObjects.empty() && m_retiredObjects.front().first <= lastFinishedID)
+        {
+            finished.push_back(std::move(m_retiredObjects.front().second));
+            m_retiredObjects.pop_front();
+        }
+    }
+}
+
+bool CommandQueueImpl::resolveResourceStates(CommandBufferImpl* commandBuffer, std::vector<SemaphoreWait>& outWaits)
+{
+    const StateTracking& commandBufferStates = commandBuffer->m_stateTracking;
+
+    // Transition resources from their current states into the states expected by the command buffer.
+    StateTracking stateTracking;
+    for (const auto& barrier : commandBufferStates.getPendingBufferBarriers())
+    {
+        BufferImpl* buffer = checked_cast<BufferImpl*>(barrier.buffer);
+        stateTracking.initBufferState(buffer, buffer->m_queueState);
+        stateTracking.setBufferState(buffer, barrier.stateAfter);
+    }
+    for (const auto& barrier : commandBufferStates.getPendingTextureBarriers())
+    {
+        TextureImpl* texture = checked_cast<TextureImpl*>(barrier.texture);
+        stateTracking.initTextureState(texture, texture->m_queueState);
+        stateTracking.setTextureState(
+            texture,
+            barrier.entireTexture ? kEntireTexture
+                                  : SubresourceRange{
+                                        barrier.mipLevel,
+                                        barrier.mipLevelCount,
+                                        barrier.arrayLayer,
+                                        barrier.arrayLayerCount,
+                                    },
+            barrier.stateAfter
+        );
+    }
+
+    // Textures last used on another queue family need to be acquired before they are transitioned.
+    short_vector<TextureImpl*> foreignTextures;
+    for (const auto& tracked : commandBufferStates.getTextureStates())
+    {
+        TextureImpl* texture = checked_cast<TextureImpl*>(tracked.texture);
+        if (texture->m_ownerQueueFamilyIndex != m_queueFamilyIndex)
+            foreignTextures.push_back(texture);
+    }
+
+    bool needsEntryCommandBuffer = stateTracking.hasBarriers() || !foreignTextures.empty();
+    if (needsEntryCommandBuffer)
+    {
+        VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        m_api.vkBeginCommandBuffer(commandBuffer->m_entryCommandBuffer, &beginInfo);
+        acquireTextures(commandBuffer->m_entryCommandBuffer, foreignTextures.data(), foreignTextures.size(), outWaits);
+        recordBarriers(*this, commandBuffer->m_entryCommandBuffer, stateTracking);
+        m_api.vkEndCommandBuffer(commandBuffer->m_entryCommandBuffer);
+    }
+
+    // Resources are left in the final states of the command buffer.
+    for (const auto& tracked : commandBufferStates.getBufferStates())
+    {
+        if (tracked.buffer->m_keepDefaultState || tracked.state.state == ResourceState::Undefined)
+            continue;
+        checked_cast<BufferImpl*>(tracked.buffer)->m_queueState = tracked.state;
+    }
+    for (const auto& tracked : commandBufferStates.getTextureStates())
+    {
+        if (tracked.texture->m_keepDefaultState)
+            continue;
+        TextureImpl* texture = checked_cast<TextureImpl*>(tracked.texture);
+        StateTracking::mergeTextureState(texture, texture->m_queueState, tracked.state);
+    }
+
+    return needsEntryCommandBuffer;
+}
+
+void CommandQueueImpl::acquireTextures(
+    VkCommandBuffer commandBuffer,
+    TextureImpl* const* textures,
+    size_t textureCount,
+    std::vector<SemaphoreWait>& outWaits
+)
+{
+    // Gather the subresource ranges to transfer per owning queue.
+    // Undefined ranges have no contents to preserve and are not transferred.
+    short_vector<std::pair<CommandQueueImpl*, std::vector<TextureBarrier>>, 2> releases;
+    std::vector<TextureBarrier> ranges;
+    for (size_t i = 0; i < textureCount; i++)
+    {
+        TextureImpl* texture = textures[i];
+        if (texture->m_ownerQueueFamilyIndex == m_queueFamilyIndex)
+            continue;
+        CommandQueueImpl* owner = m_device->getQueueImplByFamily(texture->m_ownerQueueFamilyIndex);
+        texture->m_ownerQueueFamilyIndex = m_queueFamilyIndex;
+
+        ranges.clear();
+        StateTracking::getSubresourceRanges(texture, texture->m_queueState, ranges);
+        auto it = std::find_if(releases.begin(), releases.end(), [&](const auto& r) { return r.first == owner; });
+        if (it == releases.end())
+        {
+            releases.push_back({owner, {}});
+            it = releases.end() - 1;
+        }
+        for (const auto& range : ranges)
+        {
+            if (range.stateBefore != ResourceState::Undefined)
+                it->second.push_back(range);
+        }
+    }
+
+    for (const auto& release : releases)
+    {
+        if (release.second.empty())
+            continue;
+        CommandQueueImpl* owner = release.first;
+        uint64_t submissionID = owner->submitOwnershipRelease(release.second, m_queueFamilyIndex);
+        outWaits.push_back({owner->m_trackingSemaphore, submissionID});
+        recordOwnershipBarriers(*this, commandBuffer, release.second, owner->m_queueFamilyIndex, m_queueFamilyIndex);
+    }
+}
+
+uint64_t CommandQueueImpl::submitOwnershipRelease(
+    const std::vector<TextureBarrier>& ranges,
+    uint32_t dstQueueFamilyIndex
+)
+{
+    RefPtr<CommandBufferImpl> commandBuffer;
+    getOrCreateCommandBuffer(commandBuffer.writeRef());
+
+    VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    m_api.vkBeginCommandBuffer(commandBuffer->m_commandBuffer, &beginInfo);
+    recordOwnershipBarriers(*this, commandBuffer->m_commandBuffer, ranges, m_queueFamilyIndex, dstQueueFamilyIndex);
+    m_api.vkEndCommandBuffer(commandBuffer->m_commandBuffer);
+
+    commandBuffer->m_submissionID = ++m_lastSubmittedID;
+    m_commandBuffersInFlight.push_back(commandBuffer);
+
+    VkTimelineSemaphoreSubmitInfo timelineSubmitInfo = {VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO};
+    timelineSubmitInfo.signalSemaphoreValueCount = 1;
+    timelineSubmitInfo.pSignalSemaphoreValues = &m_lastSubmittedID;
+    VkSubmitInfo submitInfo = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
+    submitInfo.pNext = &timelineSubmitInfo;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer->m_commandBuffer;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &m_trackingSemaphore;
+    m_api.vkQueueSubmit(m_queue, 1, &submitInfo, VK_NULL_HANDLE);
+
+    return m_lastSubmittedID;
+}
+
+void CommandQueueImpl::restoreDefaultState(VkCommandBuffer commandBuffer, BufferImpl* buffer)
+{
+    StateTracking stateTracking;
+    stateTracking.initBufferState(buffer, buffer->m_queueState);
+    stateTracking.requireDefaultStates();
+    recordBarriers(*this, commandBuffer, stateTracking);
+    buffer->m_queueState = BufferState{buffer->m_desc.defaultState};
+}
+
+void CommandQueueImpl::restoreDefaultState(VkCommandBuffer commandBuffer, TextureImpl* texture)
+{
+    if (texture->m_ownerQueueFamilyIndex != m_queueFamilyIndex)
+    {
+        // The command buffer is not submitted through this queue, so wait for the release on the host.
+        std::lock_guard<std::mutex> lock(m_device->m_submitMutex);
+        std::vector<SemaphoreWait> waits;
+        acquireTextures(commandBuffer, &texture, 1, waits);
+        for (const auto& wait : waits)
+        {
+            VkSemaphoreWaitInfo waitInfo = {VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO};
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores = &wait.semaphore;
+            waitInfo.pValues = &wait.value;
+            m_api.vkWaitSemaphores(m_api.m_device, &waitInfo, UINT64_MAX);
+        }
+    }
+
+    StateTracking stateTracking;
+    stateTracking.initTextureState(texture, texture->m_queueState);
+    stateTracking.requireDefaultStates();
+    recordBarriers(*this, commandBuffer, stateTracking);
+    texture->m_queueState = TextureState{texture->m_desc.defaultState};
+}
+
 Result CommandQueueImpl::createCommandEncoder(ICommandEncoder** outEncoder)
 {
     RefPtr<CommandEncoderImpl> encoder = new CommandEncoderImpl(m_device, this);
@@ -1561,6 +2607,7 @@ Result CommandQueueImpl::createCommandEncoder(ICommandEncoder** outEncoder)
 Result CommandQueueImpl::waitOnHost()
 {
     auto& api = m_device->m_api;
+    std::lock_guard<std::mutex> lock(m_device->m_submitMutex);
     api.vkQueueWaitIdle(m_queue);
     retireCommandBuffers();
     return SLANG_OK;
@@ -1592,16 +2639,27 @@ void CommandQueueImpl::queueSubmitImpl(
     uint64_t valueToSignal
 )
 {
-    // Increment last submitted ID which is used to track command buffer completion.
-    ++m_lastSubmittedID;
+    // Resource states and queue family ownership are shared between all queues of the device.
+    std::lock_guard<std::mutex> lock(m_device->m_submitMutex);
 
+    // Resolving resource states may submit ownership releases on other queues.
+    std::vector<SemaphoreWait> ownershipWaits;
     short_vector<VkCommandBuffer> vkCommandBuffers;
     for (uint32_t i = 0; i < count; i++)
+    {
+        auto commandBuffer = checked_cast<CommandBufferImpl*>(commandBuffers[i]);
+        if (resolveResourceStates(commandBuffer, ownershipWaits))
+            vkCommandBuffers.push_back(commandBuffer->m_entryCommandBuffer);
+        commandBuffer->getSubmitCommandBuffers(vkCommandBuffers);
+    }
+
+    // Increment last submitted ID which is used to track command buffer completion.
+    ++m_lastSubmittedID;
+    for (uint32_t i = 0; i < count; i++)
     {
         auto commandBuffer = checked_cast<CommandBufferImpl*>(commandBuffers[i]);
         commandBuffer->m_submissionID = m_lastSubmittedID;
         m_commandBuffersInFlight.push_back(commandBuffer);
-        vkCommandBuffers.push_back(commandBuffer->m_commandBuffer);
     }
     static_vector<VkSemaphore, 3> signalSemaphores;
     static_vector<uint64_t, 3> signalValues;
@@ -1612,26 +2670,35 @@ void CommandQueueImpl::queueSubmitImpl(
 
     VkSubmitInfo submitInfo = {};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    VkPipelineStageFlags stageFlag[] = {VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT};
-    submitInfo.pWaitDstStageMask = stageFlag;
     submitInfo.commandBufferCount = (uint32_t)vkCommandBuffers.size();
     submitInfo.pCommandBuffers = vkCommandBuffers.data();
-    static_vector<VkSemaphore, 3> waitSemaphores;
-    static_vector<uint64_t, 3> waitValues;
+    short_vector<VkSemaphore> waitSemaphores;
+    short_vector<uint64_t> waitValues;
+    short_vector<VkPipelineStageFlags> waitStages;
     for (auto s : m_pendingWaitSemaphores)
     {
         if (s != VK_NULL_HANDLE)
         {
             waitSemaphores.push_back(s);
             waitValues.push_back(0);
+            waitStages.push_back(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
         }
     }
+    // Fences may be signaled by other queues, all commands of the submission have to wait for them.
     for (auto& fenceWait : m_pendingWaitFences)
     {
         waitSemaphores.push_back(fenceWait.fence->m_semaphore);
         waitValues.push_back(fenceWait.waitValue);
+        waitStages.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
     }
     m_pendingWaitFences.clear();
+    for (const auto& wait : ownershipWaits)
+    {
+        waitSemaphores.push_back(wait.semaphore);
+        waitValues.push_back(wait.value);
+        waitStages.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+    }
+    submitInfo.pWaitDstStageMask = waitStages.data();
     VkTimelineSemaphoreSubmitInfo timelineSubmitInfo = {VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO};
     if (fence)
     {
@@ -1679,6 +2746,10 @@ Result CommandQueueImpl::submit(
 {
     if (count == 0 && fence == nullptr)
         return SLANG_OK;
+    m_device->publishOptimizedRenderPipelines();
+    // Command buffers finished with finishAsync may still be recording.
+    for (GfxCount i = 0; i < count; i++)
+        SLANG_RETURN_ON_FAIL(checked_cast<CommandBufferImpl*>(commandBuffers[i])->waitForRecording());
     queueSubmitImpl(count, commandBuffers, fence, valueToSignal);
     return SLANG_OK;
 }
@@ -1704,6 +2775,7 @@ Result CommandEncoderImpl::init()
 {
     SLANG_RETURN_ON_FAIL(m_queue->getOrCreateCommandBuffer(m_commandBuffer.writeRef()));
     m_commandList = m_commandBuffer->m_commandList;
+    m_profiler = m_device->m_profiler.get();
     return SLANG_OK;
 }
 
@@ -1726,6 +2798,16 @@ void CommandEncoderImpl::uploadBufferData(IBuffer* dst, Offset offset, Size size
     CommandEncoder::uploadBufferData(dst, offset, size, data);
 }
 
+Result CommandEncoderImpl::createTransientBuffer(const BufferDesc& desc, IBuffer** outBuffer)
+{
+    return m_commandBuffer->m_transientResourcePool.createBuffer(desc, outBuffer);
+}
+
+Result CommandEncoderImpl::createTransientTexture(const TextureDesc& desc, ITexture** outTexture)
+{
+    return m_commandBuffer->m_transientResourcePool.createTexture(desc, outTexture);
+}
+
 Result CommandEncoderImpl::finish(ICommandBuffer** outCommandBuffer)
 {
     SLANG_RETURN_ON_FAIL(resolvePipelines(m_device));
@@ -1737,6 +2819,29 @@ Result CommandEncoderImpl::finish(ICommandBuffer** outCommandBuffer)
     return SLANG_OK;
 }
 
+Result CommandEncoderImpl::finishAsync(ICommandBuffer** outCommandBuffer)
+{
+    ThreadPool* threadPool = m_device->m_recordingThreadPool.get();
+    if (!threadPool)
+        return finish(outCommandBuffer);
+
+    // Pipelines are resolved on the calling thread, recording only reads the command list.
+    SLANG_RETURN_ON_FAIL(resolvePipelines(m_device));
+    DeviceImpl* device = m_device;
+    CommandBufferImpl* commandBuffer = m_commandBuffer;
+    commandBuffer->m_recordingTask = threadPool->submit(
+        [device, commandBuffer]()
+        {
+            CommandRecorder recorder(device);
+            commandBuffer->m_recordingResult = recorder.record(commandBuffer);
+        }
+    );
+    returnComPtr(outCommandBuffer, m_commandBuffer);
+    m_commandBuffer = nullptr;
+    m_commandList = nullptr;
+    return SLANG_OK;
+}
+
 Result CommandEncoderImpl::getNativeHandle(NativeHandle* outHandle)
 {
     *outHandle = {};
@@ -1753,9 +2858,17 @@ CommandBufferImpl::CommandBufferImpl(DeviceImpl* device, CommandQueueImpl* queue
 
 CommandBufferImpl::~CommandBufferImpl()
 {
+    waitForRecording();
+    for (const Segment& segment : m_segments)
+    {
+        // Destroying the pool frees its command buffers.
+        m_device->m_api.vkDestroyCommandPool(m_device->m_api.m_device, segment.commandPool, nullptr);
+    }
     m_device->m_api.vkFreeCommandBuffers(m_device->m_api.m_device, m_commandPool, 1, &m_commandBuffer);
+    m_device->m_api.vkFreeCommandBuffers(m_device->m_api.m_device, m_commandPool, 1, &m_entryCommandBuffer);
     m_device->m_api.vkDestroyCommandPool(m_device->m_api.m_device, m_commandPool, nullptr);
     m_descriptorSetAllocator.close();
+    m_transientResourcePool.close();
 }
 
 Result CommandBufferImpl::init()
@@ -1765,6 +2878,7 @@ Result CommandBufferImpl::init()
     m_constantBufferPool
         .init(m_device, MemoryType::DeviceLocal, 256, BufferUsage::ConstantBuffer | BufferUsage::CopyDestination);
     m_uploadBufferPool.init(m_device, MemoryType::Upload, 256, BufferUsage::CopySource);
+    m_transientResourcePool.init(m_device, m_queue->m_queueFamilyIndex);
 
     VkCommandPoolCreateInfo createInfo = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
     createInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
@@ -1780,6 +2894,9 @@ Result CommandBufferImpl::init()
     SLANG_VK_RETURN_ON_FAIL(
         m_device->m_api.vkAllocateCommandBuffers(m_device->m_api.m_device, &allocInfo, &m_commandBuffer)
     );
+    SLANG_VK_RETURN_ON_FAIL(
+        m_device->m_api.vkAllocateCommandBuffers(m_device->m_api.m_device, &allocInfo, &m_entryCommandBuffer)
+    );
 
     return SLANG_OK;
 }
@@ -1788,12 +2905,76 @@ Result CommandBufferImpl::reset()
 {
     m_commandList->reset();
     SLANG_VK_RETURN_ON_FAIL(m_device->m_api.vkResetCommandBuffer(m_commandBuffer, 0));
+    SLANG_VK_RETURN_ON_FAIL(m_device->m_api.vkResetCommandBuffer(m_entryCommandBuffer, 0));
     m_descriptorSetAllocator.reset();
+    m_stateTracking.clear();
     m_constantBufferPool.reset();
     m_uploadBufferPool.reset();
+    m_transientResourcePool.reset();
+    for (uint32_t i = 0; i < m_segmentCount; i++)
+    {
+        SLANG_VK_RETURN_ON_FAIL(
+            m_device->m_api.vkResetCommandPool(m_device->m_api.m_device, m_segments[i].commandPool, 0)
+        );
+        m_segments[i].hasEntryCommands = false;
+    }
+    m_segmentCount = 0;
+    m_recordingResult = SLANG_OK;
     return SLANG_OK;
 }
 
+Result CommandBufferImpl::allocateSegments(uint32_t count)
+{
+    while (m_segments.size() < count)
+    {
+        Segment segment;
+        VkCommandPoolCreateInfo createInfo = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+        createInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        createInfo.queueFamilyIndex = m_queue->m_queueFamilyIndex;
+        SLANG_VK_RETURN_ON_FAIL(
+            m_device->m_api.vkCreateCommandPool(m_device->m_api.m_device, &createInfo, nullptr, &segment.commandPool)
+        );
+
+        VkCommandBuffer commandBuffers[2];
+        VkCommandBufferAllocateInfo allocInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+        allocInfo.commandPool = segment.commandPool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 2;
+        VkResult result = m_device->m_api.vkAllocateCommandBuffers(m_device->m_api.m_device, &allocInfo, commandBuffers);
+        if (result != VK_SUCCESS)
+        {
+            m_device->m_api.vkDestroyCommandPool(m_device->m_api.m_device, segment.commandPool, nullptr);
+            SLANG_VK_RETURN_ON_FAIL(result);
+        }
+        segment.entryCommandBuffer = commandBuffers[0];
+        segment.commandBuffer = commandBuffers[1];
+        m_segments.push_back(segment);
+    }
+    m_segmentCount = count;
+    return SLANG_OK;
+}
+
+Result CommandBufferImpl::waitForRecording()
+{
+    if (m_recordingTask)
+    {
+        m_device->m_recordingThreadPool->wait(m_recordingTask.get());
+        m_recordingTask.reset();
+    }
+    return m_recordingResult;
+}
+
+void CommandBufferImpl::getSubmitCommandBuffers(short_vector<VkCommandBuffer>& outCommandBuffers)
+{
+    outCommandBuffers.push_back(m_commandBuffer);
+    for (uint32_t i = 0; i < m_segmentCount; i++)
+    {
+        if (m_segments[i].hasEntryCommands)
+            outCommandBuffers.push_back(m_segments[i].entryCommandBuffer);
+        outCommandBuffers.push_back(m_segments[i].commandBuffer);
+    }
+}
+
 Result CommandBufferImpl::getNativeHandle(NativeHandle* outHandle)
 {
     outHandle->type = NativeHandleType::VkCommandBuffer;
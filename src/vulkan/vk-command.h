@@ -2,10 +2,17 @@
 
 #include "vk-base.h"
 #include "vk-device.h"
+#include "vk-retired-objects.h"
+#include "vk-transient-resource-pool.h"
 #include "../buffer-pool.h"
+#include "../state-tracking.h"
+#include "core/short_vector.h"
+#include "core/thread-pool.h"
 
+#include <deque>
 #include <vector>
 #include <list>
+#include <memory>
 
 namespace rhi::vk {
 
@@ -15,6 +22,10 @@ public:
     VulkanApi& m_api;
     VkQueue m_queue;
     uint32_t m_queueFamilyIndex;
+    /// Pipeline stages supported by the queue family and the enabled device features, used to restrict barrier
+    /// stage masks.
+    VkPipelineStageFlags m_supportedStages = ~VkPipelineStageFlags(0);
+    VkPipelineStageFlags2 m_supportedStages2 = ~VkPipelineStageFlags2(0);
     struct FenceWaitInfo
     {
         RefPtr<FenceImpl> fence;
@@ -32,6 +43,10 @@ public:
     std::list<RefPtr<CommandBufferImpl>> m_commandBuffersPool;
     std::list<RefPtr<CommandBufferImpl>> m_commandBuffersInFlight;
 
+    /// Objects released while submissions were in flight, with the last submission ID at the time of release.
+    std::mutex m_retiredObjectsMutex;
+    std::deque<std::pair<uint64_t, std::shared_ptr<RetiredObjects>>> m_retiredObjects;
+
     CommandQueueImpl(DeviceImpl* device, QueueType type);
     ~CommandQueueImpl();
 
@@ -43,6 +58,44 @@ public:
     void retireCommandBuffers();
     uint64_t updateLastFinishedID();
 
+    /// Keep `objects` alive until the submissions currently in flight on this queue have finished.
+    void retireObjects(const std::shared_ptr<RetiredObjects>& objects);
+    /// Drop the retired objects whose submissions have finished.
+    void destroyRetiredObjects(uint64_t lastFinishedID);
+
+    struct SemaphoreWait
+    {
+        VkSemaphore semaphore;
+        uint64_t value;
+    };
+
+    /// Resolve the pending barriers of a command buffer against the current resource states.
+    /// Records the required barriers into the command buffer's entry command buffer and returns
+    /// true if it needs to be submitted. Updates the resource states to the command buffer's final states.
+    /// Textures owned by other queue families are released on their queues, the submission has to wait
+    /// for the semaphores added to `outWaits`.
+    bool resolveResourceStates(CommandBufferImpl* commandBuffer, std::vector<SemaphoreWait>& outWaits);
+
+    /// Transfer ownership of textures to this queue's family.
+    /// Submits release barriers on the owning queues and records the acquire barriers into `commandBuffer`.
+    /// Must be called with the device's submit mutex locked.
+    void acquireTextures(
+        VkCommandBuffer commandBuffer,
+        TextureImpl* const* textures,
+        size_t textureCount,
+        std::vector<SemaphoreWait>& outWaits
+    );
+
+    /// Submit a command buffer releasing ownership of texture subresources to another queue family.
+    /// `ranges` are the subresource ranges in their current states. Returns the submission ID.
+    uint64_t submitOwnershipRelease(const std::vector<TextureBarrier>& ranges, uint32_t dstQueueFamilyIndex);
+
+    /// Record barriers transitioning a resource from its current state back to its default state.
+    /// Used for work recorded outside of command buffers (e.g. blocking readbacks).
+    /// Textures owned by another queue family are transferred to this queue, waiting on the host for the release.
+    void restoreDefaultState(VkCommandBuffer commandBuffer, BufferImpl* buffer);
+    void restoreDefaultState(VkCommandBuffer commandBuffer, TextureImpl* texture);
+
     // ICommandQueue implementation
 
     virtual SLANG_NO_THROW Result SLANG_MCALL createCommandEncoder(ICommandEncoder** outEncoder) override;
@@ -86,8 +139,16 @@ public:
     virtual SLANG_NO_THROW void SLANG_MCALL
     uploadBufferData(IBuffer* dst, Offset offset, Size size, void* data) override;
 
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    createTransientBuffer(const BufferDesc& desc, IBuffer** outBuffer) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    createTransientTexture(const TextureDesc& desc, ITexture** outTexture) override;
+
     virtual SLANG_NO_THROW Result SLANG_MCALL finish(ICommandBuffer** outCommandBuffer) override;
 
+    virtual SLANG_NO_THROW Result SLANG_MCALL finishAsync(ICommandBuffer** outCommandBuffer) override;
+
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(NativeHandle* outHandle) override;
 };
 
@@ -98,10 +159,32 @@ public:
     CommandQueueImpl* m_queue;
     VkCommandPool m_commandPool = VK_NULL_HANDLE;
     VkCommandBuffer m_commandBuffer = VK_NULL_HANDLE;
+    /// Command buffer submitted ahead of `m_commandBuffer` to transition resources into their initial states.
+    VkCommandBuffer m_entryCommandBuffer = VK_NULL_HANDLE;
     DescriptorSetAllocator m_descriptorSetAllocator;
     BufferPool<DeviceImpl, BufferImpl> m_constantBufferPool;
     BufferPool<DeviceImpl, BufferImpl> m_uploadBufferPool;
     uint64_t m_submissionID = 0;
+    /// Resource states used by the recorded commands (pending barriers and final states).
+    StateTracking m_stateTracking;
+    /// Resources created with `createTransientBuffer`/`createTransientTexture`.
+    TransientResourcePool m_transientResourcePool;
+
+    /// Part of a large command list recorded on a worker thread, submitted after `m_commandBuffer`.
+    struct Segment
+    {
+        VkCommandPool commandPool = VK_NULL_HANDLE;
+        /// Transitions resources from the states left by the previous segments.
+        VkCommandBuffer entryCommandBuffer = VK_NULL_HANDLE;
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        bool hasEntryCommands = false;
+    };
+    std::vector<Segment> m_segments;
+    uint32_t m_segmentCount = 0;
+
+    /// Recording started by `CommandEncoderImpl::finishAsync`.
+    std::shared_ptr<ThreadPool::Task> m_recordingTask;
+    Result m_recordingResult = SLANG_OK;
 
     CommandBufferImpl(DeviceImpl* device, CommandQueueImpl* queue);
     ~CommandBufferImpl();
@@ -109,6 +192,15 @@ public:
     Result init();
     Result reset();
 
+    /// Make `count` segments available, each with its own command pool so they can be recorded concurrently.
+    Result allocateSegments(uint32_t count);
+
+    /// Wait for an asynchronous recording to finish and return its result.
+    Result waitForRecording();
+
+    /// Append the native command buffers to submit, excluding `m_entryCommandBuffer`.
+    void getSubmitCommandBuffers(short_vector<VkCommandBuffer>& outCommandBuffers);
+
     // ICommandBuffer implementation
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(NativeHandle* outHandle) override;
 };
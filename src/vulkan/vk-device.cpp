@@ -3,6 +3,7 @@
 #include "vk-command.h"
 #include "vk-fence.h"
 #include "vk-helper-functions.h"
+#include "vk-pipeline.h"
 #include "vk-query.h"
 #include "vk-sampler.h"
 #include "vk-shader-object-layout.h"
@@ -31,6 +32,11 @@ namespace rhi::vk {
 
 DeviceImpl::~DeviceImpl()
 {
+    // Finish any pending command buffer recordings and pipeline builds.
+    m_recordingThreadPool.reset();
+    m_pipelineCompileThreadPool.reset();
+    publishOptimizedRenderPipelines();
+
     // Check the device queue is valid else, we can't wait on it..
     if (m_deviceQueue.isValid())
     {
@@ -40,16 +46,29 @@ DeviceImpl::~DeviceImpl()
     m_shaderObjectLayoutCache = decltype(m_shaderObjectLayoutCache)();
     shaderCache.free();
     m_deviceObjectsWithPotentialBackReferences.clear();
+    m_readbackRing.close();
 
     if (m_api.vkDestroySampler)
     {
         m_api.vkDestroySampler(m_device, m_defaultSampler, nullptr);
     }
 
+    m_transferQueue.setNull();
+    m_computeQueue.setNull();
     m_queue.setNull();
     m_deviceQueue.destroy();
 
     descriptorSetAllocator.close();
+    m_layoutCache.close();
+    m_pipelineLibraryCache.close();
+    m_shaderModuleCache.close();
+
+    if (m_pipelineCache != VK_NULL_HANDLE)
+    {
+        m_api.vkDestroyPipelineCache(m_device, m_pipelineCache, nullptr);
+    }
+
+    m_memoryAllocator.close();
 
     if (m_device != VK_NULL_HANDLE)
     {
@@ -520,6 +539,10 @@ Result DeviceImpl::initVulkanInstanceAndDevice(const NativeHandle* handles, bool
         extendedFeatures.rayTracingValidationFeatures.pNext = deviceFeatures2.pNext;
         deviceFeatures2.pNext = &extendedFeatures.rayTracingValidationFeatures;
 
+        // synchronization2 features
+        extendedFeatures.synchronization2Features.pNext = deviceFeatures2.pNext;
+        deviceFeatures2.pNext = &extendedFeatures.synchronization2Features;
+
         // dynamic rendering features
         extendedFeatures.dynamicRenderingFeatures.pNext = deviceFeatures2.pNext;
         deviceFeatures2.pNext = &extendedFeatures.dynamicRenderingFeatures;
@@ -527,6 +550,18 @@ Result DeviceImpl::initVulkanInstanceAndDevice(const NativeHandle* handles, bool
         extendedFeatures.formats4444Features.pNext = deviceFeatures2.pNext;
         deviceFeatures2.pNext = &extendedFeatures.formats4444Features;
 
+        // pipeline creation cache control features
+        extendedFeatures.pipelineCreationCacheControlFeatures.pNext = deviceFeatures2.pNext;
+        deviceFeatures2.pNext = &extendedFeatures.pipelineCreationCacheControlFeatures;
+
+        // shader module identifier features
+        extendedFeatures.shaderModuleIdentifierFeatures.pNext = deviceFeatures2.pNext;
+        deviceFeatures2.pNext = &extendedFeatures.shaderModuleIdentifierFeatures;
+
+        // graphics pipeline library features
+        extendedFeatures.graphicsPipelineLibraryFeatures.pNext = deviceFeatures2.pNext;
+        deviceFeatures2.pNext = &extendedFeatures.graphicsPipelineLibraryFeatures;
+
         if (VK_MAKE_VERSION(majorVersion, minorVersion, 0) >= VK_API_VERSION_1_2)
         {
             extendedFeatures.vulkan12Features.pNext = deviceFeatures2.pNext;
@@ -602,6 +637,56 @@ Result DeviceImpl::initVulkanInstanceAndDevice(const NativeHandle* handles, bool
             "dynamic-rendering"
         );
 
+        // Barriers are only recorded with vkCmdPipelineBarrier2 if synchronization2 is enabled.
+        if (!addFeatureExtension(
+                extendedFeatures.synchronization2Features.synchronization2,
+                extendedFeatures.synchronization2Features,
+                VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME
+            ))
+        {
+            extendedFeatures.synchronization2Features.synchronization2 = VK_FALSE;
+        }
+
+        // Pipelines are only created from shader module identifiers if creation can fail on a pipeline cache
+        // miss (VK_PIPELINE_CREATE_FAIL_ON_PIPELINE_COMPILE_REQUIRED_BIT).
+        if (extendedFeatures.shaderModuleIdentifierFeatures.shaderModuleIdentifier &&
+            extendedFeatures.pipelineCreationCacheControlFeatures.pipelineCreationCacheControl &&
+            extensionNames.count(VK_EXT_SHADER_MODULE_IDENTIFIER_EXTENSION_NAME) &&
+            extensionNames.count(VK_EXT_PIPELINE_CREATION_CACHE_CONTROL_EXTENSION_NAME))
+        {
+            addFeatureExtension(
+                true,
+                extendedFeatures.pipelineCreationCacheControlFeatures,
+                VK_EXT_PIPELINE_CREATION_CACHE_CONTROL_EXTENSION_NAME
+            );
+            addFeatureExtension(
+                true,
+                extendedFeatures.shaderModuleIdentifierFeatures,
+                VK_EXT_SHADER_MODULE_IDENTIFIER_EXTENSION_NAME
+            );
+        }
+        else
+        {
+            extendedFeatures.shaderModuleIdentifierFeatures.shaderModuleIdentifier = VK_FALSE;
+        }
+
+        // Render pipelines are linked from pipeline libraries if graphics pipeline libraries are enabled.
+        if (extendedFeatures.graphicsPipelineLibraryFeatures.graphicsPipelineLibrary &&
+            extensionNames.count(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME) &&
+            extensionNames.count(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME))
+        {
+            deviceExtensions.push_back(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME);
+            addFeatureExtension(
+                true,
+                extendedFeatures.graphicsPipelineLibraryFeatures,
+                VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME
+            );
+        }
+        else
+        {
+            extendedFeatures.graphicsPipelineLibraryFeatures.graphicsPipelineLibrary = VK_FALSE;
+        }
+
         SIMPLE_EXTENSION_FEATURE(
             extendedFeatures.formats4444Features,
             formatA4R4G4B4,
@@ -936,6 +1021,29 @@ Result DeviceImpl::initVulkanInstanceAndDevice(const NativeHandle* handles, bool
 
     m_queueFamilyIndex = m_api.findQueue(VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
     SLANG_RHI_ASSERT(m_queueFamilyIndex >= 0);
+    m_queueFamilyIndices.clear();
+    m_queueFamilyIndices.push_back(m_queueFamilyIndex);
+    m_computeQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    m_transferQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+    // Use dedicated queue families for async compute and transfers if available.
+    // Queues can only be created when we create the device ourselves.
+    if (!handles[2])
+    {
+        int computeQueueFamilyIndex = m_api.findQueue(VK_QUEUE_COMPUTE_BIT, VK_QUEUE_GRAPHICS_BIT);
+        if (computeQueueFamilyIndex >= 0)
+        {
+            m_computeQueueFamilyIndex = computeQueueFamilyIndex;
+            m_queueFamilyIndices.push_back(m_computeQueueFamilyIndex);
+        }
+        int transferQueueFamilyIndex =
+            m_api.findQueue(VK_QUEUE_TRANSFER_BIT, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+        if (transferQueueFamilyIndex >= 0)
+        {
+            m_transferQueueFamilyIndex = transferQueueFamilyIndex;
+            m_queueFamilyIndices.push_back(m_transferQueueFamilyIndex);
+        }
+    }
 
 #if defined(SLANG_RHI_NV_AFTERMATH)
     VkDeviceDiagnosticsConfigCreateInfoNV aftermathInfo = {};
@@ -970,12 +1078,18 @@ Result DeviceImpl::initVulkanInstanceAndDevice(const NativeHandle* handles, bool
     if (!handles[2])
     {
         float queuePriority = 0.0f;
-        VkDeviceQueueCreateInfo queueCreateInfo = {VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
-        queueCreateInfo.queueFamilyIndex = m_queueFamilyIndex;
-        queueCreateInfo.queueCount = 1;
-        queueCreateInfo.pQueuePriorities = &queuePriority;
+        short_vector<VkDeviceQueueCreateInfo, 3> queueCreateInfos;
+        for (uint32_t queueFamilyIndex : m_queueFamilyIndices)
+        {
+            VkDeviceQueueCreateInfo queueCreateInfo = {VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
+            queueCreateInfo.queueFamilyIndex = queueFamilyIndex;
+            queueCreateInfo.queueCount = 1;
+            queueCreateInfo.pQueuePriorities = &queuePriority;
+            queueCreateInfos.push_back(queueCreateInfo);
+        }
 
-        deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
+        deviceCreateInfo.queueCreateInfoCount = (uint32_t)queueCreateInfos.size();
+        deviceCreateInfo.pQueueCreateInfos = queueCreateInfos.data();
 
         deviceCreateInfo.enabledExtensionCount = uint32_t(deviceExtensions.size());
         deviceCreateInfo.ppEnabledExtensionNames = deviceExtensions.data();
@@ -1028,6 +1142,20 @@ Result DeviceImpl::initialize(const DeviceDesc& desc)
     }
     SLANG_RETURN_ON_FAIL(initDeviceResult);
 
+    m_memoryAllocator.init(&m_api);
+    m_layoutCache.init(&m_api);
+    m_shaderModuleCache.init(this);
+    m_pipelineLibraryCache.init(this);
+    if (m_pipelineLibraryCache.isEnabled())
+        m_pipelineCompileThreadPool = std::make_unique<ThreadPool>(1);
+
+    {
+        VkPipelineCacheCreateInfo pipelineCacheCreateInfo = {VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+        SLANG_VK_RETURN_ON_FAIL(
+            m_api.vkCreatePipelineCache(m_device, &pipelineCacheCreateInfo, nullptr, &m_pipelineCache)
+        );
+    }
+
     {
         VkQueue queue;
         m_api.vkGetDeviceQueue(m_device, m_queueFamilyIndex, 0, &queue);
@@ -1066,12 +1194,35 @@ Result DeviceImpl::initialize(const DeviceDesc& desc)
     m_queue = new CommandQueueImpl(this, QueueType::Graphics);
     m_queue->init(m_deviceQueue.getQueue(), m_queueFamilyIndex);
 
+    if (m_computeQueueFamilyIndex != VK_QUEUE_FAMILY_IGNORED)
+    {
+        VkQueue queue;
+        m_api.vkGetDeviceQueue(m_device, m_computeQueueFamilyIndex, 0, &queue);
+        m_computeQueue = new CommandQueueImpl(this, QueueType::Compute);
+        m_computeQueue->init(queue, m_computeQueueFamilyIndex);
+    }
+    if (m_transferQueueFamilyIndex != VK_QUEUE_FAMILY_IGNORED)
+    {
+        VkQueue queue;
+        m_api.vkGetDeviceQueue(m_device, m_transferQueueFamilyIndex, 0, &queue);
+        m_transferQueue = new CommandQueueImpl(this, QueueType::Transfer);
+        m_transferQueue->init(queue, m_transferQueueFamilyIndex);
+    }
+
+    m_readbackRing.init(this);
+
+    if (desc.recordingThreadCount > 0)
+        m_recordingThreadPool = std::make_unique<ThreadPool>(desc.recordingThreadCount);
+
     return SLANG_OK;
 }
 
 void DeviceImpl::waitForGpu()
 {
     m_deviceQueue.flushAndWait();
+    if (m_queue)
+        m_queue->waitOnHost();
+    waitForAsyncQueues();
 }
 
 const DeviceInfo& DeviceImpl::getDeviceInfo() const
@@ -1081,13 +1232,62 @@ const DeviceInfo& DeviceImpl::getDeviceInfo() const
 
 Result DeviceImpl::getQueue(QueueType type, ICommandQueue** outQueue)
 {
-    if (type != QueueType::Graphics)
-        return SLANG_FAIL;
-    m_queue->establishStrongReferenceToDevice();
-    returnComPtr(outQueue, m_queue);
+    CommandQueueImpl* queue = getQueueImpl(type);
+    queue->establishStrongReferenceToDevice();
+    returnComPtr(outQueue, queue);
     return SLANG_OK;
 }
 
+CommandQueueImpl* DeviceImpl::getQueueImpl(QueueType type)
+{
+    switch (type)
+    {
+    case QueueType::Transfer:
+        if (m_transferQueue)
+            return m_transferQueue;
+        [[fallthrough]];
+    case QueueType::Compute:
+        if (m_computeQueue)
+            return m_computeQueue;
+        [[fallthrough]];
+    case QueueType::Graphics:
+    default:
+        return m_queue;
+    }
+}
+
+CommandQueueImpl* DeviceImpl::getQueueImplByFamily(uint32_t queueFamilyIndex)
+{
+    if (m_computeQueue && queueFamilyIndex == m_computeQueueFamilyIndex)
+        return m_computeQueue;
+    if (m_transferQueue && queueFamilyIndex == m_transferQueueFamilyIndex)
+        return m_transferQueue;
+    return m_queue;
+}
+
+void DeviceImpl::waitForAsyncQueues()
+{
+    if (m_computeQueue)
+        m_computeQueue->waitOnHost();
+    if (m_transferQueue)
+        m_transferQueue->waitOnHost();
+}
+
+void DeviceImpl::retireObjects(RetiredObjects&& objects)
+{
+    if (objects.isEmpty())
+        return;
+    // Each queue with submissions in flight keeps a reference, the objects are destroyed when the last
+    // queue drops it (or right here if no queue took one).
+    auto retired = std::make_shared<RetiredObjects>(std::move(objects));
+    CommandQueueImpl* queues[] = {m_queue, m_computeQueue, m_transferQueue};
+    for (CommandQueueImpl* queue : queues)
+    {
+        if (queue)
+            queue->retireObjects(retired);
+    }
+}
+
 Result DeviceImpl::readTexture(ITexture* texture, ISlangBlob** outBlob, Size* outRowPitch, Size* outPixelSize)
 {
     TextureImpl* textureImpl = checked_cast<TextureImpl*>(texture);
@@ -1121,15 +1321,21 @@ Result DeviceImpl::readTexture(ITexture* texture, ISlangBlob** outBlob, Size* ou
 
     VKBufferHandleRAII staging;
     SLANG_RETURN_ON_FAIL(staging.init(
-        m_api,
+        this,
         bufferSize,
         VK_BUFFER_USAGE_TRANSFER_DST_BIT,
         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
     ));
 
+    // Work submitted to the dedicated queues is not ordered with the device queue.
+    waitForAsyncQueues();
+
     VkCommandBuffer commandBuffer = m_deviceQueue.getCommandBuffer();
     VkImage srcImage = textureImpl->m_image;
 
+    // The texture may have been left in a different state by previously submitted command buffers.
+    m_queue->restoreDefaultState(commandBuffer, textureImpl);
+
     VkImageMemoryBarrier barrier = {};
     barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     barrier.image = srcImage;
@@ -1212,11 +1418,7 @@ Result DeviceImpl::readTexture(ITexture* texture, ISlangBlob** outBlob, Size* ou
     auto blob = OwnedBlob::create(bufferSize);
 
     // Write out the data from the buffer
-    void* mappedData = nullptr;
-    SLANG_RETURN_ON_FAIL(m_api.vkMapMemory(m_device, staging.m_memory, 0, bufferSize, 0, &mappedData));
-
-    ::memcpy((void*)blob->getBufferPointer(), mappedData, bufferSize);
-    m_api.vkUnmapMemory(m_device, staging.m_memory);
+    ::memcpy((void*)blob->getBufferPointer(), staging.getMappedData(), bufferSize);
 
     *outPixelSize = pixelSize;
     *outRowPitch = rowPitch;
@@ -1233,15 +1435,21 @@ Result DeviceImpl::readBuffer(IBuffer* inBuffer, Offset offset, Size size, ISlan
     VKBufferHandleRAII staging;
 
     SLANG_RETURN_ON_FAIL(staging.init(
-        m_api,
+        this,
         size,
         VK_BUFFER_USAGE_TRANSFER_DST_BIT,
         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
     ));
 
+    // Work submitted to the dedicated queues is not ordered with the device queue.
+    waitForAsyncQueues();
+
     // Copy from real buffer to staging buffer
     VkCommandBuffer commandBuffer = m_deviceQueue.getCommandBuffer();
 
+    // The buffer may have been left in a different state by previously submitted command buffers.
+    m_queue->restoreDefaultState(commandBuffer, buffer);
+
     VkBufferMemoryBarrier barrier = {};
     barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
     barrier.srcAccessMask = calcAccessFlags(buffer->m_desc.defaultState);
@@ -1292,11 +1500,7 @@ Result DeviceImpl::readBuffer(IBuffer* inBuffer, Offset offset, Size size, ISlan
     auto blob = OwnedBlob::create(size);
 
     // Write out the data from the buffer
-    void* mappedData = nullptr;
-    SLANG_RETURN_ON_FAIL(m_api.vkMapMemory(m_device, staging.m_memory, 0, size, 0, &mappedData));
-
-    ::memcpy((void*)blob->getBufferPointer(), mappedData, size);
-    m_api.vkUnmapMemory(m_device, staging.m_memory);
+    ::memcpy((void*)blob->getBufferPointer(), staging.getMappedData(), size);
 
     returnComPtr(outBlob, blob);
     return SLANG_OK;
@@ -1393,12 +1597,7 @@ void DeviceImpl::_transitionImageLayout(
 
 uint32_t DeviceImpl::getQueueFamilyIndex(QueueType queueType)
 {
-    switch (queueType)
-    {
-    case QueueType::Graphics:
-    default:
-        return m_queueFamilyIndex;
-    }
+    return getQueueImpl(queueType)->m_queueFamilyIndex;
 }
 
 void DeviceImpl::_transitionImageLayout(
@@ -1497,6 +1696,16 @@ Result DeviceImpl::getTextureAllocationInfo(const TextureDesc& descIn, Size* out
     return SLANG_OK;
 }
 
+Result DeviceImpl::getMemoryStats(MemoryStats* outStats)
+{
+    m_memoryAllocator.getStats(m_memoryHeapStats, m_memoryBlockStats);
+    outStats->heaps = m_memoryHeapStats.data();
+    outStats->heapCount = GfxCount(m_memoryHeapStats.size());
+    outStats->blocks = m_memoryBlockStats.data();
+    outStats->blockCount = GfxCount(m_memoryBlockStats.size());
+    return SLANG_OK;
+}
+
 Result DeviceImpl::getTextureRowAlignment(Size* outAlignment)
 {
     *outAlignment = 1;
@@ -2,10 +2,20 @@
 
 #include "vk-base.h"
 #include "vk-command.h"
+#include "vk-layout-cache.h"
+#include "vk-pipeline-library.h"
+#include "vk-readback.h"
+#include "vk-retired-objects.h"
+#include "vk-shader-module-cache.h"
 
+#include "core/short_vector.h"
 #include "core/stable_vector.h"
+#include "core/thread-pool.h"
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace rhi::vk {
 
@@ -66,6 +76,13 @@ public:
     virtual SLANG_NO_THROW Result SLANG_MCALL
     readBuffer(IBuffer* buffer, Offset offset, Size size, ISlangBlob** outBlob) override;
 
+    virtual SLANG_NO_THROW Result SLANG_MCALL readTextureAsync(ITexture* texture, IReadback** outReadback) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    readBufferAsync(IBuffer* buffer, Offset offset, Size size, IReadback** outReadback) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL getMemoryStats(MemoryStats* outStats) override;
+
     virtual SLANG_NO_THROW Result SLANG_MCALL getAccelerationStructureSizes(
         const AccelerationStructureBuildDesc& desc,
         AccelerationStructureSizes* outSizes
@@ -130,6 +147,22 @@ public:
 
     uint32_t getQueueFamilyIndex(QueueType queueType);
 
+    /// Get the queue used for a queue type, falling back to the graphics queue if there is no dedicated queue.
+    CommandQueueImpl* getQueueImpl(QueueType type);
+    CommandQueueImpl* getQueueImplByFamily(uint32_t queueFamilyIndex);
+    /// Wait for the dedicated compute and transfer queues to become idle.
+    void waitForAsyncQueues();
+
+    /// Link an optimized pipeline from the libraries of `pipeline` in the background.
+    /// The optimized pipeline is swapped in by `publishOptimizedRenderPipelines` once it is built.
+    void optimizeRenderPipeline(RenderPipelineImpl* pipeline, const RenderPipelineLibraries& libraries);
+    /// Swap in the optimized pipelines that have finished building.
+    void publishOptimizedRenderPipelines();
+
+    /// Destroy objects once all submissions made before this call have finished executing.
+    /// Objects are destroyed immediately if no queue has submissions in flight.
+    void retireObjects(RetiredObjects&& objects);
+
 public:
     // DeviceImpl members.
 
@@ -146,11 +179,54 @@ public:
     VulkanDeviceQueue m_deviceQueue;
     uint32_t m_queueFamilyIndex;
     RefPtr<CommandQueueImpl> m_queue;
+    /// Dedicated async compute/transfer queues (null if the device has no such queue family).
+    uint32_t m_computeQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    uint32_t m_transferQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    RefPtr<CommandQueueImpl> m_computeQueue;
+    RefPtr<CommandQueueImpl> m_transferQueue;
+    /// Queue families of all created queues. Buffers are shared concurrently between them.
+    short_vector<uint32_t, 3> m_queueFamilyIndices;
+    /// Serializes submissions across queues, which may record ownership transfers on each other.
+    std::mutex m_submitMutex;
 
     DeviceDesc m_desc;
 
     DescriptorSetAllocator descriptorSetAllocator;
 
+    /// Descriptor set layouts and pipeline layouts shared by all shader object layouts.
+    LayoutCache m_layoutCache;
+
+    /// Shader modules shared by all programs.
+    ShaderModuleCache m_shaderModuleCache;
+
+    /// Pipeline cache used for creating all pipelines.
+    VkPipelineCache m_pipelineCache = VK_NULL_HANDLE;
+
+    /// Graphics pipeline libraries render pipelines are linked from (if VK_EXT_graphics_pipeline_library is enabled).
+    PipelineLibraryCache m_pipelineLibraryCache;
+    /// Worker thread building optimized render pipelines (null if pipeline libraries are not enabled).
+    std::unique_ptr<ThreadPool> m_pipelineCompileThreadPool;
+    /// Render pipeline waiting for its optimized pipeline. The pipeline is only referenced here, the worker thread
+    /// never touches its reference count and only writes the optimized pipeline.
+    struct PendingRenderPipelineOptimization
+    {
+        RefPtr<RenderPipelineImpl> pipeline;
+        std::shared_ptr<ThreadPool::Task> task;
+        std::shared_ptr<VkPipeline> optimizedPipeline;
+    };
+    std::mutex m_pendingRenderPipelineOptimizationsMutex;
+    std::vector<PendingRenderPipelineOptimization> m_pendingRenderPipelineOptimizations;
+
+    MemoryAllocator m_memoryAllocator;
+    // Storage of the statistics returned by getMemoryStats.
+    std::vector<MemoryHeapStats> m_memoryHeapStats;
+    std::vector<MemoryBlockStats> m_memoryBlockStats;
+
+    ReadbackRing m_readbackRing;
+
+    /// Worker threads recording command buffers (null if DeviceDesc::recordingThreadCount is 0).
+    std::unique_ptr<ThreadPool> m_recordingThreadPool;
+
     // A list to hold objects that may have a strong back reference to the device
     // instance. Because of the pipeline cache in `Device`, there could be a reference
     // cycle among `DeviceImpl`->`PipelineImpl`->`ShaderProgramImpl`->`DeviceImpl`.
@@ -189,6 +189,102 @@ VkPipelineStageFlagBits calcPipelineStageFlags(ResourceState state, bool src)
     }
 }
 
+static const VkPipelineStageFlags2 kAllShaderStages2 =
+    VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_TESSELLATION_CONTROL_SHADER_BIT |
+    VK_PIPELINE_STAGE_2_TESSELLATION_EVALUATION_SHADER_BIT | VK_PIPELINE_STAGE_2_GEOMETRY_SHADER_BIT |
+    VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT |
+    VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR;
+
+VkAccessFlags2 calcAccessFlags2(ResourceState state)
+{
+    switch (state)
+    {
+    case ResourceState::Undefined:
+    case ResourceState::Present:
+        return VK_ACCESS_2_NONE;
+    case ResourceState::VertexBuffer:
+        return VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT;
+    case ResourceState::ConstantBuffer:
+        return VK_ACCESS_2_UNIFORM_READ_BIT;
+    case ResourceState::IndexBuffer:
+        return VK_ACCESS_2_INDEX_READ_BIT;
+    case ResourceState::RenderTarget:
+        return VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+    case ResourceState::ShaderResource:
+        return VK_ACCESS_2_SHADER_SAMPLED_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+    case ResourceState::UnorderedAccess:
+        return VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    case ResourceState::DepthRead:
+        return VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+    case ResourceState::DepthWrite:
+        return VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    case ResourceState::IndirectArgument:
+        return VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT;
+    case ResourceState::CopyDestination:
+        return VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    case ResourceState::CopySource:
+        return VK_ACCESS_2_TRANSFER_READ_BIT;
+    case ResourceState::ResolveDestination:
+        return VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+    case ResourceState::ResolveSource:
+        return VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT;
+    case ResourceState::AccelerationStructure:
+        return VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+    case ResourceState::AccelerationStructureBuildInput:
+        return VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_2_SHADER_READ_BIT;
+    case ResourceState::General:
+        return VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+    default:
+        SLANG_RHI_ASSERT_FAILURE("Unsupported");
+        return VK_ACCESS_2_NONE;
+    }
+}
+
+VkPipelineStageFlags2 calcPipelineStageFlags2(ResourceState state, bool src)
+{
+    switch (state)
+    {
+    case ResourceState::Undefined:
+        SLANG_RHI_ASSERT(src);
+        return VK_PIPELINE_STAGE_2_NONE;
+    case ResourceState::VertexBuffer:
+        return VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT;
+    case ResourceState::IndexBuffer:
+        return VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT;
+    case ResourceState::ConstantBuffer:
+    case ResourceState::ShaderResource:
+    case ResourceState::UnorderedAccess:
+        return kAllShaderStages2;
+    case ResourceState::RenderTarget:
+        return VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+    case ResourceState::DepthRead:
+    case ResourceState::DepthWrite:
+        return VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+    case ResourceState::IndirectArgument:
+        return VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
+    case ResourceState::CopySource:
+        return VK_PIPELINE_STAGE_2_COPY_BIT;
+    case ResourceState::CopyDestination:
+        // Also covers clears and buffer fills/updates.
+        return VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT;
+    case ResourceState::ResolveSource:
+    case ResourceState::ResolveDestination:
+        // Resolves happen either in a render pass or with vkCmdResolveImage.
+        return VK_PIPELINE_STAGE_2_RESOLVE_BIT | VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+    case ResourceState::Present:
+        return src ? VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT : VK_PIPELINE_STAGE_2_NONE;
+    case ResourceState::General:
+        return VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    case ResourceState::AccelerationStructure:
+        return kAllShaderStages2 | VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR;
+    case ResourceState::AccelerationStructureBuildInput:
+        return VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR;
+    default:
+        SLANG_RHI_ASSERT_FAILURE("Unsupported");
+        return VK_PIPELINE_STAGE_2_NONE;
+    }
+}
+
 VkAccessFlags translateAccelerationStructureAccessFlag(AccessFlag access)
 {
     VkAccessFlags result = 0;
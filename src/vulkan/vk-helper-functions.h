@@ -124,6 +124,8 @@ VkImageLayout translateImageLayout(ResourceState state);
 
 VkAccessFlagBits calcAccessFlags(ResourceState state);
 VkPipelineStageFlagBits calcPipelineStageFlags(ResourceState state, bool src);
+VkAccessFlags2 calcAccessFlags2(ResourceState state);
+VkPipelineStageFlags2 calcPipelineStageFlags2(ResourceState state, bool src);
 VkAccessFlags translateAccelerationStructureAccessFlag(AccessFlag access);
 
 VkBufferUsageFlagBits _calcBufferUsageFlags(BufferUsage usage);
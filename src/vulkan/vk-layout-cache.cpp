@@ -0,0 +1,136 @@
+#include "vk-layout-cache.h"
+#include "vk-util.h"
+
+namespace rhi::vk {
+
+bool LayoutCache::DescriptorSetLayoutKey::operator==(const DescriptorSetLayoutKey& other) const
+{
+    if (bindings.size() != other.bindings.size())
+        return false;
+    for (size_t i = 0; i < bindings.size(); i++)
+    {
+        const VkDescriptorSetLayoutBinding& a = bindings[i];
+        const VkDescriptorSetLayoutBinding& b = other.bindings[i];
+        if (a.binding != b.binding || a.descriptorType != b.descriptorType ||
+            a.descriptorCount != b.descriptorCount || a.stageFlags != b.stageFlags ||
+            a.pImmutableSamplers != b.pImmutableSamplers)
+            return false;
+    }
+    return true;
+}
+
+size_t LayoutCache::DescriptorSetLayoutKeyHasher::operator()(const DescriptorSetLayoutKey& key) const
+{
+    size_t hash = key.bindings.size();
+    for (const VkDescriptorSetLayoutBinding& binding : key.bindings)
+    {
+        hash_combine(hash, binding.binding);
+        hash_combine(hash, (uint32_t)binding.descriptorType);
+        hash_combine(hash, binding.descriptorCount);
+        hash_combine(hash, (uint32_t)binding.stageFlags);
+    }
+    return hash;
+}
+
+bool LayoutCache::PipelineLayoutKey::operator==(const PipelineLayoutKey& other) const
+{
+    if (setLayouts != other.setLayouts || pushConstantRanges.size() != other.pushConstantRanges.size())
+        return false;
+    for (size_t i = 0; i < pushConstantRanges.size(); i++)
+    {
+        const VkPushConstantRange& a = pushConstantRanges[i];
+        const VkPushConstantRange& b = other.pushConstantRanges[i];
+        if (a.stageFlags != b.stageFlags || a.offset != b.offset || a.size != b.size)
+            return false;
+    }
+    return true;
+}
+
+size_t LayoutCache::PipelineLayoutKeyHasher::operator()(const PipelineLayoutKey& key) const
+{
+    size_t hash = key.setLayouts.size();
+    // Set layouts are deduplicated by the cache, so their handles identify them.
+    for (VkDescriptorSetLayout setLayout : key.setLayouts)
+        hash_combine(hash, (uint64_t)setLayout);
+    for (const VkPushConstantRange& range : key.pushConstantRanges)
+    {
+        hash_combine(hash, (uint32_t)range.stageFlags);
+        hash_combine(hash, range.offset);
+        hash_combine(hash, range.size);
+    }
+    return hash;
+}
+
+void LayoutCache::close()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& it : m_pipelineLayouts)
+        m_api->vkDestroyPipelineLayout(m_api->m_device, it.second, nullptr);
+    m_pipelineLayouts.clear();
+    for (auto& it : m_descriptorSetLayouts)
+        m_api->vkDestroyDescriptorSetLayout(m_api->m_device, it.second, nullptr);
+    m_descriptorSetLayouts.clear();
+}
+
+Result LayoutCache::getDescriptorSetLayout(
+    const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+    VkDescriptorSetLayout* outLayout
+)
+{
+    DescriptorSetLayoutKey key{bindings};
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_descriptorSetLayouts.find(key);
+    if (it != m_descriptorSetLayouts.end())
+    {
+        *outLayout = it->second;
+        return SLANG_OK;
+    }
+
+    VkDescriptorSetLayoutCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    createInfo.pBindings = bindings.data();
+    createInfo.bindingCount = (uint32_t)bindings.size();
+    VkDescriptorSetLayout layout;
+    SLANG_VK_RETURN_ON_FAIL(m_api->vkCreateDescriptorSetLayout(m_api->m_device, &createInfo, nullptr, &layout));
+    m_descriptorSetLayouts.emplace(std::move(key), layout);
+    *outLayout = layout;
+    return SLANG_OK;
+}
+
+Result LayoutCache::getPipelineLayout(
+    const VkDescriptorSetLayout* setLayouts,
+    uint32_t setLayoutCount,
+    const std::vector<VkPushConstantRange>& pushConstantRanges,
+    VkPipelineLayout* outLayout
+)
+{
+    PipelineLayoutKey key;
+    key.setLayouts.assign(setLayouts, setLayouts + setLayoutCount);
+    key.pushConstantRanges = pushConstantRanges;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_pipelineLayouts.find(key);
+    if (it != m_pipelineLayouts.end())
+    {
+        *outLayout = it->second;
+        return SLANG_OK;
+    }
+
+    VkPipelineLayoutCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    createInfo.setLayoutCount = setLayoutCount;
+    createInfo.pSetLayouts = setLayouts;
+    if (pushConstantRanges.size())
+    {
+        createInfo.pushConstantRangeCount = (uint32_t)pushConstantRanges.size();
+        createInfo.pPushConstantRanges = pushConstantRanges.data();
+    }
+    VkPipelineLayout layout;
+    SLANG_VK_RETURN_ON_FAIL(m_api->vkCreatePipelineLayout(m_api->m_device, &createInfo, nullptr, &layout));
+    m_pipelineLayouts.emplace(std::move(key), layout);
+    *outLayout = layout;
+    return SLANG_OK;
+}
+
+} // namespace rhi::vk
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "vk-api.h"
+
+#include "core/common.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace rhi::vk {
+
+/// Device wide cache of descriptor set layouts and pipeline layouts.
+/// Layouts are keyed by their binding description, so shader object layouts with identical bindings (e.g. of
+/// different specializations of a program) share the same Vulkan objects. This also makes descriptor sets and
+/// pipeline layouts compatible across pipelines. Cached layouts live until the cache is closed.
+class LayoutCache
+{
+public:
+    void init(VulkanApi* api) { m_api = api; }
+    void close();
+
+    Result getDescriptorSetLayout(
+        const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+        VkDescriptorSetLayout* outLayout
+    );
+
+    Result getPipelineLayout(
+        const VkDescriptorSetLayout* setLayouts,
+        uint32_t setLayoutCount,
+        const std::vector<VkPushConstantRange>& pushConstantRanges,
+        VkPipelineLayout* outLayout
+    );
+
+private:
+    struct DescriptorSetLayoutKey
+    {
+        std::vector<VkDescriptorSetLayoutBinding> bindings;
+
+        bool operator==(const DescriptorSetLayoutKey& other) const;
+    };
+
+    struct DescriptorSetLayoutKeyHasher
+    {
+        size_t operator()(const DescriptorSetLayoutKey& key) const;
+    };
+
+    struct PipelineLayoutKey
+    {
+        std::vector<VkDescriptorSetLayout> setLayouts;
+        std::vector<VkPushConstantRange> pushConstantRanges;
+
+        bool operator==(const PipelineLayoutKey& other) const;
+    };
+
+    struct PipelineLayoutKeyHasher
+    {
+        size_t operator()(const PipelineLayoutKey& key) const;
+    };
+
+    const VulkanApi* m_api = nullptr;
+    std::mutex m_mutex;
+    std::unordered_map<DescriptorSetLayoutKey, VkDescriptorSetLayout, DescriptorSetLayoutKeyHasher>
+        m_descriptorSetLayouts;
+    std::unordered_map<PipelineLayoutKey, VkPipelineLayout, PipelineLayoutKeyHasher> m_pipelineLayouts;
+};
+
+} // namespace rhi::vk
@@ -0,0 +1,359 @@
+#include "vk-memory-allocator.h"
+#include "vk-util.h"
+
+#include <algorithm>
+
+namespace rhi::vk {
+
+inline VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// ----------------------------------------------------------------------------
+// MemoryBlock
+// ----------------------------------------------------------------------------
+
+void MemoryBlock::init(VkDeviceSize size)
+{
+    m_size = size;
+    m_usedSize = 0;
+    m_allocationCount = 0;
+    m_freeRangesByOffset.clear();
+    m_freeRangesBySize.clear();
+    insertFreeRange(0, size);
+}
+
+bool MemoryBlock::allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& outOffset)
+{
+    // Best-fit: walk free ranges from the smallest one that could hold the allocation.
+    for (auto it = m_freeRangesBySize.lower_bound(size); it != m_freeRangesBySize.end(); ++it)
+    {
+        VkDeviceSize rangeSize = it->first;
+        VkDeviceSize rangeOffset = it->second;
+        VkDeviceSize alignedOffset = alignUp(rangeOffset, alignment);
+        VkDeviceSize padding = alignedOffset - rangeOffset;
+        if (padding + size > rangeSize)
+            continue;
+
+        eraseFreeRange(m_freeRangesByOffset.find(rangeOffset));
+        if (padding > 0)
+            insertFreeRange(rangeOffset, padding);
+        VkDeviceSize tail = rangeSize - padding - size;
+        if (tail > 0)
+            insertFreeRange(alignedOffset + size, tail);
+
+        m_usedSize += size;
+        m_allocationCount++;
+        outOffset = alignedOffset;
+        return true;
+    }
+    return false;
+}
+
+void MemoryBlock::free(VkDeviceSize offset, VkDeviceSize size)
+{
+    SLANG_RHI_ASSERT(m_allocationCount > 0);
+    m_usedSize -= size;
+    m_allocationCount--;
+
+    // Coalesce with the neighbouring free ranges.
+    auto next = m_freeRangesByOffset.upper_bound(offset);
+    if (next != m_freeRangesByOffset.begin())
+    {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset)
+        {
+            offset = prev->first;
+            size += prev->second;
+            eraseFreeRange(prev);
+        }
+    }
+    if (next != m_freeRangesByOffset.end() && next->first == offset + size)
+    {
+        size += next->second;
+        eraseFreeRange(next);
+    }
+    insertFreeRange(offset, size);
+}
+
+void MemoryBlock::insertFreeRange(VkDeviceSize offset, VkDeviceSize size)
+{
+    m_freeRangesByOffset.emplace(offset, size);
+    m_freeRangesBySize.emplace(size, offset);
+}
+
+void MemoryBlock::eraseFreeRange(FreeRangeIterator it)
+{
+    auto range = m_freeRangesBySize.equal_range(it->second);
+    for (auto sizeIt = range.first; sizeIt != range.second; ++sizeIt)
+    {
+        if (sizeIt->second == it->first)
+        {
+            m_freeRangesBySize.erase(sizeIt);
+            break;
+        }
+    }
+    m_freeRangesByOffset.erase(it);
+}
+
+// ----------------------------------------------------------------------------
+// MemoryAllocator
+// ----------------------------------------------------------------------------
+
+void MemoryAllocator::init(const VulkanApi* api)
+{
+    m_api = api;
+
+    const VkPhysicalDeviceMemoryProperties& memoryProperties = m_api->m_deviceMemoryProperties;
+    m_pools.resize(memoryProperties.memoryTypeCount * 2);
+    m_dedicatedAllocations.resize(memoryProperties.memoryTypeCount);
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i)
+    {
+        // Use smaller blocks on small heaps (e.g. the 256MB host visible device local heap without ReBAR).
+        VkDeviceSize heapSize = memoryProperties.memoryHeaps[memoryProperties.memoryTypes[i].heapIndex].size;
+        VkDeviceSize blockSize = heapSize <= 1024ull * 1024 * 1024 ? alignUp(heapSize / 8, 256) : kDefaultBlockSize;
+        for (uint32_t j = 0; j < 2; ++j)
+        {
+            m_pools[i * 2 + j].memoryTypeIndex = i;
+            m_pools[i * 2 + j].blockSize = blockSize;
+        }
+    }
+}
+
+void MemoryAllocator::close()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& pool : m_pools)
+    {
+        for (auto& block : pool.blocks)
+            freeMemory(block->m_memory);
+        pool.blocks.clear();
+    }
+}
+
+Result MemoryAllocator::allocate(const MemoryAllocationDesc& desc, MemoryAllocation& outAllocation)
+{
+    int memoryTypeIndex = m_api->findMemoryTypeIndex(desc.requirements.memoryTypeBits, desc.properties);
+    if (memoryTypeIndex < 0)
+        return SLANG_E_OUT_OF_MEMORY;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    uint32_t poolIndex = uint32_t(memoryTypeIndex) * 2 + (desc.linear ? 0 : 1);
+    MemoryPool& pool = m_pools[poolIndex];
+    VkDeviceSize size = desc.requirements.size;
+    VkDeviceSize alignment = std::max<VkDeviceSize>(desc.requirements.alignment, 1);
+
+    if (desc.dedicated || size > pool.blockSize / 2)
+        return allocateDedicated(uint32_t(memoryTypeIndex), size, desc.next, outAllocation);
+
+    auto initAllocation = [&](MemoryBlock* block, VkDeviceSize offset)
+    {
+        outAllocation.memory = block->m_memory;
+        outAllocation.offset = offset;
+        outAllocation.size = size;
+        outAllocation.mappedData = block->m_mappedData ? block->m_mappedData + offset : nullptr;
+        outAllocation.memoryTypeIndex = uint32_t(memoryTypeIndex);
+        outAllocation.block = block;
+    };
+
+    for (auto& block : pool.blocks)
+    {
+        VkDeviceSize offset;
+        if (block->allocate(size, alignment, offset))
+        {
+            initAllocation(block.get(), offset);
+            return SLANG_OK;
+        }
+    }
+
+    // Allocate a new block, falling back to smaller blocks if the heap is running low.
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    uint8_t* mappedData = nullptr;
+    VkDeviceSize blockSize = pool.blockSize;
+    while (SLANG_FAILED(allocateMemory(uint32_t(memoryTypeIndex), blockSize, nullptr, memory, mappedData)))
+    {
+        blockSize /= 2;
+        if (blockSize < size * 2)
+            return allocateDedicated(uint32_t(memoryTypeIndex), size, desc.next, outAllocation);
+    }
+
+    auto block = std::make_unique<MemoryBlock>();
+    block->m_memory = memory;
+    block->m_mappedData = mappedData;
+    block->m_poolIndex = poolIndex;
+    block->init(blockSize);
+
+    VkDeviceSize offset;
+    bool allocated = block->allocate(size, alignment, offset);
+    SLANG_RHI_ASSERT(allocated);
+    SLANG_UNUSED(allocated);
+    initAllocation(block.get(), offset);
+    pool.blocks.push_back(std::move(block));
+    return SLANG_OK;
+}
+
+void MemoryAllocator::free(MemoryAllocation& allocation)
+{
+    if (!allocation.isValid())
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (allocation.isDedicated())
+    {
+        freeMemory(allocation.memory);
+        DedicatedAllocations& dedicated = m_dedicatedAllocations[allocation.memoryTypeIndex];
+        dedicated.count--;
+        dedicated.size -= allocation.size;
+    }
+    else
+    {
+        MemoryBlock* block = allocation.block;
+        block->free(allocation.offset, allocation.size);
+        if (block->isEmpty())
+        {
+            // Keep a single empty block around to avoid thrashing when resources
+            // are created and destroyed in quick succession.
+            MemoryPool& pool = m_pools[block->m_poolIndex];
+            size_t emptyBlockCount = std::count_if(
+                pool.blocks.begin(),
+                pool.blocks.end(),
+                [](const std::unique_ptr<MemoryBlock>& b) { return b->isEmpty(); }
+            );
+            if (emptyBlockCount > 1)
+            {
+                auto it = std::find_if(
+                    pool.blocks.begin(),
+                    pool.blocks.end(),
+                    [block](const std::unique_ptr<MemoryBlock>& b) { return b.get() == block; }
+                );
+                freeMemory(block->m_memory);
+                pool.blocks.erase(it);
+            }
+        }
+    }
+
+    allocation = MemoryAllocation();
+}
+
+void MemoryAllocator::getStats(
+    std::vector<MemoryHeapStats>& outHeapStats,
+    std::vector<MemoryBlockStats>& outBlockStats
+)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const VkPhysicalDeviceMemoryProperties& memoryProperties = m_api->m_deviceMemoryProperties;
+    outHeapStats.assign(memoryProperties.memoryHeapCount, MemoryHeapStats{});
+    outBlockStats.clear();
+    for (const auto& pool : m_pools)
+    {
+        uint32_t heapIndex = memoryProperties.memoryTypes[pool.memoryTypeIndex].heapIndex;
+        MemoryHeapStats& heapStats = outHeapStats[heapIndex];
+        for (const auto& block : pool.blocks)
+        {
+            MemoryBlockStats blockStats = {};
+            blockStats.heapIndex = heapIndex;
+            blockStats.size = block->m_size;
+            blockStats.usedSize = block->m_usedSize;
+            blockStats.freeSize = block->m_size - block->m_usedSize;
+            blockStats.largestFreeRange = block->getLargestFreeRange();
+            blockStats.allocationCount = block->m_allocationCount;
+            blockStats.freeRangeCount = block->getFreeRangeCount();
+            outBlockStats.push_back(blockStats);
+
+            heapStats.blockCount++;
+            heapStats.blockSize += blockStats.size;
+            heapStats.usedSize += blockStats.usedSize;
+            heapStats.freeSize += blockStats.freeSize;
+            heapStats.largestFreeRange = std::max(heapStats.largestFreeRange, blockStats.largestFreeRange);
+            heapStats.allocationCount += blockStats.allocationCount;
+        }
+    }
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i)
+    {
+        MemoryHeapStats& heapStats = outHeapStats[memoryProperties.memoryTypes[i].heapIndex];
+        heapStats.dedicatedAllocationCount += m_dedicatedAllocations[i].count;
+        heapStats.dedicatedSize += m_dedicatedAllocations[i].size;
+    }
+}
+
+Result MemoryAllocator::allocateMemory(
+    uint32_t memoryTypeIndex,
+    VkDeviceSize size,
+    const void* next,
+    VkDeviceMemory& outMemory,
+    uint8_t*& outMappedData
+)
+{
+    VkMemoryAllocateInfo allocateInfo = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+    allocateInfo.allocationSize = size;
+    allocateInfo.memoryTypeIndex = memoryTypeIndex;
+    allocateInfo.pNext = next;
+
+    // Blocks are shared by all buffers, so they need to support device addresses whenever the feature is enabled.
+    VkMemoryAllocateFlagsInfo flagInfo = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO};
+    if (m_api->m_extendedFeatures.vulkan12Features.bufferDeviceAddress)
+    {
+        flagInfo.deviceMask = 1;
+        flagInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+        flagInfo.pNext = allocateInfo.pNext;
+        allocateInfo.pNext = &flagInfo;
+    }
+
+    // Running out of memory is not an error here, the caller may retry with a smaller block.
+    VkResult result = m_api->vkAllocateMemory(m_api->m_device, &allocateInfo, nullptr, &outMemory);
+    if (result != VK_SUCCESS)
+        return VulkanUtil::toResult(result);
+
+    outMappedData = nullptr;
+    VkMemoryPropertyFlags propertyFlags = m_api->m_deviceMemoryProperties.memoryTypes[memoryTypeIndex].propertyFlags;
+    if (propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+    {
+        void* mappedData = nullptr;
+        result = m_api->vkMapMemory(m_api->m_device, outMemory, 0, VK_WHOLE_SIZE, 0, &mappedData);
+        if (result != VK_SUCCESS)
+        {
+            m_api->vkFreeMemory(m_api->m_device, outMemory, nullptr);
+            outMemory = VK_NULL_HANDLE;
+            return VulkanUtil::handleFail(result);
+        }
+        outMappedData = (uint8_t*)mappedData;
+    }
+
+    return SLANG_OK;
+}
+
+void MemoryAllocator::freeMemory(VkDeviceMemory memory)
+{
+    // Freeing implicitly unmaps persistently mapped memory.
+    m_api->vkFreeMemory(m_api->m_device, memory, nullptr);
+}
+
+Result MemoryAllocator::allocateDedicated(
+    uint32_t memoryTypeIndex,
+    VkDeviceSize size,
+    const void* next,
+    MemoryAllocation& outAllocation
+)
+{
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    uint8_t* mappedData = nullptr;
+    SLANG_RETURN_ON_FAIL(allocateMemory(memoryTypeIndex, size, next, memory, mappedData));
+
+    outAllocation.memory = memory;
+    outAllocation.offset = 0;
+    outAllocation.size = size;
+    outAllocation.mappedData = mappedData;
+    outAllocation.memoryTypeIndex = memoryTypeIndex;
+    outAllocation.block = nullptr;
+
+    DedicatedAllocations& dedicated = m_dedicatedAllocations[memoryTypeIndex];
+    dedicated.count++;
+    dedicated.size += size;
+    return SLANG_OK;
+}
+
+} // namespace rhi::vk
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "vk-api.h"
+
+#include "core/common.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace rhi::vk {
+
+class MemoryBlock;
+
+/// A range of device memory handed out by the MemoryAllocator.
+struct MemoryAllocation
+{
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = 0;
+    /// Host pointer to the start of the allocation (only set for host visible memory).
+    uint8_t* mappedData = nullptr;
+    uint32_t memoryTypeIndex = 0;
+    /// Block the allocation was sub-allocated from (nullptr for dedicated allocations).
+    MemoryBlock* block = nullptr;
+
+    bool isValid() const { return memory != VK_NULL_HANDLE; }
+    bool isDedicated() const { return block == nullptr; }
+};
+
+struct MemoryAllocationDesc
+{
+    VkMemoryRequirements requirements = {};
+    VkMemoryPropertyFlags properties = 0;
+    /// Linear resources (buffers) and optimal tiled images are kept in separate blocks
+    /// so we never have to deal with bufferImageGranularity.
+    bool linear = true;
+    /// Force a dedicated VkDeviceMemory object (required for exported memory).
+    bool dedicated = false;
+    /// Extension structs chained into VkMemoryAllocateInfo (dedicated allocations only).
+    const void* next = nullptr;
+};
+
+/// Large VkDeviceMemory object that is sub-allocated using a best-fit free list.
+class MemoryBlock
+{
+public:
+    VkDeviceMemory m_memory = VK_NULL_HANDLE;
+    VkDeviceSize m_size = 0;
+    VkDeviceSize m_usedSize = 0;
+    uint32_t m_allocationCount = 0;
+    uint8_t* m_mappedData = nullptr;
+    uint32_t m_poolIndex = 0;
+
+    void init(VkDeviceSize size);
+    bool allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& outOffset);
+    void free(VkDeviceSize offset, VkDeviceSize size);
+
+    bool isEmpty() const { return m_allocationCount == 0; }
+    uint32_t getFreeRangeCount() const { return (uint32_t)m_freeRangesByOffset.size(); }
+    VkDeviceSize getLargestFreeRange() const
+    {
+        return m_freeRangesBySize.empty() ? 0 : m_freeRangesBySize.rbegin()->first;
+    }
+
+private:
+    using FreeRangeIterator = std::map<VkDeviceSize, VkDeviceSize>::iterator;
+
+    void insertFreeRange(VkDeviceSize offset, VkDeviceSize size);
+    void eraseFreeRange(FreeRangeIterator it);
+
+    // Free ranges are indexed by offset (to coalesce neighbours) and by size (for best-fit search).
+    std::map<VkDeviceSize, VkDeviceSize> m_freeRangesByOffset;
+    std::multimap<VkDeviceSize, VkDeviceSize> m_freeRangesBySize;
+};
+
+/// Device memory allocator.
+/// Memory is allocated in large blocks per memory type which are then sub-allocated,
+/// keeping the number of vkAllocateMemory calls well below maxMemoryAllocationCount.
+/// Resources larger than half a block (and exported resources) get a dedicated allocation.
+/// Host visible blocks are persistently mapped.
+class MemoryAllocator
+{
+public:
+    static constexpr VkDeviceSize kDefaultBlockSize = 64 * 1024 * 1024;
+
+    const VulkanApi* m_api = nullptr;
+
+    void init(const VulkanApi* api);
+    void close();
+
+    Result allocate(const MemoryAllocationDesc& desc, MemoryAllocation& outAllocation);
+    void free(MemoryAllocation& allocation);
+
+    /// Get the statistics of every memory heap (indexed by heap index) and of every block.
+    void getStats(std::vector<MemoryHeapStats>& outHeapStats, std::vector<MemoryBlockStats>& outBlockStats);
+
+private:
+    struct MemoryPool
+    {
+        uint32_t memoryTypeIndex = 0;
+        VkDeviceSize blockSize = 0;
+        std::vector<std::unique_ptr<MemoryBlock>> blocks;
+    };
+
+    Result allocateMemory(
+        uint32_t memoryTypeIndex,
+        VkDeviceSize size,
+        const void* next,
+        VkDeviceMemory& outMemory,
+        uint8_t*& outMappedData
+    );
+    void freeMemory(VkDeviceMemory memory);
+    Result allocateDedicated(
+        uint32_t memoryTypeIndex,
+        VkDeviceSize size,
+        const void* next,
+        MemoryAllocation& outAllocation
+    );
+
+    std::mutex m_mutex;
+    // Two pools per memory type: index * 2 for linear resources, index * 2 + 1 for images.
+    std::vector<MemoryPool> m_pools;
+    struct DedicatedAllocations
+    {
+        uint32_t count = 0;
+        VkDeviceSize size = 0;
+    };
+    // Dedicated allocations per memory type.
+    std::vector<DedicatedAllocations> m_dedicatedAllocations;
+};
+
+} // namespace rhi::vk
@@ -0,0 +1,350 @@
+#include "vk-pipeline-library.h"
+#include "vk-device.h"
+#include "vk-shader-program.h"
+#include "vk-util.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+namespace rhi::vk {
+
+namespace {
+
+/// Builds a cache key from the state a library depends on.
+struct KeyBuilder
+{
+    std::string key;
+
+    template<typename T>
+    void add(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        key.append((const char*)&value, sizeof(T));
+    }
+
+    template<typename T>
+    void addArray(const T* values, uint32_t count)
+    {
+        add(count);
+        for (uint32_t i = 0; i < count; i++)
+            add(values[i]);
+    }
+
+    void addMultisampleState(const VkPipelineMultisampleStateCreateInfo& state)
+    {
+        add(state.rasterizationSamples);
+        add(state.sampleShadingEnable);
+        add(state.minSampleShading);
+        add(state.alphaToCoverageEnable);
+        add(state.alphaToOneEnable);
+    }
+};
+
+} // namespace
+
+void PipelineLibraryCache::init(DeviceImpl* device)
+{
+    m_device = device;
+    m_enabled = device->m_api.m_extendedFeatures.graphicsPipelineLibraryFeatures.graphicsPipelineLibrary;
+}
+
+void PipelineLibraryCache::close()
+{
+    if (!m_device)
+        return;
+    auto& api = m_device->m_api;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& it : m_libraries)
+        api.vkDestroyPipeline(api.m_device, it.second.pipeline, nullptr);
+    m_libraries.clear();
+    m_moduleLibraries.clear();
+}
+
+Result PipelineLibraryCache::createRenderPipeline(
+    ShaderProgramImpl* program,
+    const VkGraphicsPipelineCreateInfo& createInfo,
+    VkPipeline* outPipeline,
+    RenderPipelineLibraries* outLibraries
+)
+{
+    // Libraries are compiled from the shader modules rather than by identifier.
+    // The program keeps the modules alive until the libraries are cached.
+    SLANG_RETURN_ON_FAIL(program->ensureShaderModules());
+
+    const VkPipelineRenderingCreateInfoKHR& renderingInfo = *(const VkPipelineRenderingCreateInfoKHR*)createInfo.pNext;
+    const VkPipelineDynamicStateCreateInfo& dynamicState = *createInfo.pDynamicState;
+    const VkPipelineMultisampleStateCreateInfo& multisample = *createInfo.pMultisampleState;
+
+    // Split the stages into pre-rasterization and fragment shader stages.
+    std::vector<VkPipelineShaderStageCreateInfo> preRasterizationStages;
+    std::vector<VkPipelineShaderStageCreateInfo> fragmentStages;
+    std::vector<ShaderModule*> preRasterizationModules;
+    std::vector<ShaderModule*> fragmentModules;
+    KeyBuilder preRasterizationKey;
+    KeyBuilder fragmentKey;
+    for (size_t i = 0; i < program->m_stageCreateInfos.size(); i++)
+    {
+        const VkPipelineShaderStageCreateInfo& stage = program->m_stageCreateInfos[i];
+        bool isFragment = stage.stage == VK_SHADER_STAGE_FRAGMENT_BIT;
+        (isFragment ? fragmentStages : preRasterizationStages).push_back(stage);
+        (isFragment ? fragmentModules : preRasterizationModules).push_back(program->m_modules[i]);
+        KeyBuilder& key = isFragment ? fragmentKey : preRasterizationKey;
+        key.add(program->m_modules[i]);
+        key.add(stage.stage);
+    }
+
+    // Dynamic state applies to all libraries, states of other subsets are ignored.
+    KeyBuilder dynamicStateKey;
+    dynamicStateKey.addArray(dynamicState.pDynamicStates, dynamicState.dynamicStateCount);
+
+    RenderPipelineLibraries libraries;
+    libraries.layout = createInfo.layout;
+
+    // Vertex input interface.
+    {
+        const VkPipelineVertexInputStateCreateInfo& vertexInput = *createInfo.pVertexInputState;
+        const VkPipelineInputAssemblyStateCreateInfo& inputAssembly = *createInfo.pInputAssemblyState;
+        KeyBuilder key;
+        key.add(VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT);
+        key.addArray(vertexInput.pVertexBindingDescriptions, vertexInput.vertexBindingDescriptionCount);
+        key.addArray(vertexInput.pVertexAttributeDescriptions, vertexInput.vertexAttributeDescriptionCount);
+        key.add(inputAssembly.topology);
+        key.add(inputAssembly.primitiveRestartEnable);
+        key.key += dynamicStateKey.key;
+
+        VkGraphicsPipelineCreateInfo libraryCreateInfo = {VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO};
+        libraryCreateInfo.pVertexInputState = &vertexInput;
+        libraryCreateInfo.pInputAssemblyState = &inputAssembly;
+        libraryCreateInfo.pDynamicState = &dynamicState;
+        SLANG_RETURN_ON_FAIL(getLibrary(
+            key.key,
+            {},
+            VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT,
+            libraryCreateInfo,
+            &libraries.libraries[0]
+        ));
+    }
+
+    // Pre-rasterization shaders.
+    {
+        const VkPipelineRasterizationStateCreateInfo& rasterization = *createInfo.pRasterizationState;
+        const VkPipelineViewportStateCreateInfo& viewport = *createInfo.pViewportState;
+        KeyBuilder& key = preRasterizationKey;
+        key.add(VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT);
+        key.add(createInfo.layout);
+        key.add(rasterization.depthClampEnable);
+        key.add(rasterization.rasterizerDiscardEnable);
+        key.add(rasterization.polygonMode);
+        key.add(rasterization.cullMode);
+        key.add(rasterization.frontFace);
+        key.add(rasterization.depthBiasEnable);
+        key.add(rasterization.depthBiasConstantFactor);
+        key.add(rasterization.depthBiasClamp);
+        key.add(rasterization.depthBiasSlopeFactor);
+        key.add(rasterization.lineWidth);
+        // The only extension of the rasterization state is conservative rasterization.
+        key.add(rasterization.pNext != nullptr);
+        key.add(viewport.viewportCount);
+        key.add(viewport.scissorCount);
+        key.add(renderingInfo.viewMask);
+        key.key += dynamicStateKey.key;
+
+        VkGraphicsPipelineCreateInfo libraryCreateInfo = {VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO};
+        libraryCreateInfo.pNext = &renderingInfo;
+        libraryCreateInfo.stageCount = (uint32_t)preRasterizationStages.size();
+        libraryCreateInfo.pStages = preRasterizationStages.data();
+        libraryCreateInfo.layout = createInfo.layout;
+        libraryCreateInfo.pViewportState = &viewport;
+        libraryCreateInfo.pRasterizationState = &rasterization;
+        libraryCreateInfo.pDynamicState = &dynamicState;
+        SLANG_RETURN_ON_FAIL(getLibrary(
+            key.key,
+            preRasterizationModules,
+            VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+            libraryCreateInfo,
+            &libraries.libraries[1]
+        ));
+    }
+
+    // Fragment shader.
+    {
+        const VkPipelineDepthStencilStateCreateInfo& depthStencil = *createInfo.pDepthStencilState;
+        KeyBuilder& key = fragmentKey;
+        key.add(VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT);
+        key.add(createInfo.layout);
+        key.add(depthStencil.depthTestEnable);
+        key.add(depthStencil.depthWriteEnable);
+        key.add(depthStencil.depthCompareOp);
+        key.add(depthStencil.depthBoundsTestEnable);
+        key.add(depthStencil.stencilTestEnable);
+        key.add(depthStencil.front);
+        key.add(depthStencil.back);
+        key.add(depthStencil.minDepthBounds);
+        key.add(depthStencil.maxDepthBounds);
+        key.addMultisampleState(multisample);
+        key.add(renderingInfo.viewMask);
+        key.key += dynamicStateKey.key;
+
+        VkGraphicsPipelineCreateInfo libraryCreateInfo = {VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO};
+        libraryCreateInfo.pNext = &renderingInfo;
+        libraryCreateInfo.stageCount = (uint32_t)fragmentStages.size();
+        libraryCreateInfo.pStages = fragmentStages.data();
+        libraryCreateInfo.layout = createInfo.layout;
+        libraryCreateInfo.pDepthStencilState = &depthStencil;
+        libraryCreateInfo.pMultisampleState = &multisample;
+        libraryCreateInfo.pDynamicState = &dynamicState;
+        SLANG_RETURN_ON_FAIL(getLibrary(
+            key.key,
+            fragmentModules,
+            VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT,
+            libraryCreateInfo,
+            &libraries.libraries[2]
+        ));
+    }
+
+    // Fragment output interface.
+    {
+        const VkPipelineColorBlendStateCreateInfo& colorBlend = *createInfo.pColorBlendState;
+        KeyBuilder key;
+        key.add(VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT);
+        key.add(colorBlend.logicOpEnable);
+        key.add(colorBlend.logicOp);
+        key.addArray(colorBlend.pAttachments, colorBlend.attachmentCount);
+        key.add(colorBlend.blendConstants);
+        key.addMultisampleState(multisample);
+        key.add(renderingInfo.viewMask);
+        key.addArray(renderingInfo.pColorAttachmentFormats, renderingInfo.colorAttachmentCount);
+        key.add(renderingInfo.depthAttachmentFormat);
+        key.add(renderingInfo.stencilAttachmentFormat);
+        key.key += dynamicStateKey.key;
+
+        VkGraphicsPipelineCreateInfo libraryCreateInfo = {VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO};
+        libraryCreateInfo.pNext = &renderingInfo;
+        libraryCreateInfo.pColorBlendState = &colorBlend;
+        libraryCreateInfo.pMultisampleState = &multisample;
+        libraryCreateInfo.pDynamicState = &dynamicState;
+        SLANG_RETURN_ON_FAIL(getLibrary(
+            key.key,
+            {},
+            VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT,
+            libraryCreateInfo,
+            &libraries.libraries[3]
+        ));
+    }
+
+    SLANG_RETURN_ON_FAIL(linkLibraries(libraries, 0, outPipeline));
+    *outLibraries = libraries;
+    return SLANG_OK;
+}
+
+Result PipelineLibraryCache::linkOptimizedRenderPipeline(
+    const RenderPipelineLibraries& libraries,
+    VkPipeline* outPipeline
+)
+{
+    return linkLibraries(libraries, VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT, outPipeline);
+}
+
+void PipelineLibraryCache::evictModule(ShaderModule* module)
+{
+    auto& api = m_device->m_api;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto moduleIt = m_moduleLibraries.find(module);
+    if (moduleIt == m_moduleLibraries.end())
+        return;
+    std::vector<std::string> keys = std::move(moduleIt->second);
+    m_moduleLibraries.erase(moduleIt);
+    for (const std::string& key : keys)
+    {
+        auto it = m_libraries.find(key);
+        if (it == m_libraries.end())
+            continue;
+        // Drop the key from the other modules the library was compiled from.
+        for (ShaderModule* other : it->second.modules)
+        {
+            auto otherIt = m_moduleLibraries.find(other);
+            if (otherIt == m_moduleLibraries.end())
+                continue;
+            auto& otherKeys = otherIt->second;
+            otherKeys.erase(std::remove(otherKeys.begin(), otherKeys.end(), key), otherKeys.end());
+        }
+        // No program references the module anymore, so no pipeline is being linked from the library. Linked
+        // pipelines do not reference their libraries, so it can be destroyed right away.
+        api.vkDestroyPipeline(api.m_device, it->second.pipeline, nullptr);
+        m_libraries.erase(it);
+    }
+}
+
+Result PipelineLibraryCache::getLibrary(
+    const std::string& key,
+    const std::vector<ShaderModule*>& modules,
+    VkGraphicsPipelineLibraryFlagsEXT flags,
+    const VkGraphicsPipelineCreateInfo& createInfo,
+    VkPipeline* outLibrary
+)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_libraries.find(key);
+        if (it != m_libraries.end())
+        {
+            *outLibrary = it->second.pipeline;
+            return SLANG_OK;
+        }
+    }
+
+    // Compile the library outside of the lock, so other threads can still get cached libraries.
+    VkGraphicsPipelineLibraryCreateInfoEXT libraryInfo = {VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT};
+    libraryInfo.pNext = createInfo.pNext;
+    libraryInfo.flags = flags;
+    VkGraphicsPipelineCreateInfo libraryCreateInfo = createInfo;
+    libraryCreateInfo.pNext = &libraryInfo;
+    libraryCreateInfo.flags |=
+        VK_PIPELINE_CREATE_LIBRARY_BIT_KHR | VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT;
+
+    auto& api = m_device->m_api;
+    VkPipeline library = VK_NULL_HANDLE;
+    SLANG_VK_RETURN_ON_FAIL(
+        api.vkCreateGraphicsPipelines(api.m_device, m_device->m_pipelineCache, 1, &libraryCreateInfo, nullptr, &library)
+    );
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto result = m_libraries.emplace(key, Library{library, modules});
+    if (result.second)
+    {
+        for (ShaderModule* module : modules)
+            m_moduleLibraries[module].push_back(key);
+    }
+    else
+    {
+        // Another thread compiled the same library in the meantime.
+        api.vkDestroyPipeline(api.m_device, library, nullptr);
+    }
+    *outLibrary = result.first->second.pipeline;
+    return SLANG_OK;
+}
+
+Result PipelineLibraryCache::linkLibraries(
+    const RenderPipelineLibraries& libraries,
+    VkPipelineCreateFlags flags,
+    VkPipeline* outPipeline
+)
+{
+    VkPipelineLibraryCreateInfoKHR libraryInfo = {VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR};
+    libraryInfo.libraryCount = (uint32_t)libraries.libraries.size();
+    libraryInfo.pLibraries = libraries.libraries.data();
+
+    VkGraphicsPipelineCreateInfo createInfo = {VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO};
+    createInfo.pNext = &libraryInfo;
+    createInfo.flags = flags;
+    createInfo.layout = libraries.layout;
+
+    auto& api = m_device->m_api;
+    SLANG_VK_RETURN_ON_FAIL(
+        api.vkCreateGraphicsPipelines(api.m_device, m_device->m_pipelineCache, 1, &createInfo, nullptr, outPipeline)
+    );
+    return SLANG_OK;
+}
+
+} // namespace rhi::vk
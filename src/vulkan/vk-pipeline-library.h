@@ -0,0 +1,82 @@
+#pragma once
+
+#include "vk-base.h"
+
+#include <array>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rhi::vk {
+
+struct ShaderModule;
+
+/// Pipeline libraries of the four state subsets of a render pipeline (VK_EXT_graphics_pipeline_library).
+struct RenderPipelineLibraries
+{
+    /// Vertex input, pre-rasterization shaders, fragment shader and fragment output libraries.
+    std::array<VkPipeline, 4> libraries = {};
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+};
+
+/// Device wide cache of graphics pipeline libraries.
+/// Each state subset of a render pipeline is compiled into a library keyed by the state it depends on, so render
+/// pipeline variants only compile the subsets that differ (e.g. a new blend state only compiles a new fragment
+/// output library). Render pipelines are linked from the libraries without link time optimization, which is
+/// cheap. Libraries retain link time optimization info, so optimized pipelines can be linked later on.
+/// Libraries compiled from a shader module are evicted once the module is destroyed (see `evictModule`).
+class PipelineLibraryCache
+{
+public:
+    void init(DeviceImpl* device);
+    void close();
+
+    bool isEnabled() const { return m_enabled; }
+
+    /// Link a render pipeline from the libraries of the state in `createInfo` (a complete, monolithic create info).
+    /// Libraries that are not cached yet are compiled.
+    Result createRenderPipeline(
+        ShaderProgramImpl* program,
+        const VkGraphicsPipelineCreateInfo& createInfo,
+        VkPipeline* outPipeline,
+        RenderPipelineLibraries* outLibraries
+    );
+
+    /// Link a render pipeline with link time optimization.
+    Result linkOptimizedRenderPipeline(const RenderPipelineLibraries& libraries, VkPipeline* outPipeline);
+
+    /// Evict the libraries compiled from `module`, called when the module is destroyed.
+    /// Keys reference modules by address, so libraries must not outlive their modules.
+    void evictModule(ShaderModule* module);
+
+private:
+    Result getLibrary(
+        const std::string& key,
+        const std::vector<ShaderModule*>& modules,
+        VkGraphicsPipelineLibraryFlagsEXT flags,
+        const VkGraphicsPipelineCreateInfo& createInfo,
+        VkPipeline* outLibrary
+    );
+
+    Result linkLibraries(
+        const RenderPipelineLibraries& libraries,
+        VkPipelineCreateFlags flags,
+        VkPipeline* outPipeline
+    );
+
+    DeviceImpl* m_device = nullptr;
+    bool m_enabled = false;
+    std::mutex m_mutex;
+    struct Library
+    {
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        /// Shader modules the library was compiled from.
+        std::vector<ShaderModule*> modules;
+    };
+    std::unordered_map<std::string, Library> m_libraries;
+    /// Keys of the cached libraries compiled from each shader module.
+    std::unordered_map<ShaderModule*, std::vector<std::string>> m_moduleLibraries;
+};
+
+} // namespace rhi::vk
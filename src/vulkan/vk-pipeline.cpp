@@ -15,21 +15,26 @@ namespace rhi::vk {
 
 RenderPipelineImpl::~RenderPipelineImpl()
 {
-    if (m_pipeline != VK_NULL_HANDLE)
+    VkPipeline pipeline = m_pipeline.load();
+    if (pipeline != VK_NULL_HANDLE)
     {
-        m_device->m_api.vkDestroyPipeline(m_device->m_api.m_device, m_pipeline, nullptr);
+        RetiredObjects retired(m_device);
+        retired.add(VK_OBJECT_TYPE_PIPELINE, (uint64_t)pipeline);
+        m_device->retireObjects(std::move(retired));
     }
 }
 
 Result RenderPipelineImpl::getNativeHandle(NativeHandle* outHandle)
 {
     outHandle->type = NativeHandleType::VkPipeline;
-    outHandle->value = (uint64_t)m_pipeline;
+    outHandle->value = (uint64_t)m_pipeline.load();
     return SLANG_OK;
 }
 
 Result DeviceImpl::createRenderPipeline2(const RenderPipelineDesc& desc, IRenderPipeline** outPipeline)
 {
+    publishOptimizedRenderPipelines();
+
     ShaderProgramImpl* program = checked_cast<ShaderProgramImpl*>(desc.program);
     if (program->m_stageCreateInfos.empty())
     {
@@ -223,20 +228,52 @@ Result DeviceImpl::createRenderPipeline2(const RenderPipelineDesc& desc, IRender
     createInfo.pDynamicState = &dynamicStateInfo;
 
     VkPipeline vkPipeline = VK_NULL_HANDLE;
+    RenderPipelineLibraries libraries;
+    bool linkedFromLibraries = false;
 
     if (m_pipelineCreationAPIDispatcher)
     {
+        SLANG_RETURN_ON_FAIL(program->ensureShaderModules());
         SLANG_RETURN_ON_FAIL(
             m_pipelineCreationAPIDispatcher
                 ->createRenderPipeline(this, program->linkedProgram.get(), &createInfo, (void**)&vkPipeline)
         );
     }
+    else if (m_pipelineLibraryCache.isEnabled())
+    {
+        // Link the pipeline from pipeline libraries, the optimized pipeline is built in the background.
+        SLANG_RETURN_ON_FAIL(m_pipelineLibraryCache.createRenderPipeline(program, createInfo, &vkPipeline, &libraries));
+        linkedFromLibraries = true;
+    }
     else
     {
-        VkPipelineCache pipelineCache = VK_NULL_HANDLE;
-        SLANG_VK_RETURN_ON_FAIL(
-            m_api.vkCreateGraphicsPipelines(m_device, pipelineCache, 1, &createInfo, nullptr, &vkPipeline)
-        );
+        // Try to create the pipeline from the pipeline cache first, without creating the shader modules.
+        VkResult result = VK_PIPELINE_COMPILE_REQUIRED_EXT;
+        std::vector<VkPipelineShaderStageCreateInfo> identifierStageCreateInfos;
+        std::vector<VkPipelineShaderStageModuleIdentifierCreateInfoEXT> identifierCreateInfos;
+        if (program->getIdentifierStageCreateInfos(identifierStageCreateInfos, identifierCreateInfos))
+        {
+            VkGraphicsPipelineCreateInfo identifierCreateInfo = createInfo;
+            identifierCreateInfo.flags |= VK_PIPELINE_CREATE_FAIL_ON_PIPELINE_COMPILE_REQUIRED_BIT_EXT;
+            identifierCreateInfo.pStages = identifierStageCreateInfos.data();
+            result = m_api.vkCreateGraphicsPipelines(
+                m_device,
+                m_pipelineCache,
+                1,
+                &identifierCreateInfo,
+                nullptr,
+                &vkPipeline
+            );
+            if (result != VK_PIPELINE_COMPILE_REQUIRED_EXT)
+                SLANG_VK_RETURN_ON_FAIL(result);
+        }
+        if (result == VK_PIPELINE_COMPILE_REQUIRED_EXT)
+        {
+            SLANG_RETURN_ON_FAIL(program->ensureShaderModules());
+            SLANG_VK_RETURN_ON_FAIL(
+                m_api.vkCreateGraphicsPipelines(m_device, m_pipelineCache, 1, &createInfo, nullptr, &vkPipeline)
+            );
+        }
     }
 
     RefPtr<RenderPipelineImpl> pipeline = new RenderPipelineImpl();
@@ -244,15 +281,60 @@ Result DeviceImpl::createRenderPipeline2(const RenderPipelineDesc& desc, IRender
     pipeline->m_program = program;
     pipeline->m_rootObjectLayout = program->m_rootObjectLayout;
     pipeline->m_pipeline = vkPipeline;
+    if (linkedFromLibraries)
+        optimizeRenderPipeline(pipeline, libraries);
     returnComPtr(outPipeline, pipeline);
     return SLANG_OK;
 }
 
+void DeviceImpl::optimizeRenderPipeline(RenderPipelineImpl* pipeline, const RenderPipelineLibraries& libraries)
+{
+    // The worker only gets the libraries, the pipeline is kept alive by the pending list.
+    PendingRenderPipelineOptimization pending;
+    pending.pipeline = pipeline;
+    pending.optimizedPipeline = std::make_shared<VkPipeline>(VK_NULL_HANDLE);
+    pending.task = m_pipelineCompileThreadPool->submit(
+        [this, libraries, optimizedPipeline = pending.optimizedPipeline]()
+        {
+            // Keep using the unoptimized pipeline if linking fails.
+            if (SLANG_FAILED(m_pipelineLibraryCache.linkOptimizedRenderPipeline(libraries, optimizedPipeline.get())))
+                *optimizedPipeline = VK_NULL_HANDLE;
+        }
+    );
+    std::lock_guard<std::mutex> lock(m_pendingRenderPipelineOptimizationsMutex);
+    m_pendingRenderPipelineOptimizations.push_back(std::move(pending));
+}
+
+void DeviceImpl::publishOptimizedRenderPipelines()
+{
+    std::lock_guard<std::mutex> lock(m_pendingRenderPipelineOptimizationsMutex);
+    auto& pendingList = m_pendingRenderPipelineOptimizations;
+    for (auto it = pendingList.begin(); it != pendingList.end();)
+    {
+        if (!it->task->isDone())
+        {
+            ++it;
+            continue;
+        }
+        VkPipeline optimizedPipeline = *it->optimizedPipeline;
+        if (optimizedPipeline != VK_NULL_HANDLE)
+        {
+            // Command buffers recorded with the unoptimized pipeline may still be in flight.
+            RetiredObjects retired(this);
+            retired.add(VK_OBJECT_TYPE_PIPELINE, (uint64_t)it->pipeline->m_pipeline.exchange(optimizedPipeline));
+            retireObjects(std::move(retired));
+        }
+        it = pendingList.erase(it);
+    }
+}
+
 ComputePipelineImpl::~ComputePipelineImpl()
 {
     if (m_pipeline != VK_NULL_HANDLE)
     {
-        m_device->m_api.vkDestroyPipeline(m_device->m_api.m_device, m_pipeline, nullptr);
+        RetiredObjects retired(m_device);
+        retired.add(VK_OBJECT_TYPE_PIPELINE, (uint64_t)m_pipeline);
+        m_device->retireObjects(std::move(retired));
     }
 }
 
@@ -273,12 +355,14 @@ Result DeviceImpl::createComputePipeline2(const ComputePipelineDesc& desc, IComp
 
     VkPipeline vkPipeline = VK_NULL_HANDLE;
 
+    // The stage is set once the shader module is created.
     VkComputePipelineCreateInfo createInfo = {VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO};
-    createInfo.stage = program->m_stageCreateInfos[0];
     createInfo.layout = program->m_rootObjectLayout->m_pipelineLayout;
 
     if (m_pipelineCreationAPIDispatcher)
     {
+        SLANG_RETURN_ON_FAIL(program->ensureShaderModules());
+        createInfo.stage = program->m_stageCreateInfos[0];
         SLANG_RETURN_ON_FAIL(
             m_pipelineCreationAPIDispatcher
                 ->createComputePipeline(this, program->linkedProgram.get(), &createInfo, (void**)&vkPipeline)
@@ -286,10 +370,34 @@ Result DeviceImpl::createComputePipeline2(const ComputePipelineDesc& desc, IComp
     }
     else
     {
-        VkPipelineCache pipelineCache = VK_NULL_HANDLE;
-        SLANG_VK_RETURN_ON_FAIL(
-            m_api.vkCreateComputePipelines(m_device, pipelineCache, 1, &createInfo, nullptr, &vkPipeline)
-        );
+        // Try to create the pipeline from the pipeline cache first, without creating the shader module.
+        VkResult result = VK_PIPELINE_COMPILE_REQUIRED_EXT;
+        std::vector<VkPipelineShaderStageCreateInfo> identifierStageCreateInfos;
+        std::vector<VkPipelineShaderStageModuleIdentifierCreateInfoEXT> identifierCreateInfos;
+        if (program->getIdentifierStageCreateInfos(identifierStageCreateInfos, identifierCreateInfos))
+        {
+            VkComputePipelineCreateInfo identifierCreateInfo = createInfo;
+            identifierCreateInfo.flags |= VK_PIPELINE_CREATE_FAIL_ON_PIPELINE_COMPILE_REQUIRED_BIT_EXT;
+            identifierCreateInfo.stage = identifierStageCreateInfos[0];
+            result = m_api.vkCreateComputePipelines(
+                m_device,
+                m_pipelineCache,
+                1,
+                &identifierCreateInfo,
+                nullptr,
+                &vkPipeline
+            );
+            if (result != VK_PIPELINE_COMPILE_REQUIRED_EXT)
+                SLANG_VK_RETURN_ON_FAIL(result);
+        }
+        if (result == VK_PIPELINE_COMPILE_REQUIRED_EXT)
+        {
+            SLANG_RETURN_ON_FAIL(program->ensureShaderModules());
+            createInfo.stage = program->m_stageCreateInfos[0];
+            SLANG_VK_RETURN_ON_FAIL(
+                m_api.vkCreateComputePipelines(m_device, m_pipelineCache, 1, &createInfo, nullptr, &vkPipeline)
+            );
+        }
     }
 
     RefPtr<ComputePipelineImpl> pipeline = new ComputePipelineImpl();
@@ -305,7 +413,9 @@ RayTracingPipelineImpl::~RayTracingPipelineImpl()
 {
     if (m_pipeline != VK_NULL_HANDLE)
     {
-        m_device->m_api.vkDestroyPipeline(m_device->m_api.m_device, m_pipeline, nullptr);
+        RetiredObjects retired(m_device);
+        retired.add(VK_OBJECT_TYPE_PIPELINE, (uint64_t)m_pipeline);
+        m_device->retireObjects(std::move(retired));
     }
 }
 
@@ -336,6 +446,7 @@ Result DeviceImpl::createRayTracingPipeline2(const RayTracingPipelineDesc& desc,
     {
         SLANG_RETURN_ON_FAIL(program->compileShaders(this));
     }
+    SLANG_RETURN_ON_FAIL(program->ensureShaderModules());
 
     VkRayTracingPipelineCreateInfoKHR createInfo = {VK_STRUCTURE_TYPE_RAY_TRACING_PIPELINE_CREATE_INFO_KHR};
     createInfo.pNext = nullptr;
@@ -422,11 +533,10 @@ Result DeviceImpl::createRayTracingPipeline2(const RayTracingPipelineDesc& desc,
     }
 
     VkPipeline vkPipeline = VK_NULL_HANDLE;
-    VkPipelineCache pipelineCache = VK_NULL_HANDLE;
     SLANG_VK_RETURN_ON_FAIL(m_api.vkCreateRayTracingPipelinesKHR(
         m_device,
         VK_NULL_HANDLE,
-        pipelineCache,
+        m_pipelineCache,
         1,
         &createInfo,
         nullptr,
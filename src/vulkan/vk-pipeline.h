@@ -1,7 +1,9 @@
 #pragma once
 
 #include "vk-base.h"
+#include "vk-pipeline-library.h"
 
+#include <atomic>
 #include <map>
 #include <string>
 
@@ -12,7 +14,9 @@ class RenderPipelineImpl : public RenderPipeline
 public:
     DeviceImpl* m_device;
     RefPtr<RootShaderObjectLayout> m_rootObjectLayout;
-    VkPipeline m_pipeline = VK_NULL_HANDLE;
+    /// Pipelines linked from pipeline libraries are replaced by an optimized pipeline once it is built in the
+    /// background (see `DeviceImpl::publishOptimizedRenderPipelines`).
+    std::atomic<VkPipeline> m_pipeline = VK_NULL_HANDLE;
 
     ~RenderPipelineImpl();
 
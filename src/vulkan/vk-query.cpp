@@ -36,7 +36,9 @@ Result QueryPoolImpl::init(const QueryPoolDesc& desc, DeviceImpl* device)
 
 QueryPoolImpl::~QueryPoolImpl()
 {
-    m_device->m_api.vkDestroyQueryPool(m_device->m_api.m_device, m_pool, nullptr);
+    RetiredObjects retired(m_device);
+    retired.add(VK_OBJECT_TYPE_QUERY_POOL, (uint64_t)m_pool);
+    m_device->retireObjects(std::move(retired));
 }
 
 Result QueryPoolImpl::getResult(GfxIndex index, GfxCount count, uint64_t* data)
@@ -0,0 +1,227 @@
+#include "vk-readback.h"
+#include "vk-device.h"
+#include "vk-buffer.h"
+#include "vk-command.h"
+#include "vk-util.h"
+
+#include <algorithm>
+
+namespace rhi::vk {
+
+// ----------------------------------------------------------------------------
+// ReadbackRing
+// ----------------------------------------------------------------------------
+
+void ReadbackRing::close()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pages.clear();
+    m_currentPage = nullptr;
+}
+
+Result ReadbackRing::allocate(Size size, Page*& outPage, Offset& outOffset)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    uint64_t lastFinishedID = m_device->m_queue->updateLastFinishedID();
+    auto isIdle = [&](const Page* page) { return page->liveCount == 0 && page->lastSubmissionID <= lastFinishedID; };
+
+    // Free dedicated pages that are no longer in use.
+    m_pages.erase(
+        std::remove_if(
+            m_pages.begin(),
+            m_pages.end(),
+            [&](const std::unique_ptr<Page>& page) { return page->dedicated && isIdle(page.get()); }
+        ),
+        m_pages.end()
+    );
+
+    if (size > kPageSize)
+    {
+        SLANG_RETURN_ON_FAIL(createPage(size, true, outPage));
+        outPage->liveCount++;
+        outOffset = 0;
+        return SLANG_OK;
+    }
+
+    if (!m_currentPage || m_currentPage->usedSize + size > m_currentPage->size)
+    {
+        m_currentPage = nullptr;
+        for (const auto& page : m_pages)
+        {
+            if (!page->dedicated && isIdle(page.get()))
+            {
+                page->usedSize = 0;
+                m_currentPage = page.get();
+                break;
+            }
+        }
+        if (!m_currentPage)
+            SLANG_RETURN_ON_FAIL(createPage(kPageSize, false, m_currentPage));
+    }
+
+    outPage = m_currentPage;
+    outOffset = m_currentPage->usedSize;
+    m_currentPage->usedSize += (size + kAlignment - 1) / kAlignment * kAlignment;
+    m_currentPage->liveCount++;
+    return SLANG_OK;
+}
+
+void ReadbackRing::release(Page* page)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SLANG_RHI_ASSERT(page->liveCount > 0);
+    page->liveCount--;
+}
+
+Result ReadbackRing::submit(ICommandEncoder* encoder, Page* page, uint64_t& outSubmissionID)
+{
+    ComPtr<ICommandBuffer> commandBuffer;
+    SLANG_RETURN_ON_FAIL(encoder->finish(commandBuffer.writeRef()));
+    SLANG_RETURN_ON_FAIL(m_device->m_queue->submit(1, commandBuffer.readRef(), nullptr, 0));
+    outSubmissionID = m_device->m_queue->m_lastSubmittedID;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    page->lastSubmissionID = std::max(page->lastSubmissionID, outSubmissionID);
+    return SLANG_OK;
+}
+
+Result ReadbackRing::createPage(Size size, bool dedicated, Page*& outPage)
+{
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = size;
+    bufferDesc.usage = BufferUsage::CopyDestination;
+    bufferDesc.defaultState = ResourceState::CopyDestination;
+    bufferDesc.memoryType = MemoryType::ReadBack;
+    ComPtr<IBuffer> buffer;
+    SLANG_RETURN_ON_FAIL(m_device->createBuffer(bufferDesc, nullptr, buffer.writeRef()));
+
+    auto page = std::make_unique<Page>();
+    page->buffer = checked_cast<BufferImpl*>(buffer.get());
+    page->size = size;
+    page->dedicated = dedicated;
+    outPage = page.get();
+    m_pages.push_back(std::move(page));
+    return SLANG_OK;
+}
+
+// ----------------------------------------------------------------------------
+// ReadbackImpl
+// ----------------------------------------------------------------------------
+
+ReadbackImpl::ReadbackImpl(DeviceImpl* device)
+    : m_device(device)
+{
+}
+
+ReadbackImpl::~ReadbackImpl()
+{
+    if (m_page)
+        m_device->m_readbackRing.release(m_page);
+}
+
+bool ReadbackImpl::isReady()
+{
+    return m_device->m_queue->updateLastFinishedID() >= m_submissionID;
+}
+
+Result ReadbackImpl::wait(uint64_t timeout)
+{
+    if (isReady())
+        return SLANG_OK;
+
+    auto& api = m_device->m_api;
+    VkSemaphoreWaitInfo waitInfo = {VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO};
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &m_device->m_queue->m_trackingSemaphore;
+    waitInfo.pValues = &m_submissionID;
+    VkResult result = api.vkWaitSemaphores(api.m_device, &waitInfo, timeout);
+    if (result == VK_TIMEOUT)
+        return SLANG_E_TIME_OUT;
+    return result == VK_SUCCESS ? SLANG_OK : SLANG_FAIL;
+}
+
+Result ReadbackImpl::getData(const void** outData, Size* outSize)
+{
+    if (!isReady())
+        return SLANG_E_PENDING;
+    *outData = (const uint8_t*)m_page->buffer->m_buffer.getMappedData() + m_offset;
+    *outSize = m_size;
+    return SLANG_OK;
+}
+
+// ----------------------------------------------------------------------------
+// DeviceImpl
+// ----------------------------------------------------------------------------
+
+Result DeviceImpl::readTextureAsync(ITexture* texture, IReadback** outReadback)
+{
+    TextureImpl* textureImpl = checked_cast<TextureImpl*>(texture);
+
+    // Use the same layout as readTexture: all subresources tightly packed, array layer major.
+    const TextureDesc& desc = textureImpl->m_desc;
+    const FormatInfo& formatInfo = getFormatInfo(desc.format);
+    Size pixelSize = formatInfo.blockSizeInBytes / formatInfo.pixelsPerBlock;
+    Size rowPitch = desc.size.width * pixelSize;
+    int arrayLayerCount = desc.arrayLength * (desc.type == TextureType::TextureCube ? 6 : 1);
+
+    Size layerSize = 0;
+    for (int j = 0; j < desc.mipLevelCount; ++j)
+    {
+        Extents mipSize = calcMipSize(desc.size, j);
+        layerSize += calcRowSize(desc.format, mipSize.width) * calcNumRows(desc.format, mipSize.height) * mipSize.depth;
+    }
+    Size bufferSize = layerSize * arrayLayerCount;
+
+    RefPtr<ReadbackImpl> readback = new ReadbackImpl(this);
+    SLANG_RETURN_ON_FAIL(m_readbackRing.allocate(bufferSize, readback->m_page, readback->m_offset));
+    readback->m_size = bufferSize;
+    readback->m_rowPitch = rowPitch;
+    readback->m_pixelSize = pixelSize;
+
+    ComPtr<ICommandEncoder> encoder;
+    SLANG_RETURN_ON_FAIL(m_queue->createCommandEncoder(encoder.writeRef()));
+    Offset dstOffset = readback->m_offset;
+    for (int i = 0; i < arrayLayerCount; ++i)
+    {
+        for (int j = 0; j < desc.mipLevelCount; ++j)
+        {
+            Extents mipSize = calcMipSize(desc.size, j);
+            Size rowSize = calcRowSize(desc.format, mipSize.width);
+            Size mipLevelSize = rowSize * calcNumRows(desc.format, mipSize.height) * mipSize.depth;
+            SubresourceRange srcSubresource = {j, 1, i, 1};
+            encoder->copyTextureToBuffer(
+                readback->m_page->buffer,
+                dstOffset,
+                mipLevelSize,
+                rowSize,
+                texture,
+                srcSubresource,
+                Offset3D(0, 0, 0),
+                mipSize
+            );
+            dstOffset += mipLevelSize;
+        }
+    }
+    SLANG_RETURN_ON_FAIL(m_readbackRing.submit(encoder, readback->m_page, readback->m_submissionID));
+
+    returnComPtr(outReadback, readback);
+    return SLANG_OK;
+}
+
+Result DeviceImpl::readBufferAsync(IBuffer* buffer, Offset offset, Size size, IReadback** outReadback)
+{
+    RefPtr<ReadbackImpl> readback = new ReadbackImpl(this);
+    SLANG_RETURN_ON_FAIL(m_readbackRing.allocate(size, readback->m_page, readback->m_offset));
+    readback->m_size = size;
+
+    ComPtr<ICommandEncoder> encoder;
+    SLANG_RETURN_ON_FAIL(m_queue->createCommandEncoder(encoder.writeRef()));
+    encoder->copyBuffer(readback->m_page->buffer, readback->m_offset, buffer, offset, size);
+    SLANG_RETURN_ON_FAIL(m_readbackRing.submit(encoder, readback->m_page, readback->m_submissionID));
+
+    returnComPtr(outReadback, readback);
+    return SLANG_OK;
+}
+
+} // namespace rhi::vk
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "vk-base.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace rhi::vk {
+
+/// Ring of persistently mapped readback buffers used for asynchronous readbacks.
+/// Readbacks are sub-allocated from the current page. A page is recycled once all readbacks
+/// referencing it have been released and the GPU has finished writing to it.
+/// Readbacks larger than a page get a dedicated page which is freed after use.
+class ReadbackRing
+{
+public:
+    static constexpr Size kPageSize = 4 * 1024 * 1024;
+    static constexpr Size kAlignment = 256;
+
+    struct Page
+    {
+        RefPtr<BufferImpl> buffer;
+        Size size = 0;
+        Size usedSize = 0;
+        uint32_t liveCount = 0;
+        uint64_t lastSubmissionID = 0;
+        bool dedicated = false;
+    };
+
+    void init(DeviceImpl* device) { m_device = device; }
+    void close();
+
+    Result allocate(Size size, Page*& outPage, Offset& outOffset);
+    void release(Page* page);
+
+    /// Submits the recorded copy commands and marks the page as written by the submission.
+    Result submit(ICommandEncoder* encoder, Page* page, uint64_t& outSubmissionID);
+
+private:
+    Result createPage(Size size, bool dedicated, Page*& outPage);
+
+    DeviceImpl* m_device = nullptr;
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<Page>> m_pages;
+    Page* m_currentPage = nullptr;
+};
+
+class ReadbackImpl : public Readback
+{
+public:
+    RefPtr<DeviceImpl> m_device;
+    ReadbackRing::Page* m_page = nullptr;
+    Offset m_offset = 0;
+    Size m_size = 0;
+    uint64_t m_submissionID = 0;
+
+    ReadbackImpl(DeviceImpl* device);
+    ~ReadbackImpl();
+
+    // IReadback implementation
+    virtual SLANG_NO_THROW bool SLANG_MCALL isReady() override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL wait(uint64_t timeout) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL getData(const void** outData, Size* outSize) override;
+};
+
+} // namespace rhi::vk
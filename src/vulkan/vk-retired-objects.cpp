@@ -0,0 +1,72 @@
+#include "vk-retired-objects.h"
+#include "vk-device.h"
+
+namespace rhi::vk {
+
+RetiredObjects::RetiredObjects(RetiredObjects&& other)
+    : m_device(other.m_device)
+    , m_handles(std::move(other.m_handles))
+    , m_allocations(std::move(other.m_allocations))
+{
+    other.m_handles.clear();
+    other.m_allocations.clear();
+}
+
+RetiredObjects::~RetiredObjects()
+{
+    destroy();
+}
+
+void RetiredObjects::destroy()
+{
+    auto& api = m_device->m_api;
+    // Views are destroyed before the objects they reference.
+    for (const Handle& handle : m_handles)
+    {
+        switch (handle.type)
+        {
+        case VK_OBJECT_TYPE_BUFFER_VIEW:
+            api.vkDestroyBufferView(api.m_device, (VkBufferView)handle.handle, nullptr);
+            break;
+        case VK_OBJECT_TYPE_IMAGE_VIEW:
+            api.vkDestroyImageView(api.m_device, (VkImageView)handle.handle, nullptr);
+            break;
+        case VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_KHR:
+            api.vkDestroyAccelerationStructureKHR(api.m_device, (VkAccelerationStructureKHR)handle.handle, nullptr);
+            break;
+        default:
+            break;
+        }
+    }
+    for (const Handle& handle : m_handles)
+    {
+        switch (handle.type)
+        {
+        case VK_OBJECT_TYPE_BUFFER:
+            api.vkDestroyBuffer(api.m_device, (VkBuffer)handle.handle, nullptr);
+            break;
+        case VK_OBJECT_TYPE_IMAGE:
+            api.vkDestroyImage(api.m_device, (VkImage)handle.handle, nullptr);
+            break;
+        case VK_OBJECT_TYPE_PIPELINE:
+            api.vkDestroyPipeline(api.m_device, (VkPipeline)handle.handle, nullptr);
+            break;
+        case VK_OBJECT_TYPE_SAMPLER:
+            api.vkDestroySampler(api.m_device, (VkSampler)handle.handle, nullptr);
+            break;
+        case VK_OBJECT_TYPE_QUERY_POOL:
+            api.vkDestroyQueryPool(api.m_device, (VkQueryPool)handle.handle, nullptr);
+            break;
+        default:
+            break;
+        }
+    }
+    for (MemoryAllocation& allocation : m_allocations)
+    {
+        m_device->m_memoryAllocator.free(allocation);
+    }
+    m_handles.clear();
+    m_allocations.clear();
+}
+
+} // namespace rhi::vk
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "vk-base.h"
+
+#include "core/short_vector.h"
+
+namespace rhi::vk {
+
+/// Vulkan objects released by the host that may still be used by submitted command buffers.
+/// The objects are destroyed together when the last reference is dropped. References are held by the
+/// retirement lists of all queues that had submissions in flight when the objects were released
+/// (see `DeviceImpl::retireObjects`).
+class RetiredObjects
+{
+public:
+    explicit RetiredObjects(DeviceImpl* device)
+        : m_device(device)
+    {
+    }
+
+    RetiredObjects(const RetiredObjects&) = delete;
+    RetiredObjects& operator=(const RetiredObjects&) = delete;
+    RetiredObjects(RetiredObjects&& other);
+    ~RetiredObjects();
+
+    void add(VkObjectType type, uint64_t handle)
+    {
+        if (handle)
+            m_handles.push_back({type, handle});
+    }
+    void add(const MemoryAllocation& allocation)
+    {
+        if (allocation.isValid())
+            m_allocations.push_back(allocation);
+    }
+
+    bool isEmpty() const { return m_handles.empty() && m_allocations.empty(); }
+
+    /// Destroy the objects now.
+    void destroy();
+
+private:
+    struct Handle
+    {
+        VkObjectType type;
+        uint64_t handle;
+    };
+
+    DeviceImpl* m_device;
+    short_vector<Handle, 4> m_handles;
+    short_vector<MemoryAllocation, 1> m_allocations;
+};
+
+} // namespace rhi::vk
@@ -11,7 +11,9 @@ SamplerImpl::SamplerImpl(DeviceImpl* device, const SamplerDesc& desc)
 
 SamplerImpl::~SamplerImpl()
 {
-    m_device->m_api.vkDestroySampler(m_device->m_api.m_device, m_sampler, nullptr);
+    RetiredObjects retired(m_device);
+    retired.add(VK_OBJECT_TYPE_SAMPLER, (uint64_t)m_sampler);
+    m_device->retireObjects(std::move(retired));
 }
 
 Result SamplerImpl::getNativeHandle(NativeHandle* outHandle)
@@ -0,0 +1,106 @@
+#include "vk-shader-module-cache.h"
+#include "vk-device.h"
+#include "vk-util.h"
+
+#include <cstring>
+#include <string_view>
+
+namespace rhi::vk {
+
+void ShaderModuleCache::init(DeviceImpl* device)
+{
+    m_device = device;
+    m_hasIdentifiers = device->m_api.m_extendedFeatures.shaderModuleIdentifierFeatures.shaderModuleIdentifier &&
+                       device->m_api.vkGetShaderModuleCreateInfoIdentifierEXT;
+}
+
+void ShaderModuleCache::close()
+{
+    auto& api = m_device->m_api;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& it : m_modules)
+    {
+        if (it.second->module)
+            api.vkDestroyShaderModule(api.m_device, it.second->module, nullptr);
+    }
+    m_modules.clear();
+}
+
+Result ShaderModuleCache::acquire(ISlangBlob* code, ShaderModule** outModule)
+{
+    const char* codeData = (const char*)code->getBufferPointer();
+    size_t codeSize = code->getBufferSize();
+    size_t hash = std::hash<std::string_view>()(std::string_view(codeData, codeSize));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto range = m_modules.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        ShaderModule* module = it->second.get();
+        if (module->code->getBufferSize() == codeSize &&
+            ::memcmp(module->code->getBufferPointer(), codeData, codeSize) == 0)
+        {
+            module->refCount++;
+            *outModule = module;
+            return SLANG_OK;
+        }
+    }
+
+    auto module = std::make_unique<ShaderModule>();
+    module->code = code;
+    module->hash = hash;
+    module->refCount = 1;
+    if (m_hasIdentifiers)
+    {
+        VkShaderModuleCreateInfo createInfo = {VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
+        createInfo.pCode = (const uint32_t*)codeData;
+        createInfo.codeSize = codeSize;
+        m_device->m_api.vkGetShaderModuleCreateInfoIdentifierEXT(
+            m_device->m_api.m_device,
+            &createInfo,
+            &module->identifier
+        );
+    }
+    *outModule = module.get();
+    m_modules.emplace(hash, std::move(module));
+    return SLANG_OK;
+}
+
+void ShaderModuleCache::release(ShaderModule* module)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (--module->refCount > 0)
+        return;
+    auto range = m_modules.equal_range(module->hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second.get() == module)
+        {
+            // Pipelines created from the module do not reference it, so it can be destroyed right away.
+            // Pipeline libraries are keyed by the module address, so they are evicted before the address is reused.
+            m_device->m_pipelineLibraryCache.evictModule(module);
+            if (module->module)
+                m_device->m_api.vkDestroyShaderModule(m_device->m_api.m_device, module->module, nullptr);
+            m_modules.erase(it);
+            return;
+        }
+    }
+}
+
+Result ShaderModuleCache::getShaderModule(ShaderModule* module, VkShaderModule* outShaderModule)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!module->module)
+    {
+        VkShaderModuleCreateInfo createInfo = {VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
+        createInfo.pCode = (const uint32_t*)module->code->getBufferPointer();
+        createInfo.codeSize = module->code->getBufferSize();
+        SLANG_VK_RETURN_ON_FAIL(
+            m_device->m_api.vkCreateShaderModule(m_device->m_api.m_device, &createInfo, nullptr, &module->module)
+        );
+    }
+    *outShaderModule = module->module;
+    return SLANG_OK;
+}
+
+} // namespace rhi::vk
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "vk-base.h"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace rhi::vk {
+
+/// SPIR-V code shared by all programs compiling to the same code.
+struct ShaderModule
+{
+    ComPtr<ISlangBlob> code;
+    size_t hash = 0;
+    /// Created on first use (see `ShaderModuleCache::getShaderModule`).
+    VkShaderModule module = VK_NULL_HANDLE;
+    /// Identifier of the code (identifierSize is 0 if VK_EXT_shader_module_identifier is not enabled).
+    VkShaderModuleIdentifierEXT identifier = {VK_STRUCTURE_TYPE_SHADER_MODULE_IDENTIFIER_EXT};
+    /// Number of programs referencing the module.
+    uint32_t refCount = 0;
+};
+
+/// Device wide cache of shader modules, keyed by a hash of the SPIR-V code.
+/// Specializations compiling to identical SPIR-V share one VkShaderModule, which is destroyed once the last
+/// program referencing it is released.
+/// If VK_EXT_shader_module_identifier is enabled, the identifier of the code is computed without creating the
+/// module, and the module is only created once a pipeline can not be created from the pipeline cache by the
+/// identifier alone.
+class ShaderModuleCache
+{
+public:
+    void init(DeviceImpl* device);
+    void close();
+
+    bool hasIdentifiers() const { return m_hasIdentifiers; }
+
+    /// Get the module for `code` and add a reference to it.
+    Result acquire(ISlangBlob* code, ShaderModule** outModule);
+    /// Drop a reference added by `acquire`.
+    void release(ShaderModule* module);
+
+    /// Get the VkShaderModule of `module`, creating it if needed.
+    Result getShaderModule(ShaderModule* module, VkShaderModule* outShaderModule);
+
+private:
+    DeviceImpl* m_device = nullptr;
+    bool m_hasIdentifiers = false;
+    std::mutex m_mutex;
+    std::unordered_multimap<size_t, std::unique_ptr<ShaderModule>> m_modules;
+};
+
+} // namespace rhi::vk
@@ -597,15 +597,6 @@ Result ShaderObjectLayoutImpl::createForElementType(
     return builder.build(outLayout);
 }
 
-ShaderObjectLayoutImpl::~ShaderObjectLayoutImpl()
-{
-    for (auto& descSetInfo : m_descriptorSetInfos)
-    {
-        getDevice()
-            ->m_api.vkDestroyDescriptorSetLayout(getDevice()->m_api.m_device, descSetInfo.descriptorSetLayout, nullptr);
-    }
-}
-
 Result ShaderObjectLayoutImpl::_init(Builder const* builder)
 {
     auto device = builder->m_device;
@@ -627,18 +618,14 @@ Result ShaderObjectLayoutImpl::_init(Builder const* builder)
 
     m_containerType = builder->m_containerType;
 
-    // Create VkDescriptorSetLayout for all descriptor sets.
+    // Get the VkDescriptorSetLayout for all descriptor sets.
+    // Layouts are owned by the device wide layout cache and shared between identical descriptor sets.
     for (auto& descriptorSetInfo : m_descriptorSetInfos)
     {
-        VkDescriptorSetLayoutCreateInfo createInfo = {};
-        createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-        createInfo.pBindings = descriptorSetInfo.vkBindings.data();
-        createInfo.bindingCount = (uint32_t)descriptorSetInfo.vkBindings.size();
-        VkDescriptorSetLayout vkDescSetLayout;
-        SLANG_RETURN_ON_FAIL(
-            device->m_api.vkCreateDescriptorSetLayout(device->m_api.m_device, &createInfo, nullptr, &vkDescSetLayout)
-        );
-        descriptorSetInfo.descriptorSetLayout = vkDescSetLayout;
+        SLANG_RETURN_ON_FAIL(device->m_layoutCache.getDescriptorSetLayout(
+            descriptorSetInfo.vkBindings,
+            &descriptorSetInfo.descriptorSetLayout
+        ));
     }
     return SLANG_OK;
 }
@@ -680,14 +667,6 @@ Result EntryPointLayout::_init(Builder const* builder)
     return SLANG_OK;
 }
 
-RootShaderObjectLayout::~RootShaderObjectLayout()
-{
-    if (m_pipelineLayout)
-    {
-        m_device->m_api.vkDestroyPipelineLayout(m_device->m_api.m_device, m_pipelineLayout, nullptr);
-    }
-}
-
 Index RootShaderObjectLayout::findEntryPointIndex(VkShaderStageFlags stage)
 {
     auto entryPointCount = m_entryPoints.size();
@@ -770,20 +749,14 @@ Result RootShaderObjectLayout::_init(Builder const* builder)
     // Once we've collected the information across the entire
     // tree of sub-objects
 
-    // Now call Vulkan API to create a pipeline layout.
-    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = {};
-    pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipelineLayoutCreateInfo.setLayoutCount = (uint32_t)m_vkDescriptorSetLayouts.size();
-    pipelineLayoutCreateInfo.pSetLayouts = m_vkDescriptorSetLayouts.data();
-    if (m_allPushConstantRanges.size())
-    {
-        pipelineLayoutCreateInfo.pushConstantRangeCount = (uint32_t)m_allPushConstantRanges.size();
-        pipelineLayoutCreateInfo.pPushConstantRanges = m_allPushConstantRanges.data();
-    }
-    SLANG_RETURN_ON_FAIL(
-        m_device->m_api
-            .vkCreatePipelineLayout(m_device->m_api.m_device, &pipelineLayoutCreateInfo, nullptr, &m_pipelineLayout)
-    );
+    // Now get the pipeline layout from the device wide layout cache.
+    // Programs with identical layouts (e.g. different specializations) share the same pipeline layout.
+    SLANG_RETURN_ON_FAIL(m_device->m_layoutCache.getPipelineLayout(
+        m_vkDescriptorSetLayouts.data(),
+        (uint32_t)m_vkDescriptorSetLayouts.size(),
+        m_allPushConstantRanges,
+        &m_pipelineLayout
+    ));
     return SLANG_OK;
 }
 
@@ -220,8 +220,6 @@ public:
         ShaderObjectLayoutImpl** outLayout
     );
 
-    ~ShaderObjectLayoutImpl();
-
     /// Get the number of descriptor sets that are allocated for this object itself
     /// (if it needed to be bound as a parameter block).
     ///
@@ -347,8 +345,6 @@ class RootShaderObjectLayout : public ShaderObjectLayoutImpl
     typedef ShaderObjectLayoutImpl Super;
 
 public:
-    ~RootShaderObjectLayout();
-
     /// Information stored for each entry point of the program
     struct EntryPointInfo
     {
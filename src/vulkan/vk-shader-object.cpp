@@ -1051,6 +1051,40 @@ void ShaderObjectImpl::setResourceStates(StateTracking& stateTracking) const
     }
 }
 
+void ShaderObjectImpl::getResources(std::vector<IResource*>& outResources) const
+{
+    for (const ResourceSlot& slot : m_resources)
+    {
+        switch (slot.type)
+        {
+        case BindingType::Buffer:
+            outResources.push_back(checked_cast<BufferImpl*>(slot.resource.get()));
+            break;
+        case BindingType::TextureView:
+            outResources.push_back(checked_cast<TextureViewImpl*>(slot.resource.get())->m_texture.get());
+            break;
+        default:
+            break;
+        }
+    }
+
+    for (const CombinedTextureSamplerSlot& slot : m_combinedTextureSamplers)
+    {
+        if (slot.textureView)
+        {
+            outResources.push_back(slot.textureView->m_texture.get());
+        }
+    }
+
+    for (auto& subObject : m_objects)
+    {
+        if (subObject)
+        {
+            subObject->getResources(outResources);
+        }
+    }
+}
+
 Result ShaderObjectImpl::_getSpecializedLayout(ShaderObjectLayoutImpl** outLayout)
 {
     if (!m_specializedLayout)
@@ -1190,6 +1224,15 @@ void RootShaderObjectImpl::setResourceStates(StateTracking& stateTracking)
     }
 }
 
+void RootShaderObjectImpl::getResources(std::vector<IResource*>& outResources) const
+{
+    ShaderObjectImpl::getResources(outResources);
+    for (auto& entryPoint : m_entryPoints)
+    {
+        entryPoint->getResources(outResources);
+    }
+}
+
 Result RootShaderObjectImpl::bindAsRoot(BindingContext& context, RootShaderObjectLayout* layout)
 {
     BindingOffset offset = {};
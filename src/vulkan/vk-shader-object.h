@@ -224,6 +224,9 @@ public:
 
     void setResourceStates(StateTracking& stateTracking) const;
 
+    /// Append the buffers and textures bound to this object and its sub-objects.
+    void getResources(std::vector<IResource*>& outResources) const;
+
     std::vector<ResourceSlot> m_resources;
     std::vector<RefPtr<SamplerImpl>> m_samplers;
     std::vector<CombinedTextureSamplerSlot> m_combinedTextureSamplers;
@@ -277,6 +280,8 @@ public:
 
     void setResourceStates(StateTracking& stateTracking);
 
+    void getResources(std::vector<IResource*>& outResources) const;
+
     /// Bind this object as a root shader object
     Result bindAsRoot(BindingContext& context, RootShaderObjectLayout* layout);
 
@@ -7,18 +7,13 @@ namespace rhi::vk {
 ShaderProgramImpl::ShaderProgramImpl(DeviceImpl* device)
     : m_device(device)
 {
-    for (auto& shaderModule : m_modules)
-        shaderModule = VK_NULL_HANDLE;
 }
 
 ShaderProgramImpl::~ShaderProgramImpl()
 {
-    for (auto shaderModule : m_modules)
+    for (ShaderModule* module : m_modules)
     {
-        if (shaderModule != VK_NULL_HANDLE)
-        {
-            m_device->m_api.vkDestroyShaderModule(m_device->m_api.m_device, shaderModule, nullptr);
-        }
+        m_device->m_shaderModuleCache.release(module);
     }
 }
 
@@ -27,50 +22,68 @@ void ShaderProgramImpl::comFree()
     m_device.breakStrongReference();
 }
 
-VkPipelineShaderStageCreateInfo ShaderProgramImpl::compileEntryPoint(
-    const char* entryPointName,
-    ISlangBlob* code,
-    VkShaderStageFlagBits stage,
-    VkShaderModule& outShaderModule
-)
+Result ShaderProgramImpl::ensureShaderModules()
 {
-    char const* dataBegin = (char const*)code->getBufferPointer();
-    char const* dataEnd = (char const*)code->getBufferPointer() + code->getBufferSize();
-
-    // We need to make a copy of the code, since the Slang compiler
-    // will free the memory after a compile request is closed.
-
-    VkShaderModuleCreateInfo moduleCreateInfo = {VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
-    moduleCreateInfo.pCode = (uint32_t*)code->getBufferPointer();
-    moduleCreateInfo.codeSize = code->getBufferSize();
-
-    VkShaderModule module;
-    SLANG_VK_CHECK(m_device->m_api.vkCreateShaderModule(m_device->m_device, &moduleCreateInfo, nullptr, &module));
-    outShaderModule = module;
+    if (m_shaderModulesCreated.load(std::memory_order_acquire))
+        return SLANG_OK;
 
-    VkPipelineShaderStageCreateInfo shaderStageCreateInfo = {VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO};
-    shaderStageCreateInfo.stage = stage;
+    std::lock_guard<std::mutex> lock(m_shaderModulesMutex);
+    for (size_t i = 0; i < m_modules.size(); i++)
+    {
+        if (!m_stageCreateInfos[i].module)
+        {
+            SLANG_RETURN_ON_FAIL(
+                m_device->m_shaderModuleCache.getShaderModule(m_modules[i], &m_stageCreateInfos[i].module)
+            );
+        }
+    }
+    m_shaderModulesCreated.store(true, std::memory_order_release);
+    return SLANG_OK;
+}
 
-    shaderStageCreateInfo.module = module;
-    shaderStageCreateInfo.pName = entryPointName;
+bool ShaderProgramImpl::getIdentifierStageCreateInfos(
+    std::vector<VkPipelineShaderStageCreateInfo>& outStageCreateInfos,
+    std::vector<VkPipelineShaderStageModuleIdentifierCreateInfoEXT>& outIdentifierCreateInfos
+)
+{
+    if (!m_device->m_shaderModuleCache.hasIdentifiers())
+        return false;
 
-    return shaderStageCreateInfo;
+    {
+        // Another thread may be setting the shader modules.
+        std::lock_guard<std::mutex> lock(m_shaderModulesMutex);
+        outStageCreateInfos = m_stageCreateInfos;
+    }
+    outIdentifierCreateInfos.resize(m_modules.size());
+    for (size_t i = 0; i < m_modules.size(); i++)
+    {
+        const VkShaderModuleIdentifierEXT& identifier = m_modules[i]->identifier;
+        if (identifier.identifierSize == 0)
+            return false;
+        VkPipelineShaderStageModuleIdentifierCreateInfoEXT& identifierCreateInfo = outIdentifierCreateInfos[i];
+        identifierCreateInfo = {VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_MODULE_IDENTIFIER_CREATE_INFO_EXT};
+        identifierCreateInfo.identifierSize = identifier.identifierSize;
+        identifierCreateInfo.pIdentifier = identifier.identifier;
+        outStageCreateInfos[i].module = VK_NULL_HANDLE;
+        outStageCreateInfos[i].pNext = &identifierCreateInfo;
+    }
+    return true;
 }
 
 Result ShaderProgramImpl::createShaderModule(slang::EntryPointReflection* entryPointInfo, ComPtr<ISlangBlob> kernelCode)
 {
     m_codeBlobs.push_back(kernelCode);
-    VkShaderModule shaderModule;
-    auto realEntryPointName = entryPointInfo->getNameOverride();
-    const char* spirvBinaryEntryPointName = "main";
-    m_stageCreateInfos.push_back(compileEntryPoint(
-        spirvBinaryEntryPointName,
-        kernelCode,
-        (VkShaderStageFlagBits)VulkanUtil::getShaderStage(entryPointInfo->getStage()),
-        shaderModule
-    ));
-    m_entryPointNames.push_back(realEntryPointName);
-    m_modules.push_back(shaderModule);
+    ShaderModule* module;
+    SLANG_RETURN_ON_FAIL(m_device->m_shaderModuleCache.acquire(kernelCode, &module));
+    m_modules.push_back(module);
+
+    // The VkShaderModule is created once a pipeline needs it (see `ensureShaderModules`).
+    VkPipelineShaderStageCreateInfo shaderStageCreateInfo = {VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO};
+    shaderStageCreateInfo.stage = (VkShaderStageFlagBits)VulkanUtil::getShaderStage(entryPointInfo->getStage());
+    shaderStageCreateInfo.module = VK_NULL_HANDLE;
+    shaderStageCreateInfo.pName = "main";
+    m_stageCreateInfos.push_back(shaderStageCreateInfo);
+    m_entryPointNames.push_back(entryPointInfo->getNameOverride());
     return SLANG_OK;
 }
 
@@ -2,7 +2,10 @@
 
 #include "vk-base.h"
 #include "vk-shader-object-layout.h"
+#include "vk-shader-module-cache.h"
 
+#include <atomic>
+#include <mutex>
 #include <vector>
 
 namespace rhi::vk {
@@ -18,17 +21,28 @@ public:
 
     BreakableReference<DeviceImpl> m_device;
 
+    /// Stage create infos of all entry points. The module of a stage is only set once the shader modules
+    /// are created (see `ensureShaderModules`), until then the modules must only be accessed with
+    /// `m_shaderModulesMutex` held.
     std::vector<VkPipelineShaderStageCreateInfo> m_stageCreateInfos;
     std::vector<std::string> m_entryPointNames;
     std::vector<ComPtr<ISlangBlob>> m_codeBlobs; //< To keep storage of code in scope
-    std::vector<VkShaderModule> m_modules;
+    /// Shader modules of all entry points, shared with other programs through the device shader module cache.
+    std::vector<ShaderModule*> m_modules;
     RefPtr<RootShaderObjectLayout> m_rootObjectLayout;
 
-    VkPipelineShaderStageCreateInfo compileEntryPoint(
-        const char* entryPointName,
-        ISlangBlob* code,
-        VkShaderStageFlagBits stage,
-        VkShaderModule& outShaderModule
+    std::mutex m_shaderModulesMutex;
+    std::atomic<bool> m_shaderModulesCreated{false};
+
+    /// Create the shader modules of all stages and set them in `m_stageCreateInfos`.
+    /// Pipelines may be created from multiple threads, so this is safe to call concurrently.
+    Result ensureShaderModules();
+
+    /// Get stage create infos referencing the shader modules by identifier, for creating pipelines from the
+    /// pipeline cache without creating the shader modules. Returns false if identifiers are not available.
+    bool getIdentifierStageCreateInfos(
+        std::vector<VkPipelineShaderStageCreateInfo>& outStageCreateInfos,
+        std::vector<VkPipelineShaderStageModuleIdentifierCreateInfoEXT>& outIdentifierCreateInfos
     );
 
     virtual Result createShaderModule(slang::EntryPointReflection* entryPointInfo, ComPtr<ISlangBlob> kernelCode)
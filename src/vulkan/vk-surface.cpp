@@ -212,9 +212,10 @@ Result SurfaceImpl::createSwapchain()
         textureDesc.defaultState = ResourceState::Present;
         RefPtr<TextureImpl> texture = new TextureImpl(m_device, textureDesc);
         texture->m_image = swapchainImages[i];
-        texture->m_imageMemory = 0;
         texture->m_vkformat = format;
         texture->m_isWeakImageReference = true;
+        // Swapchain images need to be in the present state at the end of every command buffer.
+        texture->m_keepDefaultState = true;
         m_textures.push_back(texture);
     }
 
@@ -10,20 +10,24 @@ TextureImpl::TextureImpl(DeviceImpl* device, const TextureDesc& desc)
     : Texture(desc)
     , m_device(device)
 {
+    m_queueState.state = desc.defaultState;
+    m_ownerQueueFamilyIndex = device->m_queueFamilyIndex;
 }
 
 TextureImpl::~TextureImpl()
 {
-    auto& api = m_device->m_api;
+    // The texture may still be used by submitted command buffers.
+    RetiredObjects retired(m_device);
     for (auto& view : m_views)
     {
-        api.vkDestroyImageView(api.m_device, view.second.imageView, nullptr);
+        retired.add(VK_OBJECT_TYPE_IMAGE_VIEW, (uint64_t)view.second.imageView);
     }
     if (!m_isWeakImageReference)
     {
-        api.vkFreeMemory(api.m_device, m_imageMemory, nullptr);
-        api.vkDestroyImage(api.m_device, m_image, nullptr);
+        retired.add(VK_OBJECT_TYPE_IMAGE, (uint64_t)m_image);
+        retired.add(m_imageMemory);
     }
+    m_device->retireObjects(std::move(retired));
     if (m_sharedHandle)
     {
 #if SLANG_WINDOWS_FAMILY
@@ -53,7 +57,7 @@ Result TextureImpl::getSharedHandle(NativeHandle* outHandle)
     VkMemoryGetWin32HandleInfoKHR info = {};
     info.sType = VK_STRUCTURE_TYPE_MEMORY_GET_WIN32_HANDLE_INFO_KHR;
     info.pNext = nullptr;
-    info.memory = m_imageMemory;
+    info.memory = m_imageMemory.memory;
     info.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_WIN32_BIT;
 
     auto& api = m_device->m_api;
@@ -69,7 +73,7 @@ Result TextureImpl::getSharedHandle(NativeHandle* outHandle)
     VkMemoryGetFdInfoKHR info = {};
     info.sType = VK_STRUCTURE_TYPE_MEMORY_GET_FD_INFO_KHR;
     info.pNext = nullptr;
-    info.memory = m_imageMemory;
+    info.memory = m_imageMemory.memory;
     info.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
 
     auto& api = m_device->m_api;
@@ -88,11 +92,41 @@ Result TextureImpl::getSharedHandle(NativeHandle* outHandle)
 
 TextureSubresourceView TextureImpl::getView(Format format, TextureAspect aspect, const SubresourceRange& range)
 {
+    // Most bindings and render targets use the default view, which is cached outside of the map.
+    bool isDefaultView = format == m_desc.format && aspect == TextureAspect::All && isEntireTexture(range);
+    TextureSubresourceView view;
+    if (isDefaultView)
+    {
+        view.imageView = m_defaultView.load(std::memory_order_acquire);
+        if (view.imageView)
+            return view;
+    }
+
     ViewKey key = {format, aspect, range};
-    TextureSubresourceView& view = m_views[key];
-    if (view.imageView)
+    {
+        std::shared_lock<std::shared_mutex> lock(m_viewsMutex);
+        auto it = m_views.find(key);
+        if (it != m_views.end())
+            return it->second;
+    }
+
+    std::lock_guard<std::shared_mutex> lock(m_viewsMutex);
+    // Another thread may have created the view in the meantime.
+    auto it = m_views.find(key);
+    if (it != m_views.end())
+        return it->second;
+    view.imageView = createView(format, aspect, range);
+    // Failures are not cached, so that later lookups try again.
+    if (!view.imageView)
         return view;
+    m_views.emplace(key, view);
+    if (isDefaultView)
+        m_defaultView.store(view.imageView, std::memory_order_release);
+    return view;
+}
 
+VkImageView TextureImpl::createView(Format format, TextureAspect aspect, const SubresourceRange& range)
+{
     bool isArray = m_desc.arrayLength > 1;
     VkImageViewCreateInfo createInfo = {};
     createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -128,15 +162,17 @@ TextureSubresourceView TextureImpl::getView(Format format, TextureAspect aspect,
     createInfo.subresourceRange.layerCount = range.layerCount;
     createInfo.subresourceRange.levelCount = range.mipLevelCount;
 
-    VkResult result =
-        m_device->m_api.vkCreateImageView(m_device->m_api.m_device, &createInfo, nullptr, &view.imageView);
+    VkImageView imageView = VK_NULL_HANDLE;
+    VkResult result = m_device->m_api.vkCreateImageView(m_device->m_api.m_device, &createInfo, nullptr, &imageView);
     SLANG_RHI_ASSERT(result == VK_SUCCESS);
-    return view;
+    return imageView;
 }
 
 Result TextureViewImpl::getNativeHandle(NativeHandle* outHandle)
 {
-    return SLANG_E_NOT_AVAILABLE;
+    outHandle->type = NativeHandleType::VkImageView;
+    outHandle->value = (uint64_t)getView().imageView;
+    return SLANG_OK;
 }
 
 TextureSubresourceView TextureViewImpl::getView()
@@ -144,50 +180,41 @@ TextureSubresourceView TextureViewImpl::getView()
     return m_texture->getView(m_desc.format, m_desc.aspect, m_desc.subresourceRange);
 }
 
-Result DeviceImpl::createTexture(const TextureDesc& descIn, const SubresourceData* initData, ITexture** outTexture)
+static Result getImageCreateInfo(
+    const TextureDesc& desc,
+    VkFormat format,
+    const SubresourceData* initData,
+    VkImageCreateInfo& outInfo
+)
 {
-    TextureDesc desc = fixupTextureDesc(descIn);
-
-    const VkFormat format = VulkanUtil::getVkFormat(desc.format);
-    if (format == VK_FORMAT_UNDEFINED)
-    {
-        SLANG_RHI_ASSERT_FAILURE("Unhandled image format");
-        return SLANG_FAIL;
-    }
-
-    RefPtr<TextureImpl> texture(new TextureImpl(this, desc));
-    texture->m_vkformat = format;
-    // Create the image
-
-    VkImageCreateInfo imageInfo = {VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
     switch (desc.type)
     {
     case TextureType::Texture1D:
     {
-        imageInfo.imageType = VK_IMAGE_TYPE_1D;
-        imageInfo.extent = VkExtent3D{uint32_t(descIn.size.width), 1, 1};
+        outInfo.imageType = VK_IMAGE_TYPE_1D;
+        outInfo.extent = VkExtent3D{uint32_t(desc.size.width), 1, 1};
         break;
     }
     case TextureType::Texture2D:
     {
-        imageInfo.imageType = VK_IMAGE_TYPE_2D;
-        imageInfo.extent = VkExtent3D{uint32_t(descIn.size.width), uint32_t(descIn.size.height), 1};
+        outInfo.imageType = VK_IMAGE_TYPE_2D;
+        outInfo.extent = VkExtent3D{uint32_t(desc.size.width), uint32_t(desc.size.height), 1};
         break;
     }
     case TextureType::TextureCube:
     {
-        imageInfo.imageType = VK_IMAGE_TYPE_2D;
-        imageInfo.extent = VkExtent3D{uint32_t(descIn.size.width), uint32_t(descIn.size.height), 1};
-        imageInfo.flags = VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+        outInfo.imageType = VK_IMAGE_TYPE_2D;
+        outInfo.extent = VkExtent3D{uint32_t(desc.size.width), uint32_t(desc.size.height), 1};
+        outInfo.flags = VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
         break;
     }
     case TextureType::Texture3D:
     {
         // Can't have an array and 3d texture
         SLANG_RHI_ASSERT(desc.arrayLength <= 1);
-        imageInfo.imageType = VK_IMAGE_TYPE_3D;
-        imageInfo.extent =
-            VkExtent3D{uint32_t(descIn.size.width), uint32_t(descIn.size.height), uint32_t(descIn.size.depth)};
+        outInfo.imageType = VK_IMAGE_TYPE_3D;
+        outInfo.extent =
+            VkExtent3D{uint32_t(desc.size.width), uint32_t(desc.size.height), uint32_t(desc.size.depth)};
         break;
     }
     default:
@@ -199,16 +226,62 @@ Result DeviceImpl::createTexture(const TextureDesc& descIn, const SubresourceDat
 
     int arrayLayerCount = desc.arrayLength * (desc.type == TextureType::TextureCube ? 6 : 1);
 
-    imageInfo.mipLevels = desc.mipLevelCount;
-    imageInfo.arrayLayers = arrayLayerCount;
+    outInfo.mipLevels = desc.mipLevelCount;
+    outInfo.arrayLayers = arrayLayerCount;
 
-    imageInfo.format = format;
+    outInfo.format = format;
 
-    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-    imageInfo.usage = _calcImageUsageFlags(desc.usage, desc.memoryType, initData);
-    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    outInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    outInfo.usage = _calcImageUsageFlags(desc.usage, desc.memoryType, initData);
+    outInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-    imageInfo.samples = (VkSampleCountFlagBits)desc.sampleCount;
+    outInfo.samples = (VkSampleCountFlagBits)desc.sampleCount;
+    return SLANG_OK;
+}
+
+Result TextureImpl::createUnboundImage()
+{
+    auto& api = m_device->m_api;
+    {
+        std::lock_guard<std::shared_mutex> lock(m_viewsMutex);
+        for (auto& view : m_views)
+        {
+            api.vkDestroyImageView(api.m_device, view.second.imageView, nullptr);
+        }
+        m_views.clear();
+        m_defaultView.store(VK_NULL_HANDLE, std::memory_order_relaxed);
+    }
+    if (m_image)
+    {
+        api.vkDestroyImage(api.m_device, m_image, nullptr);
+        m_image = VK_NULL_HANDLE;
+    }
+
+    VkImageCreateInfo imageInfo = {VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+    SLANG_RETURN_ON_FAIL(getImageCreateInfo(m_desc, m_vkformat, nullptr, imageInfo));
+    SLANG_VK_RETURN_ON_FAIL(api.vkCreateImage(api.m_device, &imageInfo, nullptr, &m_image));
+    m_device->_labelObject((uint64_t)m_image, VK_OBJECT_TYPE_IMAGE, m_desc.label);
+    return SLANG_OK;
+}
+
+Result DeviceImpl::createTexture(const TextureDesc& descIn, const SubresourceData* initData, ITexture** outTexture)
+{
+    TextureDesc desc = fixupTextureDesc(descIn);
+
+    const VkFormat format = VulkanUtil::getVkFormat(desc.format);
+    if (format == VK_FORMAT_UNDEFINED)
+    {
+        SLANG_RHI_ASSERT_FAILURE("Unhandled image format");
+        return SLANG_FAIL;
+    }
+
+    RefPtr<TextureImpl> texture(new TextureImpl(this, desc));
+    texture->m_vkformat = format;
+    // Create the image
+
+    VkImageCreateInfo imageInfo = {VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+    SLANG_RETURN_ON_FAIL(getImageCreateInfo(desc, format, initData, imageInfo));
+    int arrayLayerCount = imageInfo.arrayLayers;
 
     VkExternalMemoryImageCreateInfo externalMemoryImageCreateInfo = {VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_IMAGE_CREATE_INFO
     };
@@ -226,19 +299,11 @@ Result DeviceImpl::createTexture(const TextureDesc& descIn, const SubresourceDat
     }
     SLANG_VK_RETURN_ON_FAIL(m_api.vkCreateImage(m_device, &imageInfo, nullptr, &texture->m_image));
 
-    VkMemoryRequirements memRequirements;
-    m_api.vkGetImageMemoryRequirements(m_device, texture->m_image, &memRequirements);
-
-    // Allocate the memory
-    VkMemoryPropertyFlags reqMemoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
-    int memoryTypeIndex = m_api.findMemoryTypeIndex(memRequirements.memoryTypeBits, reqMemoryProperties);
-    SLANG_RHI_ASSERT(memoryTypeIndex >= 0);
+    MemoryAllocationDesc allocationDesc;
+    m_api.vkGetImageMemoryRequirements(m_device, texture->m_image, &allocationDesc.requirements);
+    allocationDesc.properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    allocationDesc.linear = false;
 
-    VkMemoryPropertyFlags actualMemoryProperites =
-        m_api.m_deviceMemoryProperties.memoryTypes[memoryTypeIndex].propertyFlags;
-    VkMemoryAllocateInfo allocInfo = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = memoryTypeIndex;
 #if SLANG_WINDOWS_FAMILY
     VkExportMemoryWin32HandleInfoKHR exportMemoryWin32HandleInfo = {
         VK_STRUCTURE_TYPE_EXPORT_MEMORY_WIN32_HANDLE_INFO_KHR
@@ -258,12 +323,18 @@ Result DeviceImpl::createTexture(const TextureDesc& descIn, const SubresourceDat
                                              : nullptr;
 #endif
         exportMemoryAllocateInfo.handleTypes = extMemoryHandleType;
-        allocInfo.pNext = &exportMemoryAllocateInfo;
+        allocationDesc.dedicated = true;
+        allocationDesc.next = &exportMemoryAllocateInfo;
     }
-    SLANG_VK_RETURN_ON_FAIL(m_api.vkAllocateMemory(m_device, &allocInfo, nullptr, &texture->m_imageMemory));
+    SLANG_RETURN_ON_FAIL(m_memoryAllocator.allocate(allocationDesc, texture->m_imageMemory));
 
     // Bind the memory to the image
-    m_api.vkBindImageMemory(m_device, texture->m_image, texture->m_imageMemory, 0);
+    SLANG_VK_RETURN_ON_FAIL(m_api.vkBindImageMemory(
+        m_device,
+        texture->m_image,
+        texture->m_imageMemory.memory,
+        texture->m_imageMemory.offset
+    ));
 
     _labelObject((uint64_t)texture->m_image, VK_OBJECT_TYPE_IMAGE, desc.label);
 
@@ -293,7 +364,7 @@ Result DeviceImpl::createTexture(const TextureDesc& descIn, const SubresourceDat
         bufferSize *= arrayLayerCount;
 
         SLANG_RETURN_ON_FAIL(uploadBuffer.init(
-            m_api,
+            this,
             bufferSize,
             VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
@@ -305,10 +376,7 @@ Result DeviceImpl::createTexture(const TextureDesc& descIn, const SubresourceDat
         {
             int subresourceCounter = 0;
 
-            uint8_t* dstData;
-            m_api.vkMapMemory(m_device, uploadBuffer.m_memory, 0, bufferSize, 0, (void**)&dstData);
-            uint8_t* dstDataStart;
-            dstDataStart = dstData;
+            uint8_t* dstData = (uint8_t*)uploadBuffer.getMappedData();
 
             Offset dstSubresourceOffset = 0;
             for (int i = 0; i < arrayLayerCount; ++i)
@@ -350,8 +418,6 @@ Result DeviceImpl::createTexture(const TextureDesc& descIn, const SubresourceDat
                     dstSubresourceOffset += dstLayerSizeInBytes * mipSize.depth;
                 }
             }
-
-            m_api.vkUnmapMemory(m_device, uploadBuffer.m_memory);
         }
 
         _transitionImageLayout(
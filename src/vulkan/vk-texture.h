@@ -2,6 +2,10 @@
 
 #include "vk-base.h"
 #include "vk-device.h"
+#include "../state-tracking.h"
+
+#include <atomic>
+#include <shared_mutex>
 
 namespace rhi::vk {
 
@@ -20,8 +24,12 @@ public:
     DeviceImpl* m_device;
     VkImage m_image = VK_NULL_HANDLE;
     VkFormat m_vkformat = VK_FORMAT_R8G8B8A8_UNORM;
-    VkDeviceMemory m_imageMemory = VK_NULL_HANDLE;
+    MemoryAllocation m_imageMemory;
     bool m_isWeakImageReference = false;
+    /// State of the texture after the last submitted command buffer.
+    TextureState m_queueState;
+    /// Queue family owning the texture after the last submitted command buffer.
+    uint32_t m_ownerQueueFamilyIndex;
 
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(NativeHandle* outHandle) override;
 
@@ -53,9 +61,21 @@ public:
         }
     };
 
+    /// Views are created lazily, possibly from multiple recording threads.
+    /// Lookups take a shared lock, only creating a view takes the exclusive lock.
+    std::shared_mutex m_viewsMutex;
     std::unordered_map<ViewKey, TextureSubresourceView, ViewKeyHasher> m_views;
+    /// View of the entire texture in the texture's format, looked up without locking or hashing.
+    std::atomic<VkImageView> m_defaultView{VK_NULL_HANDLE};
 
     TextureSubresourceView getView(Format format, TextureAspect aspect, const SubresourceRange& range);
+
+    /// Recreate the image without memory, destroying the previous image and its views.
+    /// Used for transient textures, which are bound to memory when their command buffer is recorded.
+    Result createUnboundImage();
+
+private:
+    VkImageView createView(Format format, TextureAspect aspect, const SubresourceRange& range);
 };
 
 class TextureViewImpl : public TextureView
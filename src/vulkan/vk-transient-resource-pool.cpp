@@ -0,0 +1,428 @@
+#include "vk-transient-resource-pool.h"
+#include "vk-buffer.h"
+#include "vk-device.h"
+#include "vk-texture.h"
+#include "vk-util.h"
+
+#include "../resource-desc-utils.h"
+
+#include <algorithm>
+#include <map>
+
+namespace rhi::vk {
+
+static size_t hashDesc(const BufferDesc& desc)
+{
+    size_t hash = 0;
+    hash_combine(hash, desc.size);
+    hash_combine(hash, desc.elementSize);
+    hash_combine(hash, desc.format);
+    hash_combine(hash, desc.memoryType);
+    hash_combine(hash, desc.usage);
+    hash_combine(hash, desc.defaultState);
+    return hash;
+}
+
+static size_t hashDesc(const TextureDesc& desc)
+{
+    size_t hash = 0;
+    hash_combine(hash, desc.type);
+    hash_combine(hash, desc.size.width);
+    hash_combine(hash, desc.size.height);
+    hash_combine(hash, desc.size.depth);
+    hash_combine(hash, desc.arrayLength);
+    hash_combine(hash, desc.mipLevelCount);
+    hash_combine(hash, desc.format);
+    hash_combine(hash, desc.sampleCount);
+    hash_combine(hash, desc.memoryType);
+    hash_combine(hash, desc.usage);
+    hash_combine(hash, desc.defaultState);
+    return hash;
+}
+
+static bool isSameDesc(const BufferDesc& a, const BufferDesc& b)
+{
+    return a.size == b.size && a.elementSize == b.elementSize && a.format == b.format &&
+           a.memoryType == b.memoryType && a.usage == b.usage && a.defaultState == b.defaultState;
+}
+
+static bool isSameDesc(const TextureDesc& a, const TextureDesc& b)
+{
+    return a.type == b.type && a.size.width == b.size.width && a.size.height == b.size.height &&
+           a.size.depth == b.size.depth && a.arrayLength == b.arrayLength && a.mipLevelCount == b.mipLevelCount &&
+           a.format == b.format && a.sampleCount == b.sampleCount && a.sampleQuality == b.sampleQuality &&
+           a.memoryType == b.memoryType && a.usage == b.usage && a.defaultState == b.defaultState;
+}
+
+static VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static bool isLifetimeOverlapping(const TransientResource* a, const TransientResource* b)
+{
+    return a->firstStep <= b->lastStep && b->firstStep <= a->lastStep;
+}
+
+void TransientResourcePool::init(DeviceImpl* device, uint32_t queueFamilyIndex)
+{
+    m_device = device;
+    m_queueFamilyIndex = queueFamilyIndex;
+}
+
+void TransientResourcePool::close()
+{
+    m_resourcesInUse.clear();
+    m_acquired.clear();
+    m_firstUses.clear();
+    m_freeResources.clear();
+    m_resources.clear();
+    for (auto& heap : m_heaps)
+    {
+        m_device->m_memoryAllocator.free(heap.allocation);
+    }
+    m_heaps.clear();
+}
+
+Result TransientResourcePool::createBuffer(const BufferDesc& descIn, IBuffer** outBuffer)
+{
+    if (descIn.isShared)
+        return SLANG_E_INVALID_ARG;
+
+    BufferDesc desc = fixupBufferDesc(descIn);
+    size_t descHash = hashDesc(desc);
+
+    auto it = m_freeResources.find(descHash);
+    if (it != m_freeResources.end())
+    {
+        auto& freeResources = it->second;
+        for (auto resourceIt = freeResources.begin(); resourceIt != freeResources.end(); ++resourceIt)
+        {
+            TransientResource* resource = *resourceIt;
+            if (resource->buffer && isSameDesc(resource->buffer->m_desc, desc))
+            {
+                freeResources.erase(resourceIt);
+                markInUse(resource, resource->buffer);
+                returnComPtr(outBuffer, resource->buffer);
+                return SLANG_OK;
+            }
+        }
+    }
+
+    auto resource = std::make_unique<TransientResource>();
+    resource->descHash = descHash;
+    if (desc.memoryType == MemoryType::DeviceLocal)
+    {
+        resource->buffer = new BufferImpl(m_device, desc);
+        SLANG_RETURN_ON_FAIL(resource->buffer->createUnboundBuffer());
+        m_device->m_api.vkGetBufferMemoryRequirements(
+            m_device->m_api.m_device,
+            resource->buffer->m_buffer.m_buffer,
+            &resource->requirements
+        );
+        resource->placed = true;
+    }
+    else
+    {
+        ComPtr<IBuffer> buffer;
+        SLANG_RETURN_ON_FAIL(m_device->createBuffer(desc, nullptr, buffer.writeRef()));
+        resource->buffer = checked_cast<BufferImpl*>(buffer.get());
+    }
+
+    markInUse(resource.get(), resource->buffer);
+    returnComPtr(outBuffer, resource->buffer);
+    m_resources.push_back(std::move(resource));
+    return SLANG_OK;
+}
+
+Result TransientResourcePool::createTexture(const TextureDesc& descIn, ITexture** outTexture)
+{
+    if (descIn.isShared)
+        return SLANG_E_INVALID_ARG;
+
+    TextureDesc desc = fixupTextureDesc(descIn);
+    size_t descHash = hashDesc(desc);
+
+    auto it = m_freeResources.find(descHash);
+    if (it != m_freeResources.end())
+    {
+        auto& freeResources = it->second;
+        for (auto resourceIt = freeResources.begin(); resourceIt != freeResources.end(); ++resourceIt)
+        {
+            TransientResource* resource = *resourceIt;
+            if (resource->texture && isSameDesc(resource->texture->m_desc, desc))
+            {
+                freeResources.erase(resourceIt);
+                markInUse(resource, resource->texture);
+                returnComPtr(outTexture, resource->texture);
+                return SLANG_OK;
+            }
+        }
+    }
+
+    auto resource = std::make_unique<TransientResource>();
+    resource->descHash = descHash;
+    if (desc.memoryType == MemoryType::DeviceLocal)
+    {
+        const VkFormat format = VulkanUtil::getVkFormat(desc.format);
+        if (format == VK_FORMAT_UNDEFINED)
+        {
+            SLANG_RHI_ASSERT_FAILURE("Unhandled image format");
+            return SLANG_FAIL;
+        }
+        resource->texture = new TextureImpl(m_device, desc);
+        resource->texture->m_vkformat = format;
+        SLANG_RETURN_ON_FAIL(resource->texture->createUnboundImage());
+        m_device->m_api.vkGetImageMemoryRequirements(
+            m_device->m_api.m_device,
+            resource->texture->m_image,
+            &resource->requirements
+        );
+        resource->placed = true;
+    }
+    else
+    {
+        ComPtr<ITexture> texture;
+        SLANG_RETURN_ON_FAIL(m_device->createTexture(desc, nullptr, texture.writeRef()));
+        resource->texture = checked_cast<TextureImpl*>(texture.get());
+    }
+    resource->texture->m_ownerQueueFamilyIndex = m_queueFamilyIndex;
+
+    markInUse(resource.get(), resource->texture);
+    returnComPtr(outTexture, resource->texture);
+    m_resources.push_back(std::move(resource));
+    return SLANG_OK;
+}
+
+TransientResource* TransientResourcePool::findResource(IResource* resource)
+{
+    auto it = m_resourcesInUse.find(resource);
+    return it != m_resourcesInUse.end() ? it->second : nullptr;
+}
+
+Result TransientResourcePool::bindMemory()
+{
+    m_firstUses.clear();
+
+    // Resources can only share a heap if they accept the same memory types. Buffers and images are placed in
+    // separate heaps so we never have to deal with bufferImageGranularity.
+    std::map<std::pair<bool, uint32_t>, std::vector<TransientResource*>> groups;
+    for (TransientResource* resource : m_acquired)
+    {
+        resource->aliased = false;
+        if (!resource->placed || !resource->used)
+            continue;
+        groups[{resource->buffer.get() != nullptr, resource->requirements.memoryTypeBits}].push_back(resource);
+    }
+
+    for (auto& group : groups)
+    {
+        SLANG_RETURN_ON_FAIL(placeResources(group.first.first, group.first.second, group.second));
+        for (TransientResource* resource : group.second)
+        {
+            m_firstUses[resource->firstCommand].push_back(resource);
+        }
+    }
+    return SLANG_OK;
+}
+
+Result TransientResourcePool::placeResources(
+    bool linear,
+    uint32_t memoryTypeBits,
+    std::vector<TransientResource*>& resources
+)
+{
+    // Greedy placement, largest resources first. Ties are broken by lifetime so that the placements only depend
+    // on the sizes and lifetimes of the resources and stay the same across recordings.
+    std::stable_sort(
+        resources.begin(),
+        resources.end(),
+        [](const TransientResource* a, const TransientResource* b)
+        {
+            if (a->requirements.size != b->requirements.size)
+                return a->requirements.size > b->requirements.size;
+            return a->firstStep < b->firstStep;
+        }
+    );
+
+    std::vector<VkDeviceSize> offsets(resources.size());
+    VkDeviceSize heapSize = 0;
+    VkDeviceSize heapAlignment = 1;
+    std::vector<std::pair<VkDeviceSize, VkDeviceSize>> ranges;
+    for (size_t i = 0; i < resources.size(); i++)
+    {
+        const VkMemoryRequirements& requirements = resources[i]->requirements;
+
+        // Place the resource at the lowest offset not used by the already placed resources alive at the same time.
+        ranges.clear();
+        for (size_t j = 0; j < i; j++)
+        {
+            if (isLifetimeOverlapping(resources[i], resources[j]))
+                ranges.push_back({offsets[j], offsets[j] + resources[j]->requirements.size});
+        }
+        std::sort(ranges.begin(), ranges.end());
+        VkDeviceSize offset = 0;
+        for (const auto& range : ranges)
+        {
+            if (offset + requirements.size <= range.first)
+                break;
+            offset = std::max(offset, alignUp(range.second, requirements.alignment));
+        }
+
+        offsets[i] = offset;
+        heapSize = std::max(heapSize, offset + requirements.size);
+        heapAlignment = std::max(heapAlignment, requirements.alignment);
+    }
+
+    // Find the heap for this kind of resources, reallocate it if it is too small.
+    Heap* heap = nullptr;
+    for (auto& h : m_heaps)
+    {
+        if (h.linear == linear && h.memoryTypeBits == memoryTypeBits)
+        {
+            heap = &h;
+            break;
+        }
+    }
+    if (!heap)
+    {
+        m_heaps.emplace_back();
+        heap = &m_heaps.back();
+        heap->linear = linear;
+        heap->memoryTypeBits = memoryTypeBits;
+    }
+    if (heap->allocation.size < heapSize || heap->allocation.offset % heapAlignment != 0)
+    {
+        if (heap->allocation.isValid())
+            m_device->m_memoryAllocator.free(heap->allocation);
+        MemoryAllocationDesc allocationDesc;
+        allocationDesc.requirements.size = heapSize;
+        allocationDesc.requirements.alignment = heapAlignment;
+        allocationDesc.requirements.memoryTypeBits = memoryTypeBits;
+        allocationDesc.properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        allocationDesc.linear = linear;
+        SLANG_RETURN_ON_FAIL(m_device->m_memoryAllocator.allocate(allocationDesc, heap->allocation));
+        heap->generation = m_nextHeapGeneration++;
+    }
+    heap->used = true;
+    heap->unusedCount = 0;
+
+    auto& api = m_device->m_api;
+    for (size_t i = 0; i < resources.size(); i++)
+    {
+        TransientResource* resource = resources[i];
+        if (resource->heapGeneration != heap->generation || resource->offset != offsets[i])
+        {
+            // Buffers and images cannot be bound to memory twice, recreate them to move them to a new placement.
+            if (resource->heapGeneration != 0)
+            {
+                if (resource->buffer)
+                    SLANG_RETURN_ON_FAIL(resource->buffer->createUnboundBuffer());
+                else
+                    SLANG_RETURN_ON_FAIL(resource->texture->createUnboundImage());
+            }
+            VkDeviceSize memoryOffset = heap->allocation.offset + offsets[i];
+            if (resource->buffer)
+            {
+                SLANG_VK_RETURN_ON_FAIL(api.vkBindBufferMemory(
+                    api.m_device,
+                    resource->buffer->m_buffer.m_buffer,
+                    heap->allocation.memory,
+                    memoryOffset
+                ));
+            }
+            else
+            {
+                SLANG_VK_RETURN_ON_FAIL(
+                    api.vkBindImageMemory(api.m_device, resource->texture->m_image, heap->allocation.memory, memoryOffset)
+                );
+            }
+            resource->heapGeneration = heap->generation;
+            resource->offset = offsets[i];
+        }
+
+        // The resource aliases memory of a resource used before it.
+        for (size_t j = 0; j < resources.size(); j++)
+        {
+            if (j == i || resources[j]->lastStep >= resource->firstStep)
+                continue;
+            if (offsets[i] < offsets[j] + resources[j]->requirements.size &&
+                offsets[j] < offsets[i] + resource->requirements.size)
+            {
+                resource->aliased = true;
+                break;
+            }
+        }
+    }
+    return SLANG_OK;
+}
+
+void TransientResourcePool::reset()
+{
+    // Return the resources in request order, followed by the resources that were not requested.
+    std::unordered_map<size_t, std::vector<TransientResource*>> freeResources;
+    for (TransientResource* resource : m_acquired)
+    {
+        resource->inUse = false;
+        resource->used = false;
+        resource->firstCommand = nullptr;
+        freeResources[resource->descHash].push_back(resource);
+    }
+    bool hasReleasedResources = false;
+    for (auto& it : m_freeResources)
+    {
+        for (TransientResource* resource : it.second)
+        {
+            if (++resource->unusedCount > kMaxUnusedCount)
+            {
+                resource->buffer.setNull();
+                resource->texture.setNull();
+                hasReleasedResources = true;
+                continue;
+            }
+            freeResources[it.first].push_back(resource);
+        }
+    }
+    m_freeResources = std::move(freeResources);
+    if (hasReleasedResources)
+    {
+        m_resources.erase(
+            std::remove_if(
+                m_resources.begin(),
+                m_resources.end(),
+                [](const std::unique_ptr<TransientResource>& resource)
+                { return !resource->buffer && !resource->texture; }
+            ),
+            m_resources.end()
+        );
+    }
+
+    m_acquired.clear();
+    m_resourcesInUse.clear();
+    m_firstUses.clear();
+
+    for (auto it = m_heaps.begin(); it != m_heaps.end();)
+    {
+        if (!it->used && ++it->unusedCount > kMaxUnusedCount)
+        {
+            m_device->m_memoryAllocator.free(it->allocation);
+            it = m_heaps.erase(it);
+            continue;
+        }
+        it->used = false;
+        ++it;
+    }
+}
+
+void TransientResourcePool::markInUse(TransientResource* resource, IResource* object)
+{
+    resource->inUse = true;
+    resource->used = false;
+    resource->aliased = false;
+    resource->firstCommand = nullptr;
+    resource->unusedCount = 0;
+    m_acquired.push_back(resource);
+    m_resourcesInUse[object] = resource;
+}
+
+} // namespace rhi::vk
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "vk-base.h"
+#include "vk-memory-allocator.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace rhi::vk {
+
+/// Buffer or texture handed out by a TransientResourcePool.
+struct TransientResource
+{
+    RefPtr<BufferImpl> buffer;
+    RefPtr<TextureImpl> texture;
+    size_t descHash = 0;
+    /// Device local resources are placed in a transient heap, other resources own their memory.
+    bool placed = false;
+    bool inUse = false;
+    /// Number of recordings the resource was not requested in.
+    uint32_t unusedCount = 0;
+
+    VkMemoryRequirements requirements = {};
+    /// Heap and offset the resource is bound to (heapGeneration is 0 if the resource is not bound).
+    uint64_t heapGeneration = 0;
+    VkDeviceSize offset = 0;
+
+    // Lifetime within the recorded command list, in steps (passes or commands outside of passes).
+    bool used = false;
+    uint32_t firstStep = 0;
+    uint32_t lastStep = 0;
+    /// Command the first step starts at.
+    const void* firstCommand = nullptr;
+    /// The memory of the resource was used by other resources earlier in the command list.
+    bool aliased = false;
+};
+
+/// Pool of the transient resources of a command buffer (see `ICommandEncoder::createTransientBuffer`).
+/// Resources are keyed by their desc and handed out again once the command buffer is reused. Resources that
+/// were not requested for `kMaxUnusedCount` recordings are released.
+/// Device local resources are created without memory. When the command buffer is recorded, resources whose
+/// lifetimes do not overlap are placed at overlapping ranges of a heap, which is kept across recordings.
+/// As long as the same resources are requested and used in the same order, they keep their placement and
+/// recording the command buffer does not allocate or create any objects.
+class TransientResourcePool
+{
+public:
+    static constexpr uint32_t kMaxUnusedCount = 8;
+
+    void init(DeviceImpl* device, uint32_t queueFamilyIndex);
+    void close();
+
+    Result createBuffer(const BufferDesc& desc, IBuffer** outBuffer);
+    Result createTexture(const TextureDesc& desc, ITexture** outTexture);
+
+    bool hasResourcesInUse() const { return !m_acquired.empty(); }
+
+    /// Find the transient resource requested for the current recording, nullptr for other resources.
+    TransientResource* findResource(IResource* resource);
+
+    /// Place the resources used by the command list in the heaps and bind their memory.
+    /// Lifetimes (`used`, `firstStep`, `lastStep`) must be set on the resources in use.
+    Result bindMemory();
+
+    /// Get the placed resources whose first step starts at `command`.
+    const std::unordered_map<const void*, std::vector<TransientResource*>>& getFirstUses() const
+    {
+        return m_firstUses;
+    }
+
+    /// Return the resources in use to the pool. Called once the command buffer has finished executing.
+    void reset();
+
+private:
+    struct Heap
+    {
+        bool linear = true;
+        uint32_t memoryTypeBits = 0;
+        MemoryAllocation allocation;
+        uint64_t generation = 0;
+        bool used = false;
+        uint32_t unusedCount = 0;
+    };
+
+    void markInUse(TransientResource* resource, IResource* object);
+    Result placeResources(bool linear, uint32_t memoryTypeBits, std::vector<TransientResource*>& resources);
+
+    DeviceImpl* m_device = nullptr;
+    uint32_t m_queueFamilyIndex = 0;
+    std::vector<std::unique_ptr<TransientResource>> m_resources;
+    /// Free resources by desc hash. Resources are kept in the order they were requested in the last recording,
+    /// so that the same requests get the same resources (and placements) again.
+    std::unordered_map<size_t, std::vector<TransientResource*>> m_freeResources;
+    /// Resources requested for the current recording, in request order.
+    std::vector<TransientResource*> m_acquired;
+    std::unordered_map<IResource*, TransientResource*> m_resourcesInUse;
+    std::unordered_map<const void*, std::vector<TransientResource*>> m_firstUses;
+    std::vector<Heap> m_heaps;
+    uint64_t m_nextHeapGeneration = 1;
+};
+
+} // namespace rhi::vk
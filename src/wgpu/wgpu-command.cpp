@@ -534,11 +534,15 @@ void CommandRecorder::cmdDispatchComputeIndirect(const commands::DispatchCompute
     if (!m_computeStateValid)
         return;
 
-    m_ctx.api.wgpuComputePassEncoderDispatchWorkgroupsIndirect(
-        m_computePassEncoder,
-        checked_cast<BufferImpl*>(cmd.argBuffer)->m_buffer,
-        cmd.offset
-    );
+    // WebGPU has no count variant, count buffers are rejected when the command list is finished.
+    for (GfxIndex i = 0; i < cmd.maxDispatchCount; i++)
+    {
+        m_ctx.api.wgpuComputePassEncoderDispatchWorkgroupsIndirect(
+            m_computePassEncoder,
+            checked_cast<BufferImpl*>(cmd.argBuffer)->m_buffer,
+            cmd.offset + i * 3 * sizeof(uint32_t)
+        );
+    }
 }
 
 void CommandRecorder::cmdBeginRayTracingPass(const commands::BeginRayTracingPass& cmd)
@@ -767,8 +771,8 @@ Result CommandQueueImpl::submit(
 
 Result DeviceImpl::getQueue(QueueType type, ICommandQueue** outQueue)
 {
-    if (type != QueueType::Graphics)
-        return SLANG_FAIL;
+    // There is only a single queue, compute and transfer work is submitted to it as well.
+    SLANG_UNUSED(type);
     m_queue->establishStrongReferenceToDevice();
     returnComPtr(outQueue, m_queue);
     return SLANG_OK;
@@ -783,10 +787,22 @@ CommandEncoderImpl::CommandEncoderImpl(DeviceImpl* device, CommandQueueImpl* que
     m_commandBuffer = new CommandBufferImpl(device, queue);
     m_commandBuffer->m_commandList = new CommandList();
     m_commandList = m_commandBuffer->m_commandList;
+    m_profiler = device->m_profiler.get();
 }
 
 CommandEncoderImpl::~CommandEncoderImpl() {}
 
+Result CommandEncoderImpl::createTransientBuffer(const BufferDesc& desc, IBuffer** outBuffer)
+{
+    // Transient resources are not pooled on this backend.
+    return m_device->createBuffer(desc, nullptr, outBuffer);
+}
+
+Result CommandEncoderImpl::createTransientTexture(const TextureDesc& desc, ITexture** outTexture)
+{
+    return m_device->createTexture(desc, nullptr, outTexture);
+}
+
 Result CommandEncoderImpl::finish(ICommandBuffer** outCommandBuffer)
 {
     SLANG_RETURN_ON_FAIL(resolvePipelines(m_device));
@@ -0,0 +1,75 @@
+#include "testing.h"
+
+#include "../src/rhi-shared.h"
+#include "../src/buffer-pool.h"
+
+using namespace rhi;
+using namespace rhi::testing;
+
+/// Forwards buffer creation to a device and counts the created buffers.
+struct CountingDevice
+{
+    IDevice* device;
+    int createdBufferCount = 0;
+
+    Result createBuffer(const BufferDesc& desc, const void* initData, IBuffer** outBuffer)
+    {
+        createdBufferCount++;
+        return device->createBuffer(desc, initData, outBuffer);
+    }
+};
+
+void testBufferPool(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+    CountingDevice countingDevice = {device};
+
+    BufferPool<CountingDevice, Buffer> pool;
+    pool.init(&countingDevice, MemoryType::Upload, 256, BufferUsage::ConstantBuffer);
+
+    const size_t largeSize = 5 * 1024 * 1024;
+
+    // Small allocations are sub-allocated from a page that is kept across resets.
+    auto small = pool.allocate(1024);
+    CHECK_EQ(countingDevice.createdBufferCount, 1);
+    pool.reset();
+    CHECK_EQ(pool.allocate(1024).resource, small.resource);
+    CHECK_EQ(countingDevice.createdBufferCount, 1);
+
+    // Large allocations are rounded up to their size class.
+    auto large0 = pool.allocate(largeSize);
+    auto large1 = pool.allocate(largeSize - 1000);
+    CHECK_EQ(countingDevice.createdBufferCount, 3);
+    CHECK_EQ(large0.offset, 0u);
+    CHECK_EQ(large0.resource->m_desc.size, largeSize);
+    CHECK_EQ(large1.resource->m_desc.size, largeSize);
+    CHECK_NE(large0.resource, large1.resource);
+
+    // Large buffers released by reset() are recycled for allocations of the same size class.
+    pool.reset();
+    auto recycled0 = pool.allocate(largeSize);
+    auto recycled1 = pool.allocate(largeSize - 2000);
+    CHECK_EQ(countingDevice.createdBufferCount, 3);
+    CHECK((recycled0.resource == large0.resource || recycled0.resource == large1.resource));
+    CHECK((recycled1.resource == large0.resource || recycled1.resource == large1.resource));
+    CHECK_NE(recycled0.resource, recycled1.resource);
+
+    // A different size class needs a new buffer.
+    pool.allocate(largeSize + 1024 * 1024);
+    CHECK_EQ(countingDevice.createdBufferCount, 4);
+
+    // Free large buffers are released once they have been idle for too long.
+    pool.reset();
+    CHECK_FALSE(pool.m_freeLargeBuffers.empty());
+    for (uint32_t i = 0; i <= pool.kMaxIdleFrames; i++)
+        pool.reset();
+    CHECK(pool.m_freeLargeBuffers.empty());
+    CHECK(pool.m_pages.empty());
+    pool.allocate(largeSize);
+    CHECK_EQ(countingDevice.createdBufferCount, 5);
+}
+
+TEST_CASE("buffer-pool")
+{
+    runGpuTests(testBufferPool, {DeviceType::CPU});
+}
@@ -0,0 +1,164 @@
+#include "testing.h"
+
+#include <algorithm>
+
+using namespace rhi;
+using namespace rhi::testing;
+
+void testBufferSuballocation(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    // Create many small buffers, which end up sharing device memory blocks,
+    // and make sure each one sees its own contents.
+    const int bufferCount = 1024;
+    const int elementCount = 16;
+
+    std::vector<ComPtr<IBuffer>> buffers;
+    for (int i = 0; i < bufferCount; i++)
+    {
+        uint32_t initialData[elementCount];
+        for (int j = 0; j < elementCount; j++)
+            initialData[j] = i * elementCount + j;
+
+        BufferDesc bufferDesc = {};
+        bufferDesc.size = sizeof(initialData);
+        bufferDesc.elementSize = sizeof(uint32_t);
+        bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::CopySource | BufferUsage::CopyDestination;
+        bufferDesc.defaultState = ResourceState::ShaderResource;
+        bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+        ComPtr<IBuffer> buffer;
+        REQUIRE_CALL(device->createBuffer(bufferDesc, initialData, buffer.writeRef()));
+        buffers.push_back(buffer);
+    }
+
+    // Release every other buffer to punch holes into the memory blocks and refill them.
+    for (int i = 0; i < bufferCount; i += 2)
+    {
+        uint32_t initialData[elementCount];
+        for (int j = 0; j < elementCount; j++)
+            initialData[j] = i * elementCount + j;
+
+        BufferDesc bufferDesc = buffers[i]->getDesc();
+        buffers[i].setNull();
+        REQUIRE_CALL(device->createBuffer(bufferDesc, initialData, buffers[i].writeRef()));
+    }
+
+    for (int i = 0; i < bufferCount; i++)
+    {
+        ComPtr<ISlangBlob> data;
+        REQUIRE_CALL(device->readBuffer(buffers[i], 0, elementCount * sizeof(uint32_t), data.writeRef()));
+        const uint32_t* result = (const uint32_t*)data->getBufferPointer();
+        for (int j = 0; j < elementCount; j++)
+        {
+            CAPTURE(i);
+            CAPTURE(j);
+            CHECK_EQ(result[j], uint32_t(i * elementCount + j));
+        }
+    }
+}
+
+static uint32_t getAllocationCount(const MemoryStats& stats)
+{
+    uint32_t count = 0;
+    for (GfxIndex i = 0; i < stats.heapCount; i++)
+        count += stats.heaps[i].allocationCount;
+    return count;
+}
+
+void testMemoryStats(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    MemoryStats stats;
+    if (deviceType != DeviceType::Vulkan)
+    {
+        CHECK_EQ(device->getMemoryStats(&stats), SLANG_E_NOT_AVAILABLE);
+        return;
+    }
+
+    REQUIRE_CALL(device->getMemoryStats(&stats));
+    uint32_t initialAllocationCount = getAllocationCount(stats);
+
+    const int bufferCount = 64;
+    std::vector<ComPtr<IBuffer>> buffers;
+    for (int i = 0; i < bufferCount; i++)
+    {
+        BufferDesc bufferDesc = {};
+        bufferDesc.size = 256;
+        bufferDesc.usage = BufferUsage::ShaderResource;
+        bufferDesc.defaultState = ResourceState::ShaderResource;
+        bufferDesc.memoryType = MemoryType::DeviceLocal;
+        ComPtr<IBuffer> buffer;
+        REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, buffer.writeRef()));
+        buffers.push_back(buffer);
+    }
+    REQUIRE_CALL(device->getMemoryStats(&stats));
+    CHECK_EQ(getAllocationCount(stats), initialAllocationCount + bufferCount);
+
+    // Release every other buffer to punch holes into the blocks.
+    for (int i = 0; i < bufferCount; i += 2)
+        buffers[i].setNull();
+    // Released memory is reclaimed once the queue is idle.
+    device->getQueue(QueueType::Graphics)->waitOnHost();
+    REQUIRE_CALL(device->getMemoryStats(&stats));
+    CHECK_EQ(getAllocationCount(stats), initialAllocationCount + bufferCount / 2);
+
+    REQUIRE_GE(stats.blockCount, 1);
+    std::vector<MemoryHeapStats> heapTotals(stats.heapCount, MemoryHeapStats{});
+    uint32_t freeRangeCount = 0;
+    for (GfxIndex i = 0; i < stats.blockCount; i++)
+    {
+        const MemoryBlockStats& block = stats.blocks[i];
+        CAPTURE(i);
+        REQUIRE_LT(block.heapIndex, uint32_t(stats.heapCount));
+        CHECK_EQ(block.usedSize + block.freeSize, block.size);
+        CHECK_LE(block.largestFreeRange, block.freeSize);
+        CHECK_GE(block.freeRangeCount, block.freeSize > 0 ? 1u : 0u);
+        MemoryHeapStats& heap = heapTotals[block.heapIndex];
+        heap.blockCount++;
+        heap.blockSize += block.size;
+        heap.usedSize += block.usedSize;
+        heap.freeSize += block.freeSize;
+        heap.largestFreeRange = std::max(heap.largestFreeRange, block.largestFreeRange);
+        heap.allocationCount += block.allocationCount;
+        freeRangeCount += block.freeRangeCount;
+    }
+    for (GfxIndex i = 0; i < stats.heapCount; i++)
+    {
+        CAPTURE(i);
+        CHECK_EQ(stats.heaps[i].blockCount, heapTotals[i].blockCount);
+        CHECK_EQ(stats.heaps[i].blockSize, heapTotals[i].blockSize);
+        CHECK_EQ(stats.heaps[i].usedSize, heapTotals[i].usedSize);
+        CHECK_EQ(stats.heaps[i].freeSize, heapTotals[i].freeSize);
+        CHECK_EQ(stats.heaps[i].largestFreeRange, heapTotals[i].largestFreeRange);
+        CHECK_EQ(stats.heaps[i].allocationCount, heapTotals[i].allocationCount);
+    }
+    // The released buffers left holes between the remaining ones.
+    CHECK_GE(freeRangeCount, uint32_t(bufferCount / 2));
+}
+
+TEST_CASE("buffer-suballocation")
+{
+    runGpuTests(
+        testBufferSuballocation,
+        {
+            DeviceType::D3D12,
+            DeviceType::Vulkan,
+            DeviceType::CUDA,
+            DeviceType::CPU,
+        }
+    );
+}
+
+TEST_CASE("memory-stats")
+{
+    runGpuTests(
+        testMemoryStats,
+        {
+            DeviceType::Vulkan,
+            DeviceType::CPU,
+        }
+    );
+}
@@ -45,12 +45,82 @@ void testClearTexture(GpuTestContext* ctx, DeviceType deviceType)
 
 TEST_CASE("clear-texture")
 {
-    // D3D11, Metal, CUDA, CPU don't support clearTexture
+    // D3D11, Metal, CUDA don't support clearTexture
     runGpuTests(
         testClearTexture,
         {
             // DeviceType::D3D12, TODO: implement
             DeviceType::Vulkan,
+            DeviceType::CPU,
+        }
+    );
+}
+
+// Clears larger than 1MB, which the CPU backend fills with streaming stores.
+void testClearTextureLarge(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    // Rows of 12 byte texels are not 16 byte aligned, which exercises the unaligned heads and tails.
+    const uint32_t width = 683;
+    const uint32_t height = 512;
+    TextureDesc textureDesc = {};
+    textureDesc.type = TextureType::Texture2D;
+    textureDesc.mipLevelCount = 1;
+    textureDesc.size.width = width;
+    textureDesc.size.height = height;
+    textureDesc.size.depth = 1;
+    textureDesc.usage = TextureUsage::RenderTarget | TextureUsage::CopySource | TextureUsage::CopyDestination;
+    textureDesc.defaultState = ResourceState::RenderTarget;
+    textureDesc.format = Format::R32G32B32_FLOAT;
+
+    FormatSupport formatSupport;
+    device->getFormatSupport(textureDesc.format, &formatSupport);
+    if (!is_set(formatSupport, FormatSupport::RenderTarget))
+        textureDesc.format = Format::R32G32B32A32_FLOAT;
+    uint32_t channelCount = textureDesc.format == Format::R32G32B32_FLOAT ? 3 : 4;
+
+    ComPtr<ITexture> texture;
+    REQUIRE_CALL(device->createTexture(textureDesc, nullptr, texture.writeRef()));
+
+    auto queue = device->getQueue(QueueType::Graphics);
+    auto encoder = queue->createCommandEncoder();
+    ClearValue clearValue = {};
+    clearValue.color.floatValues[0] = 0.5f;
+    clearValue.color.floatValues[1] = 1.0f;
+    clearValue.color.floatValues[2] = 0.2f;
+    clearValue.color.floatValues[3] = 0.1f;
+    encoder->clearTexture(texture, clearValue);
+    queue->submit(encoder->finish());
+    queue->waitOnHost();
+
+    ComPtr<ISlangBlob> blob;
+    size_t rowPitch, pixelSize;
+    REQUIRE_CALL(device->readTexture(texture, blob.writeRef(), &rowPitch, &pixelSize));
+    const uint8_t* data = (const uint8_t*)blob->getBufferPointer();
+    uint32_t mismatchCount = 0;
+    for (uint32_t y = 0; y < height; y++)
+    {
+        const float* row = (const float*)(data + y * rowPitch);
+        for (uint32_t x = 0; x < width; x++)
+        {
+            for (uint32_t c = 0; c < channelCount; c++)
+            {
+                if (row[x * channelCount + c] != clearValue.color.floatValues[c])
+                    mismatchCount++;
+            }
+        }
+    }
+    CHECK_EQ(mismatchCount, 0);
+}
+
+TEST_CASE("clear-texture-large")
+{
+    runGpuTests(
+        testClearTextureLarge,
+        {
+            DeviceType::Vulkan,
+            DeviceType::CPU,
         }
     );
 }
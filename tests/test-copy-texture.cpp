@@ -2,6 +2,9 @@
 
 #include "texture-utils.h"
 
+#include <cstring>
+#include <vector>
+
 #if SLANG_WINDOWS_FAMILY
 #include <d3d12.h>
 #endif
@@ -736,7 +739,7 @@ void testCopyTexture(GpuTestContext* ctx, DeviceType deviceType)
     }
 }
 
-// Texture support is currently very limited for D3D11, Metal, CUDA and CPU
+// Texture support is currently very limited for D3D11, Metal and CUDA
 
 TEST_CASE("copy-texture-simple")
 {
@@ -747,6 +750,7 @@ TEST_CASE("copy-texture-simple")
             DeviceType::Vulkan,
             DeviceType::Metal,
             DeviceType::WGPU,
+            DeviceType::CPU,
         }
     );
 }
@@ -760,6 +764,7 @@ TEST_CASE("copy-texture-section")
             DeviceType::Vulkan,
             DeviceType::Metal,
             DeviceType::WGPU,
+            DeviceType::CPU,
         }
     );
 }
@@ -773,6 +778,7 @@ TEST_CASE("copy-texture-large-to-small")
             DeviceType::Vulkan,
             DeviceType::Metal,
             DeviceType::WGPU,
+            DeviceType::CPU,
         }
     );
 }
@@ -786,6 +792,7 @@ TEST_CASE("copy-texture-small-to-large")
             DeviceType::Vulkan,
             DeviceType::Metal,
             DeviceType::WGPU,
+            DeviceType::CPU,
         }
     );
 }
@@ -799,6 +806,7 @@ TEST_CASE("copy-texture-between-mips")
             DeviceType::Vulkan,
             // DeviceType::Metal, // TODO: no support for 1D mips
             // DeviceType::WGPU, // TODO: no support for 1D mips
+            DeviceType::CPU,
         }
     );
 }
@@ -812,6 +820,7 @@ TEST_CASE("copy-texture-between-layers")
             DeviceType::Vulkan,
             DeviceType::Metal,
             // DeviceType::WGPU, // TODO: no support for layers
+            DeviceType::CPU,
         }
     );
 }
@@ -825,6 +834,7 @@ TEST_CASE("copy-texture-with-offsets")
             DeviceType::Vulkan,
             DeviceType::Metal,
             DeviceType::WGPU,
+            DeviceType::CPU,
         }
     );
 }
@@ -838,6 +848,106 @@ TEST_CASE("copy-texture-with-extent")
             DeviceType::Vulkan,
             DeviceType::Metal,
             DeviceType::WGPU,
+            DeviceType::CPU,
+        }
+    );
+}
+
+// Copies larger than 4MB, which the CPU backend splits across threads.
+void testCopyTextureLarge(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    const uint32_t width = 2048;
+    const uint32_t height = 1024;
+    std::vector<uint32_t> data(width * height);
+    for (uint32_t i = 0; i < width * height; i++)
+        data[i] = i;
+
+    TextureDesc textureDesc = {};
+    textureDesc.type = TextureType::Texture2D;
+    textureDesc.size = {width, height, 1};
+    textureDesc.mipLevelCount = 1;
+    textureDesc.format = Format::R32_UINT;
+    textureDesc.usage = TextureUsage::ShaderResource | TextureUsage::CopySource | TextureUsage::CopyDestination;
+    textureDesc.defaultState = ResourceState::CopyDestination;
+    ComPtr<ITexture> src;
+    REQUIRE_CALL(device->createTexture(textureDesc, nullptr, src.writeRef()));
+    ComPtr<ITexture> dst;
+    REQUIRE_CALL(device->createTexture(textureDesc, nullptr, dst.writeRef()));
+
+    // Rows of the padded buffer are not contiguous, so rows are copied separately.
+    size_t alignment;
+    device->getTextureRowAlignment(&alignment);
+    Size rowStride = width * sizeof(uint32_t) + alignment;
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = height * rowStride;
+    bufferDesc.usage = BufferUsage::CopyDestination | BufferUsage::CopySource;
+    bufferDesc.defaultState = ResourceState::CopyDestination;
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, buffer.writeRef()));
+
+    // A section with rows that are not contiguous in either texture.
+    const Offset3D sectionOffset = {16, 8, 0};
+    const Extents sectionExtent = {1536, 768, 1};
+
+    auto queue = device->getQueue(QueueType::Graphics);
+    auto encoder = queue->createCommandEncoder();
+    SubresourceData subresourceData = {data.data(), width * sizeof(uint32_t), 0};
+    encoder->uploadTextureData(src, {0, 1, 0, 1}, {0, 0, 0}, {width, height, 1}, &subresourceData, 1);
+    encoder->copyTexture(dst, {0, 1, 0, 1}, {0, 0, 0}, src, {0, 1, 0, 1}, {0, 0, 0}, {width, height, 1});
+    encoder->copyTexture(dst, {0, 1, 0, 1}, {0, 0, 0}, src, {0, 1, 0, 1}, sectionOffset, sectionExtent);
+    encoder->copyTextureToBuffer(
+        buffer,
+        0,
+        bufferDesc.size,
+        rowStride,
+        dst,
+        {0, 1, 0, 1},
+        {0, 0, 0},
+        {width, height, 1}
+    );
+    queue->submit(encoder->finish());
+    queue->waitOnHost();
+
+    // The full texture, read back through the tightly packed readTexture path.
+    {
+        ComPtr<ISlangBlob> blob;
+        size_t rowPitch, pixelSize;
+        REQUIRE_CALL(device->readTexture(src, blob.writeRef(), &rowPitch, &pixelSize));
+        const uint8_t* result = (const uint8_t*)blob->getBufferPointer();
+        bool equal = true;
+        for (uint32_t y = 0; y < height && equal; y++)
+            equal = ::memcmp(result + y * rowPitch, data.data() + y * width, width * sizeof(uint32_t)) == 0;
+        CHECK(equal);
+    }
+
+    ComPtr<ISlangBlob> blob;
+    REQUIRE_CALL(device->readBuffer(buffer, 0, bufferDesc.size, blob.writeRef()));
+    const uint8_t* result = (const uint8_t*)blob->getBufferPointer();
+    uint32_t mismatchCount = 0;
+    for (uint32_t y = 0; y < height; y++)
+    {
+        const uint32_t* row = (const uint32_t*)(result + y * rowStride);
+        for (uint32_t x = 0; x < width; x++)
+        {
+            bool inSection = x < sectionExtent.width && y < sectionExtent.height;
+            uint32_t expected = inSection ? (y + sectionOffset.y) * width + x + sectionOffset.x : y * width + x;
+            if (row[x] != expected)
+                mismatchCount++;
+        }
+    }
+    CHECK_EQ(mismatchCount, 0);
+}
+
+TEST_CASE("copy-texture-large")
+{
+    runGpuTests(
+        testCopyTextureLarge,
+        {
+            DeviceType::D3D12,
+            DeviceType::Vulkan,
+            DeviceType::CPU,
         }
     );
 }
@@ -0,0 +1,225 @@
+#include "testing.h"
+
+#include <cstdio>
+
+#if SLANG_LINUX_FAMILY || SLANG_APPLE_FAMILY
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace rhi;
+using namespace rhi::testing;
+
+static std::vector<uint8_t> makeData(Size size)
+{
+    std::vector<uint8_t> data(size);
+    for (Size i = 0; i < size; i++)
+        data[i] = uint8_t(i * 31 + (i >> 8));
+    return data;
+}
+
+static std::vector<uint8_t> readBuffer(IDevice* device, IBuffer* buffer)
+{
+    ComPtr<ISlangBlob> blob;
+    REQUIRE_CALL(device->readBuffer(buffer, 0, buffer->getDesc().size, blob.writeRef()));
+    const uint8_t* data = (const uint8_t*)blob->getBufferPointer();
+    return std::vector<uint8_t>(data, data + blob->getBufferSize());
+}
+
+void testCPUBufferStorage(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    struct TestCase
+    {
+        Size size;
+        MemoryType memoryType;
+    };
+    // Heap, huge page and lazily committed allocations.
+    TestCase testCases[] = {
+        {100, MemoryType::DeviceLocal},
+        {4 * 1024 * 1024 + 100, MemoryType::DeviceLocal},
+        {64 * 1024, MemoryType::Upload},
+        {64 * 1024, MemoryType::ReadBack},
+    };
+    for (const TestCase& testCase : testCases)
+    {
+        CAPTURE(testCase.size);
+        CAPTURE(int(testCase.memoryType));
+        BufferDesc bufferDesc = {};
+        bufferDesc.size = testCase.size;
+        bufferDesc.memoryType = testCase.memoryType;
+        bufferDesc.usage = BufferUsage::CopySource | BufferUsage::CopyDestination;
+        std::vector<uint8_t> data = makeData(testCase.size);
+        ComPtr<IBuffer> buffer;
+        REQUIRE_CALL(device->createBuffer(bufferDesc, data.data(), buffer.writeRef()));
+        // Default alignment is 64 bytes.
+        CHECK_EQ(buffer->getDeviceAddress() % 64, 0);
+        CHECK(readBuffer(device, buffer) == data);
+    }
+}
+
+void testCPUBufferFromHostMemory(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    std::vector<uint8_t> data = makeData(1000);
+    struct ReleaseState
+    {
+        void* data = nullptr;
+        int count = 0;
+    } releaseState;
+    auto release = [](void* data, void* userData)
+    {
+        ReleaseState* state = (ReleaseState*)userData;
+        state->data = data;
+        state->count++;
+    };
+
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = data.size();
+    bufferDesc.usage = BufferUsage::CopySource | BufferUsage::CopyDestination;
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(
+        device->createBufferFromHostMemory(data.data(), bufferDesc, release, &releaseState, buffer.writeRef())
+    );
+
+    // The buffer uses the host memory directly.
+    CHECK_EQ(buffer->getDeviceAddress(), DeviceAddress(data.data()));
+    CHECK(readBuffer(device, buffer) == data);
+    data[0] = 0xff;
+    CHECK(readBuffer(device, buffer) == data);
+
+    buffer = nullptr;
+    CHECK_EQ(releaseState.count, 1);
+    CHECK_EQ(releaseState.data, data.data());
+}
+
+void testCPUReadBufferView(GpuTestContext* ctx, DeviceType deviceType)
+{
+    SLANG_UNUSED(deviceType);
+
+    CPUDeviceExtendedDesc cpuDesc = {};
+    cpuDesc.readBufferView = true;
+    ComPtr<IDevice> device = createTestingCPUDevice(ctx, cpuDesc);
+
+    std::vector<uint8_t> data = makeData(256);
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = data.size();
+    bufferDesc.usage = BufferUsage::CopySource | BufferUsage::CopyDestination;
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, data.data(), buffer.writeRef()));
+
+    ComPtr<ISlangBlob> blob;
+    REQUIRE_CALL(device->readBuffer(buffer, 16, 64, blob.writeRef()));
+    CHECK_EQ(blob->getBufferPointer(), (const void*)(buffer->getDeviceAddress() + 16));
+    CHECK_EQ(blob->getBufferSize(), size_t(64));
+
+    // The blob keeps the buffer memory alive.
+    buffer = nullptr;
+    const uint8_t* blobData = (const uint8_t*)blob->getBufferPointer();
+    CHECK(std::vector<uint8_t>(blobData, blobData + 64) == std::vector<uint8_t>(data.begin() + 16, data.begin() + 80));
+}
+
+#if SLANG_LINUX_FAMILY || SLANG_APPLE_FAMILY
+void testCPUBufferFromFile(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    const Size size = 3 * 4096 + 16;
+    std::vector<uint8_t> data = makeData(size);
+    FILE* file = std::tmpfile();
+    REQUIRE(file);
+    REQUIRE_EQ(std::fwrite(data.data(), 1, size, file), size);
+    REQUIRE_EQ(std::fflush(file), 0);
+
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = size;
+    bufferDesc.usage = BufferUsage::CopySource | BufferUsage::CopyDestination;
+    NativeHandle handle;
+    handle.type = NativeHandleType::FileDescriptor;
+    handle.value = uint64_t(fileno(file));
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBufferFromNativeHandle(handle, bufferDesc, buffer.writeRef()));
+    CHECK(readBuffer(device, buffer) == data);
+
+    // Writes to the buffer go to the file.
+    void* mapped = nullptr;
+    REQUIRE_CALL(device->mapBuffer(buffer, CpuAccessMode::Write, &mapped));
+    std::memset(mapped, 0xab, 16);
+    REQUIRE_CALL(device->unmapBuffer(buffer));
+    uint8_t fileData[16] = {};
+    REQUIRE_EQ(pread(fileno(file), fileData, sizeof(fileData), 0), ssize_t(sizeof(fileData)));
+    CHECK(std::vector<uint8_t>(fileData, fileData + 16) == std::vector<uint8_t>(16, 0xab));
+
+    // Files smaller than the buffer cannot be mapped.
+    bufferDesc.size = size + 4096;
+    ComPtr<IBuffer> largeBuffer;
+    CHECK(SLANG_FAILED(device->createBufferFromNativeHandle(handle, bufferDesc, largeBuffer.writeRef())));
+
+    buffer = nullptr;
+    std::fclose(file);
+}
+
+void testCPUSharedBufferAcrossProcesses(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    const Size size = 4096;
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = size;
+    bufferDesc.usage = BufferUsage::CopySource | BufferUsage::CopyDestination;
+    bufferDesc.isShared = true;
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, buffer.writeRef()));
+    NativeHandle sharedHandle;
+    REQUIRE_CALL(buffer->getSharedHandle(&sharedHandle));
+    REQUIRE(sharedHandle.type == NativeHandleType::FileDescriptor);
+
+    // The child process inherits the file descriptor and writes through its own mapping.
+    pid_t pid = fork();
+    REQUIRE(pid >= 0);
+    if (pid == 0)
+    {
+        void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, int(sharedHandle.value), 0);
+        if (data == MAP_FAILED)
+            _exit(1);
+        std::memset(data, 0x5a, size);
+        _exit(0);
+    }
+    int status = 0;
+    REQUIRE_EQ(waitpid(pid, &status, 0), pid);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE_EQ(WEXITSTATUS(status), 0);
+
+    CHECK(readBuffer(device, buffer) == std::vector<uint8_t>(size, 0x5a));
+}
+#endif
+
+TEST_CASE("cpu-buffer-storage")
+{
+    runGpuTests(testCPUBufferStorage, {DeviceType::CPU});
+}
+
+TEST_CASE("cpu-buffer-from-host-memory")
+{
+    runGpuTests(testCPUBufferFromHostMemory, {DeviceType::CPU});
+}
+
+TEST_CASE("cpu-read-buffer-view")
+{
+    runGpuTests(testCPUReadBufferView, {DeviceType::CPU});
+}
+
+#if SLANG_LINUX_FAMILY || SLANG_APPLE_FAMILY
+TEST_CASE("cpu-buffer-from-file")
+{
+    runGpuTests(testCPUBufferFromFile, {DeviceType::CPU});
+}
+
+TEST_CASE("cpu-shared-buffer-across-processes")
+{
+    runGpuTests(testCPUSharedBufferAcrossProcesses, {DeviceType::CPU});
+}
+#endif
@@ -0,0 +1,389 @@
+#include "testing.h"
+
+#include "../src/cpu/cpu-texture.h"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace rhi;
+using namespace rhi::testing;
+
+static ComPtr<IDevice> createCPUDevice(GpuTestContext* ctx, CPUTextureLayout textureLayout)
+{
+    CPUDeviceExtendedDesc cpuDesc = {};
+    cpuDesc.textureLayout = textureLayout;
+    return createTestingCPUDevice(ctx, cpuDesc);
+}
+
+/// Run the read/write kernel over a `width` x `height` texture of `format`, returns the RGBA32F output texels.
+static std::vector<float> runKernel(
+    IDevice* device,
+    Format format,
+    uint32_t width,
+    uint32_t height,
+    const std::vector<uint8_t>& input
+)
+{
+    ComPtr<IShaderProgram> shaderProgram;
+    slang::ProgramLayout* slangReflection;
+    REQUIRE_CALL(loadComputeProgram(device, shaderProgram, "test-cpu-texel-access", "computeMain", slangReflection));
+
+    ComputePipelineDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<IComputePipeline> pipeline;
+    REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipeline.writeRef()));
+
+    Size texelSize = getFormatInfo(format).blockSizeInBytes;
+    TextureDesc textureDesc = {};
+    textureDesc.type = TextureType::Texture2D;
+    textureDesc.format = format;
+    textureDesc.size.width = width;
+    textureDesc.size.height = height;
+    textureDesc.size.depth = 1;
+    textureDesc.mipLevelCount = 1;
+    textureDesc.usage = TextureUsage::ShaderResource | TextureUsage::CopyDestination;
+    textureDesc.defaultState = ResourceState::ShaderResource;
+    SubresourceData subresourceData = {input.data(), width * texelSize, width * height * texelSize};
+    ComPtr<ITexture> srcTexture;
+    REQUIRE_CALL(device->createTexture(textureDesc, &subresourceData, srcTexture.writeRef()));
+
+    textureDesc.format = Format::R32G32B32A32_FLOAT;
+    textureDesc.usage = TextureUsage::UnorderedAccess | TextureUsage::CopySource;
+    textureDesc.defaultState = ResourceState::UnorderedAccess;
+    ComPtr<ITexture> dstTexture;
+    REQUIRE_CALL(device->createTexture(textureDesc, nullptr, dstTexture.writeRef()));
+
+    ComPtr<IShaderObject> rootObject = device->createRootShaderObject(pipeline);
+    {
+        auto cursor = ShaderCursor(rootObject);
+        uint32_t size[2] = {width, height};
+        cursor["size"].setData(size, sizeof(size));
+        cursor["src"].setBinding(srcTexture);
+        cursor["dst"].setBinding(dstTexture);
+    }
+    rootObject->finalize();
+
+    auto queue = device->getQueue(QueueType::Graphics);
+    auto encoder = queue->createCommandEncoder();
+    auto passEncoder = encoder->beginComputePass();
+    ComputeState state;
+    state.pipeline = pipeline;
+    state.rootObject = rootObject;
+    passEncoder->setComputeState(state);
+    passEncoder->dispatchCompute((width + 15) / 16, (height + 15) / 16, 1);
+    passEncoder->end();
+    queue->submit(encoder->finish());
+    queue->waitOnHost();
+
+    ComPtr<ISlangBlob> blob;
+    size_t rowPitch, pixelSize;
+    REQUIRE_CALL(device->readTexture(dstTexture, blob.writeRef(), &rowPitch, &pixelSize));
+    REQUIRE_EQ(blob->getBufferSize(), width * height * 4 * sizeof(float));
+    const float* data = (const float*)blob->getBufferPointer();
+    return std::vector<float>(data, data + width * height * 4);
+}
+
+static std::vector<uint8_t> makeInput(Format format, uint32_t width, uint32_t height)
+{
+    std::vector<uint8_t> input(width * height * getFormatInfo(format).blockSizeInBytes);
+    if (format == Format::R32G32B32A32_FLOAT || format == Format::R32_FLOAT)
+    {
+        float* values = (float*)input.data();
+        for (size_t i = 0; i < input.size() / sizeof(float); i++)
+            values[i] = float((i * 7919) % 251);
+    }
+    else
+    {
+        for (size_t i = 0; i < input.size(); i++)
+            input[i] = uint8_t((i * 7919) % 251);
+    }
+    return input;
+}
+
+/// Unpack texel `index` of `input` the way `Texture2D<float4>::Load` returns it.
+static void loadTexel(Format format, const std::vector<uint8_t>& input, size_t index, float outValue[4])
+{
+    const float* floats = (const float*)input.data();
+    const uint8_t* bytes = input.data();
+    switch (format)
+    {
+    case Format::R32G32B32A32_FLOAT:
+        for (int c = 0; c < 4; c++)
+            outValue[c] = floats[index * 4 + c];
+        break;
+    case Format::R32_FLOAT:
+        outValue[0] = floats[index];
+        outValue[1] = 0.0f;
+        outValue[2] = 0.0f;
+        outValue[3] = 1.0f;
+        break;
+    case Format::R8G8B8A8_UNORM:
+        for (int c = 0; c < 4; c++)
+            outValue[c] = bytes[index * 4 + c] / 255.0f;
+        break;
+    case Format::B8G8R8A8_UNORM:
+        for (int c = 0; c < 4; c++)
+            outValue[c] = bytes[index * 4 + (c < 3 ? 2 - c : 3)] / 255.0f;
+        break;
+    default:
+        FAIL("unexpected format");
+    }
+}
+
+void testCPUTexelAccess(GpuTestContext* ctx, DeviceType deviceType)
+{
+    SLANG_UNUSED(deviceType);
+
+    // Not a multiple of the tile size.
+    const uint32_t width = 37;
+    const uint32_t height = 19;
+
+    for (CPUTextureLayout textureLayout : {CPUTextureLayout::Linear, CPUTextureLayout::Tiled})
+    {
+        ComPtr<IDevice> device = createCPUDevice(ctx, textureLayout);
+        for (Format format :
+             {Format::R32G32B32A32_FLOAT, Format::R32_FLOAT, Format::R8G8B8A8_UNORM, Format::B8G8R8A8_UNORM})
+        {
+            const char* formatName = getFormatInfo(format).name;
+            CAPTURE(int(textureLayout));
+            CAPTURE(formatName);
+            std::vector<uint8_t> input = makeInput(format, width, height);
+            std::vector<float> expected(width * height * 4);
+            for (size_t i = 0; i < width * height; i++)
+            {
+                float value[4];
+                loadTexel(format, input, i, value);
+                for (int c = 0; c < 4; c++)
+                    expected[i * 4 + c] = value[c] * 2.0f;
+            }
+            std::vector<float> result = runKernel(device, format, width, height, input);
+            CHECK(result == expected);
+        }
+    }
+}
+
+struct TexelAccessShape
+{
+    const char* name;
+    TextureType type;
+    uint32_t width;
+    uint32_t height;
+    uint32_t depth;
+    uint32_t arrayLength;
+    int32_t rank;
+    /// Coordinate holding the array layer (-1 for non array textures).
+    int32_t layerCoord;
+};
+
+/// Texel access on every texture shape, reading R32_UINT texels holding their own linear index. Out of range
+/// coordinates and array layers are clamped to the edge of the texture.
+void testCPUTexelAccessShapes(GpuTestContext* ctx, DeviceType deviceType)
+{
+    SLANG_UNUSED(deviceType);
+
+    const TexelAccessShape shapes[] = {
+        {"1d", TextureType::Texture1D, 37, 1, 1, 1, 1, -1},
+        {"1d-array", TextureType::Texture1D, 37, 1, 1, 3, 1, 1},
+        {"2d-array", TextureType::Texture2D, 37, 19, 1, 3, 2, 2},
+        {"3d", TextureType::Texture3D, 13, 11, 5, 1, 3, -1},
+        // The face follows the 3 direction coordinates.
+        {"cube", TextureType::TextureCube, 9, 9, 1, 1, 2, 3},
+        {"cube-array", TextureType::TextureCube, 9, 9, 1, 2, 2, 3},
+    };
+
+    for (CPUTextureLayout textureLayout : {CPUTextureLayout::Linear, CPUTextureLayout::Tiled})
+    {
+        ComPtr<IDevice> device = createCPUDevice(ctx, textureLayout);
+        for (const TexelAccessShape& shape : shapes)
+        {
+            CAPTURE(int(textureLayout));
+            CAPTURE(shape.name);
+
+            const int32_t extents[3] = {int32_t(shape.width), int32_t(shape.height), int32_t(shape.depth)};
+            const int32_t layerCount = int32_t(shape.arrayLength) * (shape.type == TextureType::TextureCube ? 6 : 1);
+            const uint32_t layerSize = shape.width * shape.height * shape.depth;
+            std::vector<uint32_t> input(layerSize * layerCount);
+            for (size_t i = 0; i < input.size(); i++)
+                input[i] = uint32_t(i);
+            std::vector<SubresourceData> subresourceData;
+            for (int32_t layer = 0; layer < layerCount; layer++)
+            {
+                SubresourceData layerData = {};
+                layerData.data = input.data() + layer * layerSize;
+                layerData.strideY = shape.width * sizeof(uint32_t);
+                layerData.strideZ = shape.width * shape.height * sizeof(uint32_t);
+                subresourceData.push_back(layerData);
+            }
+
+            TextureDesc textureDesc = {};
+            textureDesc.type = shape.type;
+            textureDesc.format = Format::R32_UINT;
+            textureDesc.size.width = shape.width;
+            textureDesc.size.height = shape.height;
+            textureDesc.size.depth = shape.depth;
+            textureDesc.arrayLength = shape.arrayLength;
+            textureDesc.mipLevelCount = 1;
+            textureDesc.usage = TextureUsage::ShaderResource;
+            textureDesc.defaultState = ResourceState::ShaderResource;
+            ComPtr<ITexture> texture;
+            REQUIRE_CALL(device->createTexture(textureDesc, subresourceData.data(), texture.writeRef()));
+            ComPtr<ITextureView> textureView = device->createTextureView(texture, {});
+            REQUIRE(textureView != nullptr);
+            auto view = static_cast<cpu::TextureViewImpl*>(textureView.get());
+
+            // Coordinates from one texel before to one texel past each axis, and layers past the last one.
+            int32_t minCoords[4] = {0, 0, 0, 0};
+            int32_t maxCoords[4] = {0, 0, 0, 0};
+            for (int32_t axis = 0; axis < shape.rank; axis++)
+            {
+                minCoords[axis] = -1;
+                maxCoords[axis] = extents[axis];
+            }
+            if (shape.layerCoord >= 0)
+            {
+                minCoords[3] = -1;
+                maxCoords[3] = layerCount + 1;
+            }
+            for (int32_t layer = minCoords[3]; layer <= maxCoords[3]; layer++)
+            {
+                for (int32_t z = minCoords[2]; z <= maxCoords[2]; z++)
+                {
+                    for (int32_t y = minCoords[1]; y <= maxCoords[1]; y++)
+                    {
+                        for (int32_t x = minCoords[0]; x <= maxCoords[0]; x++)
+                        {
+                            int32_t coords[4] = {x, y, z, 0};
+                            if (shape.layerCoord >= 0)
+                                coords[shape.layerCoord] = layer;
+                            int32_t clampedX = std::clamp(x, 0, extents[0] - 1);
+                            int32_t clampedY = std::clamp(y, 0, extents[1] - 1);
+                            int32_t clampedZ = std::clamp(z, 0, extents[2] - 1);
+                            int32_t clampedLayer = std::clamp(layer, 0, layerCount - 1);
+                            uint32_t expected =
+                                input[clampedLayer * layerSize + (clampedZ * shape.height + clampedY) * shape.width +
+                                      clampedX];
+
+                            uint32_t loaded = 0;
+                            view->Load(coords, &loaded, sizeof(loaded));
+                            uint32_t referenced = *(const uint32_t*)view->refAt((const uint32_t*)coords);
+                            if (loaded != expected || referenced != expected)
+                            {
+                                CAPTURE(x);
+                                CAPTURE(y);
+                                CAPTURE(z);
+                                CAPTURE(layer);
+                                CHECK_EQ(loaded, expected);
+                                CHECK_EQ(referenced, expected);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/// Times reading and writing every texel of a 4K texture through the generic texture view, which works out the
+/// shape, layout and format of the texture for every texel, and through the specialized view created by the device.
+void testCPUTexelAccessBenchmark(GpuTestContext* ctx, DeviceType deviceType)
+{
+    SLANG_UNUSED(deviceType);
+
+    const uint32_t width = 4096;
+    const uint32_t height = 4096;
+    ComPtr<IDevice> device = createCPUDevice(ctx, CPUTextureLayout::Linear);
+
+    std::vector<uint32_t> input(width * height);
+    for (uint32_t i = 0; i < input.size(); i++)
+        input[i] = i * 2654435761u;
+    TextureDesc textureDesc = {};
+    textureDesc.type = TextureType::Texture2D;
+    textureDesc.format = Format::R8G8B8A8_UNORM;
+    textureDesc.size.width = width;
+    textureDesc.size.height = height;
+    textureDesc.size.depth = 1;
+    textureDesc.mipLevelCount = 1;
+    textureDesc.usage = TextureUsage::ShaderResource;
+    textureDesc.defaultState = ResourceState::ShaderResource;
+    SubresourceData subresourceData = {input.data(), width * sizeof(uint32_t), width * height * sizeof(uint32_t)};
+    ComPtr<ITexture> srcTexture;
+    REQUIRE_CALL(device->createTexture(textureDesc, &subresourceData, srcTexture.writeRef()));
+    textureDesc.format = Format::R32G32B32A32_FLOAT;
+    textureDesc.usage = TextureUsage::UnorderedAccess;
+    textureDesc.defaultState = ResourceState::UnorderedAccess;
+    ComPtr<ITexture> dstTexture;
+    REQUIRE_CALL(device->createTexture(textureDesc, nullptr, dstTexture.writeRef()));
+
+    auto createGenericView = [](ITexture* texture)
+    {
+        RefPtr<cpu::TextureViewImpl> view = new cpu::TextureViewImpl({});
+        view->m_texture = static_cast<cpu::TextureImpl*>(texture);
+        return view;
+    };
+    ComPtr<ITextureView> srcTextureView = device->createTextureView(srcTexture, {});
+    ComPtr<ITextureView> dstTextureView = device->createTextureView(dstTexture, {});
+    REQUIRE(srcTextureView != nullptr);
+    REQUIRE(dstTextureView != nullptr);
+    RefPtr<cpu::TextureViewImpl> views[2][2] = {
+        {createGenericView(srcTexture), createGenericView(dstTexture)},
+        {static_cast<cpu::TextureViewImpl*>(srcTextureView.get()),
+         static_cast<cpu::TextureViewImpl*>(dstTextureView.get())},
+    };
+
+    double checksums[2];
+    for (int specialized = 0; specialized < 2; specialized++)
+    {
+        cpu::TextureViewImpl* src = views[specialized][0];
+        cpu::TextureViewImpl* dst = views[specialized][1];
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (uint32_t y = 0; y < height; y++)
+        {
+            for (uint32_t x = 0; x < width; x++)
+            {
+                int32_t coords[2] = {int32_t(x), int32_t(y)};
+                float value[4];
+                src->Load(coords, value, sizeof(value));
+                float* texel = (float*)dst->refAt((const uint32_t*)coords);
+                for (int c = 0; c < 4; c++)
+                    texel[c] = value[c] * 2.0f;
+            }
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        double checksum = 0.0;
+        for (uint32_t y = 0; y < height; y += 61)
+        {
+            for (uint32_t x = 0; x < width; x += 67)
+            {
+                uint32_t coords[2] = {x, y};
+                const float* texel = (const float*)dst->refAt(coords);
+                checksum += texel[0] + texel[1] + texel[2] + texel[3];
+            }
+        }
+        checksums[specialized] = checksum;
+
+        double seconds = std::chrono::duration<double>(endTime - startTime).count();
+        MESSAGE(
+            doctest::String(specialized ? "Specialized" : "Generic"),
+            " view 4K read/write: ",
+            seconds,
+            " s"
+        );
+    }
+    CHECK_EQ(checksums[0], checksums[1]);
+}
+
+TEST_CASE("cpu-texel-access")
+{
+    runGpuTests(testCPUTexelAccess, {DeviceType::CPU});
+}
+
+TEST_CASE("cpu-texel-access-shapes")
+{
+    runGpuTests(testCPUTexelAccessShapes, {DeviceType::CPU});
+}
+
+TEST_CASE("cpu-texel-access-benchmark")
+{
+    runGpuTests(testCPUTexelAccessBenchmark, {DeviceType::CPU});
+}
@@ -0,0 +1,234 @@
+#include "testing.h"
+
+#include "../src/cpu/cpu-texture.h"
+
+#include <chrono>
+
+using namespace rhi;
+using namespace rhi::testing;
+
+static ComPtr<IDevice> createCPUDevice(GpuTestContext* ctx, CPUTextureLayout textureLayout)
+{
+    CPUDeviceExtendedDesc cpuDesc = {};
+    cpuDesc.textureLayout = textureLayout;
+    return createTestingCPUDevice(ctx, cpuDesc);
+}
+
+/// Run the 5-point stencil over a `width` x `height` texture, returns the output texels.
+static std::vector<float> runStencil(IDevice* device, uint32_t width, uint32_t height, const std::vector<float>& input)
+{
+    ComPtr<IShaderProgram> shaderProgram;
+    slang::ProgramLayout* slangReflection;
+    REQUIRE_CALL(loadComputeProgram(device, shaderProgram, "test-cpu-texture-layout", "computeMain", slangReflection));
+
+    ComputePipelineDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<IComputePipeline> pipeline;
+    REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipeline.writeRef()));
+
+    TextureDesc textureDesc = {};
+    textureDesc.type = TextureType::Texture2D;
+    textureDesc.format = Format::R32_FLOAT;
+    textureDesc.size.width = width;
+    textureDesc.size.height = height;
+    textureDesc.size.depth = 1;
+    textureDesc.mipLevelCount = 1;
+    textureDesc.usage = TextureUsage::ShaderResource | TextureUsage::CopyDestination;
+    textureDesc.defaultState = ResourceState::ShaderResource;
+    SubresourceData subresourceData = {input.data(), width * sizeof(float), width * height * sizeof(float)};
+    ComPtr<ITexture> srcTexture;
+    REQUIRE_CALL(device->createTexture(textureDesc, &subresourceData, srcTexture.writeRef()));
+
+    textureDesc.usage = TextureUsage::UnorderedAccess | TextureUsage::CopySource;
+    textureDesc.defaultState = ResourceState::UnorderedAccess;
+    ComPtr<ITexture> dstTexture;
+    REQUIRE_CALL(device->createTexture(textureDesc, nullptr, dstTexture.writeRef()));
+
+    ComPtr<IShaderObject> rootObject = device->createRootShaderObject(pipeline);
+    {
+        auto cursor = ShaderCursor(rootObject);
+        uint32_t size[2] = {width, height};
+        cursor["size"].setData(size, sizeof(size));
+        cursor["src"].setBinding(srcTexture);
+        cursor["dst"].setBinding(dstTexture);
+    }
+    rootObject->finalize();
+
+    auto queue = device->getQueue(QueueType::Graphics);
+    auto encoder = queue->createCommandEncoder();
+    auto passEncoder = encoder->beginComputePass();
+    ComputeState state;
+    state.pipeline = pipeline;
+    state.rootObject = rootObject;
+    passEncoder->setComputeState(state);
+    passEncoder->dispatchCompute((width + 15) / 16, (height + 15) / 16, 1);
+    passEncoder->end();
+    queue->submit(encoder->finish());
+    queue->waitOnHost();
+
+    ComPtr<ISlangBlob> blob;
+    size_t rowPitch, pixelSize;
+    REQUIRE_CALL(device->readTexture(dstTexture, blob.writeRef(), &rowPitch, &pixelSize));
+    REQUIRE_EQ(blob->getBufferSize(), width * height * sizeof(float));
+    const float* data = (const float*)blob->getBufferPointer();
+    return std::vector<float>(data, data + width * height);
+}
+
+static std::vector<float> makeInput(uint32_t width, uint32_t height)
+{
+    std::vector<float> input(width * height);
+    for (uint32_t i = 0; i < input.size(); i++)
+        input[i] = float((i * 7919) % 251);
+    return input;
+}
+
+void testCPUTextureLayout(GpuTestContext* ctx, DeviceType deviceType)
+{
+    SLANG_UNUSED(deviceType);
+
+    // Not a multiple of the tile size.
+    const uint32_t width = 37;
+    const uint32_t height = 19;
+    std::vector<float> input = makeInput(width, height);
+
+    std::vector<float> expected(width * height);
+    auto at = [&](int32_t x, int32_t y)
+    {
+        x = x < 0 ? 0 : (x >= int32_t(width) ? width - 1 : x);
+        y = y < 0 ? 0 : (y >= int32_t(height) ? height - 1 : y);
+        return input[y * width + x];
+    };
+    for (int32_t y = 0; y < int32_t(height); y++)
+        for (int32_t x = 0; x < int32_t(width); x++)
+            expected[y * width + x] = 4.0f * at(x, y) - at(x - 1, y) - at(x + 1, y) - at(x, y - 1) - at(x, y + 1);
+
+    for (CPUTextureLayout textureLayout : {CPUTextureLayout::Linear, CPUTextureLayout::Tiled})
+    {
+        CAPTURE(int(textureLayout));
+        ComPtr<IDevice> device = createCPUDevice(ctx, textureLayout);
+        std::vector<float> result = runStencil(device, width, height, input);
+        CHECK(result == expected);
+
+        // Clears fill the texels of all tiles.
+        TextureDesc textureDesc = {};
+        textureDesc.type = TextureType::Texture2D;
+        textureDesc.format = Format::R32_FLOAT;
+        textureDesc.size.width = width;
+        textureDesc.size.height = height;
+        textureDesc.size.depth = 1;
+        textureDesc.mipLevelCount = 1;
+        textureDesc.usage = TextureUsage::RenderTarget | TextureUsage::CopySource;
+        textureDesc.defaultState = ResourceState::RenderTarget;
+        ComPtr<ITexture> texture;
+        REQUIRE_CALL(device->createTexture(textureDesc, nullptr, texture.writeRef()));
+        auto queue = device->getQueue(QueueType::Graphics);
+        auto encoder = queue->createCommandEncoder();
+        ClearValue clearValue = {};
+        clearValue.color.floatValues[0] = 3.0f;
+        encoder->clearTexture(texture, clearValue);
+        queue->submit(encoder->finish());
+        queue->waitOnHost();
+        ComPtr<ISlangBlob> blob;
+        size_t rowPitch, pixelSize;
+        REQUIRE_CALL(device->readTexture(texture, blob.writeRef(), &rowPitch, &pixelSize));
+        const float* data = (const float*)blob->getBufferPointer();
+        CHECK(std::vector<float>(data, data + width * height) == std::vector<float>(width * height, 3.0f));
+    }
+}
+
+/// Times the 5-point stencil over an 8K x 8K texture with both layouts. Texels are accessed through the texture
+/// views like compute kernels do, visiting the texels in 16x16 groups.
+void testCPUTextureLayoutBenchmark(GpuTestContext* ctx, DeviceType deviceType)
+{
+    SLANG_UNUSED(deviceType);
+
+    const uint32_t width = 8192;
+    const uint32_t height = 8192;
+    const uint32_t groupSize = 16;
+    std::vector<float> input = makeInput(width, height);
+
+    double checksums[2];
+    for (CPUTextureLayout textureLayout : {CPUTextureLayout::Linear, CPUTextureLayout::Tiled})
+    {
+        ComPtr<IDevice> device = createCPUDevice(ctx, textureLayout);
+
+        TextureDesc textureDesc = {};
+        textureDesc.type = TextureType::Texture2D;
+        textureDesc.format = Format::R32_FLOAT;
+        textureDesc.size.width = width;
+        textureDesc.size.height = height;
+        textureDesc.size.depth = 1;
+        textureDesc.mipLevelCount = 1;
+        textureDesc.usage = TextureUsage::ShaderResource;
+        textureDesc.defaultState = ResourceState::ShaderResource;
+        SubresourceData subresourceData = {input.data(), width * sizeof(float), width * height * sizeof(float)};
+        ComPtr<ITexture> srcTexture;
+        REQUIRE_CALL(device->createTexture(textureDesc, &subresourceData, srcTexture.writeRef()));
+        textureDesc.usage = TextureUsage::UnorderedAccess;
+        textureDesc.defaultState = ResourceState::UnorderedAccess;
+        ComPtr<ITexture> dstTexture;
+        REQUIRE_CALL(device->createTexture(textureDesc, nullptr, dstTexture.writeRef()));
+
+        ComPtr<ITextureView> srcTextureView = device->createTextureView(srcTexture, {});
+        ComPtr<ITextureView> dstTextureView = device->createTextureView(dstTexture, {});
+        REQUIRE(srcTextureView != nullptr);
+        REQUIRE(dstTextureView != nullptr);
+        auto src = static_cast<cpu::TextureViewImpl*>(srcTextureView.get());
+        auto dst = static_cast<cpu::TextureViewImpl*>(dstTextureView.get());
+        auto load = [&](int32_t x, int32_t y)
+        {
+            int32_t coords[2] = {x, y};
+            float value;
+            src->Load(coords, &value, sizeof(value));
+            return value;
+        };
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (uint32_t groupY = 0; groupY < height; groupY += groupSize)
+        {
+            for (uint32_t groupX = 0; groupX < width; groupX += groupSize)
+            {
+                for (int32_t y = groupY; y < int32_t(groupY + groupSize); y++)
+                {
+                    for (int32_t x = groupX; x < int32_t(groupX + groupSize); x++)
+                    {
+                        uint32_t coords[2] = {uint32_t(x), uint32_t(y)};
+                        *(float*)dst->refAt(coords) = 4.0f * load(x, y) - load(x - 1, y) - load(x + 1, y) -
+                                                      load(x, y - 1) - load(x, y + 1);
+                    }
+                }
+            }
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        double checksum = 0.0;
+        for (uint32_t y = 0; y < height; y += 61)
+        {
+            for (uint32_t x = 0; x < width; x += 67)
+            {
+                uint32_t coords[2] = {x, y};
+                checksum += *(const float*)dst->refAt(coords);
+            }
+        }
+        checksums[int(textureLayout)] = checksum;
+
+        double seconds = std::chrono::duration<double>(endTime - startTime).count();
+        MESSAGE(
+            doctest::String(textureLayout == CPUTextureLayout::Linear ? "Linear" : "Tiled"),
+            " layout 8K stencil: ",
+            seconds,
+            " s"
+        );
+    }
+    CHECK_EQ(checksums[0], checksums[1]);
+}
+
+TEST_CASE("cpu-texture-layout")
+{
+    runGpuTests(testCPUTextureLayout, {DeviceType::CPU});
+}
+
+TEST_CASE("cpu-texture-layout-benchmark")
+{
+    runGpuTests(testCPUTextureLayoutBenchmark, {DeviceType::CPU});
+}
@@ -70,6 +70,7 @@ TEST_CASE("create-buffer-from-handle")
         {
             DeviceType::D3D12,
             DeviceType::Vulkan,
+            DeviceType::CPU,
         }
     );
 }
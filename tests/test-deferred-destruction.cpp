@@ -0,0 +1,93 @@
+#include "testing.h"
+
+using namespace rhi;
+using namespace rhi::testing;
+
+void testReleaseInFlightResources(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    ComPtr<IShaderProgram> shaderProgram;
+    slang::ProgramLayout* slangReflection;
+    REQUIRE_CALL(loadComputeProgram(device, shaderProgram, "test-compute-trivial", "computeMain", slangReflection));
+
+    const int numberCount = 4;
+    float initialData[] = {0.0f, 1.0f, 2.0f, 3.0f};
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = numberCount * sizeof(float);
+    bufferDesc.format = Format::Unknown;
+    bufferDesc.elementSize = sizeof(float);
+    bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess | BufferUsage::CopyDestination |
+                       BufferUsage::CopySource;
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+    ComPtr<IBuffer> resultBuffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, resultBuffer.writeRef()));
+
+    auto queue = device->getQueue(QueueType::Graphics);
+
+    FenceDesc fenceDesc = {};
+    ComPtr<IFence> fence;
+    REQUIRE_CALL(device->createFence(fenceDesc, fence.writeRef()));
+
+    // The submitted work waits on a fence that is only signaled from the host after the pipeline and the source
+    // buffer have been released, so it is guaranteed to be in flight when the last references are dropped.
+    {
+        ComputePipelineDesc pipelineDesc = {};
+        pipelineDesc.program = shaderProgram.get();
+        ComPtr<IComputePipeline> pipeline;
+        REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipeline.writeRef()));
+
+        ComPtr<IBuffer> buffer;
+        REQUIRE_CALL(device->createBuffer(bufferDesc, (void*)initialData, buffer.writeRef()));
+
+        auto encoder = queue->createCommandEncoder();
+        {
+            auto rootObject = device->createRootShaderObject(pipeline);
+            ShaderCursor(rootObject)["buffer"].setBinding(buffer);
+            rootObject->finalize();
+
+            auto passEncoder = encoder->beginComputePass();
+            ComputeState state;
+            state.pipeline = pipeline;
+            state.rootObject = rootObject;
+            passEncoder->setComputeState(state);
+            passEncoder->dispatchCompute(1, 1, 1);
+            passEncoder->end();
+        }
+        encoder->copyBuffer(resultBuffer, 0, buffer, 0, bufferDesc.size);
+
+        IFence* fences[] = {fence};
+        uint64_t waitValues[] = {1};
+        REQUIRE_CALL(queue->waitForFenceValuesOnDevice(1, fences, waitValues));
+        queue->submit(encoder->finish());
+    }
+
+    // Create and release buffers of the same size, which would be placed in the memory of the source buffer
+    // if it had been destroyed already. No initial data is used, uploads would wait for the blocked queue.
+    for (int i = 0; i < 8; i++)
+    {
+        ComPtr<IBuffer> buffer;
+        REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, buffer.writeRef()));
+    }
+
+    // The work has not started yet, the released objects must still be alive when it runs.
+    uint64_t fenceValue = 0;
+    REQUIRE_CALL(fence->getCurrentValue(&fenceValue));
+    CHECK_EQ(fenceValue, 0u);
+    REQUIRE_CALL(fence->setCurrentValue(1));
+    queue->waitOnHost();
+
+    compareComputeResult(device, resultBuffer, makeArray<float>(1.0f, 2.0f, 3.0f, 4.0f));
+}
+
+TEST_CASE("release-in-flight-resources")
+{
+    runGpuTests(
+        testReleaseInFlightResources,
+        {
+            DeviceType::Vulkan,
+        }
+    );
+}
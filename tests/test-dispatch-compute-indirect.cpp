@@ -0,0 +1,227 @@
+#include "testing.h"
+
+using namespace rhi;
+using namespace rhi::testing;
+
+static ComPtr<IComputePipeline> createPipeline(IDevice* device, const char* entryPointName)
+{
+    ComPtr<IShaderProgram> shaderProgram;
+    slang::ProgramLayout* slangReflection;
+    REQUIRE_CALL(
+        loadComputeProgram(device, shaderProgram, "test-dispatch-compute-indirect", entryPointName, slangReflection)
+    );
+    ComputePipelineDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<IComputePipeline> pipeline;
+    REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipeline.writeRef()));
+    return pipeline;
+}
+
+static ComPtr<IBuffer> createUintBuffer(IDevice* device, uint32_t elementCount, BufferUsage extraUsage)
+{
+    std::vector<uint32_t> initialData(elementCount, 0);
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = elementCount * sizeof(uint32_t);
+    bufferDesc.elementSize = sizeof(uint32_t);
+    bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess | BufferUsage::CopySource |
+                       BufferUsage::CopyDestination | extraUsage;
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, initialData.data(), buffer.writeRef()));
+    return buffer;
+}
+
+/// One kernel writes the dispatch arguments (and count) of the next, without a host round trip.
+static void testDispatchComputeIndirectImpl(GpuTestContext* ctx, DeviceType deviceType, bool useCountBuffer)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    ComPtr<IComputePipeline> writeArgsPipeline = createPipeline(device, "writeArgs");
+    ComPtr<IComputePipeline> accumulatePipeline = createPipeline(device, "accumulate");
+
+    ComPtr<IBuffer> argBuffer = createUintBuffer(device, 9, BufferUsage::IndirectArgument);
+    ComPtr<IBuffer> countBuffer = createUintBuffer(device, 1, BufferUsage::IndirectArgument);
+    ComPtr<IBuffer> resultBuffer = createUintBuffer(device, 20, BufferUsage::None);
+
+    auto bindBuffers = [&](IComputePipeline* pipeline)
+    {
+        ComPtr<IShaderObject> rootObject = device->createRootShaderObject(pipeline);
+        ShaderCursor cursor(rootObject);
+        cursor["args"].setBinding(argBuffer);
+        cursor["count"].setBinding(countBuffer);
+        cursor["result"].setBinding(resultBuffer);
+        rootObject->finalize();
+        return rootObject;
+    };
+    ComPtr<IShaderObject> writeArgsRootObject = bindBuffers(writeArgsPipeline);
+    ComPtr<IShaderObject> accumulateRootObject = bindBuffers(accumulatePipeline);
+
+    auto queue = device->getQueue(QueueType::Graphics);
+    auto encoder = queue->createCommandEncoder();
+    {
+        auto passEncoder = encoder->beginComputePass();
+        ComputeState state;
+        state.pipeline = writeArgsPipeline;
+        state.rootObject = writeArgsRootObject;
+        passEncoder->setComputeState(state);
+        passEncoder->dispatchCompute(1, 1, 1);
+        passEncoder->end();
+    }
+    {
+        auto passEncoder = encoder->beginComputePass();
+        ComputeState state;
+        state.pipeline = accumulatePipeline;
+        state.rootObject = accumulateRootObject;
+        passEncoder->setComputeState(state);
+        if (useCountBuffer)
+            passEncoder->dispatchComputeIndirect(argBuffer, 0, 3, countBuffer, 0);
+        else
+            passEncoder->dispatchComputeIndirect(argBuffer, 0);
+        passEncoder->end();
+    }
+    queue->submit(encoder->finish());
+    queue->waitOnHost();
+
+    if (useCountBuffer)
+    {
+        // Dispatches of 2 and 3 groups, the third one is dropped by the count.
+        compareComputeResult(
+            device,
+            resultBuffer,
+            makeArray<uint32_t>(2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0)
+        );
+    }
+    else
+    {
+        compareComputeResult(
+            device,
+            resultBuffer,
+            makeArray<uint32_t>(1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0)
+        );
+    }
+}
+
+void testDispatchComputeIndirect(GpuTestContext* ctx, DeviceType deviceType)
+{
+    testDispatchComputeIndirectImpl(ctx, deviceType, false);
+}
+
+void testDispatchComputeIndirectCount(GpuTestContext* ctx, DeviceType deviceType)
+{
+    testDispatchComputeIndirectImpl(ctx, deviceType, true);
+}
+
+/// Count buffers are rejected when the command list is finished on devices without a count variant.
+void testDispatchComputeIndirectCountUnsupported(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+    if (device->hasFeature("dispatch-indirect-count"))
+        SKIP("dispatch-indirect-count supported");
+
+    ComPtr<IComputePipeline> accumulatePipeline = createPipeline(device, "accumulate");
+
+    ComPtr<IBuffer> argBuffer = createUintBuffer(device, 9, BufferUsage::IndirectArgument);
+    ComPtr<IBuffer> countBuffer = createUintBuffer(device, 1, BufferUsage::IndirectArgument);
+    ComPtr<IBuffer> resultBuffer = createUintBuffer(device, 20, BufferUsage::None);
+
+    ComPtr<IShaderObject> rootObject = device->createRootShaderObject(accumulatePipeline);
+    ShaderCursor cursor(rootObject);
+    cursor["args"].setBinding(argBuffer);
+    cursor["count"].setBinding(countBuffer);
+    cursor["result"].setBinding(resultBuffer);
+    rootObject->finalize();
+
+    auto queue = device->getQueue(QueueType::Graphics);
+    auto encoder = queue->createCommandEncoder();
+    auto passEncoder = encoder->beginComputePass();
+    ComputeState state;
+    state.pipeline = accumulatePipeline;
+    state.rootObject = rootObject;
+    passEncoder->setComputeState(state);
+    passEncoder->dispatchComputeIndirect(argBuffer, 0, 3, countBuffer, 0);
+    passEncoder->end();
+
+    ComPtr<ICommandBuffer> commandBuffer;
+    CHECK_EQ(encoder->finish(commandBuffer.writeRef()), SLANG_E_NOT_AVAILABLE);
+}
+
+/// CPU dispatches run the groups one after another unless parallel dispatch is requested,
+/// so unsynchronized writes from all groups are counted.
+void testDispatchComputeSerial(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    ComPtr<IComputePipeline> countGroupsPipeline = createPipeline(device, "countGroups");
+
+    ComPtr<IBuffer> argBuffer = createUintBuffer(device, 9, BufferUsage::IndirectArgument);
+    ComPtr<IBuffer> countBuffer = createUintBuffer(device, 1, BufferUsage::IndirectArgument);
+    ComPtr<IBuffer> resultBuffer = createUintBuffer(device, 20, BufferUsage::None);
+
+    ComPtr<IShaderObject> rootObject = device->createRootShaderObject(countGroupsPipeline);
+    ShaderCursor cursor(rootObject);
+    cursor["args"].setBinding(argBuffer);
+    cursor["count"].setBinding(countBuffer);
+    cursor["result"].setBinding(resultBuffer);
+    rootObject->finalize();
+
+    auto queue = device->getQueue(QueueType::Graphics);
+    auto encoder = queue->createCommandEncoder();
+    auto passEncoder = encoder->beginComputePass();
+    ComputeState state;
+    state.pipeline = countGroupsPipeline;
+    state.rootObject = rootObject;
+    passEncoder->setComputeState(state);
+    passEncoder->dispatchCompute(1000, 4, 1);
+    passEncoder->end();
+    queue->submit(encoder->finish());
+    queue->waitOnHost();
+
+    compareComputeResult(
+        device,
+        resultBuffer,
+        makeArray<uint32_t>(4000, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0)
+    );
+}
+
+TEST_CASE("dispatch-compute-indirect")
+{
+    runGpuTests(
+        testDispatchComputeIndirect,
+        {
+            DeviceType::D3D12,
+            DeviceType::Vulkan,
+            DeviceType::CPU,
+        }
+    );
+}
+
+TEST_CASE("dispatch-compute-indirect-count")
+{
+    runGpuTests(
+        testDispatchComputeIndirectCount,
+        {
+            DeviceType::D3D12,
+            DeviceType::CPU,
+        }
+    );
+}
+
+TEST_CASE("dispatch-compute-indirect-count-unsupported")
+{
+    runGpuTests(
+        testDispatchComputeIndirectCountUnsupported,
+        {
+            DeviceType::Vulkan,
+        }
+    );
+}
+
+TEST_CASE("dispatch-compute-serial")
+{
+    runGpuTests(
+        testDispatchComputeSerial,
+        {
+            DeviceType::CPU,
+        }
+    );
+}
@@ -0,0 +1,80 @@
+#include "testing.h"
+
+#if SLANG_RHI_ENABLE_VULKAN
+#include "../src/vulkan/vk-shader-program.h"
+#endif
+
+using namespace rhi;
+using namespace rhi::testing;
+
+#if SLANG_RHI_ENABLE_VULKAN
+
+static vk::RootShaderObjectLayout* loadRootLayout(IDevice* device, ComPtr<IShaderProgram>& program, const char* source)
+{
+    REQUIRE_CALL(loadComputeProgramFromSource(device, program, source));
+    vk::RootShaderObjectLayout* layout = checked_cast<vk::ShaderProgramImpl*>(program.get())->m_rootObjectLayout;
+    REQUIRE(layout);
+    return layout;
+}
+
+void testLayoutCache(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    // A and B differ in code only, C has an additional binding.
+    const char* sourceA = R"(
+        uniform RWStructuredBuffer<float> buffer;
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID) { buffer[tid.x] = buffer[tid.x] + 1.0f; }
+    )";
+    const char* sourceB = R"(
+        uniform RWStructuredBuffer<float> buffer;
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID) { buffer[tid.x] = buffer[tid.x] * 2.0f; }
+    )";
+    const char* sourceC = R"(
+        uniform RWStructuredBuffer<float> buffer;
+        uniform StructuredBuffer<float> input;
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID) { buffer[tid.x] = input[tid.x]; }
+    )";
+
+    ComPtr<IShaderProgram> programA;
+    ComPtr<IShaderProgram> programB;
+    ComPtr<IShaderProgram> programC;
+    vk::RootShaderObjectLayout* layoutA = loadRootLayout(device, programA, sourceA);
+    vk::RootShaderObjectLayout* layoutB = loadRootLayout(device, programB, sourceB);
+    vk::RootShaderObjectLayout* layoutC = loadRootLayout(device, programC, sourceC);
+
+    // Identical bindings share the descriptor set layouts and the pipeline layout.
+    CHECK_NE(layoutA->m_pipelineLayout, VK_NULL_HANDLE);
+    CHECK_EQ(layoutA->m_pipelineLayout, layoutB->m_pipelineLayout);
+    REQUIRE_EQ(layoutA->m_vkDescriptorSetLayouts.size(), layoutB->m_vkDescriptorSetLayouts.size());
+    for (size_t i = 0; i < layoutA->m_vkDescriptorSetLayouts.size(); i++)
+        CHECK_EQ(layoutA->m_vkDescriptorSetLayouts[i], layoutB->m_vkDescriptorSetLayouts[i]);
+
+    // Different bindings get different layouts.
+    CHECK_NE(layoutC->m_pipelineLayout, layoutA->m_pipelineLayout);
+
+    // Cached layouts outlive the programs that created them.
+    VkPipelineLayout pipelineLayout = layoutA->m_pipelineLayout;
+    programA = nullptr;
+    programB = nullptr;
+    layoutB = loadRootLayout(device, programB, sourceB);
+    CHECK_EQ(layoutB->m_pipelineLayout, pipelineLayout);
+}
+
+TEST_CASE("layout-cache")
+{
+    runGpuTests(
+        testLayoutCache,
+        {
+            DeviceType::Vulkan,
+        }
+    );
+}
+
+#endif // SLANG_RHI_ENABLE_VULKAN
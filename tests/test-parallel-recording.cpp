@@ -0,0 +1,86 @@
+#include "testing.h"
+
+using namespace rhi;
+using namespace rhi::testing;
+
+void testParallelRecording(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device;
+    DeviceDesc deviceDesc = {};
+    deviceDesc.deviceType = deviceType;
+    deviceDesc.recordingThreadCount = 4;
+    deviceDesc.slang.slangGlobalSession = ctx->slangGlobalSession;
+    auto searchPaths = getSlangSearchPaths();
+    deviceDesc.slang.searchPaths = searchPaths.data();
+    deviceDesc.slang.searchPathCount = searchPaths.size();
+    REQUIRE_CALL(getRHI()->createDevice(deviceDesc, device.writeRef()));
+
+    ComPtr<IShaderProgram> shaderProgram;
+    slang::ProgramLayout* slangReflection;
+    REQUIRE_CALL(loadComputeProgram(device, shaderProgram, "test-compute-trivial", "computeMain", slangReflection));
+
+    ComputePipelineDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<IComputePipeline> pipeline;
+    REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipeline.writeRef()));
+
+    const int numberCount = 4;
+    float initialData[] = {0.0f, 1.0f, 2.0f, 3.0f};
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = numberCount * sizeof(float);
+    bufferDesc.format = Format::Unknown;
+    bufferDesc.elementSize = sizeof(float);
+    bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess | BufferUsage::CopyDestination |
+                       BufferUsage::CopySource;
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, (void*)initialData, buffer.writeRef()));
+    ComPtr<IBuffer> copyBuffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, copyBuffer.writeRef()));
+
+    // Record enough passes for the command list to be split across the recording threads.
+    // The copies depend on the passes recorded before them, so barriers have to be stitched between segments.
+    const int passCount = 400;
+    {
+        auto queue = device->getQueue(QueueType::Graphics);
+        auto encoder = queue->createCommandEncoder();
+
+        auto rootObject = device->createRootShaderObject(pipeline);
+        ShaderCursor(rootObject)["buffer"].setBinding(buffer);
+        rootObject->finalize();
+
+        for (int i = 0; i < passCount; i++)
+        {
+            auto passEncoder = encoder->beginComputePass();
+            ComputeState state;
+            state.pipeline = pipeline;
+            state.rootObject = rootObject;
+            passEncoder->setComputeState(state);
+            passEncoder->dispatchCompute(1, 1, 1);
+            passEncoder->end();
+
+            if (i % 50 == 49)
+                encoder->copyBuffer(copyBuffer, 0, buffer, 0, bufferDesc.size);
+        }
+
+        ComPtr<ICommandBuffer> commandBuffer;
+        REQUIRE_CALL(encoder->finishAsync(commandBuffer.writeRef()));
+        queue->submit(commandBuffer);
+        queue->waitOnHost();
+    }
+
+    compareComputeResult(device, buffer, makeArray<float>(400.0f, 401.0f, 402.0f, 403.0f));
+    compareComputeResult(device, copyBuffer, makeArray<float>(400.0f, 401.0f, 402.0f, 403.0f));
+}
+
+TEST_CASE("parallel-recording")
+{
+    runGpuTests(
+        testParallelRecording,
+        {
+            DeviceType::Vulkan,
+        }
+    );
+}
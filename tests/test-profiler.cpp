@@ -0,0 +1,210 @@
+#include "testing.h"
+
+#include <cstring>
+
+using namespace rhi;
+using namespace rhi::testing;
+
+void testProfiler(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device;
+    DeviceDesc deviceDesc = {};
+    deviceDesc.deviceType = deviceType;
+    deviceDesc.enableProfiler = true;
+    deviceDesc.slang.slangGlobalSession = ctx->slangGlobalSession;
+    auto searchPaths = getSlangSearchPaths();
+    deviceDesc.slang.searchPaths = searchPaths.data();
+    deviceDesc.slang.searchPathCount = searchPaths.size();
+    REQUIRE_CALL(getRHI()->createDevice(deviceDesc, device.writeRef()));
+
+    ComPtr<IShaderProgram> shaderProgram;
+    slang::ProgramLayout* slangReflection;
+    REQUIRE_CALL(loadComputeProgram(device, shaderProgram, "test-compute-trivial", "computeMain", slangReflection));
+
+    ComputePipelineDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<IComputePipeline> pipeline;
+    REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipeline.writeRef()));
+
+    float initialData[] = {0.0f, 1.0f, 2.0f, 3.0f};
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = sizeof(initialData);
+    bufferDesc.format = Format::Unknown;
+    bufferDesc.elementSize = sizeof(float);
+    bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess | BufferUsage::CopyDestination |
+                       BufferUsage::CopySource;
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, (void*)initialData, buffer.writeRef()));
+
+    // No frame has been resolved yet.
+    ProfilerFrame frame;
+    CHECK_EQ(device->getProfilerFrame(&frame), SLANG_E_NOT_AVAILABLE);
+
+    auto queue = device->getQueue(QueueType::Graphics);
+    float color[3] = {1.0f, 1.0f, 1.0f};
+    const int frameCount = 3;
+    for (int i = 0; i < frameCount; i++)
+    {
+        auto encoder = queue->createCommandEncoder();
+        auto rootObject = device->createRootShaderObject(pipeline);
+        ShaderCursor(rootObject)["buffer"].setBinding(buffer);
+        rootObject->finalize();
+
+        encoder->pushDebugGroup("Frame", color);
+        auto passEncoder = encoder->beginComputePass();
+        passEncoder->pushDebugGroup("Dispatch", color);
+        ComputeState state;
+        state.pipeline = pipeline;
+        state.rootObject = rootObject;
+        passEncoder->setComputeState(state);
+        passEncoder->dispatchCompute(1, 1, 1);
+        passEncoder->popDebugGroup();
+        passEncoder->end();
+        encoder->popDebugGroup();
+
+        ComPtr<ICommandBuffer> commandBuffer;
+        REQUIRE_CALL(encoder->finish(commandBuffer.writeRef()));
+        queue->submit(commandBuffer);
+        REQUIRE_CALL(device->endProfilerFrame());
+    }
+    queue->waitOnHost();
+
+    REQUIRE_CALL(device->getProfilerFrame(&frame));
+    CHECK_EQ(frame.frameIndex, frameCount - 1);
+    REQUIRE_EQ(frame.zoneCount, 3);
+
+    const ProfilerZone& frameZone = frame.zones[0];
+    const ProfilerZone& passZone = frame.zones[1];
+    const ProfilerZone& dispatchZone = frame.zones[2];
+    CHECK(::strcmp(frameZone.name, "Frame") == 0);
+    CHECK(::strcmp(passZone.name, "ComputePass") == 0);
+    CHECK(::strcmp(dispatchZone.name, "Dispatch") == 0);
+    CHECK_EQ(frameZone.parent, -1);
+    CHECK_EQ(passZone.parent, 0);
+    CHECK_EQ(dispatchZone.parent, 1);
+    CHECK_EQ(frameZone.depth, 0);
+    CHECK_EQ(passZone.depth, 1);
+    CHECK_EQ(dispatchZone.depth, 2);
+
+    CHECK_EQ(frameZone.startTime, 0.0);
+    for (GfxIndex i = 0; i < frame.zoneCount; i++)
+    {
+        const ProfilerZone& zone = frame.zones[i];
+        CHECK(zone.closed);
+        CHECK_GE(zone.endTime, zone.startTime);
+        if (zone.parent >= 0)
+        {
+            CHECK_GE(zone.startTime, frame.zones[zone.parent].startTime);
+            CHECK_LE(zone.endTime, frame.zones[zone.parent].endTime);
+        }
+    }
+
+    // A debug group that is not popped before the end of the frame is reported as not closed.
+    {
+        auto encoder = queue->createCommandEncoder();
+        auto rootObject = device->createRootShaderObject(pipeline);
+        ShaderCursor(rootObject)["buffer"].setBinding(buffer);
+        rootObject->finalize();
+
+        encoder->pushDebugGroup("Open", color);
+        auto passEncoder = encoder->beginComputePass();
+        ComputeState state;
+        state.pipeline = pipeline;
+        state.rootObject = rootObject;
+        passEncoder->setComputeState(state);
+        passEncoder->dispatchCompute(1, 1, 1);
+        passEncoder->end();
+
+        ComPtr<ICommandBuffer> commandBuffer;
+        REQUIRE_CALL(encoder->finish(commandBuffer.writeRef()));
+        queue->submit(commandBuffer);
+        REQUIRE_CALL(device->endProfilerFrame());
+    }
+    queue->waitOnHost();
+
+    REQUIRE_CALL(device->getProfilerFrame(&frame));
+    CHECK_EQ(frame.frameIndex, frameCount);
+    REQUIRE_EQ(frame.zoneCount, 2);
+    const ProfilerZone& openZone = frame.zones[0];
+    CHECK(::strcmp(openZone.name, "Open") == 0);
+    CHECK_FALSE(openZone.closed);
+    CHECK_EQ(openZone.endTime, openZone.startTime);
+    CHECK(::strcmp(frame.zones[1].name, "ComputePass") == 0);
+    CHECK_EQ(frame.zones[1].parent, 0);
+    CHECK(frame.zones[1].closed);
+
+    // Every frame counts the dispatches.
+    compareComputeResult(device, buffer, makeArray<float>(4.0f, 5.0f, 6.0f, 7.0f));
+}
+
+TEST_CASE("profiler")
+{
+    runGpuTests(
+        testProfiler,
+        {
+            DeviceType::D3D12,
+            DeviceType::Vulkan,
+            DeviceType::CPU,
+        }
+    );
+}
+
+/// Debug groups left open inside a pass are closed by `end`, unbalanced pops inside a pass are ignored.
+void testProfilerUnbalancedPassDebugGroups(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device;
+    DeviceDesc deviceDesc = {};
+    deviceDesc.deviceType = deviceType;
+    deviceDesc.enableProfiler = true;
+    deviceDesc.slang.slangGlobalSession = ctx->slangGlobalSession;
+    REQUIRE_CALL(getRHI()->createDevice(deviceDesc, device.writeRef()));
+
+    auto queue = device->getQueue(QueueType::Graphics);
+    float color[3] = {1.0f, 1.0f, 1.0f};
+    auto encoder = queue->createCommandEncoder();
+    encoder->pushDebugGroup("Frame", color);
+    auto passEncoder = encoder->beginComputePass();
+    passEncoder->pushDebugGroup("Outer", color);
+    passEncoder->pushDebugGroup("Inner", color);
+    passEncoder->end();
+    passEncoder = encoder->beginComputePass();
+    passEncoder->popDebugGroup();
+    passEncoder->end();
+    encoder->popDebugGroup();
+
+    ComPtr<ICommandBuffer> commandBuffer;
+    REQUIRE_CALL(encoder->finish(commandBuffer.writeRef()));
+    queue->submit(commandBuffer);
+    REQUIRE_CALL(device->endProfilerFrame());
+    queue->waitOnHost();
+
+    ProfilerFrame frame;
+    REQUIRE_CALL(device->getProfilerFrame(&frame));
+    CHECK_EQ(frame.frameIndex, 0);
+    REQUIRE_EQ(frame.zoneCount, 5);
+    const char* names[] = {"Frame", "ComputePass", "Outer", "Inner", "ComputePass"};
+    GfxIndex parents[] = {-1, 0, 1, 2, 0};
+    for (GfxIndex i = 0; i < frame.zoneCount; i++)
+    {
+        const ProfilerZone& zone = frame.zones[i];
+        CHECK(::strcmp(zone.name, names[i]) == 0);
+        CHECK_EQ(zone.parent, parents[i]);
+        CHECK(zone.closed);
+        if (zone.parent >= 0)
+            CHECK_LE(zone.endTime, frame.zones[zone.parent].endTime);
+    }
+}
+
+TEST_CASE("profiler-unbalanced-pass-debug-groups")
+{
+    runGpuTests(
+        testProfilerUnbalancedPassDebugGroups,
+        {
+            DeviceType::D3D12,
+            DeviceType::Vulkan,
+            DeviceType::CPU,
+        }
+    );
+}
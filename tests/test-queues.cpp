@@ -0,0 +1,118 @@
+#include "testing.h"
+
+using namespace rhi;
+using namespace rhi::testing;
+
+void testCrossQueueCopy(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    ComPtr<ICommandQueue> graphicsQueue;
+    ComPtr<ICommandQueue> computeQueue;
+    ComPtr<ICommandQueue> transferQueue;
+    REQUIRE_CALL(device->getQueue(QueueType::Graphics, graphicsQueue.writeRef()));
+    REQUIRE_CALL(device->getQueue(QueueType::Compute, computeQueue.writeRef()));
+    REQUIRE_CALL(device->getQueue(QueueType::Transfer, transferQueue.writeRef()));
+
+    const uint32_t width = 16;
+    const uint32_t height = 16;
+    std::vector<uint32_t> initialData(width * height);
+    for (uint32_t i = 0; i < width * height; i++)
+        initialData[i] = i;
+
+    TextureDesc textureDesc = {};
+    textureDesc.type = TextureType::Texture2D;
+    textureDesc.size = {width, height, 1};
+    textureDesc.mipLevelCount = 1;
+    textureDesc.format = Format::R32_UINT;
+    textureDesc.usage = TextureUsage::ShaderResource | TextureUsage::CopySource | TextureUsage::CopyDestination;
+    textureDesc.defaultState = ResourceState::ShaderResource;
+    ComPtr<ITexture> texture;
+    REQUIRE_CALL(device->createTexture(textureDesc, nullptr, texture.writeRef()));
+
+    size_t alignment;
+    device->getTextureRowAlignment(&alignment);
+    Size rowStride = (width * sizeof(uint32_t) + alignment - 1) & ~(alignment - 1);
+
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = rowStride * height;
+    bufferDesc.usage = BufferUsage::CopySource | BufferUsage::CopyDestination;
+    bufferDesc.defaultState = ResourceState::CopyDestination;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+    ComPtr<IBuffer> stagingBuffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, stagingBuffer.writeRef()));
+    ComPtr<IBuffer> resultBuffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, resultBuffer.writeRef()));
+
+    FenceDesc fenceDesc = {};
+    ComPtr<IFence> fence;
+    REQUIRE_CALL(device->createFence(fenceDesc, fence.writeRef()));
+
+    // Upload the texture on the transfer queue.
+    {
+        auto encoder = transferQueue->createCommandEncoder();
+        SubresourceData subresourceData = {initialData.data(), width * sizeof(uint32_t), 0};
+        encoder->uploadTextureData(texture, {0, 1, 0, 1}, {0, 0, 0}, {width, height, 1}, &subresourceData, 1);
+        transferQueue->submit(encoder->finish(), fence, 1);
+    }
+
+    // Copy the texture into a buffer on the compute queue.
+    {
+        IFence* fences[] = {fence};
+        uint64_t waitValues[] = {1};
+        REQUIRE_CALL(computeQueue->waitForFenceValuesOnDevice(1, fences, waitValues));
+        auto encoder = computeQueue->createCommandEncoder();
+        encoder->copyTextureToBuffer(
+            stagingBuffer,
+            0,
+            bufferDesc.size,
+            rowStride,
+            texture,
+            {0, 1, 0, 1},
+            {0, 0, 0},
+            {width, height, 1}
+        );
+        computeQueue->submit(encoder->finish(), fence, 2);
+    }
+
+    // Copy the buffer on the graphics queue.
+    {
+        IFence* fences[] = {fence};
+        uint64_t waitValues[] = {2};
+        REQUIRE_CALL(graphicsQueue->waitForFenceValuesOnDevice(1, fences, waitValues));
+        auto encoder = graphicsQueue->createCommandEncoder();
+        encoder->copyBuffer(resultBuffer, 0, stagingBuffer, 0, bufferDesc.size);
+        graphicsQueue->submit(encoder->finish());
+        graphicsQueue->waitOnHost();
+    }
+
+    ComPtr<ISlangBlob> bufferData;
+    REQUIRE_CALL(device->readBuffer(resultBuffer, 0, bufferDesc.size, bufferData.writeRef()));
+    for (uint32_t y = 0; y < height; y++)
+    {
+        const uint32_t* row = (const uint32_t*)((const uint8_t*)bufferData->getBufferPointer() + y * rowStride);
+        for (uint32_t x = 0; x < width; x++)
+        {
+            CAPTURE(x);
+            CAPTURE(y);
+            CHECK_EQ(row[x], y * width + x);
+        }
+    }
+
+    // The texture was last used on the compute queue, reading it back transfers it to the graphics queue.
+    ComPtr<ISlangBlob> textureData;
+    Size rowPitch, pixelSize;
+    REQUIRE_CALL(device->readTexture(texture, textureData.writeRef(), &rowPitch, &pixelSize));
+    CHECK(::memcmp(textureData->getBufferPointer(), initialData.data(), initialData.size() * sizeof(uint32_t)) == 0);
+}
+
+TEST_CASE("cross-queue-copy")
+{
+    runGpuTests(
+        testCrossQueueCopy,
+        {
+            DeviceType::D3D12,
+            DeviceType::Vulkan,
+        }
+    );
+}
@@ -0,0 +1,126 @@
+#include "testing.h"
+
+using namespace rhi;
+using namespace rhi::testing;
+
+void testReadbackAsyncBuffer(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    const int elementCount = 4096;
+    std::vector<uint32_t> initialData(elementCount);
+    for (int i = 0; i < elementCount; i++)
+        initialData[i] = i;
+
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = elementCount * sizeof(uint32_t);
+    bufferDesc.elementSize = sizeof(uint32_t);
+    bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::CopySource;
+    bufferDesc.defaultState = ResourceState::ShaderResource;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, initialData.data(), buffer.writeRef()));
+
+    // Issue many readbacks of different ranges before waiting on any of them.
+    const int readbackCount = 64;
+    const int chunkSize = elementCount / readbackCount;
+    std::vector<ComPtr<IReadback>> readbacks(readbackCount);
+    for (int i = 0; i < readbackCount; i++)
+    {
+        REQUIRE_CALL(device->readBufferAsync(
+            buffer,
+            i * chunkSize * sizeof(uint32_t),
+            chunkSize * sizeof(uint32_t),
+            readbacks[i].writeRef()
+        ));
+    }
+
+    for (int i = readbackCount - 1; i >= 0; i--)
+    {
+        REQUIRE_CALL(readbacks[i]->wait());
+        CHECK(readbacks[i]->isReady());
+
+        const void* data = nullptr;
+        Size size = 0;
+        REQUIRE_CALL(readbacks[i]->getData(&data, &size));
+        CHECK_EQ(size, chunkSize * sizeof(uint32_t));
+        const uint32_t* result = (const uint32_t*)data;
+        for (int j = 0; j < chunkSize; j++)
+        {
+            CAPTURE(i);
+            CAPTURE(j);
+            CHECK_EQ(result[j], uint32_t(i * chunkSize + j));
+        }
+    }
+}
+
+void testReadbackAsyncTexture(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    const uint32_t width = 16;
+    const uint32_t height = 16;
+    std::vector<uint32_t> initialData(width * height);
+    for (uint32_t i = 0; i < width * height; i++)
+        initialData[i] = i;
+
+    TextureDesc textureDesc = {};
+    textureDesc.type = TextureType::Texture2D;
+    textureDesc.size = {width, height, 1};
+    textureDesc.mipLevelCount = 1;
+    textureDesc.format = Format::R32_UINT;
+    textureDesc.usage = TextureUsage::ShaderResource | TextureUsage::CopySource;
+    textureDesc.defaultState = ResourceState::ShaderResource;
+
+    SubresourceData subresourceData = {initialData.data(), width * sizeof(uint32_t), 0};
+    ComPtr<ITexture> texture;
+    REQUIRE_CALL(device->createTexture(textureDesc, &subresourceData, texture.writeRef()));
+
+    ComPtr<IReadback> readback;
+    REQUIRE_CALL(device->readTextureAsync(texture, readback.writeRef()));
+    REQUIRE_CALL(readback->wait());
+
+    Size rowPitch = 0;
+    Size pixelSize = 0;
+    REQUIRE_CALL(readback->getTextureLayout(&rowPitch, &pixelSize));
+    CHECK_EQ(pixelSize, sizeof(uint32_t));
+
+    const void* data = nullptr;
+    Size size = 0;
+    REQUIRE_CALL(readback->getData(&data, &size));
+    for (uint32_t y = 0; y < height; y++)
+    {
+        const uint32_t* row = (const uint32_t*)((const uint8_t*)data + y * rowPitch);
+        for (uint32_t x = 0; x < width; x++)
+        {
+            CAPTURE(x);
+            CAPTURE(y);
+            CHECK_EQ(row[x], y * width + x);
+        }
+    }
+}
+
+TEST_CASE("readback-async-buffer")
+{
+    runGpuTests(
+        testReadbackAsyncBuffer,
+        {
+            DeviceType::D3D12,
+            DeviceType::Vulkan,
+            DeviceType::CUDA,
+            DeviceType::CPU,
+        }
+    );
+}
+
+TEST_CASE("readback-async-texture")
+{
+    runGpuTests(
+        testReadbackAsyncTexture,
+        {
+            DeviceType::D3D12,
+            DeviceType::Vulkan,
+        }
+    );
+}
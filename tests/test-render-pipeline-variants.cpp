@@ -0,0 +1,259 @@
+#include "testing.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace rhi;
+using namespace rhi::testing;
+
+struct Vertex
+{
+    float position[3];
+};
+
+struct Instance
+{
+    float position[3];
+    float color[3];
+};
+
+static const int kVertexCount = 6;
+static const Vertex kVertexData[kVertexCount] = {
+    // Triangle 1
+    {0, 0, 0.5},
+    {1, 0, 0.5},
+    {0, 1, 0.5},
+
+    // Triangle 2
+    {-1, 0, 0.5},
+    {0, 0, 0.5},
+    {-1, 1, 0.5},
+};
+
+static const int kInstanceCount = 2;
+static const Instance kInstanceData[kInstanceCount] = {
+    {{0, 0, 0}, {1, 0, 0}},
+    {{0, -1, 0}, {0, 0, 1}},
+};
+
+static const int kWidth = 256;
+static const int kHeight = 256;
+
+static const int kPixelCount = 4;
+static const int kChannelCount = 4;
+
+struct RenderPipelineVariantsTest
+{
+    ComPtr<IDevice> device;
+    ComPtr<IBuffer> vertexBuffer;
+    ComPtr<IBuffer> instanceBuffer;
+    ComPtr<ITexture> colorBuffer;
+    ComPtr<ITextureView> colorBufferView;
+
+    void init(IDevice* device_)
+    {
+        device = device_;
+
+        BufferDesc vertexBufferDesc;
+        vertexBufferDesc.size = kVertexCount * sizeof(Vertex);
+        vertexBufferDesc.usage = BufferUsage::VertexBuffer;
+        vertexBufferDesc.defaultState = ResourceState::VertexBuffer;
+        vertexBuffer = device->createBuffer(vertexBufferDesc, &kVertexData[0]);
+        REQUIRE(vertexBuffer != nullptr);
+
+        BufferDesc instanceBufferDesc;
+        instanceBufferDesc.size = kInstanceCount * sizeof(Instance);
+        instanceBufferDesc.usage = BufferUsage::VertexBuffer;
+        instanceBufferDesc.defaultState = ResourceState::VertexBuffer;
+        instanceBuffer = device->createBuffer(instanceBufferDesc, &kInstanceData[0]);
+        REQUIRE(instanceBuffer != nullptr);
+
+        TextureDesc colorBufferDesc;
+        colorBufferDesc.type = TextureType::Texture2D;
+        colorBufferDesc.size.width = kWidth;
+        colorBufferDesc.size.height = kHeight;
+        colorBufferDesc.size.depth = 1;
+        colorBufferDesc.mipLevelCount = 1;
+        colorBufferDesc.format = Format::R32G32B32A32_FLOAT;
+        colorBufferDesc.usage = TextureUsage::RenderTarget | TextureUsage::CopySource;
+        colorBufferDesc.defaultState = ResourceState::RenderTarget;
+        colorBuffer = device->createTexture(colorBufferDesc, nullptr);
+        REQUIRE(colorBuffer != nullptr);
+
+        TextureViewDesc colorBufferViewDesc = {};
+        colorBufferViewDesc.format = Format::R32G32B32A32_FLOAT;
+        REQUIRE_CALL(device->createTextureView(colorBuffer, colorBufferViewDesc, colorBufferView.writeRef()));
+    }
+
+    void draw(IRenderPipeline* pipeline)
+    {
+        auto queue = device->getQueue(QueueType::Graphics);
+        auto encoder = queue->createCommandEncoder();
+
+        auto rootObject = device->createRootShaderObject(pipeline);
+        rootObject->finalize();
+
+        RenderPassColorAttachment colorAttachment;
+        colorAttachment.view = colorBufferView;
+        colorAttachment.loadOp = LoadOp::Clear;
+        colorAttachment.storeOp = StoreOp::Store;
+        RenderPassDesc renderPass;
+        renderPass.colorAttachments = &colorAttachment;
+        renderPass.colorAttachmentCount = 1;
+        auto passEncoder = encoder->beginRenderPass(renderPass);
+
+        RenderState state;
+        state.pipeline = pipeline;
+        state.rootObject = rootObject;
+        state.viewports[0] = Viewport(kWidth, kHeight);
+        state.viewportCount = 1;
+        state.scissorRects[0] = ScissorRect(kWidth, kHeight);
+        state.scissorRectCount = 1;
+        state.vertexBuffers[0] = vertexBuffer;
+        state.vertexBuffers[1] = instanceBuffer;
+        state.vertexBufferCount = 2;
+        passEncoder->setRenderState(state);
+
+        DrawArguments args;
+        args.vertexCount = kVertexCount;
+        args.instanceCount = kInstanceCount;
+        passEncoder->draw(args);
+        passEncoder->end();
+
+        queue->submit(encoder->finish());
+        queue->waitOnHost();
+    }
+
+    /// Read back four pixels located within the triangles.
+    void readPixels(float* outPixels)
+    {
+        ComPtr<ISlangBlob> resultBlob;
+        size_t rowPitch = 0;
+        size_t pixelSize = 0;
+        REQUIRE_CALL(device->readTexture(colorBuffer, resultBlob.writeRef(), &rowPitch, &pixelSize));
+        auto result = (const float*)resultBlob->getBufferPointer();
+
+        const int xCoords[kPixelCount] = {64, 192, 64, 192};
+        const int yCoords[kPixelCount] = {100, 100, 250, 250};
+        for (int i = 0; i < kPixelCount; ++i)
+        {
+            const float* pixel = result + xCoords[i] * kChannelCount + yCoords[i] * rowPitch / sizeof(float);
+            for (int j = 0; j < kChannelCount; ++j)
+                outPixels[i * kChannelCount + j] = pixel[j];
+        }
+    }
+};
+
+void testRenderPipelineVariants(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    RenderPipelineVariantsTest test;
+    test.init(device);
+
+    VertexStreamDesc vertexStreams[] = {
+        {sizeof(Vertex), InputSlotClass::PerVertex, 0},
+        {sizeof(Instance), InputSlotClass::PerInstance, 1},
+    };
+    InputElementDesc inputElements[] = {
+        {"POSITIONA", 0, Format::R32G32B32_FLOAT, offsetof(Vertex, position), 0},
+        {"POSITIONB", 0, Format::R32G32B32_FLOAT, offsetof(Instance, position), 1},
+        {"COLOR", 0, Format::R32G32B32_FLOAT, offsetof(Instance, color), 1},
+    };
+    InputLayoutDesc inputLayoutDesc = {};
+    inputLayoutDesc.inputElementCount = SLANG_COUNT_OF(inputElements);
+    inputLayoutDesc.inputElements = inputElements;
+    inputLayoutDesc.vertexStreamCount = SLANG_COUNT_OF(vertexStreams);
+    inputLayoutDesc.vertexStreams = vertexStreams;
+    auto inputLayout = device->createInputLayout(inputLayoutDesc);
+    REQUIRE(inputLayout != nullptr);
+
+    ComPtr<IShaderProgram> shaderProgram;
+    slang::ProgramLayout* slangReflection;
+    REQUIRE_CALL(loadGraphicsProgram(
+        device,
+        shaderProgram,
+        "test-instanced-draw",
+        "vertexMain",
+        "fragmentMain",
+        slangReflection
+    ));
+
+    // Variants of the same program differing in output format, blend and cull state. Variants only compile the
+    // pipeline libraries of the state that differs.
+    Format formats[] = {Format::R32G32B32A32_FLOAT, Format::R8G8B8A8_UNORM};
+    bool blendEnables[] = {false, true};
+    CullMode cullModes[] = {CullMode::None, CullMode::Back};
+    std::vector<ComPtr<IRenderPipeline>> pipelines;
+    for (Format format : formats)
+    {
+        for (bool enableBlend : blendEnables)
+        {
+            for (CullMode cullMode : cullModes)
+            {
+                ColorTargetState colorTarget;
+                colorTarget.format = format;
+                colorTarget.enableBlend = enableBlend;
+                colorTarget.color.srcFactor = BlendFactor::SrcAlpha;
+                colorTarget.color.dstFactor = BlendFactor::InvSrcAlpha;
+                RenderPipelineDesc pipelineDesc = {};
+                pipelineDesc.program = shaderProgram.get();
+                pipelineDesc.inputLayout = inputLayout;
+                pipelineDesc.targets = &colorTarget;
+                pipelineDesc.targetCount = 1;
+                pipelineDesc.rasterizer.cullMode = cullMode;
+                pipelineDesc.depthStencil.depthTestEnable = false;
+                pipelineDesc.depthStencil.depthWriteEnable = false;
+                ComPtr<IRenderPipeline> pipeline;
+                REQUIRE_CALL(device->createRenderPipeline(pipelineDesc, pipeline.writeRef()));
+                pipelines.push_back(pipeline);
+            }
+        }
+    }
+
+    for (auto& pipeline : pipelines)
+    {
+        NativeHandle handle;
+        REQUIRE_CALL(pipeline->getNativeHandle(&handle));
+        CHECK_NE(handle.value, 0);
+    }
+
+    // Render with the first variant (RGBA32F, no blending, no culling), which is linked without link time
+    // optimization if pipeline libraries are supported.
+    IRenderPipeline* pipeline = pipelines[0];
+    NativeHandle linkedHandle;
+    REQUIRE_CALL(pipeline->getNativeHandle(&linkedHandle));
+    test.draw(pipeline);
+    float linkedPixels[kPixelCount * kChannelCount];
+    test.readPixels(linkedPixels);
+    float expectedPixels[] =
+        {1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f};
+    compareResultFuzzy(linkedPixels, expectedPixels, SLANG_COUNT_OF(expectedPixels));
+
+    // Optimized pipelines are swapped in on submit once they are built. Devices without pipeline libraries keep
+    // the monolithic pipeline, so the wait is bounded.
+    NativeHandle handle = linkedHandle;
+    for (int i = 0; i < 200 && handle.value == linkedHandle.value; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        test.draw(pipeline);
+        REQUIRE_CALL(pipeline->getNativeHandle(&handle));
+    }
+
+    // The optimized pipeline renders the same image.
+    test.draw(pipeline);
+    float optimizedPixels[kPixelCount * kChannelCount];
+    test.readPixels(optimizedPixels);
+    compareResultFuzzy(optimizedPixels, linkedPixels, SLANG_COUNT_OF(linkedPixels));
+}
+
+TEST_CASE("render-pipeline-variants")
+{
+    runGpuTests(
+        testRenderPipelineVariants,
+        {
+            DeviceType::Vulkan,
+        }
+    );
+}
@@ -1,5 +1,7 @@
 #include "testing.h"
 
+#include "../src/state-tracking.h"
+
 #include <set>
 
 using namespace rhi;
@@ -118,6 +120,319 @@ void testTextureResourceStates(GpuTestContext* ctx, DeviceType deviceType)
     }
 }
 
+void testResourceStatesAcrossCommandBuffers(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    auto queue = device->getQueue(QueueType::Graphics);
+
+    const uint32_t initialData[] = {1, 2, 3, 4};
+
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = sizeof(initialData);
+    bufferDesc.elementSize = sizeof(uint32_t);
+    bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::CopySource | BufferUsage::CopyDestination;
+    bufferDesc.defaultState = ResourceState::ShaderResource;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+    ComPtr<IBuffer> src;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, initialData, src.writeRef()));
+    ComPtr<IBuffer> intermediate;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, intermediate.writeRef()));
+    ComPtr<IBuffer> dst;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, dst.writeRef()));
+
+    // Each command buffer leaves the buffers in a non-default state
+    // which the next command buffer has to pick up from.
+    {
+        auto commandEncoder = queue->createCommandEncoder();
+        commandEncoder->copyBuffer(intermediate, 0, src, 0, sizeof(initialData));
+        queue->submit(commandEncoder->finish());
+    }
+    {
+        auto commandEncoder = queue->createCommandEncoder();
+        commandEncoder->copyBuffer(dst, 0, intermediate, 0, sizeof(initialData));
+        queue->submit(commandEncoder->finish());
+    }
+    {
+        auto commandEncoder = queue->createCommandEncoder();
+        commandEncoder->setBufferState(intermediate, ResourceState::CopyDestination);
+        commandEncoder->copyBuffer(intermediate, 0, dst, 0, sizeof(initialData));
+        queue->submit(commandEncoder->finish());
+    }
+    queue->waitOnHost();
+
+    compareComputeResult(device, dst, makeArray<uint32_t>(1, 2, 3, 4));
+    compareComputeResult(device, intermediate, makeArray<uint32_t>(1, 2, 3, 4));
+}
+
+/// Checks StateTracking against a per-subresource model of the texture state.
+struct SubresourceStateChecker
+{
+    Texture* texture;
+    uint32_t mipLevelCount;
+    StateTracking stateTracking;
+    // Expected state of each subresource.
+    std::vector<ResourceState> expected;
+    // State of each subresource after applying the recorded barriers.
+    std::vector<ResourceState> barrierStates;
+
+    SubresourceStateChecker(ITexture* texture_)
+        : texture(checked_cast<Texture*>(texture_))
+        , mipLevelCount(texture->m_desc.mipLevelCount)
+    {
+        size_t subresourceCount = texture->m_desc.arrayLength * mipLevelCount;
+        expected.resize(subresourceCount, texture->m_desc.defaultState);
+        barrierStates = expected;
+    }
+
+    void setTextureState(SubresourceRange range, ResourceState state)
+    {
+        range = texture->resolveSubresourceRange(range);
+        for (GfxIndex layer = range.baseArrayLayer; layer < range.baseArrayLayer + range.layerCount; layer++)
+            for (GfxIndex mip = range.mipLevel; mip < range.mipLevel + range.mipLevelCount; mip++)
+                expected[layer * mipLevelCount + mip] = state;
+
+        stateTracking.setTextureState(texture, range, state);
+
+        for (const TextureBarrier& barrier : stateTracking.getTextureBarriers())
+        {
+            CHECK_EQ(barrier.texture, texture);
+            CHECK_NE(barrier.stateBefore, barrier.stateAfter);
+            CHECK_EQ(barrier.stateAfter, state);
+            GfxIndex layerEnd = barrier.arrayLayer + barrier.arrayLayerCount;
+            GfxIndex mipEnd = barrier.mipLevel + barrier.mipLevelCount;
+            if (barrier.entireTexture)
+            {
+                layerEnd = texture->m_desc.arrayLength;
+                mipEnd = mipLevelCount;
+            }
+            for (GfxIndex layer = barrier.entireTexture ? 0 : barrier.arrayLayer; layer < layerEnd; layer++)
+            {
+                for (GfxIndex mip = barrier.entireTexture ? 0 : barrier.mipLevel; mip < mipEnd; mip++)
+                {
+                    ResourceState& barrierState = barrierStates[layer * mipLevelCount + mip];
+                    CHECK_EQ(barrierState, barrier.stateBefore);
+                    barrierState = barrier.stateAfter;
+                }
+            }
+        }
+        stateTracking.clearBarriers();
+        CHECK(barrierStates == expected);
+
+        // Expand the run-length encoded tracked state.
+        REQUIRE_EQ(stateTracking.getTextureStates().size(), 1u);
+        const TextureState& textureState = stateTracking.getTextureStates()[0].state;
+        std::vector<ResourceState> tracked(expected.size(), textureState.state);
+        for (size_t i = 0; i < textureState.runs.size(); i++)
+        {
+            if (i > 0)
+            {
+                CHECK_LT(textureState.runs[i - 1].start, textureState.runs[i].start);
+                CHECK_NE(textureState.runs[i - 1].state, textureState.runs[i].state);
+            }
+            size_t end = i + 1 < textureState.runs.size() ? textureState.runs[i + 1].start : tracked.size();
+            std::fill(tracked.begin() + textureState.runs[i].start, tracked.begin() + end, textureState.runs[i].state);
+        }
+        CHECK(tracked == expected);
+    }
+};
+
+void testTextureSubresourceStates(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    auto queue = device->getQueue(QueueType::Graphics);
+
+    TextureDesc texDesc = {};
+    texDesc.type = TextureType::Texture2D;
+    texDesc.format = Format::R8G8B8A8_UNORM;
+    texDesc.size = Extents{4, 4, 1};
+    texDesc.arrayLength = 256;
+    texDesc.mipLevelCount = 3;
+    texDesc.usage = TextureUsage::ShaderResource | TextureUsage::CopySource | TextureUsage::CopyDestination;
+    texDesc.defaultState = ResourceState::ShaderResource;
+    texDesc.memoryType = MemoryType::DeviceLocal;
+    ComPtr<ITexture> texture;
+    REQUIRE_CALL(device->createTexture(texDesc, nullptr, texture.writeRef()));
+
+    // Put alternating layers and individual mip levels into different states, then restore the entire texture.
+    {
+        auto commandEncoder = queue->createCommandEncoder();
+        SubresourceStateChecker checker(texture);
+        auto setTextureState = [&](SubresourceRange range, ResourceState state)
+        {
+            commandEncoder->setTextureState(texture, range, state);
+            checker.setTextureState(range, state);
+        };
+        for (GfxIndex layer = 0; layer < texDesc.arrayLength; layer += 2)
+            setTextureState({0, 3, layer, 1}, ResourceState::CopySource);
+        CHECK_EQ(checker.stateTracking.getTextureStates()[0].state.runs.size(), 256u);
+        setTextureState({1, 1, 0, texDesc.arrayLength}, ResourceState::CopyDestination);
+        setTextureState({0, 3, 64, 128}, ResourceState::CopySource);
+        setTextureState({1, 1, 65, 1}, ResourceState::CopySource);
+        queue->submit(commandEncoder->finish());
+    }
+    {
+        auto commandEncoder = queue->createCommandEncoder();
+        SubresourceStateChecker checker(texture);
+        auto setTextureState = [&](SubresourceRange range, ResourceState state)
+        {
+            commandEncoder->setTextureState(texture, range, state);
+            checker.setTextureState(range, state);
+        };
+        setTextureState({2, 1, 1, 1}, ResourceState::CopyDestination);
+        setTextureState(kEntireTexture, ResourceState::ShaderResource);
+        // Restoring the entire texture collapses the runs.
+        CHECK(checker.stateTracking.getTextureStates()[0].state.runs.empty());
+        CHECK_EQ(checker.stateTracking.getTextureStates()[0].state.state, ResourceState::ShaderResource);
+        queue->submit(commandEncoder->finish());
+    }
+    queue->waitOnHost();
+}
+
+void testMergedStateTransitions(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    auto queue = device->getQueue(QueueType::Graphics);
+
+    const uint32_t initialData[] = {1, 2, 3, 4};
+
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = sizeof(initialData);
+    bufferDesc.elementSize = sizeof(uint32_t);
+    bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess | BufferUsage::CopySource |
+                       BufferUsage::CopyDestination;
+    bufferDesc.defaultState = ResourceState::ShaderResource;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+    ComPtr<IBuffer> src;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, initialData, src.writeRef()));
+    ComPtr<IBuffer> intermediate;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, intermediate.writeRef()));
+    ComPtr<IBuffer> dst;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, dst.writeRef()));
+
+    // Several transitions of the same resource without commands in between end up in one batch.
+    {
+        auto commandEncoder = queue->createCommandEncoder();
+        commandEncoder->setBufferState(src, ResourceState::UnorderedAccess);
+        commandEncoder->setBufferState(src, ResourceState::CopyDestination);
+        commandEncoder->setBufferState(src, ResourceState::ShaderResource);
+        commandEncoder->setBufferState(intermediate, ResourceState::CopySource);
+        commandEncoder->copyBuffer(intermediate, 0, src, 0, sizeof(initialData));
+        commandEncoder->setBufferState(intermediate, ResourceState::UnorderedAccess);
+        commandEncoder->setBufferState(dst, ResourceState::CopySource);
+        commandEncoder->copyBuffer(dst, 0, intermediate, 0, sizeof(initialData));
+        commandEncoder->setBufferState(dst, ResourceState::UnorderedAccess);
+        queue->submit(commandEncoder->finish());
+    }
+    queue->waitOnHost();
+
+    compareComputeResult(device, dst, makeArray<uint32_t>(1, 2, 3, 4));
+    compareComputeResult(device, intermediate, makeArray<uint32_t>(1, 2, 3, 4));
+}
+
+/// Transitions of overlapping subresource ranges without commands in between end up in one batch of barriers.
+void testOverlappingTextureTransitions(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    auto queue = device->getQueue(QueueType::Graphics);
+
+    TextureDesc texDesc = {};
+    texDesc.type = TextureType::Texture2D;
+    texDesc.format = Format::R32_UINT;
+    texDesc.size = Extents{4, 4, 1};
+    texDesc.mipLevelCount = 3;
+    texDesc.usage = TextureUsage::ShaderResource | TextureUsage::CopySource | TextureUsage::CopyDestination;
+    texDesc.defaultState = ResourceState::ShaderResource;
+    texDesc.memoryType = MemoryType::DeviceLocal;
+    // Mip level i is filled with i + 1.
+    std::vector<uint32_t> mipData[3];
+    SubresourceData initData[3];
+    for (uint32_t mip = 0; mip < 3; mip++)
+    {
+        uint32_t size = 4 >> mip;
+        mipData[mip].resize(size * size, mip + 1);
+        initData[mip] = {mipData[mip].data(), size * sizeof(uint32_t), size * size * sizeof(uint32_t)};
+    }
+    ComPtr<ITexture> texture;
+    REQUIRE_CALL(device->createTexture(texDesc, initData, texture.writeRef()));
+
+    // A mip range, a sub-range of it and then the entire texture.
+    {
+        auto commandEncoder = queue->createCommandEncoder();
+        SubresourceStateChecker checker(texture);
+        auto setTextureState = [&](SubresourceRange range, ResourceState state)
+        {
+            commandEncoder->setTextureState(texture, range, state);
+            checker.setTextureState(range, state);
+        };
+        setTextureState({0, 2, 0, 1}, ResourceState::CopyDestination);
+        setTextureState({1, 1, 0, 1}, ResourceState::CopySource);
+        setTextureState(kEntireTexture, ResourceState::CopySource);
+        queue->submit(commandEncoder->finish());
+    }
+    queue->waitOnHost();
+
+    ComPtr<ISlangBlob> blob;
+    Size rowPitch, pixelSize;
+    REQUIRE_CALL(device->readTexture(texture, blob.writeRef(), &rowPitch, &pixelSize));
+    const uint8_t* data = (const uint8_t*)blob->getBufferPointer();
+    for (uint32_t y = 0; y < 4; y++)
+    {
+        const uint32_t* row = (const uint32_t*)(data + y * rowPitch);
+        for (uint32_t x = 0; x < 4; x++)
+            CHECK_EQ(row[x], 1);
+    }
+}
+
+TEST_CASE("texture-subresource-states")
+{
+    runGpuTests(
+        testTextureSubresourceStates,
+        {
+            DeviceType::CPU,
+            DeviceType::D3D12,
+            DeviceType::Vulkan,
+        }
+    );
+}
+
+TEST_CASE("overlapping-texture-transitions")
+{
+    runGpuTests(
+        testOverlappingTextureTransitions,
+        {
+            DeviceType::CPU,
+            DeviceType::D3D12,
+            DeviceType::Vulkan,
+        }
+    );
+}
+
+TEST_CASE("merged-state-transitions")
+{
+    runGpuTests(
+        testMergedStateTransitions,
+        {
+            DeviceType::D3D12,
+            DeviceType::Vulkan,
+        }
+    );
+}
+
+TEST_CASE("resource-states-across-command-buffers")
+{
+    runGpuTests(
+        testResourceStatesAcrossCommandBuffers,
+        {
+            DeviceType::D3D12,
+            DeviceType::Vulkan,
+        }
+    );
+}
+
 TEST_CASE("buffer-resource-states")
 {
     runGpuTests(
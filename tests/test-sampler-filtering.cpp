@@ -0,0 +1,106 @@
+#include "testing.h"
+
+using namespace rhi;
+using namespace rhi::testing;
+
+static ComPtr<ISampler> createSampler(IDevice* device, TextureFilteringMode filter, TextureAddressingMode address)
+{
+    SamplerDesc desc = {};
+    desc.minFilter = filter;
+    desc.magFilter = filter;
+    desc.mipFilter = filter;
+    desc.addressU = address;
+    desc.addressV = address;
+    desc.addressW = address;
+    ComPtr<ISampler> sampler;
+    REQUIRE_CALL(device->createSampler(desc, sampler.writeRef()));
+    return sampler;
+}
+
+void testSamplerFiltering(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    ComPtr<IShaderProgram> shaderProgram;
+    slang::ProgramLayout* slangReflection;
+    REQUIRE_CALL(loadComputeProgram(device, shaderProgram, "test-sampler-filtering", "computeMain", slangReflection));
+
+    ComputePipelineDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<IComputePipeline> pipeline;
+    REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipeline.writeRef()));
+
+    // 2x1 texture with the texels 0 and 1, its 1x1 mip level is 2.
+    TextureDesc textureDesc = {};
+    textureDesc.type = TextureType::Texture2D;
+    textureDesc.format = Format::R32G32B32A32_FLOAT;
+    textureDesc.size.width = 2;
+    textureDesc.size.height = 1;
+    textureDesc.size.depth = 1;
+    textureDesc.mipLevelCount = 2;
+    textureDesc.usage = TextureUsage::ShaderResource | TextureUsage::CopyDestination;
+    textureDesc.defaultState = ResourceState::ShaderResource;
+    float mip0[] = {0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f};
+    float mip1[] = {2.0f, 0.0f, 0.0f, 1.0f};
+    SubresourceData subresourceData[2] = {{mip0, sizeof(mip0), sizeof(mip0)}, {mip1, sizeof(mip1), sizeof(mip1)}};
+    ComPtr<ITexture> texture;
+    REQUIRE_CALL(device->createTexture(textureDesc, subresourceData, texture.writeRef()));
+
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = 5 * sizeof(float);
+    bufferDesc.format = Format::Unknown;
+    bufferDesc.elementSize = sizeof(float);
+    bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess | BufferUsage::CopyDestination |
+                       BufferUsage::CopySource;
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, buffer.writeRef()));
+
+    ComPtr<IShaderObject> rootObject = device->createRootShaderObject(pipeline);
+    {
+        auto cursor = ShaderCursor(rootObject);
+        cursor["tex"].setBinding(texture);
+        cursor["linearClamp"].setBinding(
+            createSampler(device, TextureFilteringMode::Linear, TextureAddressingMode::ClampToEdge)
+        );
+        cursor["linearWrap"].setBinding(
+            createSampler(device, TextureFilteringMode::Linear, TextureAddressingMode::Wrap)
+        );
+        cursor["pointClamp"].setBinding(
+            createSampler(device, TextureFilteringMode::Point, TextureAddressingMode::ClampToEdge)
+        );
+        cursor["buffer"].setBinding(buffer);
+    }
+    rootObject->finalize();
+
+    {
+        auto queue = device->getQueue(QueueType::Graphics);
+        auto encoder = queue->createCommandEncoder();
+
+        auto passEncoder = encoder->beginComputePass();
+        ComputeState state;
+        state.pipeline = pipeline;
+        state.rootObject = rootObject;
+        passEncoder->setComputeState(state);
+        passEncoder->dispatchCompute(1, 1, 1);
+        passEncoder->end();
+
+        queue->submit(encoder->finish());
+        queue->waitOnHost();
+    }
+
+    compareComputeResult(device, buffer, makeArray<float>(0.5f, 0.0f, 0.5f, 0.0f, 1.25f));
+}
+
+TEST_CASE("sampler-filtering")
+{
+    runGpuTests(
+        testSamplerFiltering,
+        {
+            DeviceType::D3D12,
+            DeviceType::Vulkan,
+            DeviceType::CPU,
+        }
+    );
+}
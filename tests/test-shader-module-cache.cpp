@@ -0,0 +1,123 @@
+#include "testing.h"
+
+#if SLANG_RHI_ENABLE_VULKAN
+#include "../src/vulkan/vk-shader-program.h"
+#endif
+
+#include <thread>
+#include <vector>
+
+using namespace rhi;
+using namespace rhi::testing;
+
+static void runTrivialCompute(IDevice* device, IComputePipeline* pipeline, IBuffer* buffer)
+{
+    auto queue = device->getQueue(QueueType::Graphics);
+    auto encoder = queue->createCommandEncoder();
+
+    auto rootObject = device->createRootShaderObject(pipeline);
+    ShaderCursor(rootObject)["buffer"].setBinding(buffer);
+    rootObject->finalize();
+
+    auto passEncoder = encoder->beginComputePass();
+    ComputeState state;
+    state.pipeline = pipeline;
+    state.rootObject = rootObject;
+    passEncoder->setComputeState(state);
+    passEncoder->dispatchCompute(1, 1, 1);
+    passEncoder->end();
+
+    queue->submit(encoder->finish());
+    queue->waitOnHost();
+}
+
+void testShaderModuleCache(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    const int numberCount = 4;
+    float initialData[] = {0.0f, 1.0f, 2.0f, 3.0f};
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = numberCount * sizeof(float);
+    bufferDesc.format = Format::Unknown;
+    bufferDesc.elementSize = sizeof(float);
+    bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess | BufferUsage::CopyDestination |
+                       BufferUsage::CopySource;
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, initialData, buffer.writeRef()));
+
+    // Two programs compiling to the same code share their shader modules and pipeline layouts.
+    ComPtr<IShaderProgram> programA;
+    ComPtr<IShaderProgram> programB;
+    slang::ProgramLayout* slangReflection;
+    REQUIRE_CALL(loadComputeProgram(device, programA, "test-compute-trivial", "computeMain", slangReflection));
+    REQUIRE_CALL(loadComputeProgram(device, programB, "test-compute-trivial", "computeMain", slangReflection));
+
+    ComputePipelineDesc pipelineDesc = {};
+    pipelineDesc.program = programA.get();
+    ComPtr<IComputePipeline> pipelineA;
+    REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipelineA.writeRef()));
+    pipelineDesc.program = programB.get();
+    ComPtr<IComputePipeline> pipelineB;
+    REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipelineB.writeRef()));
+
+    runTrivialCompute(device, pipelineA, buffer);
+    runTrivialCompute(device, pipelineB, buffer);
+    compareComputeResult(device, buffer, makeArray<float>(2.0f, 3.0f, 4.0f, 5.0f));
+
+#if SLANG_RHI_ENABLE_VULKAN
+    {
+        // Pipelines may have been created by identifier, so create the modules explicitly.
+        auto programImplA = checked_cast<vk::ShaderProgramImpl*>(programA.get());
+        auto programImplB = checked_cast<vk::ShaderProgramImpl*>(programB.get());
+        REQUIRE_EQ(programImplA->m_modules.size(), 1);
+        REQUIRE_EQ(programImplB->m_modules.size(), 1);
+        CHECK_EQ(programImplA->m_modules[0], programImplB->m_modules[0]);
+        REQUIRE_CALL(programImplA->ensureShaderModules());
+        REQUIRE_CALL(programImplB->ensureShaderModules());
+        VkShaderModule module = programImplA->m_stageCreateInfos[0].module;
+        CHECK_NE(module, VK_NULL_HANDLE);
+        CHECK_EQ(programImplB->m_stageCreateInfos[0].module, module);
+
+        // Shader modules of a new program can be created from multiple threads at once.
+        ComPtr<IShaderProgram> programC;
+        REQUIRE_CALL(loadComputeProgram(device, programC, "test-compute-trivial", "computeMain", slangReflection));
+        auto programImplC = checked_cast<vk::ShaderProgramImpl*>(programC.get());
+        std::vector<std::thread> threads;
+        std::vector<Result> results(4, SLANG_FAIL);
+        for (size_t i = 0; i < results.size(); i++)
+            threads.emplace_back([&, i]() { results[i] = programImplC->ensureShaderModules(); });
+        for (auto& thread : threads)
+            thread.join();
+        for (Result result : results)
+            CHECK(SLANG_SUCCEEDED(result));
+        CHECK_EQ(programImplC->m_stageCreateInfos[0].module, module);
+    }
+#endif
+
+    // Releasing one program keeps the shared module alive for the other.
+    pipelineA = nullptr;
+    programA = nullptr;
+    runTrivialCompute(device, pipelineB, buffer);
+    compareComputeResult(device, buffer, makeArray<float>(3.0f, 4.0f, 5.0f, 6.0f));
+
+    // Recreate the pipeline from a new program, which may be created from the pipeline cache by
+    // shader module identifier.
+    REQUIRE_CALL(loadComputeProgram(device, programA, "test-compute-trivial", "computeMain", slangReflection));
+    pipelineDesc.program = programA.get();
+    REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipelineA.writeRef()));
+    runTrivialCompute(device, pipelineA, buffer);
+    compareComputeResult(device, buffer, makeArray<float>(4.0f, 5.0f, 6.0f, 7.0f));
+}
+
+TEST_CASE("shader-module-cache")
+{
+    runGpuTests(
+        testShaderModuleCache,
+        {
+            DeviceType::Vulkan,
+        }
+    );
+}
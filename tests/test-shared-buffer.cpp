@@ -74,6 +74,11 @@ void testSharedBuffer(GpuTestContext* ctx, DeviceType deviceType)
     compareComputeResult(dstDevice, dstBuffer, makeArray<float>(1.0f, 2.0f, 3.0f, 4.0f));
 }
 
+TEST_CASE("shared-buffer-cpu")
+{
+    runGpuTests(testSharedBuffer<DeviceType::CPU>, {DeviceType::CPU});
+}
+
 #if SLANG_WIN64
 TEST_CASE("shared-buffer-cuda")
 {
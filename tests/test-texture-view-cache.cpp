@@ -0,0 +1,216 @@
+#include "testing.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace rhi;
+using namespace rhi::testing;
+
+static uint64_t getViewHandle(ITextureView* view)
+{
+    NativeHandle handle;
+    REQUIRE_CALL(view->getNativeHandle(&handle));
+    return handle.value;
+}
+
+void testTextureViewCache(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    const int mipCount = 4;
+    TextureDesc textureDesc = {};
+    textureDesc.type = TextureType::Texture2D;
+    textureDesc.size = {64, 64, 1};
+    textureDesc.arrayLength = 2;
+    textureDesc.mipLevelCount = mipCount;
+    textureDesc.format = Format::R8G8B8A8_UNORM;
+    textureDesc.usage = TextureUsage::ShaderResource | TextureUsage::UnorderedAccess;
+    textureDesc.defaultState = ResourceState::ShaderResource;
+    ComPtr<ITexture> texture;
+    REQUIRE_CALL(device->createTexture(textureDesc, nullptr, texture.writeRef()));
+
+    // Views with the same desc share the native view of the texture.
+    ComPtr<ITextureView> defaultView;
+    REQUIRE_CALL(device->createTextureView(texture, {}, defaultView.writeRef()));
+    ComPtr<ITextureView> defaultView2;
+    REQUIRE_CALL(device->createTextureView(texture, {}, defaultView2.writeRef()));
+    uint64_t defaultHandle = getViewHandle(defaultView);
+    CHECK_NE(defaultHandle, 0);
+    CHECK_EQ(getViewHandle(defaultView2), defaultHandle);
+
+    std::vector<ComPtr<ITextureView>> mipViews(mipCount);
+    std::vector<uint64_t> mipHandles(mipCount);
+    for (int mip = 0; mip < mipCount; mip++)
+    {
+        TextureViewDesc viewDesc = {};
+        viewDesc.subresourceRange = {mip, 1, 0, 1};
+        REQUIRE_CALL(device->createTextureView(texture, viewDesc, mipViews[mip].writeRef()));
+        mipHandles[mip] = getViewHandle(mipViews[mip]);
+        CHECK_NE(mipHandles[mip], defaultHandle);
+        for (int other = 0; other < mip; other++)
+            CHECK_NE(mipHandles[mip], mipHandles[other]);
+    }
+
+    // Look up views from multiple threads, as when binding views while recording in parallel.
+    const uint32_t threadCount = 8;
+    const uint32_t iterationCount = 1000;
+    std::atomic<uint32_t> mismatchCount{0};
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                uint32_t mismatches = 0;
+                for (uint32_t i = 0; i < iterationCount; i++)
+                {
+                    NativeHandle handle;
+                    // Mostly default views, with a share of subresource views.
+                    if ((i + t) % 4 != 0)
+                    {
+                        defaultView->getNativeHandle(&handle);
+                        mismatches += handle.value != defaultHandle;
+                    }
+                    else
+                    {
+                        uint32_t mip = (i / 4) % mipCount;
+                        mipViews[mip]->getNativeHandle(&handle);
+                        mismatches += handle.value != mipHandles[mip];
+                    }
+                }
+                mismatchCount += mismatches;
+            }
+        );
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    CHECK_EQ(mismatchCount.load(), 0);
+
+    // Create views of the second array layer concurrently, all threads must end up with the same native views.
+    std::vector<std::vector<uint64_t>> layerHandles(threadCount, std::vector<uint64_t>(mipCount));
+    threads.clear();
+    for (uint32_t t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                for (int mip = 0; mip < mipCount; mip++)
+                {
+                    TextureViewDesc viewDesc = {};
+                    viewDesc.subresourceRange = {mip, 1, 1, 1};
+                    ComPtr<ITextureView> view;
+                    if (SLANG_SUCCEEDED(device->createTextureView(texture, viewDesc, view.writeRef())))
+                    {
+                        NativeHandle handle = {};
+                        view->getNativeHandle(&handle);
+                        layerHandles[t][mip] = handle.value;
+                    }
+                }
+            }
+        );
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    for (int mip = 0; mip < mipCount; mip++)
+    {
+        CAPTURE(mip);
+        CHECK_NE(layerHandles[0][mip], 0);
+        CHECK_NE(layerHandles[0][mip], mipHandles[mip]);
+        for (uint32_t t = 1; t < threadCount; t++)
+            CHECK_EQ(layerHandles[t][mip], layerHandles[0][mip]);
+    }
+}
+
+TEST_CASE("texture-view-cache")
+{
+    runGpuTests(
+        testTextureViewCache,
+        {
+            DeviceType::Vulkan,
+        }
+    );
+}
+
+/// Measures view lookups from multiple threads. Shader objects look up the native view of every bound texture
+/// view when writing descriptors, so this is the cost of binding views while recording in parallel.
+void testTextureViewCacheBenchmark(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    const int mipCount = 4;
+    TextureDesc textureDesc = {};
+    textureDesc.type = TextureType::Texture2D;
+    textureDesc.size = {64, 64, 1};
+    textureDesc.mipLevelCount = mipCount;
+    textureDesc.format = Format::R8G8B8A8_UNORM;
+    textureDesc.usage = TextureUsage::ShaderResource | TextureUsage::UnorderedAccess;
+    textureDesc.defaultState = ResourceState::ShaderResource;
+    ComPtr<ITexture> texture;
+    REQUIRE_CALL(device->createTexture(textureDesc, nullptr, texture.writeRef()));
+
+    ComPtr<ITextureView> defaultView;
+    REQUIRE_CALL(device->createTextureView(texture, {}, defaultView.writeRef()));
+    std::vector<ComPtr<ITextureView>> mipViews(mipCount);
+    for (int mip = 0; mip < mipCount; mip++)
+    {
+        TextureViewDesc viewDesc = {};
+        viewDesc.subresourceRange = {mip, 1, 0, 1};
+        REQUIRE_CALL(device->createTextureView(texture, viewDesc, mipViews[mip].writeRef()));
+    }
+
+    const uint32_t iterationCount = 200000;
+    for (bool useMipViews : {false, true})
+    {
+        for (uint32_t threadCount : {1u, 2u, 4u, 8u})
+        {
+            std::atomic<uint64_t> handleSum{0};
+            std::vector<std::thread> threads;
+            auto startTime = std::chrono::high_resolution_clock::now();
+            for (uint32_t t = 0; t < threadCount; t++)
+            {
+                threads.emplace_back(
+                    [&]()
+                    {
+                        uint64_t sum = 0;
+                        for (uint32_t i = 0; i < iterationCount; i++)
+                        {
+                            ITextureView* view = useMipViews ? mipViews[i % mipCount].get() : defaultView.get();
+                            NativeHandle handle;
+                            view->getNativeHandle(&handle);
+                            sum += handle.value;
+                        }
+                        handleSum += sum;
+                    }
+                );
+            }
+            for (auto& thread : threads)
+                thread.join();
+            auto endTime = std::chrono::high_resolution_clock::now();
+
+            CHECK_NE(handleSum.load(), 0);
+            double seconds = std::chrono::duration<double>(endTime - startTime).count();
+            double lookupsPerSecond = double(threadCount) * iterationCount / seconds;
+            MESSAGE(
+                doctest::String(useMipViews ? "Subresource" : "Default"),
+                " view lookups per second (",
+                threadCount,
+                " threads): ",
+                lookupsPerSecond
+            );
+        }
+    }
+}
+
+TEST_CASE("texture-view-cache-benchmark")
+{
+    runGpuTests(
+        testTextureViewCacheBenchmark,
+        {
+            DeviceType::Vulkan,
+        }
+    );
+}
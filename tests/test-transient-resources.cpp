@@ -0,0 +1,206 @@
+#include "testing.h"
+
+using namespace rhi;
+using namespace rhi::testing;
+
+void testTransientBuffers(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    ComPtr<IShaderProgram> shaderProgram;
+    slang::ProgramLayout* slangReflection;
+    REQUIRE_CALL(loadComputeProgram(device, shaderProgram, "test-compute-trivial", "computeMain", slangReflection));
+
+    ComputePipelineDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<IComputePipeline> pipeline;
+    REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipeline.writeRef()));
+
+    const int numberCount = 4;
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = numberCount * sizeof(float);
+    bufferDesc.format = Format::Unknown;
+    bufferDesc.elementSize = sizeof(float);
+    bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess | BufferUsage::CopyDestination |
+                       BufferUsage::CopySource;
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+    ComPtr<IBuffer> resultA;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, resultA.writeRef()));
+    ComPtr<IBuffer> resultB;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, resultB.writeRef()));
+
+    auto queue = device->getQueue(QueueType::Graphics);
+
+    // Record the same frame a few times, so transient buffers are handed out again by the pools.
+    for (int frame = 0; frame < 4; frame++)
+    {
+        auto encoder = queue->createCommandEncoder();
+
+        // A is only used before B, so B can be placed in the memory of A.
+        ComPtr<IBuffer> transientA;
+        REQUIRE_CALL(encoder->createTransientBuffer(bufferDesc, transientA.writeRef()));
+        ComPtr<IBuffer> transientB;
+        REQUIRE_CALL(encoder->createTransientBuffer(bufferDesc, transientB.writeRef()));
+        CHECK_NE(transientA.get(), transientB.get());
+
+        float dataA[] = {0.0f, 1.0f, 2.0f, 3.0f};
+        encoder->uploadBufferData(transientA, 0, sizeof(dataA), dataA);
+
+        auto rootObject = device->createRootShaderObject(pipeline);
+        ShaderCursor(rootObject)["buffer"].setBinding(transientA);
+        rootObject->finalize();
+
+        auto passEncoder = encoder->beginComputePass();
+        ComputeState state;
+        state.pipeline = pipeline;
+        state.rootObject = rootObject;
+        passEncoder->setComputeState(state);
+        passEncoder->dispatchCompute(1, 1, 1);
+        passEncoder->end();
+
+        encoder->copyBuffer(resultA, 0, transientA, 0, bufferDesc.size);
+
+        float dataB[] = {10.0f, 20.0f, 30.0f, 40.0f};
+        encoder->uploadBufferData(transientB, 0, sizeof(dataB), dataB);
+        encoder->copyBuffer(resultB, 0, transientB, 0, bufferDesc.size);
+
+        queue->submit(encoder->finish());
+        queue->waitOnHost();
+
+        compareComputeResult(device, resultA, makeArray<float>(1.0f, 2.0f, 3.0f, 4.0f));
+        compareComputeResult(device, resultB, makeArray<float>(10.0f, 20.0f, 30.0f, 40.0f));
+    }
+}
+
+void testTransientTextures(GpuTestContext* ctx, DeviceType deviceType)
+{
+    ComPtr<IDevice> device = createTestingDevice(ctx, deviceType);
+
+    const uint32_t width = 16;
+    const uint32_t height = 16;
+
+    TextureDesc textureDesc = {};
+    textureDesc.type = TextureType::Texture2D;
+    textureDesc.format = Format::R32_UINT;
+    textureDesc.size = Extents{width, height, 1};
+    textureDesc.mipLevelCount = 1;
+    textureDesc.usage = TextureUsage::ShaderResource | TextureUsage::CopySource | TextureUsage::CopyDestination;
+    textureDesc.defaultState = ResourceState::ShaderResource;
+    textureDesc.memoryType = MemoryType::DeviceLocal;
+
+    size_t alignment;
+    device->getTextureRowAlignment(&alignment);
+    Size rowStride = (width * sizeof(uint32_t) + alignment - 1) & ~(alignment - 1);
+
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = rowStride * height;
+    bufferDesc.usage = BufferUsage::CopySource | BufferUsage::CopyDestination;
+    bufferDesc.defaultState = ResourceState::CopyDestination;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+    ComPtr<IBuffer> resultA;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, resultA.writeRef()));
+    ComPtr<IBuffer> resultB;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, resultB.writeRef()));
+
+    std::vector<uint32_t> dataA(width * height);
+    std::vector<uint32_t> dataB(width * height);
+    for (uint32_t i = 0; i < width * height; i++)
+    {
+        dataA[i] = i;
+        dataB[i] = 0x10000 + i;
+    }
+
+    auto queue = device->getQueue(QueueType::Graphics);
+
+    auto checkResult = [&](IBuffer* buffer, const std::vector<uint32_t>& expected)
+    {
+        ComPtr<ISlangBlob> blob;
+        REQUIRE_CALL(device->readBuffer(buffer, 0, bufferDesc.size, blob.writeRef()));
+        for (uint32_t y = 0; y < height; y++)
+        {
+            const uint32_t* row = (const uint32_t*)((const uint8_t*)blob->getBufferPointer() + y * rowStride);
+            CAPTURE(y);
+            CHECK(::memcmp(row, expected.data() + y * width, width * sizeof(uint32_t)) == 0);
+        }
+    };
+
+    // Record the same frame a few times, so transient textures are handed out again by the pools.
+    for (int frame = 0; frame < 4; frame++)
+    {
+        auto encoder = queue->createCommandEncoder();
+
+        // A is only used before B, so B can be placed in the memory of A. Reading back both textures checks that
+        // B is initialized after all uses of A and that A is not overwritten before it is read.
+        ComPtr<ITexture> transientA;
+        REQUIRE_CALL(encoder->createTransientTexture(textureDesc, transientA.writeRef()));
+        ComPtr<ITexture> transientB;
+        REQUIRE_CALL(encoder->createTransientTexture(textureDesc, transientB.writeRef()));
+        CHECK_NE(transientA.get(), transientB.get());
+
+        SubresourceData subresourceDataA = {dataA.data(), width * sizeof(uint32_t), 0};
+        encoder->uploadTextureData(transientA, {0, 1, 0, 1}, {0, 0, 0}, {width, height, 1}, &subresourceDataA, 1);
+        encoder->copyTextureToBuffer(
+            resultA,
+            0,
+            bufferDesc.size,
+            rowStride,
+            transientA,
+            {0, 1, 0, 1},
+            {0, 0, 0},
+            {width, height, 1}
+        );
+
+        SubresourceData subresourceDataB = {dataB.data(), width * sizeof(uint32_t), 0};
+        encoder->uploadTextureData(transientB, {0, 1, 0, 1}, {0, 0, 0}, {width, height, 1}, &subresourceDataB, 1);
+        encoder->copyTextureToBuffer(
+            resultB,
+            0,
+            bufferDesc.size,
+            rowStride,
+            transientB,
+            {0, 1, 0, 1},
+            {0, 0, 0},
+            {width, height, 1}
+        );
+
+        queue->submit(encoder->finish());
+        queue->waitOnHost();
+
+        checkResult(resultA, dataA);
+        checkResult(resultB, dataB);
+    }
+}
+
+TEST_CASE("transient-buffers")
+{
+    runGpuTests(
+        testTransientBuffers,
+        {
+            DeviceType::D3D11,
+            DeviceType::D3D12,
+            DeviceType::Vulkan,
+            DeviceType::Metal,
+            DeviceType::CUDA,
+            DeviceType::CPU,
+            DeviceType::WGPU,
+        }
+    );
+}
+
+TEST_CASE("transient-textures")
+{
+    runGpuTests(
+        testTransientTextures,
+        {
+            DeviceType::D3D11,
+            DeviceType::D3D12,
+            DeviceType::Vulkan,
+            DeviceType::Metal,
+            DeviceType::CUDA,
+            DeviceType::CPU,
+            DeviceType::WGPU,
+        }
+    );
+}
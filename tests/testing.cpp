@@ -374,6 +374,24 @@ ComPtr<IDevice> createTestingDevice(
     return device;
 }
 
+ComPtr<IDevice> createTestingCPUDevice(GpuTestContext* ctx, const CPUDeviceExtendedDesc& cpuDesc)
+{
+    CPUDeviceExtendedDesc extDesc = cpuDesc;
+    void* extDescPtrs[] = {&extDesc};
+
+    ComPtr<IDevice> device;
+    DeviceDesc deviceDesc = {};
+    deviceDesc.deviceType = DeviceType::CPU;
+    deviceDesc.extendedDescCount = 1;
+    deviceDesc.extendedDescs = extDescPtrs;
+    deviceDesc.slang.slangGlobalSession = ctx->slangGlobalSession;
+    auto searchPaths = getSlangSearchPaths();
+    deviceDesc.slang.searchPaths = searchPaths.data();
+    deviceDesc.slang.searchPathCount = searchPaths.size();
+    REQUIRE_CALL(getRHI()->createDevice(deviceDesc, device.writeRef()));
+    return device;
+}
+
 void releaseCachedDevices()
 {
     gCachedDevices.clear();
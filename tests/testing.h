@@ -129,6 +129,9 @@ ComPtr<IDevice> createTestingDevice(
     std::vector<const char*> additionalSearchPaths = {}
 );
 
+/// Create an uncached CPU device with backend specific options.
+ComPtr<IDevice> createTestingCPUDevice(GpuTestContext* ctx, const CPUDeviceExtendedDesc& cpuDesc);
+
 void releaseCachedDevices();
 
 ComPtr<slang::ISession> createTestingSession(